@@ -181,108 +181,121 @@ bool DTrack2::server_parseerror()
 
 
 /**
- *	\brief	Receive and process one DTrack data packet (UDP; ASCII protocol)
+ * 	\brief	Convert standard body data into legacy format.
  *
- *	@return	successful?
+ *	@param[in]	dtbt	standard body data (DTrackSDK)
+ *	@param[out]	dtbt2	standard body data (legacy format)
  */
-bool DTrack2::receive()
+static void convert_body(const DTrack_Body_Type_d *dtbt, dtrack2_body_type *dtbt2)
 {
-	if (!sdk->isLocalDataPortValid())
-		return false;
-	if (!sdk->receive())
-		return false;
-	// copy body data
-	act_num_body = sdk->getNumBody();
-	act_body.resize(act_num_body);
-	for (int i = 0; i < act_num_body; i++)
-	{
-		const DTrack_Body_Type_d *dtbt = sdk->getBody(i);
-		dtrack2_body_type *dtbt2 = &act_body.at(i);
-		dtbt2->id = dtbt->id;
-		dtbt2->quality = (float)dtbt->quality;
-		for (int j = 0; j < 3; j++)
-			dtbt2->loc[j] = (float)dtbt->loc[j];
-		for (int j = 0; j < 9; j++)
-			dtbt2->rot[j] = (float)dtbt->rot[j];
-	}
-	// copy flystick data
-	act_num_flystick = sdk->getNumFlyStick();
-	act_flystick.resize(act_num_flystick);
-	for (int i = 0; i < act_num_flystick; i++)
-	{
-		const DTrack_FlyStick_Type_d *dtfst = sdk->getFlyStick(i);
-		dtrack2_flystick_type *dtfst2 = &act_flystick.at(i);
-		dtfst2->id = dtfst->id;
-		dtfst2->quality = (float)dtfst->quality;
-		dtfst2->num_button = dtfst->num_button;
-		for (int j = 0; j < DTRACK2_FLYSTICK_MAX_BUTTON; j++)
-			dtfst2->button[j] = dtfst->button[j];
-		dtfst2->num_joystick = dtfst->num_joystick;
-		for (int j = 0; j < DTRACK2_FLYSTICK_MAX_JOYSTICK; j++)
-			dtfst2->joystick[j] = (float)dtfst->joystick[j];
-		for (int j = 0; j < 3; j++)
-			dtfst2->loc[j] = (float)dtfst->loc[j];
-		for (int j = 0; j < 9; j++)
-			dtfst2->rot[j] = (float)dtfst->rot[j];
-	}
-	// copy measurement tool data
-	act_num_meatool = sdk->getNumMeaTool();
-	act_meatool.resize(act_num_meatool);
-	for (int i = 0; i < act_num_meatool; i++)
-	{
-		const DTrack_MeaTool_Type_d *dtmtt = sdk->getMeaTool(i);
-		dtrack2_meatool_type *dtmtt2 = &act_meatool.at(i);
-		dtmtt2->id = dtmtt->id;
-		dtmtt2->quality = (float)dtmtt->quality;
-		dtmtt2->num_button = dtmtt->num_button;
-		for (int j = 0; j < DTRACK2_MEATOOL_MAX_BUTTON; j++)
-			dtmtt2->button[j] = dtmtt->button[j];
-		for (int j = 0; j < 3; j++)
-			dtmtt2->loc[j] = (float)dtmtt->loc[j];
-		for (int j = 0; j < 9; j++)
-			dtmtt2->rot[j] = (float)dtmtt->rot[j];
-	}
-	// copy hand data
-	act_num_hand = sdk->getNumHand();
-	act_hand.resize(act_num_hand);
-	for (int i = 0; i < act_num_hand; i++)
+	dtbt2->id = dtbt->id;
+	dtbt2->quality = (float)dtbt->quality;
+	for (int j = 0; j < 3; j++)
+		dtbt2->loc[j] = (float)dtbt->loc[j];
+	for (int j = 0; j < 9; j++)
+		dtbt2->rot[j] = (float)dtbt->rot[j];
+}
+
+
+/**
+ * 	\brief	Convert Flystick data into legacy format.
+ *
+ *	@param[in]	dtfst	Flystick data (DTrackSDK)
+ *	@param[out]	dtfst2	Flystick data (legacy format)
+ */
+static void convert_flystick(const DTrack_FlyStick_Type_d *dtfst, dtrack2_flystick_type *dtfst2)
+{
+	dtfst2->id = dtfst->id;
+	dtfst2->quality = (float)dtfst->quality;
+	dtfst2->num_button = dtfst->num_button;
+	for (int j = 0; j < DTRACK2_FLYSTICK_MAX_BUTTON; j++)
+		dtfst2->button[j] = dtfst->button[j];
+	dtfst2->num_joystick = dtfst->num_joystick;
+	for (int j = 0; j < DTRACK2_FLYSTICK_MAX_JOYSTICK; j++)
+		dtfst2->joystick[j] = (float)dtfst->joystick[j];
+	for (int j = 0; j < 3; j++)
+		dtfst2->loc[j] = (float)dtfst->loc[j];
+	for (int j = 0; j < 9; j++)
+		dtfst2->rot[j] = (float)dtfst->rot[j];
+}
+
+
+/**
+ * 	\brief	Convert Measurement Tool data into legacy format.
+ *
+ *	@param[in]	dtmtt	Measurement Tool data (DTrackSDK)
+ *	@param[out]	dtmtt2	Measurement Tool data (legacy format)
+ */
+static void convert_meatool(const DTrack_MeaTool_Type_d *dtmtt, dtrack2_meatool_type *dtmtt2)
+{
+	dtmtt2->id = dtmtt->id;
+	dtmtt2->quality = (float)dtmtt->quality;
+	dtmtt2->num_button = dtmtt->num_button;
+	for (int j = 0; j < DTRACK2_MEATOOL_MAX_BUTTON; j++)
+		dtmtt2->button[j] = dtmtt->button[j];
+	for (int j = 0; j < 3; j++)
+		dtmtt2->loc[j] = (float)dtmtt->loc[j];
+	for (int j = 0; j < 9; j++)
+		dtmtt2->rot[j] = (float)dtmtt->rot[j];
+}
+
+
+/**
+ * 	\brief	Convert Fingertracking hand data into legacy format.
+ *
+ *	@param[in]	dtht	Fingertracking hand data (DTrackSDK)
+ *	@param[out]	dtht2	Fingertracking hand data (legacy format)
+ */
+static void convert_hand(const DTrack_Hand_Type_d *dtht, dtrack2_hand_type *dtht2)
+{
+	dtht2->id = dtht->id;
+	dtht2->quality = (float)dtht->quality;
+	dtht2->lr = dtht->lr;
+	dtht2->nfinger = dtht->nfinger;
+	for (int j = 0; j < 3; j++)
+		dtht2->loc[j] = (float)dtht->loc[j];
+	for (int j = 0; j < 9; j++)
+		dtht2->rot[j] = (float)dtht->rot[j];
+	for (int k = 0; k < DTRACK2_HAND_MAX_FINGER; k++)
 	{
-		const DTrack_Hand_Type_d *dtht = sdk->getHand(i);
-		dtrack2_hand_type *dtht2 = &act_hand.at(i);
-		dtht2->id = dtht->id;
-		dtht2->quality = (float)dtht->quality;
-		dtht2->lr = dtht->lr;
-		dtht2->nfinger = dtht->nfinger;
 		for (int j = 0; j < 3; j++)
-			dtht2->loc[j] = (float)dtht->loc[j];
+			dtht2->finger[k].loc[j] = (float)dtht->finger[k].loc[j];
 		for (int j = 0; j < 9; j++)
-			dtht2->rot[j] = (float)dtht->rot[j];
-		for (int k = 0; k < DTRACK2_HAND_MAX_FINGER; k++)
-		{
-			for (int j = 0; j < 3; j++)
-				dtht2->finger[k].loc[j] = (float)dtht->finger[k].loc[j];
-			for (int j = 0; j < 9; j++)
-				dtht2->finger[k].rot[j] = (float)dtht->finger[k].rot[j];
-			dtht2->finger[k].radiustip = (float)dtht->finger[k].radiustip;
-			for (int j = 0; j < 3; j++)
-				dtht2->finger[k].lengthphalanx[j] = (float)dtht->finger[k].lengthphalanx[j];
-			for (int j = 0; j < 2; j++)
-				dtht2->finger[k].anglephalanx[j] = (float)dtht->finger[k].anglephalanx[j];
-		}
-	}
-	// copy marker data
-	act_num_marker = sdk->getNumMarker();
-	act_marker.resize(act_num_marker);
-	for (int i = 0; i < act_num_marker; i++)
-	{
-		const DTrack_Marker_Type_d *dtmt = sdk->getMarker(i);
-		dtrack2_marker_type *dtmt2 = &act_marker.at(i);
-		dtmt2->id = dtmt->id;
-		dtmt2->quality = (float)dtmt->quality;
+			dtht2->finger[k].rot[j] = (float)dtht->finger[k].rot[j];
+		dtht2->finger[k].radiustip = (float)dtht->finger[k].radiustip;
 		for (int j = 0; j < 3; j++)
-			dtmt2->loc[j] = (float)dtmt->loc[j];
+			dtht2->finger[k].lengthphalanx[j] = (float)dtht->finger[k].lengthphalanx[j];
+		for (int j = 0; j < 2; j++)
+			dtht2->finger[k].anglephalanx[j] = (float)dtht->finger[k].anglephalanx[j];
 	}
-	return true;
+}
+
+
+/**
+ * 	\brief	Convert single marker data into legacy format.
+ *
+ *	@param[in]	dtmt	single marker data (DTrackSDK)
+ *	@param[out]	dtmt2	single marker data (legacy format)
+ */
+static void convert_marker(const DTrack_Marker_Type_d *dtmt, dtrack2_marker_type *dtmt2)
+{
+	dtmt2->id = dtmt->id;
+	dtmt2->quality = (float)dtmt->quality;
+	for (int j = 0; j < 3; j++)
+		dtmt2->loc[j] = (float)dtmt->loc[j];
+}
+
+
+/**
+ *	\brief	Receive and process one DTrack data packet (UDP; ASCII protocol)
+ *
+ *	@return	successful?
+ */
+bool DTrack2::receive()
+{
+	if (!sdk->isLocalDataPortValid())
+		return false;
+	return sdk->receive();
 }
 
 
@@ -318,7 +331,7 @@ double DTrack2::get_timestamp()
  */
 int DTrack2::get_num_body()
 {
-	return act_num_body;
+	return sdk->getNumBody();
 }
 
 
@@ -331,8 +344,11 @@ int DTrack2::get_num_body()
  */
 dtrack2_body_type DTrack2::get_body(int id)
 {
-	if (id < act_num_body) {
-		return act_body[id];
+	const DTrack_Body_Type_d *dtbt = sdk->getBody(id);
+	if (dtbt != NULL) {
+		dtrack2_body_type dtbt2;
+		convert_body(dtbt, &dtbt2);
+		return dtbt2;
 	}
 	dtrack2_body_type dummy;
 	memset(&dummy, 0, sizeof(dtrack2_body_type));
@@ -350,7 +366,7 @@ dtrack2_body_type DTrack2::get_body(int id)
  */
 int DTrack2::get_num_flystick()
 {
-	return act_num_flystick;
+	return sdk->getNumFlyStick();
 }
 
 
@@ -363,8 +379,11 @@ int DTrack2::get_num_flystick()
  */
 dtrack2_flystick_type DTrack2::get_flystick(int id)
 {
-	if (id < act_num_flystick) {
-		return act_flystick[id];
+	const DTrack_FlyStick_Type_d *dtfst = sdk->getFlyStick(id);
+	if (dtfst != NULL) {
+		dtrack2_flystick_type dtfst2;
+		convert_flystick(dtfst, &dtfst2);
+		return dtfst2;
 	}
 	dtrack2_flystick_type dummy;
 	memset(&dummy, 0, sizeof(dtrack2_flystick_type));
@@ -382,7 +401,7 @@ dtrack2_flystick_type DTrack2::get_flystick(int id)
  */
 int DTrack2::get_num_meatool(void)
 {
-	return act_num_meatool;
+	return sdk->getNumMeaTool();
 }
 
 
@@ -395,8 +414,11 @@ int DTrack2::get_num_meatool(void)
  */
 dtrack2_meatool_type DTrack2::get_meatool(int id)
 {
-	if (id < act_num_meatool) {
-		return act_meatool[id];
+	const DTrack_MeaTool_Type_d *dtmtt = sdk->getMeaTool(id);
+	if (dtmtt != NULL) {
+		dtrack2_meatool_type dtmtt2;
+		convert_meatool(dtmtt, &dtmtt2);
+		return dtmtt2;
 	}
 	dtrack2_meatool_type dummy;
 	memset(&dummy, 0, sizeof(dtrack2_meatool_type));
@@ -414,7 +436,7 @@ dtrack2_meatool_type DTrack2::get_meatool(int id)
  */
 int DTrack2::get_num_hand()
 {
-	return act_num_hand;
+	return sdk->getNumHand();
 }
 
 
@@ -427,8 +449,11 @@ int DTrack2::get_num_hand()
  */
 dtrack2_hand_type DTrack2::get_hand(int id)
 {
-	if (id < act_num_hand) {
-		return act_hand[id];
+	const DTrack_Hand_Type_d *dtht = sdk->getHand(id);
+	if (dtht != NULL) {
+		dtrack2_hand_type dtht2;
+		convert_hand(dtht, &dtht2);
+		return dtht2;
 	}
 	dtrack2_hand_type dummy;
 	memset(&dummy, 0, sizeof(dtrack2_hand_type));
@@ -446,7 +471,7 @@ dtrack2_hand_type DTrack2::get_hand(int id)
  */
 int DTrack2::get_num_marker()
 {
-	return act_num_marker;
+	return sdk->getNumMarker();
 }
 
 
@@ -459,8 +484,11 @@ int DTrack2::get_num_marker()
  */
 dtrack2_marker_type DTrack2::get_marker(int index)
 {
-	if (index >= 0 && index < act_num_marker) {
-		return act_marker[index];
+	const DTrack_Marker_Type_d *dtmt = sdk->getMarker(index);
+	if (dtmt != NULL) {
+		dtrack2_marker_type dtmt2;
+		convert_marker(dtmt, &dtmt2);
+		return dtmt2;
 	}
 	dtrack2_marker_type dummy;
 	memset(&dummy, 0, sizeof(dtrack2_marker_type));
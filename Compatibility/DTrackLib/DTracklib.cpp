@@ -66,7 +66,6 @@ DTracklib::DTracklib(
 
 	sdk = new DTrackSDK( s, remote_port, udpport, DTrackSDK::SYS_DTRACK, udpbufsize, ( int )udptimeout_us, ( int )udptimeout_us );
 	act_nbodycal = -1;
-	act_nbody = act_nflystick = act_nmeatool = act_nmarker = act_nglove = 0;
 }
 
 
@@ -124,113 +123,126 @@ bool DTracklib::parseerror()
 
 
 /**
- *	\brief	Receive and process one DTrack data packet (UDP; ASCII protocol)
+ * 	\brief	Convert standard body data into legacy format.
  *
- *	@return	successful?
+ *	@param[in]	dtbt	standard body data (DTrackSDK)
+ *	@param[out]	dtbt2	standard body data (legacy format)
  */
-bool DTracklib::receive()
+static void convert_body(const DTrack_Body_Type_d *dtbt, dtracklib_body_type *dtbt2)
 {
-	if (!sdk->receive())
-		return false;
-	// copy body data
-	act_nbody = sdk->getNumBody();
-	act_body.resize(act_nbody);
-	for (int i = 0; i < act_nbody; i++)
-	{
-		const DTrack_Body_Type_d *dtbt = sdk->getBody(i);
-		dtracklib_body_type *dtbt2 = &act_body.at(i);
-		dtbt2->id = dtbt->id;
-		dtbt2->quality = (float)dtbt->quality;
-		for (int j = 0; j < 3; j++)
-			dtbt2->loc[j] = (float)dtbt->loc[j];
-		for (int j = 0; j < 3; j++)
-			dtbt2->ang[j] = 0;
-		for (int j = 0; j < 9; j++)
-			dtbt2->rot[j] = (float)dtbt->rot[j];
-	}
-	// copy flystick data
-	act_nflystick = sdk->getNumFlyStick();
-	act_flystick.resize(act_nflystick);
-	for (int i = 0; i < act_nflystick; i++)
+	dtbt2->id = dtbt->id;
+	dtbt2->quality = (float)dtbt->quality;
+	for (int j = 0; j < 3; j++)
+		dtbt2->loc[j] = (float)dtbt->loc[j];
+	for (int j = 0; j < 3; j++)
+		dtbt2->ang[j] = 0;
+	for (int j = 0; j < 9; j++)
+		dtbt2->rot[j] = (float)dtbt->rot[j];
+}
+
+
+/**
+ * 	\brief	Convert Flystick data into legacy format.
+ *
+ *	@param[in]	dtfst	Flystick data (DTrackSDK)
+ *	@param[out]	dtfst2	Flystick data (legacy format)
+ */
+static void convert_flystick(const DTrack_FlyStick_Type_d *dtfst, dtracklib_flystick_type *dtfst2)
+{
+	dtfst2->id = dtfst->id;
+	dtfst2->quality = (float)dtfst->quality;
+	dtfst2->bt = 0;
+	for (int j = 0; j < min(dtfst->num_button, DTRACKLIB_FLYSTICK_MAX_BUTTON); j++)
 	{
-		const DTrack_FlyStick_Type_d *dtfst = sdk->getFlyStick(i);
-		dtracklib_flystick_type *dtfst2 = &act_flystick.at(i);
-		dtfst2->id = dtfst->id;
-		dtfst2->quality = (float)dtfst->quality;
-		dtfst2->bt = 0;
-		for (int j = 0; j < min(dtfst->num_button, DTRACKLIB_FLYSTICK_MAX_BUTTON); j++)
-		{
-			if (dtfst->button[j] == 1)
-				dtfst2->bt |= (dtfst->button[j] << j);
-		}
-		for (int j = 0; j < 3; j++)
-			dtfst2->loc[j] = (float)dtfst->loc[j];
-		for (int j = 0; j < 3; j++)
-			dtfst2->ang[j] = 0;
-		for (int j = 0; j < 9; j++)
-			dtfst2->rot[j] = (float)dtfst->rot[j];
+		if (dtfst->button[j] == 1)
+			dtfst2->bt |= (dtfst->button[j] << j);
 	}
-	// copy measurement tool data
-	act_nmeatool = sdk->getNumMeaTool();
-	act_meatool.resize(act_nmeatool);
-	for (int i = 0; i < act_nmeatool; i++)
+	for (int j = 0; j < 3; j++)
+		dtfst2->loc[j] = (float)dtfst->loc[j];
+	for (int j = 0; j < 3; j++)
+		dtfst2->ang[j] = 0;
+	for (int j = 0; j < 9; j++)
+		dtfst2->rot[j] = (float)dtfst->rot[j];
+}
+
+
+/**
+ * 	\brief	Convert Measurement Tool data into legacy format.
+ *
+ *	@param[in]	dtmtt	Measurement Tool data (DTrackSDK)
+ *	@param[out]	dtmtt2	Measurement Tool data (legacy format)
+ */
+static void convert_meatool(const DTrack_MeaTool_Type_d *dtmtt, dtracklib_meatool_type *dtmtt2)
+{
+	dtmtt2->id = dtmtt->id;
+	dtmtt2->quality = (float)dtmtt->quality;
+	dtmtt2->bt = 0;
+	for (int j = 0; j < min(dtmtt->num_button, DTRACKLIB_FLYSTICK_MAX_BUTTON); j++)
 	{
-		const DTrack_MeaTool_Type_d *dtmtt = sdk->getMeaTool(i);
-		dtracklib_meatool_type *dtmtt2 = &act_meatool.at(i);
-		dtmtt2->id = dtmtt->id;
-		dtmtt2->quality = (float)dtmtt->quality;
-		dtmtt2->bt = 0;
-		for (int j = 0; j < min(dtmtt->num_button, DTRACKLIB_FLYSTICK_MAX_BUTTON); j++)
-		{
-			if (dtmtt->button[j] == 1)
-				dtmtt2->bt |= (dtmtt->button[j] << j);
-		}
-		for (int j = 0; j < 3; j++)
-			dtmtt2->loc[j] = (float)dtmtt->loc[j];
-		for (int j = 0; j < 9; j++)
-			dtmtt2->rot[j] = (float)dtmtt->rot[j];
+		if (dtmtt->button[j] == 1)
+			dtmtt2->bt |= (dtmtt->button[j] << j);
 	}
-	// copy hand data
-	act_nglove = sdk->getNumHand();
-	act_glove.resize(act_nglove);
-	for (int i = 0; i < act_nglove; i++)
+	for (int j = 0; j < 3; j++)
+		dtmtt2->loc[j] = (float)dtmtt->loc[j];
+	for (int j = 0; j < 9; j++)
+		dtmtt2->rot[j] = (float)dtmtt->rot[j];
+}
+
+
+/**
+ * 	\brief	Convert Fingertracking hand data into legacy format.
+ *
+ *	@param[in]	dtht	Fingertracking hand data (DTrackSDK)
+ *	@param[out]	dtht2	Fingertracking hand data (legacy format)
+ */
+static void convert_hand(const DTrack_Hand_Type_d *dtht, dtracklib_glove_type *dtht2)
+{
+	dtht2->id = dtht->id;
+	dtht2->quality = (float)dtht->quality;
+	dtht2->lr = dtht->lr;
+	dtht2->nfinger = dtht->nfinger;
+	for (int j = 0; j < 3; j++)
+		dtht2->loc[j] = (float)dtht->loc[j];
+	for (int j = 0; j < 9; j++)
+		dtht2->rot[j] = (float)dtht->rot[j];
+	for (int k = 0; k < DTRACKLIB_HAND_MAX_FINGER; k++)
 	{
-		const DTrack_Hand_Type_d *dtht = sdk->getHand(i);
-		dtracklib_glove_type *dtht2 = &act_glove.at(i);
-		dtht2->id = dtht->id;
-		dtht2->quality = (float)dtht->quality;
-		dtht2->lr = dtht->lr;
-		dtht2->nfinger = dtht->nfinger;
 		for (int j = 0; j < 3; j++)
-			dtht2->loc[j] = (float)dtht->loc[j];
+			dtht2->finger[k].loc[j] = (float)dtht->finger[k].loc[j];
 		for (int j = 0; j < 9; j++)
-			dtht2->rot[j] = (float)dtht->rot[j];
-		for (int k = 0; k < DTRACKLIB_HAND_MAX_FINGER; k++)
-		{
-			for (int j = 0; j < 3; j++)
-				dtht2->finger[k].loc[j] = (float)dtht->finger[k].loc[j];
-			for (int j = 0; j < 9; j++)
-				dtht2->finger[k].rot[j] = (float)dtht->finger[k].rot[j];
-			dtht2->finger[k].radiustip = (float)dtht->finger[k].radiustip;
-			for (int j = 0; j < 3; j++)
-				dtht2->finger[k].lengthphalanx[j] = (float)dtht->finger[k].lengthphalanx[j];
-			for (int j = 0; j < 2; j++)
-				dtht2->finger[k].anglephalanx[j] = (float)dtht->finger[k].anglephalanx[j];
-		}
-	}
-	// copy marker data
-	act_nmarker = sdk->getNumMarker();
-	act_marker.resize(act_nmarker);
-	for (int i = 0; i < act_nmarker; i++)
-	{
-		const DTrack_Marker_Type_d *dtmt = sdk->getMarker(i);
-		dtracklib_marker_type *dtmt2 = &act_marker.at(i);
-		dtmt2->id = dtmt->id;
-		dtmt2->quality = (float)dtmt->quality;
+			dtht2->finger[k].rot[j] = (float)dtht->finger[k].rot[j];
+		dtht2->finger[k].radiustip = (float)dtht->finger[k].radiustip;
 		for (int j = 0; j < 3; j++)
-			dtmt2->loc[j] = (float)dtmt->loc[j];
+			dtht2->finger[k].lengthphalanx[j] = (float)dtht->finger[k].lengthphalanx[j];
+		for (int j = 0; j < 2; j++)
+			dtht2->finger[k].anglephalanx[j] = (float)dtht->finger[k].anglephalanx[j];
 	}
-	return true;
+}
+
+
+/**
+ * 	\brief	Convert single marker data into legacy format.
+ *
+ *	@param[in]	dtmt	single marker data (DTrackSDK)
+ *	@param[out]	dtmt2	single marker data (legacy format)
+ */
+static void convert_marker(const DTrack_Marker_Type_d *dtmt, dtracklib_marker_type *dtmt2)
+{
+	dtmt2->id = dtmt->id;
+	dtmt2->quality = (float)dtmt->quality;
+	for (int j = 0; j < 3; j++)
+		dtmt2->loc[j] = (float)dtmt->loc[j];
+}
+
+
+/**
+ *	\brief	Receive and process one DTrack data packet (UDP; ASCII protocol)
+ *
+ *	@return	successful?
+ */
+bool DTracklib::receive()
+{
+	return sdk->receive();
 }
 
 
@@ -277,7 +289,7 @@ int DTracklib::get_nbodycal()
  */
 int DTracklib::get_nbody()
 {
-	return act_nbody;
+	return sdk->getNumBody();
 }
 
 
@@ -290,13 +302,16 @@ int DTracklib::get_nbody()
  */
 dtracklib_body_type DTracklib::get_body(int id)
 {
-	if ((id < 0)||(id >= act_nbody))
+	const DTrack_Body_Type_d *dtbt = sdk->getBody(id);
+	if (dtbt == NULL)
 	{
 		dtracklib_body_type dummy;
 		memset(&dummy, 0, sizeof(dtracklib_body_type));
 		return dummy;
 	}
-	return act_body[id];
+	dtracklib_body_type dtbt2;
+	convert_body(dtbt, &dtbt2);
+	return dtbt2;
 }
 
 
@@ -308,7 +323,7 @@ dtracklib_body_type DTracklib::get_body(int id)
  */
 int DTracklib::get_nflystick()
 {
-	return act_nflystick;
+	return sdk->getNumFlyStick();
 }
 
 
@@ -321,13 +336,16 @@ int DTracklib::get_nflystick()
  */
 dtracklib_flystick_type DTracklib::get_flystick(int id)
 {
-	if ((id < 0)||(id >= act_nflystick))
+	const DTrack_FlyStick_Type_d *dtfst = sdk->getFlyStick(id);
+	if (dtfst == NULL)
 	{
 		dtracklib_flystick_type dummy;
 		memset(&dummy, 0, sizeof(dtracklib_flystick_type));
 		return dummy;
 	}
-	return act_flystick[id];
+	dtracklib_flystick_type dtfst2;
+	convert_flystick(dtfst, &dtfst2);
+	return dtfst2;
 }
 
 
@@ -339,7 +357,7 @@ dtracklib_flystick_type DTracklib::get_flystick(int id)
  */
 int DTracklib::get_nmeatool()
 {
-	return act_nmeatool;
+	return sdk->getNumMeaTool();
 }
 
 
@@ -352,13 +370,16 @@ int DTracklib::get_nmeatool()
  */
 dtracklib_meatool_type DTracklib::get_meatool(int id)
 {
-	if(id < 0 || id >= act_nmeatool){
+	const DTrack_MeaTool_Type_d *dtmtt = sdk->getMeaTool(id);
+	if (dtmtt == NULL)
+	{
 		dtracklib_meatool_type dummy;
 		memset(&dummy, 0, sizeof(dtracklib_meatool_type));
 		return dummy;
 	}
-	
-	return act_meatool[id];
+	dtracklib_meatool_type dtmtt2;
+	convert_meatool(dtmtt, &dtmtt2);
+	return dtmtt2;
 }
 
 
@@ -370,7 +391,7 @@ dtracklib_meatool_type DTracklib::get_meatool(int id)
  */
 int DTracklib::get_nglove()
 {
-	return act_nglove;
+	return sdk->getNumHand();
 }
 
 
@@ -383,13 +404,16 @@ int DTracklib::get_nglove()
  */
 dtracklib_glove_type DTracklib::get_glove(int id)
 {
-	if(id < 0 || id >= act_nglove){
+	const DTrack_Hand_Type_d *dtht = sdk->getHand(id);
+	if (dtht == NULL)
+	{
 		dtracklib_glove_type dummy;
 		memset(&dummy, 0, sizeof(dtracklib_glove_type));
 		return dummy;
 	}
-	
-	return act_glove[id];
+	dtracklib_glove_type dtht2;
+	convert_hand(dtht, &dtht2);
+	return dtht2;
 }
 
 
@@ -401,7 +425,7 @@ dtracklib_glove_type DTracklib::get_glove(int id)
  */
 int DTracklib::get_nmarker()
 {
-	return act_nmarker;
+	return sdk->getNumMarker();
 }
 
 
@@ -414,12 +438,16 @@ int DTracklib::get_nmarker()
  */
 dtracklib_marker_type DTracklib::get_marker(int index)
 {
-	if(index < 0 || index >= act_nmarker){
+	const DTrack_Marker_Type_d *dtmt = sdk->getMarker(index);
+	if (dtmt == NULL)
+	{
 		dtracklib_marker_type dummy;
 		memset(&dummy, 0, sizeof(dtracklib_marker_type));
 		return dummy;
 	}
-	return act_marker[index];
+	dtracklib_marker_type dtmt2;
+	convert_marker(dtmt, &dtmt2);
+	return dtmt2;
 }
 
 
@@ -37,6 +37,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 // global DTrackSDK
 static DTrackSDK* dt = NULL;
@@ -60,15 +61,24 @@ enum ERRORS {
  */
 static void dtrack2_get_and_print_all_event_messages()
 {
-	while ( dt->getMessage() )
+	const int maxCount = 100;
+	std::vector< DTrackMessage > messages;
+	int num;
+	do
 	{
-		std::cerr << dt->getMessageOrigin()
-			      << " " << dt->getMessageStatus()
-			      << " " << dt->getMessageFrameNr()
-			      << " 0x" << std::hex << dt->getMessageErrorId() << std::dec
-			      << " " << dt->getMessageMsg() 
-			      << std::endl;
+		num = dt->getMessages( messages, maxCount );
+
+		for ( int i = 0; i < num; i++ )
+		{
+			std::cerr << messages[ i ].origin
+				      << " " << messages[ i ].status
+				      << " " << messages[ i ].frameNr
+				      << " 0x" << std::hex << messages[ i ].errorId << std::dec
+				      << " " << messages[ i ].msg
+				      << std::endl;
+		}
 	}
+	while ( num == maxCount );
 }
 
 
@@ -0,0 +1,623 @@
+/* DTrackSDK in C++: example_benchmark.cpp
+ *
+ * C++ program measuring the performance of DTrackSDK parser and network functions.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Purpose:
+ *  - generates synthetic tracking data packets with a seeded generator, i.e. reproducible
+ *  - measures parse time per frame and per line (DTrackSDK::processPacket())
+ *  - measures latency and throughput of UDP data via loopback interface
+ *  - prints results as CSV ('benchmark,metric,value,unit'), to be compared between versions
+ *  - requires no DTrack system; for DTrackSDK v2.10.0 (or newer)
+ */
+
+#include "DTrackSDK.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// types of lines to be generated:
+static const char* s_type_names[] = { "6d", "6dcov", "6df2", "6dmt2", "gl", "6dj", "6di", "3d", "st" };
+enum { TYPE_6D, TYPE_6DCOV, TYPE_6DF2, TYPE_6DMT2, TYPE_GL, TYPE_6DJ, TYPE_6DI, TYPE_3D, TYPE_ST, NUM_TYPES };
+
+// settings:
+static unsigned int s_seed = 1;
+static int s_count[ NUM_TYPES ] = { 8, 0, 1, 0, 2, 1, 0, 20, 0 };  // entries per line type
+static int s_num_frames = 100000;   // number of frames to be parsed per benchmark
+static int s_num_packets = 256;     // number of different packets
+static int s_num_udp = 10000;       // number of UDP packets, 0 to skip network benchmarks
+static int s_human_joints = 20;     // number of joints per ART-Human model
+static int s_hand_fingers = 5;      // number of fingers per Fingertracking hand
+
+// prototypes
+static bool parse_args( int argc, char** argv );
+static void generate_packets( std::vector< std::string >& packets, const int* count, unsigned int seed );
+static void bench_parse( const char* name, const int* count );
+static void bench_udp_latency( const std::string& packet );
+static void bench_udp_throughput( const std::string& packet );
+static void print_result( const char* benchmark, const char* metric, double value, const char* unit );
+
+
+/**
+ * \brief Main.
+ */
+int main( int argc, char** argv )
+{
+	if ( ! parse_args( argc, argv ) )
+	{
+		std::cout << "Usage: example_benchmark [--seed <n>] [--frames <n>] [--udp <n>] [--<type> <n> ...]" << std::endl;
+		std::cout << "  <type>: number of entries per line type, one of:";
+		for ( int i = 0; i < NUM_TYPES; i++ )
+			std::cout << " " << s_type_names[ i ];
+		std::cout << std::endl;
+		std::cout << "  --udp 0 skips network benchmarks" << std::endl;
+		return -1;
+	}
+
+	std::cout << "benchmark,metric,value,unit" << std::endl;
+
+	// parsing all line types together:
+	bench_parse( "parse", s_count );
+
+	// parsing single line types:
+	int none[ NUM_TYPES ] = { 0 };
+	bench_parse( "parse_fr", none );
+
+	for ( int i = 0; i < NUM_TYPES; i++ )
+	{
+		if ( s_count[ i ] <= 0 )
+			continue;
+
+		int single[ NUM_TYPES ] = { 0 };
+		single[ i ] = s_count[ i ];
+		if ( i == TYPE_6DCOV )
+			single[ TYPE_6D ] = s_count[ i ];  // covariance needs standard bodies
+
+		std::string name = std::string( "parse_" ) + s_type_names[ i ];
+		bench_parse( name.c_str(), single );
+	}
+
+	// network:
+	if ( s_num_udp > 0 )
+	{
+		std::vector< std::string > packets;
+		generate_packets( packets, s_count, s_seed );
+
+		bench_udp_latency( packets[ 0 ] );
+		bench_udp_throughput( packets[ 0 ] );
+	}
+
+	return 0;
+}
+
+
+/**
+ * \brief Parse command line arguments.
+ *
+ * @return Arguments valid?
+ */
+static bool parse_args( int argc, char** argv )
+{
+	for ( int i = 1; i < argc; i++ )
+	{
+		std::string arg = argv[ i ];
+		if ( ( arg.length() < 3 ) || ( arg.compare( 0, 2, "--" ) != 0 ) || ( i + 1 >= argc ) )
+			return false;
+
+		std::istringstream valuestream( argv[ ++i ] );
+		int value;
+		valuestream >> value;
+		if ( valuestream.fail() || ( value < 0 ) )
+			return false;
+
+		std::string name = arg.substr( 2 );
+		if ( name == "seed" )
+		{
+			s_seed = static_cast< unsigned int >( value );
+		}
+		else if ( name == "frames" )
+		{
+			s_num_frames = std::max( value, 1 );
+		}
+		else if ( name == "udp" )
+		{
+			s_num_udp = value;
+		}
+		else
+		{
+			int type = 0;
+			while ( ( type < NUM_TYPES ) && ( name != s_type_names[ type ] ) )
+				type++;
+
+			if ( type >= NUM_TYPES )
+				return false;
+
+			s_count[ type ] = value;
+		}
+	}
+	return true;
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Generator of tracking data packets:
+// ---------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Seeded pseudo random generator (xorshift), independent of the C library.
+ */
+class Random
+{
+public:
+
+	explicit Random( unsigned int seed ) : d_state( seed * 2654435761u + 1 ) {}
+
+	unsigned int next()
+	{
+		d_state ^= d_state << 13;
+		d_state ^= d_state >> 17;
+		d_state ^= d_state << 5;
+		return d_state;
+	}
+
+	int range( int lo, int hi )  // lo .. hi
+	{
+		return lo + static_cast< int >( next() % static_cast< unsigned int >( hi - lo + 1 ) );
+	}
+
+	double uniform( double lo, double hi )
+	{
+		return lo + ( hi - lo ) * ( next() / 4294967296.0 );
+	}
+
+private:
+
+	unsigned int d_state;
+};
+
+
+/**
+ * \brief Append formatted text to a string.
+ */
+static void append( std::string& s, const char* format, double value )
+{
+	char buf[ 64 ];  // enough for all generated values
+	sprintf( buf, format, value );
+	s += buf;
+}
+
+static void append_i( std::string& s, const char* format, int value )
+{
+	char buf[ 64 ];  // enough for all generated values
+	sprintf( buf, format, value );
+	s += buf;
+}
+
+/**
+ * \brief Append position (3 values) and rotation matrix (9 values) in brackets.
+ */
+static void append_locrot( std::string& s, Random& rnd )
+{
+	append( s, "[%.3f", rnd.uniform( -3000.0, 3000.0 ) );
+	append( s, " %.3f", rnd.uniform( -3000.0, 3000.0 ) );
+	append( s, " %.3f]", rnd.uniform( -3000.0, 3000.0 ) );
+
+	s += "[";
+	for ( int i = 0; i < 9; i++ )
+		append( s, ( i == 0 ) ? "%.6f" : " %.6f", rnd.uniform( -1.0, 1.0 ) );
+	s += "]";
+}
+
+/**
+ * \brief Append some values in brackets.
+ */
+static void append_values( std::string& s, Random& rnd, int num, const char* format, double lo, double hi )
+{
+	s += "[";
+	for ( int i = 0; i < num; i++ )
+	{
+		if ( i > 0 )  s += " ";
+		append( s, format, rnd.uniform( lo, hi ) );
+	}
+	s += "]";
+}
+
+
+/**
+ * \brief Generate tracking data packets, similar to the output of a DTrack system.
+ *
+ * @param[out] packets Generated packets
+ * @param[in]  count   Number of entries per line type
+ * @param[in]  seed    Seed of generator
+ */
+static void generate_packets( std::vector< std::string >& packets, const int* count, unsigned int seed )
+{
+	Random rnd( seed );
+
+	packets.resize( s_num_packets );
+	for ( int k = 0; k < s_num_packets; k++ )
+	{
+		std::string& s = packets[ k ];
+		s.clear();
+
+		append_i( s, "fr %d\r\n", 1000 + k );
+		append_i( s, "ts2 %d", 1700000000 + k );
+		append_i( s, " %d", rnd.range( 0, 999999 ) );
+		append_i( s, " %d\r\n", rnd.range( 0, 20000 ) );
+
+		if ( count[ TYPE_6D ] > 0 )
+		{
+			append_i( s, "6dcal %d\r\n", count[ TYPE_6D ] );
+			append_i( s, "6d %d ", count[ TYPE_6D ] );
+			for ( int i = 0; i < count[ TYPE_6D ]; i++ )
+			{
+				append_i( s, "[%d 1.000]", i );
+				append_locrot( s, rnd );
+			}
+			s += "\r\n";
+		}
+
+		if ( count[ TYPE_6DCOV ] > 0 )
+		{
+			int n = std::min( count[ TYPE_6DCOV ], count[ TYPE_6D ] );
+			append_i( s, "6dcov %d ", n );
+			for ( int i = 0; i < n; i++ )
+			{
+				append_i( s, "[%d", i );
+				append( s, " %.3f", rnd.uniform( -10.0, 10.0 ) );
+				append( s, " %.3f", rnd.uniform( -10.0, 10.0 ) );
+				append( s, " %.3f]", rnd.uniform( -10.0, 10.0 ) );
+				append_values( s, rnd, 21, "%.4f", 0.0, 5.0 );
+			}
+			s += "\r\n";
+		}
+
+		if ( count[ TYPE_6DF2 ] > 0 )
+		{
+			append_i( s, "6df2 %d", count[ TYPE_6DF2 ] );
+			append_i( s, " %d ", count[ TYPE_6DF2 ] );
+			for ( int i = 0; i < count[ TYPE_6DF2 ]; i++ )
+			{
+				append_i( s, "[%d 1.000 8 2]", i );
+				append_locrot( s, rnd );
+				append_i( s, "[%d", rnd.range( 0, 255 ) );
+				append( s, " %.2f", rnd.uniform( -1.0, 1.0 ) );
+				append( s, " %.2f]", rnd.uniform( -1.0, 1.0 ) );
+			}
+			s += "\r\n";
+		}
+
+		if ( count[ TYPE_6DMT2 ] > 0 )
+		{
+			append_i( s, "6dmt2 %d", count[ TYPE_6DMT2 ] );
+			append_i( s, " %d ", count[ TYPE_6DMT2 ] );
+			for ( int i = 0; i < count[ TYPE_6DMT2 ]; i++ )
+			{
+				append_i( s, "[%d 1.000 4", i );
+				append( s, " %.1f]", rnd.uniform( 0.0, 5.0 ) );
+				append_locrot( s, rnd );
+				append_i( s, "[%d]", rnd.range( 0, 15 ) );
+				append_values( s, rnd, 6, "%.3f", 0.0, 3.0 );
+			}
+			s += "\r\n";
+		}
+
+		if ( count[ TYPE_GL ] > 0 )
+		{
+			append_i( s, "glcal %d\r\n", count[ TYPE_GL ] );
+			append_i( s, "gl %d ", count[ TYPE_GL ] );
+			for ( int i = 0; i < count[ TYPE_GL ]; i++ )
+			{
+				append_i( s, "[%d 1.000", i );
+				append_i( s, " %d", i % 2 );
+				append_i( s, " %d]", s_hand_fingers );
+				append_locrot( s, rnd );
+				for ( int j = 0; j < s_hand_fingers; j++ )
+				{
+					append_locrot( s, rnd );
+					append_values( s, rnd, 6, "%.2f", 0.0, 90.0 );
+				}
+			}
+			s += "\r\n";
+		}
+
+		if ( count[ TYPE_6DJ ] > 0 )
+		{
+			append_i( s, "6dj %d", count[ TYPE_6DJ ] );
+			append_i( s, " %d ", count[ TYPE_6DJ ] );
+			for ( int i = 0; i < count[ TYPE_6DJ ]; i++ )
+			{
+				append_i( s, "[%d", i );
+				append_i( s, " %d]", s_human_joints );
+				for ( int j = 0; j < s_human_joints; j++ )
+				{
+					append_i( s, "[%d 1.000]", j );
+					append( s, "[%.3f", rnd.uniform( -3000.0, 3000.0 ) );
+					append( s, " %.3f", rnd.uniform( -3000.0, 3000.0 ) );
+					append( s, " %.3f", rnd.uniform( -3000.0, 3000.0 ) );
+					append( s, " %.2f", rnd.uniform( -180.0, 180.0 ) );
+					append( s, " %.2f", rnd.uniform( -180.0, 180.0 ) );
+					append( s, " %.2f]", rnd.uniform( -180.0, 180.0 ) );
+					append_values( s, rnd, 9, "%.6f", -1.0, 1.0 );
+				}
+			}
+			s += "\r\n";
+		}
+
+		if ( count[ TYPE_6DI ] > 0 )
+		{
+			append_i( s, "6di %d ", count[ TYPE_6DI ] );
+			for ( int i = 0; i < count[ TYPE_6DI ]; i++ )
+			{
+				append_i( s, "[%d", i );
+				append_i( s, " %d", rnd.range( 0, 2 ) );
+				append( s, " %.3f]", rnd.uniform( 0.0, 2.0 ) );
+				append_locrot( s, rnd );
+			}
+			s += "\r\n";
+		}
+
+		if ( count[ TYPE_3D ] > 0 )
+		{
+			append_i( s, "3d %d ", count[ TYPE_3D ] );
+			for ( int i = 0; i < count[ TYPE_3D ]; i++ )
+			{
+				append_i( s, "[%d 1.000]", rnd.range( 1, 500 ) );
+				append_values( s, rnd, 3, "%.3f", -3000.0, 3000.0 );
+			}
+			s += "\r\n";
+		}
+
+		if ( count[ TYPE_ST ] > 0 )
+		{
+			int nc = count[ TYPE_ST ];
+			append_i( s, "st 3 [0 3][%d", nc );
+			append_i( s, " %d", rnd.range( 0, 9 ) );
+			append_i( s, " %d][1 5][1 2 3 4 5]", rnd.range( 0, 9 ) );
+			append_i( s, "[2 %d 3]", nc );
+			for ( int c = 0; c < nc; c++ )
+			{
+				append_i( s, "[%d", c );
+				append_i( s, " %d", rnd.range( 0, 50 ) );
+				append_i( s, " %d", rnd.range( 0, 50 ) );
+				append_i( s, " %d]", rnd.range( 0, 10 ) );
+			}
+			s += "\r\n";
+		}
+	}
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Benchmarks:
+// ---------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Measure parse time of generated packets.
+ *
+ * @param[in] name  Name of benchmark
+ * @param[in] count Number of entries per line type
+ */
+static void bench_parse( const char* name, const int* count )
+{
+	std::vector< std::string > packets;
+	generate_packets( packets, count, s_seed );
+
+	long nlines = 0;
+	size_t nbytes = 0;
+	for ( int i = 0; i < s_num_frames; i++ )
+	{
+		const std::string& p = packets[ i % s_num_packets ];
+		nlines += static_cast< long >( std::count( p.begin(), p.end(), '\n' ) );
+		nbytes += p.length();
+	}
+
+	DTrackSDK sdk( ( unsigned short )0 );
+
+	for ( int i = 0; i < s_num_packets; i++ )  // warm up, allocating all memory
+		sdk.processPacket( packets[ i ].c_str(), packets[ i ].length() + 1 );
+
+	int nerr = 0;
+	double t0 = DTrackSys::time_monotonic();
+	for ( int i = 0; i < s_num_frames; i++ )
+	{
+		const std::string& p = packets[ i % s_num_packets ];
+		if ( ! sdk.processPacket( p.c_str(), p.length() + 1 ) )
+			nerr++;
+	}
+	double dt = DTrackSys::time_monotonic() - t0;
+
+	print_result( name, "frames", s_num_frames, "count" );
+	print_result( name, "bytes_per_frame", ( double )nbytes / s_num_frames, "bytes" );
+	print_result( name, "time_per_frame", dt * 1e9 / s_num_frames, "ns" );
+	print_result( name, "time_per_line", dt * 1e9 / nlines, "ns" );
+	print_result( name, "throughput", ( double )nbytes / dt / 1e6, "MB/s" );
+	print_result( name, "errors", nerr, "count" );
+}
+
+
+/**
+ * \brief Sender for UDP throughput benchmark.
+ */
+struct UdpSender
+{
+	const std::string* packet;
+	unsigned short port;
+	int num;
+	int nerr;
+};
+
+static void udp_sender( void* arg )
+{
+	UdpSender* sender = static_cast< UdpSender* >( arg );
+	DTrackNet::UDP udp( 0, 0 );
+
+	for ( int i = 0; i < sender->num; i++ )
+	{
+		if ( udp.send( sender->packet->c_str(), static_cast< int >( sender->packet->length() ),
+		               0x7f000001, sender->port, 1000000 ) != 0 )
+		{
+			sender->nerr++;
+		}
+	}
+}
+
+
+/**
+ * \brief Measure latency of UDP::receive(), sending one packet after the other via loopback interface.
+ *
+ * @param[in] packet Data packet
+ */
+static void bench_udp_latency( const std::string& packet )
+{
+	DTrackNet::UDP receiver( 0, 0 );
+	DTrackNet::UDP sender( 0, 0 );
+	if ( ! receiver.isValid() || ! sender.isValid() )
+	{
+		print_result( "udp_latency", "errors", 1, "count" );
+		return;
+	}
+
+	std::vector< char > buf( packet.length() + 16 );
+	std::vector< double > latency, kernel;
+	latency.reserve( s_num_udp );
+	kernel.reserve( s_num_udp );
+
+	int nerr = 0;
+	for ( int i = 0; i < s_num_udp; i++ )
+	{
+		double arrival;
+		double t0 = DTrackSys::time_monotonic();
+		if ( sender.send( packet.c_str(), static_cast< int >( packet.length() ), 0x7f000001, receiver.getPort(), 1000000 ) != 0 ||
+		     receiver.receive( &buf[ 0 ], static_cast< int >( buf.size() ), 1000000, &arrival ) < 0 )
+		{
+			nerr++;
+			continue;
+		}
+		double t1 = DTrackSys::time_monotonic();
+
+		latency.push_back( t1 - t0 );
+		kernel.push_back( t1 - arrival );
+	}
+
+	if ( latency.empty() )
+	{
+		print_result( "udp_latency", "errors", nerr, "count" );
+		return;
+	}
+
+	std::sort( latency.begin(), latency.end() );
+	std::sort( kernel.begin(), kernel.end() );
+	size_t n = latency.size();
+
+	print_result( "udp_latency", "packets", static_cast< double >( n ), "count" );
+	print_result( "udp_latency", "send_to_receive_p50", latency[ n / 2 ] * 1e6, "us" );
+	print_result( "udp_latency", "send_to_receive_p99", latency[ ( n * 99 ) / 100 ] * 1e6, "us" );
+	print_result( "udp_latency", "send_to_receive_max", latency[ n - 1 ] * 1e6, "us" );
+	print_result( "udp_latency", "arrival_to_receive_p50", kernel[ n / 2 ] * 1e6, "us" );
+	print_result( "udp_latency", "arrival_to_receive_p99", kernel[ ( n * 99 ) / 100 ] * 1e6, "us" );
+	print_result( "udp_latency", "errors", nerr, "count" );
+}
+
+
+/**
+ * \brief Measure throughput of UDP::receiveBatch(), receiving packets sent by another thread.
+ *
+ * @param[in] packet Data packet
+ */
+static void bench_udp_throughput( const std::string& packet )
+{
+	const int batchsize = 32;
+	const int toutUs = 200000;  // end of test, if no more data arrives
+
+	DTrackNet::UDP receiver( 0, 0 );
+	if ( ! receiver.isValid() )
+	{
+		print_result( "udp_throughput", "errors", 1, "count" );
+		return;
+	}
+
+	int slotsize = static_cast< int >( packet.length() ) + 16;
+	std::vector< char > buf( static_cast< size_t >( slotsize ) * batchsize );
+	int len[ batchsize ];
+
+	UdpSender sender;
+	sender.packet = &packet;
+	sender.port = receiver.getPort();
+	sender.num = s_num_udp;
+	sender.nerr = 0;
+
+	DTrackSys::Thread thread;
+	double t0 = DTrackSys::time_monotonic();
+	double t1 = t0;
+	if ( ! thread.start( udp_sender, &sender ) )
+	{
+		print_result( "udp_throughput", "errors", 1, "count" );
+		return;
+	}
+
+	int nrecv = 0;
+	while ( nrecv < s_num_udp )
+	{
+		int n = receiver.receiveBatch( &buf[ 0 ], slotsize, batchsize, len, toutUs );
+		if ( n <= 0 )
+			break;  // timeout, i.e. remaining packets were lost
+
+		nrecv += n;
+		t1 = DTrackSys::time_monotonic();
+	}
+	thread.join();
+
+	double dt = t1 - t0;
+	print_result( "udp_throughput", "packets", nrecv, "count" );
+	print_result( "udp_throughput", "lost", s_num_udp - nrecv - sender.nerr, "count" );
+	print_result( "udp_throughput", "errors", sender.nerr, "count" );
+	if ( dt > 0.0 )
+	{
+		print_result( "udp_throughput", "rate", nrecv / dt, "packets/s" );
+		print_result( "udp_throughput", "throughput", ( double )nrecv * packet.length() / dt / 1e6, "MB/s" );
+	}
+}
+
+
+/**
+ * \brief Print one result as CSV line.
+ */
+static void print_result( const char* benchmark, const char* metric, double value, const char* unit )
+{
+	int precision = ( strcmp( unit, "count" ) == 0 ) ? 0 : 3;
+
+	std::cout << benchmark << "," << metric << "," << std::fixed << std::setprecision( precision ) << value << ","
+	          << unit << std::endl;
+}
+
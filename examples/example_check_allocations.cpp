@@ -0,0 +1,269 @@
+/* DTrackSDK in C++: example_check_allocations.cpp
+ *
+ * C++ program checking that DTrackSDK parses tracking data without memory allocation, if the parser
+ * has a fixed capacity.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Purpose:
+ *  - counts all calls of the global 'operator new', after DTrackParser::enableFixedCapacity()
+ *  - parses frames filling the capacity of bodies (also '6dcov'), single markers, ART-Human joints,
+ *    Flysticks and cameras, with detection of changes enabled
+ *  - parses frames exceeding the capacity, which have to be limited or rejected
+ *  - exit code 0 if no memory was allocated and all checks passed; requires no DTrack system;
+ *    for DTrackSDK v2.10.0 (or newer)
+ */
+
+#include "DTrackSDK.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+// counting of memory allocations:
+static bool s_counting = false;  // count allocations?
+static long s_num_alloc = 0;     // number of counted allocations
+
+static void* count_alloc( size_t size )
+{
+	if ( s_counting )
+		s_num_alloc++;
+
+	return malloc( ( size > 0 ) ? size : 1 );
+}
+
+void* operator new( size_t size )
+{
+	void* p = count_alloc( size );
+	if ( p == NULL )
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void* operator new[]( size_t size )
+{
+	void* p = count_alloc( size );
+	if ( p == NULL )
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void* operator new( size_t size, const std::nothrow_t& ) throw()  { return count_alloc( size ); }
+void* operator new[]( size_t size, const std::nothrow_t& ) throw()  { return count_alloc( size ); }
+void operator delete( void* p ) throw()  { free( p ); }
+void operator delete[]( void* p ) throw()  { free( p ); }
+void operator delete( void* p, const std::nothrow_t& ) throw()  { free( p ); }
+void operator delete[]( void* p, const std::nothrow_t& ) throw()  { free( p ); }
+
+// capacity:
+static const int MAX_BODY = 4;
+static const int MAX_FLYSTICK = 2;
+static const int MAX_HUMAN = 2;
+static const int MAX_JOINT = 10;
+static const int MAX_MARKER = 8;
+static const int MAX_CAMERA = 2;
+
+static int s_num_errors = 0;
+
+// prototypes
+static std::string make_frame( unsigned int fr, int numBodyCal, int numBody, int numMarker, int numJoints0, int numJoints1 );
+static bool parse( DTrackSDK& sdk, const std::string& frame );
+static void expect( bool condition, const char* description );
+
+
+/**
+ * \brief Main.
+ */
+int main( int, char** )
+{
+	DTrackSDK sdk( ( unsigned short )0 );
+	sdk.enableEvents();
+
+	DTrackParser::Capacity capacity;
+	capacity.maxBody = MAX_BODY;
+	capacity.maxFlyStick = MAX_FLYSTICK;
+	capacity.maxHuman = MAX_HUMAN;
+	capacity.maxJoint = MAX_JOINT;
+	capacity.maxMarker = MAX_MARKER;
+	capacity.maxCamera = MAX_CAMERA;
+	expect( sdk.enableFixedCapacity( true, capacity ), "enabling fixed capacity" );
+
+	// frames are generated before counting starts:
+	std::string full = make_frame( 1, MAX_BODY, MAX_BODY, MAX_MARKER, MAX_JOINT / 2, MAX_JOINT / 2 );
+	std::string fewer = make_frame( 2, 2, 1, 3, 1, 0 );
+	std::string tooManyBodyCal = make_frame( 3, MAX_BODY + 6, MAX_BODY, MAX_MARKER, 2, 2 );
+	std::string tooManyBody = make_frame( 4, MAX_BODY + 1, MAX_BODY + 1, MAX_MARKER, 2, 2 );
+	std::string tooManyMarker = make_frame( 5, MAX_BODY, MAX_BODY, MAX_MARKER + 1, 2, 2 );
+	std::string tooManyJoint = make_frame( 6, MAX_BODY, MAX_BODY, MAX_MARKER, MAX_JOINT / 2, MAX_JOINT / 2 + 1 );
+
+	s_counting = true;
+
+	for ( int i = 0; i < 1000; i++ )
+	{
+		expect( parse( sdk, full ), "parsing full frame" );
+		expect( ! sdk.isCapacityExceeded(), "full frame fits into capacity" );
+		expect( sdk.getNumBody() == MAX_BODY && sdk.getNumMarker() == MAX_MARKER, "number of bodies and markers" );
+		expect( sdk.getHuman( 1 ) != NULL && sdk.getHuman( 1 )->num_joints == MAX_JOINT / 2, "number of joints" );
+		expect( sdk.getBody( MAX_BODY - 1 )->covref[ 0 ] == 1.0, "covariance of last body" );
+
+		expect( parse( sdk, fewer ), "parsing frame with fewer data" );
+		expect( ! sdk.isCapacityExceeded(), "frame with fewer data fits into capacity" );
+		expect( sdk.getHuman( 0 )->num_joints == 1 && sdk.getHuman( 1 )->num_joints == 0, "number of joints in frame with fewer data" );
+	}
+
+	// exceeding capacity:
+	expect( parse( sdk, tooManyBodyCal ), "parsing frame with too many calibrated bodies" );
+	expect( sdk.isCapacityExceeded() && sdk.getNumBody() == MAX_BODY, "number of calibrated bodies is limited" );
+
+	expect( ! parse( sdk, tooManyBody ), "frame with too many bodies is rejected" );
+	expect( sdk.isCapacityExceeded(), "too many bodies are reported" );
+
+	expect( ! parse( sdk, tooManyMarker ), "frame with too many markers is rejected" );
+	expect( sdk.isCapacityExceeded() && sdk.getNumMarker() == 0, "too many markers are reported" );
+
+	expect( ! parse( sdk, tooManyJoint ), "frame with too many joints is rejected" );
+	expect( sdk.isCapacityExceeded(), "too many joints are reported" );
+
+	expect( parse( sdk, full ), "parsing full frame after exceeded capacity" );
+	expect( ! sdk.isCapacityExceeded(), "full frame fits into capacity again" );
+
+	s_counting = false;
+
+	std::cout << "allocations after setup: " << s_num_alloc << std::endl;
+	expect( s_num_alloc == 0, "no memory allocation after setup" );
+
+	std::cout << ( ( s_num_errors == 0 ) ? "all checks passed" : "CHECKS FAILED" ) << std::endl;
+	return ( s_num_errors == 0 ) ? 0 : 1;
+}
+
+
+/**
+ * \brief Append formatted text to a string.
+ */
+static void append( std::string& s, const char* format, int value )
+{
+	char buf[ 128 ];  // enough for all generated text
+	sprintf( buf, format, value );
+	s += buf;
+}
+
+
+/**
+ * \brief Generate a tracking data packet.
+ *
+ * @param[in] fr         Frame counter
+ * @param[in] numBodyCal Number of calibrated bodies ('6dcal')
+ * @param[in] numBody    Number of bodies ('6d', '6dcov')
+ * @param[in] numMarker  Number of single markers ('3d')
+ * @param[in] numJoints0 Number of joints of first ART-Human model
+ * @param[in] numJoints1 Number of joints of second ART-Human model
+ * @return               Packet
+ */
+static std::string make_frame( unsigned int fr, int numBodyCal, int numBody, int numMarker, int numJoints0, int numJoints1 )
+{
+	std::string s;
+	append( s, "fr %d\r\n", ( int )fr );
+	s += "ts2 1700000000 500000 3000\r\n";
+	append( s, "6dcal %d\r\n", numBodyCal );
+
+	append( s, "6d %d", numBody );
+	for ( int i = 0; i < numBody; i++ )
+	{
+		append( s, " [%d 1.000][100.0 200.0 300.0][1 0 0 0 1 0 0 0 1]", i );
+	}
+	s += "\r\n";
+
+	append( s, "6dcov %d", numBody );
+	for ( int i = 0; i < numBody; i++ )
+	{
+		append( s, " [%d 1.0 2.0 3.0]", i );
+		s += "[1 0 0 0 0 0 1 0 0 0 0 1 0 0 0 1 0 0 1 0 1]";
+	}
+	s += "\r\n";
+
+	append( s, "6df2 %d", MAX_FLYSTICK );
+	append( s, " %d", MAX_FLYSTICK );
+	for ( int i = 0; i < MAX_FLYSTICK; i++ )
+	{
+		append( s, " [%d 1.000 2 2][1.0 2.0 3.0][1 0 0 0 1 0 0 0 1]", i );
+		append( s, "[%d 0.5 -0.5]", ( int )fr & 3 );
+	}
+	s += "\r\n";
+
+	append( s, "3d %d", numMarker );
+	for ( int i = 0; i < numMarker; i++ )
+	{
+		append( s, " [%d 1.000][10.0 20.0 30.0]", 100 + i );
+	}
+	s += "\r\n";
+
+	int numJoints[ 2 ] = { numJoints0, numJoints1 };
+	append( s, "6dj %d 2", MAX_HUMAN );
+	for ( int h = 0; h < 2; h++ )
+	{
+		append( s, " [%d", h );
+		append( s, " %d]", numJoints[ h ] );
+		for ( int j = 0; j < numJoints[ h ]; j++ )
+			append( s, "[%d 1.000][1.0 2.0 3.0 10.0 20.0 30.0][1 0 0 0 1 0 0 0 1]", j );
+	}
+	s += "\r\n";
+
+	s += "st 3 [0 3][2 1 5] [1 5][0 0 0 0 0] [2 2 4][0 5 5 100][1 6 6 120]\r\n";
+	return s;
+}
+
+
+/**
+ * \brief Parse one tracking data packet.
+ */
+static bool parse( DTrackSDK& sdk, const std::string& frame )
+{
+	return sdk.processPacket( frame.c_str(), frame.length() + 1 );
+}
+
+
+/**
+ * \brief Check a condition, counting failed checks.
+ */
+static void expect( bool condition, const char* description )
+{
+	if ( condition )
+		return;
+
+	if ( s_num_errors < 20 )
+	{
+		bool counting = s_counting;  // output might allocate memory
+		s_counting = false;
+		std::cout << "  failed: " << description << std::endl;
+		s_counting = counting;
+	}
+
+	s_num_errors++;
+}
@@ -0,0 +1,433 @@
+/* DTrackSDK in C++: example_check_numbers.cpp
+ *
+ * C++ program checking the number scanners of DTrackSDK against the C library.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Purpose:
+ *  - compares string_get_d() bit by bit with strtod(), string_get_i() and string_get_ui() with
+ *    strtoll() and strtoull() (clamped to the range of 'int' and 'unsigned int'), including end pointers
+ *  - checks boundary values (15/16/17 significant digits, exponents +-22/+-23, -0, 1e308, denormals)
+ *    and seeded random numbers in several formats
+ *  - repeats all checks with a locale using a decimal comma, if one is available
+ *  - decimal numbers only, as sent by DTrack; hexadecimal numbers are not supported
+ *  - exit code 0 if all checks passed; requires no DTrack system; for DTrackSDK v2.10.0 (or newer)
+ */
+
+#include "DTrackParse.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace DTrackSDK_Parse;
+
+// settings:
+static unsigned int s_seed = 1;
+static int s_num_random = 1000000;  // number of random numbers
+static std::string s_locale;        // locale with decimal comma, empty to try some common names
+
+// locales with decimal comma, tried if none is given:
+static const char* s_comma_locales[] = {
+	"de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR", "German_Germany.1252", "German", NULL
+};
+
+/**
+ * \brief Expected result of scanning one number, got from the C library in 'C' locale.
+ */
+struct Expected
+{
+	std::string text;  //!< number, terminated by ']'
+	bool okD;          //!< valid 'double'
+	double d;          //!< 'double' value
+	size_t lenD;       //!< length of 'double' value
+	bool okI;          //!< valid 'int'
+	int i;             //!< 'int' value
+	size_t lenI;       //!< length of 'int' value
+	bool okUI;         //!< valid 'unsigned int'
+	unsigned int ui;   //!< 'unsigned int' value
+	size_t lenUI;      //!< length of 'unsigned int' value
+};
+
+// prototypes
+static bool parse_args( int argc, char** argv );
+static void add_boundary( std::vector< Expected >& list );
+static void add_random( std::vector< Expected >& list, int num, unsigned int seed );
+static void add( std::vector< Expected >& list, const std::string& text );
+static int check( const std::vector< Expected >& list, const char* name );
+
+
+/**
+ * \brief Main.
+ */
+int main( int argc, char** argv )
+{
+	if ( ! parse_args( argc, argv ) )
+	{
+		std::cout << "Usage: example_check_numbers [--seed <n>] [--random <n>] [--locale <name>]" << std::endl;
+		std::cout << "  --locale: locale with decimal comma, for checking independence of the locale" << std::endl;
+		return -1;
+	}
+
+	setlocale( LC_NUMERIC, "C" );
+
+	std::vector< Expected > list;
+	add_boundary( list );
+	int numBoundary = static_cast< int >( list.size() );
+	add_random( list, s_num_random, s_seed );
+
+	std::cout << "numbers: " << numBoundary << " boundary, " << list.size() - numBoundary << " random" << std::endl;
+
+	int nerr = check( list, "C" );
+
+	// repeat with decimal comma:
+	const char* name = NULL;
+	if ( ! s_locale.empty() )
+	{
+		name = setlocale( LC_NUMERIC, s_locale.c_str() );
+	}
+	else
+	{
+		for ( int i = 0; ( name == NULL ) && ( s_comma_locales[ i ] != NULL ); i++ )
+			name = setlocale( LC_NUMERIC, s_comma_locales[ i ] );
+	}
+
+	if ( ( name == NULL ) || ( strcmp( localeconv()->decimal_point, "." ) == 0 ) )
+	{
+		std::cout << "locale with decimal comma: not available, skipped" << std::endl;
+		if ( ! s_locale.empty() )
+			nerr++;  // explicitly requested
+	}
+	else
+	{
+		std::string localeName = name;  // might be overwritten by next call
+		nerr += check( list, localeName.c_str() );
+	}
+
+	setlocale( LC_NUMERIC, "C" );
+
+	std::cout << ( ( nerr == 0 ) ? "all checks passed" : "CHECKS FAILED" ) << std::endl;
+	return ( nerr == 0 ) ? 0 : 1;
+}
+
+
+/**
+ * \brief Parse command line arguments.
+ *
+ * @return Arguments valid?
+ */
+static bool parse_args( int argc, char** argv )
+{
+	for ( int i = 1; i < argc; i++ )
+	{
+		std::string arg = argv[ i ];
+		if ( i + 1 >= argc )
+			return false;
+
+		if ( arg == "--locale" )
+		{
+			s_locale = argv[ ++i ];
+			continue;
+		}
+
+		std::istringstream valuestream( argv[ ++i ] );
+		int value;
+		valuestream >> value;
+		if ( valuestream.fail() || ( value < 0 ) )
+			return false;
+
+		if ( arg == "--seed" )
+		{
+			s_seed = static_cast< unsigned int >( value );
+		}
+		else if ( arg == "--random" )
+		{
+			s_num_random = value;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Numbers to be checked:
+// ---------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Seeded pseudo random generator (xorshift), independent of the C library.
+ */
+class Random
+{
+public:
+
+	explicit Random( unsigned int seed ) : d_state( seed * 2654435761u + 1 ) {}
+
+	unsigned int next()
+	{
+		d_state ^= d_state << 13;
+		d_state ^= d_state >> 17;
+		d_state ^= d_state << 5;
+		return d_state;
+	}
+
+	int range( int lo, int hi )  // lo .. hi
+	{
+		return lo + static_cast< int >( next() % static_cast< unsigned int >( hi - lo + 1 ) );
+	}
+
+	double uniform( double lo, double hi )
+	{
+		return lo + ( hi - lo ) * ( next() / 4294967296.0 );
+	}
+
+private:
+
+	unsigned int d_state;
+};
+
+
+/**
+ * \brief Add boundary values.
+ */
+static void add_boundary( std::vector< Expected >& list )
+{
+	static const char* numbers[] = {
+		// zero and sign:
+		"0", "-0", "+0", "0.0", "-0.0", "-0e5", "0e-400", "000", "-000.000", "+5", "-5", "+-5", "-",  "+", ".", "",
+		// incomplete numbers and exponents:
+		".5", "5.", "-.5", "1e", "1e+", "1e-", "1E5", "1.5e+3", "2.5E-3", "1e0005", "1.e3", ".e3", "e3", "x",
+		// 15, 16 and 17 significant digits:
+		"123456789012345", "1234567890123456", "12345678901234567", "999999999999999", "9999999999999999",
+		"99999999999999999", "0.123456789012345", "0.1234567890123456", "0.12345678901234567",
+		"1.00000000000000", "1.000000000000000", "1.0000000000000000", "9007199254740991", "9007199254740992",
+		"9007199254740993", "0.000000000000000000000123456789012345", "1234567890.12345", "1234567890.123456",
+		"0.1", "0.2", "0.3", "2.675", "1.005", "0.30000000000000004", "3.141592653589793", "2.718281828459045",
+		// exponents +-22 and +-23:
+		"1e22", "1e23", "1e-22", "1e-23", "9e22", "9e-22", "123456789012345e22", "123456789012345e-22",
+		"123456789012345e23", "123456789012345e-23", "0.123456789012345e22", "0.123456789012345e-22",
+		"1.5e23", "1.5e-23", "4.35e22", "4.35e-22", "1000000000000000000000", "10000000000000000000000",
+		"0.0000000000000000000001", "0.00000000000000000000001",
+		// large and small numbers, denormals:
+		"1e308", "-1e308", "1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308", "1e309",
+		"2.2250738585072014e-308", "2.2250738585072011e-308", "2.2250738585072009e-308", "4.9406564584124654e-324",
+		"5e-324", "2.4703282292062327e-324", "2.4703282292062328e-324", "1e-320", "-1e-320", "1e-400", "1e-310",
+		"1e99999", "1e-99999", "1e100000000000000000000",
+		// special values:
+		"inf", "-inf", "INF", "infinity", "-Infinity", "nan", "-nan", "NAN",
+		// integers near the limits of 'int' and 'unsigned int':
+		"2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296", "-4294967295",
+		"-4294967296", "18446744073709551616", "-99999999999999999999", "0007", "-0007",
+		NULL
+	};
+
+	for ( int i = 0; numbers[ i ] != NULL; i++ )
+		add( list, numbers[ i ] );
+
+	// blanks in front of a value:
+	add( list, " 1.5" );
+	add( list, "\t-2" );
+	add( list, "  \t 3e2" );
+}
+
+
+/**
+ * \brief Add seeded random numbers in several formats.
+ */
+static void add_random( std::vector< Expected >& list, int num, unsigned int seed )
+{
+	static const char* formats[] = { "%.3f", "%.6f", "%.15g", "%.16g", "%.17g", "%e", "%.20e", "%g" };
+	const int numFormats = sizeof( formats ) / sizeof( formats[ 0 ] );
+	Random rnd( seed );
+	char buf[ 512 ];
+
+	for ( int n = 0; n < num; n++ )
+	{
+		int kind = rnd.range( 0, numFormats + 1 );
+		if ( kind < numFormats )
+		{	// formatted by the C library, 'C' locale:
+			double scale = 1.0;
+			int e = rnd.range( -30, 30 );
+			for ( int i = 0; i < ( e < 0 ? -e : e ); i++ )
+				scale = ( e < 0 ) ? scale / 10.0 : scale * 10.0;
+
+			sprintf( buf, formats[ kind ], rnd.uniform( -1.0, 1.0 ) * scale );
+		}
+		else if ( kind == numFormats )
+		{	// random digit string with optional decimal point and exponent:
+			int len = 0;
+			if ( rnd.range( 0, 3 ) == 0 )
+				buf[ len++ ] = '-';
+
+			int ndigit = rnd.range( 1, 25 );
+			int dp = rnd.range( -1, ndigit );
+			for ( int i = 0; i < ndigit; i++ )
+			{
+				if ( i == dp )
+					buf[ len++ ] = '.';
+
+				buf[ len++ ] = static_cast< char >( '0' + rnd.range( 0, 9 ) );
+			}
+
+			if ( rnd.range( 0, 1 ) == 0 )
+				len += sprintf( buf + len, "e%d", rnd.range( -330, 330 ) );
+
+			buf[ len ] = '\0';
+		}
+		else
+		{	// random bit pattern of a 'double', all digits:
+			unsigned long long bits = ( static_cast< unsigned long long >( rnd.next() ) << 32 ) | rnd.next();
+			double d;
+			memcpy( &d, &bits, sizeof( d ) );
+			if ( d != d || d - d != 0.0 )  // NaN or infinite
+				d = 1.0;
+
+			sprintf( buf, "%.17g", d );
+		}
+
+		add( list, buf );
+	}
+}
+
+
+/**
+ * \brief Add one number, with expected results of the C library.
+ *
+ * Expected results for 'int' and 'unsigned int' are clamped to the range of the type; like strtoul(),
+ * negative numbers are negated in 'unsigned int'.
+ */
+static void add( std::vector< Expected >& list, const std::string& text )
+{
+	Expected ex;
+	ex.text = text + "]";  // as inside a block; the C library stops there as well
+	const char* s = ex.text.c_str();
+	char* end;
+
+	const char* p = s;  // skip blanks, as done by DTrackSDK (the C library skips all kind of white space)
+	while ( *p == ' ' || *p == '\t' )
+		p++;
+
+	size_t nblank = p - s;
+
+	// 'double':
+	ex.d = strtod( p, &end );
+	ex.okD = ( end != p );
+	ex.lenD = nblank + ( end - p );
+
+	// 'int' and 'unsigned int', without white space or sign behind the sign:
+	bool neg = ( *p == '-' );
+	const char* q = ( *p == '-' || *p == '+' ) ? p + 1 : p;
+	bool digit = ( *q >= '0' && *q <= '9' );
+
+	errno = 0;
+	unsigned long long m = strtoull( q, &end, 10 );
+	if ( errno == ERANGE )
+		m = ULLONG_MAX;
+
+	ex.okI = ex.okUI = digit;
+	ex.lenI = ex.lenUI = nblank + ( end - p );
+
+	if ( neg )
+		ex.i = ( m > ( unsigned long long )INT_MAX + 1 ) ? INT_MIN : ( int )( 0 - m );
+	else
+		ex.i = ( m > ( unsigned long long )INT_MAX ) ? INT_MAX : ( int )m;
+
+	if ( m > UINT_MAX )
+		m = UINT_MAX;
+
+	ex.ui = neg ? 0U - ( unsigned int )m : ( unsigned int )m;
+
+	list.push_back( ex );
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Checks:
+// ---------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Print a failed check.
+ */
+static void print_error( int& nerr, const char* name, const char* function, const Expected& ex )
+{
+	if ( nerr < 20 )
+		std::cout << "  " << name << ": " << function << "( \"" << ex.text << "\" ) differs" << std::endl;
+
+	nerr++;
+}
+
+
+/**
+ * \brief Check all numbers with the actual locale.
+ *
+ * @param[in] list Numbers with expected results
+ * @param[in] name Name of locale, for output
+ * @return         Number of failed checks
+ */
+static int check( const std::vector< Expected >& list, const char* name )
+{
+	int nerr = 0;
+
+	for ( size_t n = 0; n < list.size(); n++ )
+	{
+		const Expected& ex = list[ n ];
+		const char* s = ex.text.c_str();
+
+		double d = 0.0;
+		const char* end = string_get_d( s, &d );
+		bool ok = ( end != NULL );
+		if ( ok != ex.okD || ( ok && ( memcmp( &d, &ex.d, sizeof( d ) ) != 0 ||
+		                               static_cast< size_t >( end - s ) != ex.lenD ) ) )
+		{
+			print_error( nerr, name, "string_get_d", ex );
+		}
+
+		int i = 0;
+		end = string_get_i( s, &i );
+		ok = ( end != NULL );
+		if ( ok != ex.okI || ( ok && ( i != ex.i || static_cast< size_t >( end - s ) != ex.lenI ) ) )
+			print_error( nerr, name, "string_get_i", ex );
+
+		unsigned int ui = 0;
+		end = string_get_ui( s, &ui );
+		ok = ( end != NULL );
+		if ( ok != ex.okUI || ( ok && ( ui != ex.ui || static_cast< size_t >( end - s ) != ex.lenUI ) ) )
+			print_error( nerr, name, "string_get_ui", ex );
+	}
+
+	std::cout << "locale " << name << ": " << list.size() << " numbers, " << nerr << " errors" << std::endl;
+	return nerr;
+}
@@ -0,0 +1,242 @@
+/* DTrackSDK in C++: example_check_pipeline.cpp
+ *
+ * C++ program checking pipelined 'dtrack2' commands of DTrackSDK against a simulated Controller.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Purpose:
+ *  - simulates a Controller at the local TCP port 50105, answering commands in order;
+ *    the answer to parameter 'test slow' is delayed beyond the command timeout
+ *  - a pipelined getParams() runs into the timeout in the middle of the batch
+ *  - afterwards getParam() and getParams() have to get their own answers, not late ones of the batch
+ *  - getMessages() has to get all event messages, also if one arrives between pipelined requests
+ *  - exit code 0 if all checks passed; requires no DTrack system, but a free TCP port 50105;
+ *    for DTrackSDK v2.10.0 (or newer)
+ */
+
+#include "DTrackSDK.hpp"
+#include "DTrackNet.hpp"
+#include "DTrackSys.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// usually the following should work; otherwise define OS_* manually:
+#if defined( _WIN32 ) || defined( WIN32 ) || defined( _WIN64 )
+	#define OS_WIN   // for MS Windows (2000, XP, Vista, 7, 8, 10)
+#else
+	#define OS_UNIX  // for Unix (Linux, Irix)
+#endif
+
+#ifdef OS_UNIX
+	#include <unistd.h>
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <arpa/inet.h>
+	typedef int socket_type;
+	#define INVALID_SOCKET  ( -1 )
+	#define closesocket( s )  close( s )
+#endif
+#ifdef OS_WIN
+	#include <winsock2.h>
+	#include <windows.h>
+	typedef SOCKET socket_type;
+#endif
+
+static const unsigned short CONTROLLER_PORT = 50105;  // TCP port of command interface
+static const int COMMAND_TIMEOUT = 100000;   // command timeout of DTrackSDK (in us)
+static const double SLOW_DELAY = 0.3;        // delay of 'slow' answers (in s)
+static const unsigned int NUM_MESSAGES = 3;  // number of event messages
+
+static int s_num_errors = 0;
+
+// prototypes
+static socket_type listen_local( unsigned short port );
+static void controller( void* arg );
+static void expect( bool condition, const char* description );
+
+
+/**
+ * \brief Main.
+ */
+int main( int, char** )
+{
+	DTrackNet::net_init();
+
+	socket_type server = listen_local( CONTROLLER_PORT );
+	if ( server == INVALID_SOCKET )
+	{
+		std::cout << "TCP port " << CONTROLLER_PORT << " not available" << std::endl;
+		DTrackNet::net_exit();
+		return 1;
+	}
+
+	DTrackSys::Thread thread;
+	thread.start( controller, &server );
+
+	{
+		DTrackSDK sdk( "127.0.0.1", 0 );
+		expect( sdk.isCommandInterfaceValid(), "connecting to simulated Controller" );
+		sdk.setCommandTimeoutUS( COMMAND_TIMEOUT );
+
+		std::vector< std::string > params, values;
+		params.push_back( "test a" );
+		params.push_back( "test b" );
+		params.push_back( "test slow" );
+		params.push_back( "test c" );
+		params.push_back( "test d" );
+
+		// timeout in the middle of the batch:
+		expect( ! sdk.getParams( params, values ), "batch with delayed answer fails" );
+		expect( sdk.getLastServerError() == DTrackSDK::ERR_TIMEOUT, "timeout is reported" );
+		expect( sdk.getNumPendingDTrack2Commands() == 3, "commands on the way are pending" );
+		expect( sdk.isCommandInterfaceValid(), "connection is kept after timeout" );
+
+		DTrackSys::time_sleep( 2.0 * SLOW_DELAY );  // late answers arrive meanwhile
+
+		std::string value;
+		expect( sdk.getParam( "test e", value ), "getting parameter after timeout" );
+		expect( value == "val_e", "parameter gets its own answer" );
+		expect( sdk.getNumPendingDTrack2Commands() == 0, "late answers are skipped" );
+
+		params.erase( params.begin() + 2 );
+		expect( sdk.getParams( params, values ), "getting parameters after timeout" );
+		expect( values.size() == 4 && values[ 0 ] == "val_a" && values[ 1 ] == "val_b" &&
+		        values[ 2 ] == "val_c" && values[ 3 ] == "val_d", "parameters get their own answers" );
+
+		// the second request finds no message, the following ones do:
+		std::vector< DTrackMessage > messages;
+		expect( sdk.getMessages( messages ) == NUM_MESSAGES, "getting all messages" );
+		expect( messages.size() == NUM_MESSAGES && messages[ 0 ].errorId == 1 &&
+		        messages[ NUM_MESSAGES - 1 ].errorId == NUM_MESSAGES, "messages in order" );
+		expect( sdk.getMessages( messages ) == 0 && messages.empty(), "no more messages" );
+	}  // closes connection, controller thread finishes
+
+	thread.join();
+	closesocket( server );
+	DTrackNet::net_exit();
+
+	std::cout << ( ( s_num_errors == 0 ) ? "all checks passed" : "CHECKS FAILED" ) << std::endl;
+	return ( s_num_errors == 0 ) ? 0 : 1;
+}
+
+
+/**
+ * \brief Open TCP socket listening at localhost.
+ *
+ * @param[in] port Port number
+ * @return         Socket; INVALID_SOCKET in case of error
+ */
+static socket_type listen_local( unsigned short port )
+{
+	socket_type sock = socket( AF_INET, SOCK_STREAM, 0 );
+	if ( sock == INVALID_SOCKET )
+		return INVALID_SOCKET;
+
+	int on = 1;
+	setsockopt( sock, SOL_SOCKET, SO_REUSEADDR, ( const char* )&on, sizeof( on ) );
+
+	struct sockaddr_in addr;
+	memset( &addr, 0, sizeof( addr ) );
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons( port );
+	addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+
+	if ( bind( sock, ( struct sockaddr* )&addr, sizeof( addr ) ) != 0 || listen( sock, 1 ) != 0 )
+	{
+		closesocket( sock );
+		return INVALID_SOCKET;
+	}
+
+	return sock;
+}
+
+
+/**
+ * \brief Thread simulating a Controller, answering commands of one connection in order.
+ *
+ * @param[in] arg Pointer to listening socket
+ */
+static void controller( void* arg )
+{
+	socket_type conn = accept( *( socket_type* )arg, NULL, NULL );
+	if ( conn == INVALID_SOCKET )
+		return;
+
+	unsigned int numGetMsg = 0;  // number of 'dtrack2 getmsg' commands
+	unsigned int numMessages = 0;  // number of sent event messages
+	std::string buf;
+	char data[ 1024 ];
+	int len;
+	while ( ( len = ( int )recv( conn, data, sizeof( data ), 0 ) ) > 0 )
+	{
+		buf.append( data, len );
+
+		size_t pos;
+		while ( ( pos = buf.find( '\0' ) ) != std::string::npos )
+		{
+			std::string command = buf.substr( 0, pos );
+			buf.erase( 0, pos + 1 );
+
+			std::string answer = "dtrack2 ok";
+			if ( command.compare( 0, 17, "dtrack2 get test " ) == 0 )
+			{
+				std::string name = command.substr( 17 );
+				if ( name == "slow" )
+					DTrackSys::time_sleep( SLOW_DELAY );
+
+				answer = "dtrack2 set test " + name + " val_" + name;
+			}
+			else if ( command == "dtrack2 getmsg" )
+			{
+				if ( numGetMsg++ != 1 && numMessages < NUM_MESSAGES )
+				{
+					numMessages++;
+					answer = "dtrack2 msg ctrl ok 100 " + std::string( 1, ( char )( '0' + numMessages ) ) + " \"message\"";
+				}
+			}
+
+			send( conn, answer.c_str(), ( int )answer.length() + 1, 0 );
+		}
+	}
+
+	closesocket( conn );
+}
+
+
+/**
+ * \brief Check a condition, counting failed checks.
+ */
+static void expect( bool condition, const char* description )
+{
+	if ( condition )
+		return;
+
+	std::cout << "  failed: " << description << std::endl;
+	s_num_errors++;
+}
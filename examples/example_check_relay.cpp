@@ -0,0 +1,209 @@
+/* DTrackSDK in C++: example_check_relay.cpp
+ *
+ * C++ program checking that DTrackRelayDecoder rejects binary frames with oversized lists.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Purpose:
+ *  - builds binary frames of DTrackRelay by hand, with list counts beyond the limits of the decoder
+ *    or beyond the remaining data of the frame
+ *  - such frames have to be rejected, without allocating memory for the claimed number of entries
+ *  - lists just at the limits have to be accepted
+ *  - exit code 0 if all checks passed; requires no DTrack system; for DTrackSDK v2.10.0 (or newer)
+ */
+
+#include "DTrackSDK.hpp"
+#include "DTrackRelay.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+// counting of allocated memory:
+static bool s_counting = false;  // count allocations?
+static size_t s_num_bytes = 0;   // number of counted bytes
+
+static void* count_alloc( size_t size )
+{
+	if ( s_counting )
+		s_num_bytes += size;
+
+	return malloc( ( size > 0 ) ? size : 1 );
+}
+
+void* operator new( size_t size )
+{
+	void* p = count_alloc( size );
+	if ( p == NULL )
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void* operator new[]( size_t size )
+{
+	void* p = count_alloc( size );
+	if ( p == NULL )
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void* operator new( size_t size, const std::nothrow_t& ) throw()  { return count_alloc( size ); }
+void* operator new[]( size_t size, const std::nothrow_t& ) throw()  { return count_alloc( size ); }
+void operator delete( void* p ) throw()  { free( p ); }
+void operator delete[]( void* p ) throw()  { free( p ); }
+void operator delete( void* p, const std::nothrow_t& ) throw()  { free( p ); }
+void operator delete[]( void* p, const std::nothrow_t& ) throw()  { free( p ); }
+
+// section tags of binary frames, as in DTrackRelay.cpp:
+static const int TAG_END = 0;
+static const int TAG_BODY = 1;
+static const int TAG_HAND = 5;
+static const int TAG_HUMAN = 6;
+static const int TAG_MARKER = 8;
+
+static const size_t MAX_ALLOC = 1000000;  // maximum of allocated memory for one frame (in bytes)
+
+static std::string s_header;  // header of a valid key frame
+static int s_num_errors = 0;
+
+// prototypes
+static std::string make_frame( int tag, int num, int numBytes );
+static bool decode( DTrackRelayDecoder& decoder, const std::string& frame );
+static void expect( bool condition, const char* description );
+
+
+/**
+ * \brief Main.
+ */
+int main( int, char** )
+{
+	// header of a valid key frame, without any tracking data:
+	{
+		DTrackSDK sdk( ( unsigned short )0 );
+		std::string packet = "fr 1\r\n";
+		expect( sdk.processPacket( packet ), "parsing tracking data" );
+
+		DTrackRelay relay;
+		char buffer[ 256 ];
+		int len = relay.encode( sdk, buffer, sizeof( buffer ) );
+		expect( len > 0 && buffer[ len - 1 ] == TAG_END, "encoding frame" );
+		if ( len <= 0 )
+			return 1;
+
+		s_header.assign( buffer, len - 1 );
+	}
+
+	DTrackRelayDecoder decoder;
+	expect( decode( decoder, make_frame( TAG_END, 0, 0 ) ), "frame without tracking data" );
+
+	// claimed number of entries, just bitmap with 'untracked' bits:
+	expect( ! decode( decoder, make_frame( TAG_HAND, 500000, 62500 ) ), "too many hands are rejected" );
+	expect( ! decode( decoder, make_frame( TAG_BODY, 1001, 126 ) ), "too many bodies are rejected" );
+	expect( ! decode( decoder, make_frame( TAG_BODY, 1000, 124 ) ), "too short bitmap is rejected" );
+	expect( decode( decoder, make_frame( TAG_BODY, 1000, 125 ) ), "maximum number of bodies" );
+	expect( decoder.getNumBody() == 1000 && ! decoder.getBody( 999 )->isTracked(), "untracked bodies" );
+
+	// entries with at least one byte each:
+	expect( ! decode( decoder, make_frame( TAG_MARKER, 10000, 100 ) ), "markers beyond data are rejected" );
+	expect( ! decode( decoder, make_frame( TAG_MARKER, 10001, 60000 ) ), "too many markers are rejected" );
+	expect( ! decode( decoder, make_frame( TAG_HUMAN, 101, 101 ) ), "too many ART-Human models are rejected" );
+	expect( decode( decoder, make_frame( TAG_HUMAN, 100, 100 ) ), "maximum number of ART-Human models" );
+	expect( decoder.getNumHuman() == 100 && decoder.getHumanJoints( 99 ).num_joints == 0, "ART-Human models without joints" );
+
+	std::cout << ( ( s_num_errors == 0 ) ? "all checks passed" : "CHECKS FAILED" ) << std::endl;
+	return ( s_num_errors == 0 ) ? 0 : 1;
+}
+
+
+/**
+ * \brief Append an unsigned varint to a binary frame.
+ */
+static void append_varint( std::string& s, unsigned int v )
+{
+	while ( v >= 0x80 )
+	{
+		s += static_cast< char >( ( v & 0x7f ) | 0x80 );
+		v >>= 7;
+	}
+
+	s += static_cast< char >( v );
+}
+
+
+/**
+ * \brief Generate a key frame with one list of entries.
+ *
+ * @param[in] tag      Section tag; TAG_END for no list
+ * @param[in] num      Claimed number of entries (zig-zag encoded difference to 0)
+ * @param[in] numBytes Number of zero bytes following the number (bitmap or entries)
+ * @return             Binary frame
+ */
+static std::string make_frame( int tag, int num, int numBytes )
+{
+	std::string s = s_header;
+	if ( tag != TAG_END )
+	{
+		s += static_cast< char >( tag );
+		append_varint( s, static_cast< unsigned int >( num ) << 1 );
+		s.append( numBytes, '\0' );
+	}
+
+	s += static_cast< char >( TAG_END );
+	return s;
+}
+
+
+/**
+ * \brief Decode one binary frame, checking the allocated memory.
+ */
+static bool decode( DTrackRelayDecoder& decoder, const std::string& frame )
+{
+	decoder.reset();  // each frame is a key frame with the same sequence number
+
+	s_num_bytes = 0;
+	s_counting = true;
+	bool ok = decoder.decode( frame.data(), static_cast< int >( frame.length() ) );
+	s_counting = false;
+
+	expect( s_num_bytes <= MAX_ALLOC, "limited memory allocation" );
+	return ok;
+}
+
+
+/**
+ * \brief Check a condition, counting failed checks.
+ */
+static void expect( bool condition, const char* description )
+{
+	if ( condition )
+		return;
+
+	std::cout << "  failed: " << description << std::endl;
+	s_num_errors++;
+}
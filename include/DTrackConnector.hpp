@@ -0,0 +1,164 @@
+/* DTrackSDK in C++: DTrackConnector.hpp
+ *
+ * Background connecting of the DTrack2/DTRACK3 command interface.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_CONNECTOR_HPP_
+#define _ART_DTRACKSDK_CONNECTOR_HPP_
+
+#include "DTrackNet.hpp"
+#include "DTrackSys.hpp"
+
+#include <string>
+
+/**
+ * \brief Background connecting of the DTrack2/DTRACK3 command interface.
+ *
+ * A thread resolves the hostname of the Controller and establishes the TCP connection, so the calling
+ * thread never waits for a name server or an unreachable Controller. Failed attempts are repeated, with
+ * a waiting time doubled after each failure (exponential backoff). An established connection is passed
+ * to exactly one other thread by takeConnection(); after it got broken, reconnect() starts again.
+ *
+ * Stopping the thread has to wait for a running name resolution or connection attempt.
+ *
+ * Usually created by DTrackSDK, refer to DTrackSDK::enableAutoReconnect().
+ */
+class DTrackConnector
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 *
+	 * @param[in] host             Hostname or IP address of Controller
+	 * @param[in] port             Port number (TCP) of Controller
+	 * @param[in] connectTimeoutUs Timeout of one connection attempt in us (micro seconds)
+	 * @param[in] minBackoffUs     Waiting time after the first failed attempt in us
+	 * @param[in] maxBackoffUs     Maximum waiting time between attempts in us
+	 */
+	DTrackConnector( const std::string& host, unsigned short port, int connectTimeoutUs, int minBackoffUs,
+	                 int maxBackoffUs );
+
+	/**
+	 * \brief Destructor. Stops connecting thread.
+	 */
+	~DTrackConnector();
+
+	/**
+	 * \brief Start connecting thread.
+	 *
+	 * @param[in] isConnected Using thread has already a connection, so wait for reconnect()
+	 * @return                Success?
+	 */
+	bool start( bool isConnected = false );
+
+	/**
+	 * \brief Stop connecting thread.
+	 */
+	void stop();
+
+	/**
+	 * \brief Returns if connecting thread is running.
+	 *
+	 * @return Running?
+	 */
+	bool isRunning() const;
+
+	/**
+	 * \brief Returns if the thread is trying to establish a connection.
+	 *
+	 * @return Connecting?
+	 */
+	bool isConnecting() const;
+
+	/**
+	 * \brief Returns if an established connection is waiting to be taken by takeConnection().
+	 *
+	 * @return Connection available?
+	 */
+	bool isConnected() const;
+
+	/**
+	 * \brief Get IP address of Controller, as resolved by the latest attempt.
+	 *
+	 * @return IP address, 0 if not resolved yet
+	 */
+	unsigned int getRemoteIp() const;
+
+	/**
+	 * \brief Get number of failed connection attempts since the last established connection.
+	 *
+	 * @return Number of failed attempts
+	 */
+	int getNumFailed() const;
+
+	/**
+	 * \brief Take established connection. Called by using thread.
+	 *
+	 * @return TCP connection, to be deleted by the calling thread; NULL if not available
+	 */
+	DTrackNet::TCP* takeConnection();
+
+	/**
+	 * \brief Start establishing a new connection, after the taken one got broken. Called by using thread.
+	 */
+	void reconnect();
+
+private:
+
+	DTrackConnector( const DTrackConnector& );             // not copyable
+	DTrackConnector& operator=( const DTrackConnector& );  // not copyable
+
+	//! States of connection
+	enum {
+		STATE_CONNECTING = 0,  //!< thread is establishing a connection
+		STATE_CONNECTED,       //!< connection established, not taken yet
+		STATE_TAKEN            //!< connection taken by using thread
+	};
+
+	static void connectThread( void* arg );
+	void connectLoop();
+	bool connectServer();
+	void waitUs( int us );
+
+	std::string d_host;           //!< hostname or IP address of Controller
+	unsigned short d_port;        //!< port number of Controller
+	int d_connecttimeoutUs;       //!< timeout of one connection attempt in us
+	int d_minbackoffUs;           //!< waiting time after first failed attempt in us
+	int d_maxbackoffUs;           //!< maximum waiting time between attempts in us
+
+	DTrackNet::TCP* d_tcp;        //!< established connection, not taken yet (NULL if none)
+
+	DTrackSys::Thread* d_thread;  //!< connecting thread (NULL if not running)
+	volatile int d_stop;          //!< connecting thread: request to stop
+	volatile int d_state;         //!< state of connection; changed by both threads
+	volatile int d_remoteip;      //!< resolved IP address of Controller (0 if unknown)
+	volatile int d_numfailed;     //!< number of failed attempts since last established connection
+};
+
+#endif  // _ART_DTRACKSDK_CONNECTOR_HPP_
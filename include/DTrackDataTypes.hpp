@@ -32,6 +32,7 @@
 #define _ART_DTRACKSDK_DATATYPES_HPP_
 
 #include <vector>
+#include <string>
 
 namespace DTrackSDK_Datatypes {
 
@@ -54,6 +55,46 @@ struct DTrackQuaternion
  */
 DTrackQuaternion rot2quat( const double rot[ 9 ] );
 
+/**
+ * \brief Helper to expand a covariance matrix from reduced form.
+ *
+ * The reduced form contains the upper triangle of the symmetric matrix row by row, like sent by DTrack.
+ *
+ * @param[out] cov        Full matrix (dim x dim)
+ * @param[in]  covReduced Reduced form (dim * ( dim + 1 ) / 2 values)
+ * @param[in]  dim        Dimension of matrix
+ */
+void cov_reduced2full( double* cov, const double* covReduced, int dim );
+
+/**
+ * \brief Helper to expand a covariance matrix from reduced form, in single precision.
+ *
+ * @param[out] cov        Full matrix (dim x dim)
+ * @param[in]  covReduced Reduced form (dim * ( dim + 1 ) / 2 values), see cov_reduced2full()
+ * @param[in]  dim        Dimension of matrix
+ */
+void cov_reduced2full( float* cov, const double* covReduced, int dim );
+
+/**
+ * \brief Helper to get the diagonal (variances) of a covariance matrix in reduced form.
+ *
+ * @param[out] var        Diagonal (dim values)
+ * @param[in]  covReduced Reduced form (dim * ( dim + 1 ) / 2 values), see cov_reduced2full()
+ * @param[in]  dim        Dimension of matrix
+ */
+void cov_reduced2diag( double* var, const double* covReduced, int dim );
+
+/**
+ * \brief Helper to get one element of a covariance matrix in reduced form.
+ *
+ * @param[in] covReduced Reduced form (dim * ( dim + 1 ) / 2 values), see cov_reduced2full()
+ * @param[in] dim        Dimension of matrix
+ * @param[in] row        Row, range 0 .. dim - 1
+ * @param[in] col        Column, range 0 .. dim - 1
+ * @return               Element; 0 if out of range
+ */
+double cov_reduced_get( const double* covReduced, int dim, int row, int col );
+
 // -----------------------------------------------------------------------------------------------------
 
 /**
@@ -72,6 +113,9 @@ typedef DTrackMarker DTrack_Marker_Type_d;  //!< Alias for DTrackMarker. DEPRECA
 
 /**
  * \brief Standard body data (6DOF).
+ *
+ * Since DTrackSDK v2.10.0 the covariance is stored in reduced form; use getCovariance() instead of
+ * the former member 'cov'.
  */
 struct DTrackBody
 {
@@ -80,7 +124,7 @@ struct DTrackBody
 	double loc[ 3 ];     //!< Location (in [mm])
 	double rot[ 9 ];     //!< Rotation matrix (column-wise)
 	double covref[ 3 ];  //!< Reference point of covariance (in [mm])
-	double cov[ 36 ];    //!< 6x6-dimensional covariance matrix for the 6d pose (with 3d location in [mm], 3d euler angles in [rad]).
+	double covreduced[ 21 ];  //!< Covariance matrix for the 6d pose in reduced form (upper triangle row by row), see getCovariance()
 
 	/**
 	 * \brief Returns if body is currently tracked.
@@ -97,6 +141,42 @@ struct DTrackBody
 	 */
 	DTrackQuaternion getQuaternion() const
 	{ return rot2quat( rot ); }
+
+	/**
+	 * \brief Get 6x6-dimensional covariance matrix for the 6d pose (with 3d location in [mm], 3d euler angles in [rad]).
+	 *
+	 * Expanded from the reduced form on each call.
+	 *
+	 * @param[out] cov Covariance matrix (symmetric)
+	 */
+	void getCovariance( double cov[ 36 ] ) const
+	{ cov_reduced2full( cov, covreduced, 6 ); }
+
+	/**
+	 * \brief Get 6x6-dimensional covariance matrix for the 6d pose, in single precision.
+	 *
+	 * @param[out] cov Covariance matrix (symmetric)
+	 */
+	void getCovariance( float cov[ 36 ] ) const
+	{ cov_reduced2full( cov, covreduced, 6 ); }
+
+	/**
+	 * \brief Get diagonal (variances) of covariance matrix for the 6d pose.
+	 *
+	 * @param[out] var Variances of 3d location (in [mm^2]) and 3d euler angles (in [rad^2])
+	 */
+	void getCovarianceDiagonal( double var[ 6 ] ) const
+	{ cov_reduced2diag( var, covreduced, 6 ); }
+
+	/**
+	 * \brief Get one element of covariance matrix for the 6d pose.
+	 *
+	 * @param[in] row Row, range 0 .. 5
+	 * @param[in] col Column, range 0 .. 5
+	 * @return        Element; 0 if out of range
+	 */
+	double getCovariance( int row, int col ) const
+	{ return cov_reduced_get( covreduced, 6, row, col ); }
 };
 
 typedef DTrackBody DTrack_Body_Type_d;  //!< Alias for DTrackBody. DEPRECATED.
@@ -180,7 +260,8 @@ typedef DTrackFlyStick DTrack_FlyStick_Type_d;  //!< Alias for DTrackFlyStick. D
 /**
  * \brief Measurement Tool data (6DOF + buttons).
  *
- * Note the maximum number of buttons.
+ * Note the maximum number of buttons. Since DTrackSDK v2.10.0 the covariance is stored in reduced form;
+ * use getCovariance() instead of the former member 'cov'.
  */
 struct DTrackMeaTool
 {
@@ -191,7 +272,7 @@ struct DTrackMeaTool
 	double loc[ 3 ];   //!< Location (in [mm])
 	double rot[ 9 ];   //!< Rotation matrix (column-wise)
 	double tipradius;  //!< Radius of tip (in [mm]) if applicable
-	double cov[ 9 ];   //!< Covariance of location (column-wise; in [mm^2])
+	double covreduced[ 6 ];  //!< Covariance of location in reduced form (upper triangle row by row), see getCovariance()
 
 	/**
 	 * \brief Returns if Measurement Tool is currently tracked.
@@ -208,6 +289,42 @@ struct DTrackMeaTool
 	 */
 	DTrackQuaternion getQuaternion() const
 	{ return rot2quat( rot ); }
+
+	/**
+	 * \brief Get covariance of location (in [mm^2]).
+	 *
+	 * Expanded from the reduced form on each call.
+	 *
+	 * @param[out] cov Covariance matrix (3x3, symmetric)
+	 */
+	void getCovariance( double cov[ 9 ] ) const
+	{ cov_reduced2full( cov, covreduced, 3 ); }
+
+	/**
+	 * \brief Get covariance of location, in single precision.
+	 *
+	 * @param[out] cov Covariance matrix (3x3, symmetric)
+	 */
+	void getCovariance( float cov[ 9 ] ) const
+	{ cov_reduced2full( cov, covreduced, 3 ); }
+
+	/**
+	 * \brief Get diagonal (variances) of covariance of location.
+	 *
+	 * @param[out] var Variances (in [mm^2])
+	 */
+	void getCovarianceDiagonal( double var[ 3 ] ) const
+	{ cov_reduced2diag( var, covreduced, 3 ); }
+
+	/**
+	 * \brief Get one element of covariance of location.
+	 *
+	 * @param[in] row Row, range 0 .. 2
+	 * @param[in] col Column, range 0 .. 2
+	 * @return        Element; 0 if out of range
+	 */
+	double getCovariance( int row, int col ) const
+	{ return cov_reduced_get( covreduced, 3, row, col ); }
 };
 
 typedef DTrackMeaTool DTrack_MeaTool_Type_d;  //!< Alias for DTrackMeaTool. DEPRECATED.
@@ -351,6 +468,28 @@ struct DTrackHuman
 
 typedef DTrackHuman DTrack_Human_Type_d;  //!< Alias for DTrackHuman. DEPRECATED.
 
+typedef DTrackHuman::DTrackJoint DTrackJoint;  //!< ART-Human joint data
+
+/**
+ * \brief ART-Human model, joints in compact storage.
+ *
+ * Refers to joint data stored by the parser; valid until the next frame is processed.
+ */
+struct DTrackHumanJoints
+{
+	int id;                    //!< ID number of human model (starting with 0)
+	int num_joints;            //!< Number of joints
+	const DTrackJoint* joint;  //!< Joint data (num_joints entries); NULL if no joints
+
+	/**
+	 * \brief Returns if human model is currently tracked.
+	 *
+	 * @return Is tracked?
+	 */
+	bool isTracked() const
+	{ return ( num_joints > 0 ); }
+};
+
 // -----------------------------------------------------------------------------------------------------
 
 /**
@@ -390,6 +529,59 @@ struct DTrackStatus
 	std::vector< DTrackCameraStatus > cameraStatus;  //!< Camera status
 };
 
+// -----------------------------------------------------------------------------------------------------
+
+/**
+ * \brief Change of tracking data since the previous frame.
+ */
+struct DTrackEvent
+{
+	//! Types of changes
+	typedef enum {
+		EVENT_ADDED,             //!< Object was added (number of calibrated objects increased)
+		EVENT_REMOVED,           //!< Object was removed (number of calibrated objects decreased)
+		EVENT_TRACKED,           //!< Object became tracked
+		EVENT_LOST,              //!< Object is no longer tracked
+		EVENT_BUTTON_PRESSED,    //!< Button was pressed
+		EVENT_BUTTON_RELEASED,   //!< Button was released
+		EVENT_JOYSTICK           //!< Joystick value changed by at least the threshold, or returned to zero
+	} EventType;
+
+	//! Types of objects
+	typedef enum {
+		OBJECT_BODY,             //!< Standard body
+		OBJECT_FLYSTICK,         //!< Flystick
+		OBJECT_MEATOOL,          //!< Measurement Tool
+		OBJECT_MEAREF,           //!< Measurement Tool reference
+		OBJECT_HAND,             //!< A.R.T. FINGERTRACKING hand
+		OBJECT_HUMAN,            //!< ART-Human model
+		OBJECT_INERTIAL,         //!< Hybrid (optical-inertial) body
+		NUM_OBJECTTYPES          //!< Number of object types
+	} ObjectType;
+
+	EventType type;          //!< Type of change
+	ObjectType objectType;   //!< Type of object
+	int id;                  //!< ID number of object (starting with 0)
+	int index;               //!< Index of button or joystick value (-1 if not applicable)
+	double value;            //!< New joystick value (0.0 if not applicable)
+};
+
+// -----------------------------------------------------------------------------------------------------
+
+/**
+ * \brief DTrack2/DTRACK3 event message of the Controller.
+ *
+ * Note that this struct may be enhanced in future DTrackSDK versions.
+ */
+struct DTrackMessage
+{
+	std::string origin;     //!< Origin of message
+	std::string status;     //!< Status of message
+	unsigned int frameNr;   //!< Frame counter
+	unsigned int errorId;   //!< Error id
+	std::string msg;        //!< Message text
+};
+
 
 }  // namespace DTrackSDK_Datatypes
 
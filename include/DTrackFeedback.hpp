@@ -0,0 +1,216 @@
+/* DTrackSDK in C++: DTrackFeedback.hpp
+ *
+ * Collecting feedback commands for Flysticks and tactile FINGERTRACKING devices.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_FEEDBACK_HPP_
+#define _ART_DTRACKSDK_FEEDBACK_HPP_
+
+/**
+ * \brief Collecting feedback commands for Flysticks and tactile FINGERTRACKING devices.
+ *
+ * Commands added within one frame are sent together by DTrackSDK::sendFeedback(), using at most
+ * one datagram for tactile feedback ('tfb') and one for Flystick feedback ('ffb'). A newer command for
+ * the same finger or Flystick replaces an older one. Optionally a minimum interval between two commands
+ * for the same device (hand or Flystick) can be set; commands of a device are kept back until its
+ * interval is over.
+ *
+ * Uses fixed-size storage only, so no memory is allocated while adding and sending commands.
+ */
+class DTrackFeedbackBatch
+{
+public:
+
+	static const int MAX_TACTILE = 64;   //!< Maximum number of fingers with pending tactile feedback
+	static const int MAX_FLYSTICK = 16;  //!< Maximum number of Flysticks with pending feedback
+	static const int MAX_DEVICES = 32;   //!< Maximum number of devices (hands, Flysticks) to check rate limits
+	static const int MAX_COMMANDLEN = 16 + MAX_TACTILE * 64;  //!< Buffer length for a command containing all entries
+
+	/**
+	 * \brief Constructor.
+	 *
+	 * @param[in] minInterval Minimum interval between two commands for the same device in s; 0 if not limited
+	 */
+	DTrackFeedbackBatch( double minInterval = 0.0 );
+
+	/**
+	 * \brief Set minimum interval between two commands for the same device.
+	 *
+	 * @param[in] minInterval Minimum interval in s; 0 if not limited
+	 */
+	void setMinInterval( double minInterval );
+
+	/**
+	 * \brief Remove all pending commands.
+	 *
+	 * Keeps the times of last commands per device.
+	 */
+	void clear();
+
+	/**
+	 * \brief Returns if no commands are pending.
+	 *
+	 * @return No commands pending?
+	 */
+	bool isEmpty() const;
+
+	/**
+	 * \brief Add tactile feedback on a specific finger of a specific hand.
+	 *
+	 * @param[in] handId   Hand id, range 0 ..
+	 * @param[in] fingerId Finger id, range 0 ..
+	 * @param[in] strength Strength of feedback, between 0.0 and 1.0
+	 * @return             Success? (fails if strength is out of range or too many fingers are pending)
+	 */
+	bool tactileFinger( int handId, int fingerId, double strength );
+
+	/**
+	 * \brief Add tactile feedback on all fingers of a specific hand.
+	 *
+	 * @param[in] handId    Hand id, range 0 ..
+	 * @param[in] strength  Strength of feedback on all fingers, between 0.0 and 1.0
+	 * @param[in] numFinger Number of fingers
+	 * @return              Success? (fails if a strength is out of range or too many fingers are pending)
+	 */
+	bool tactileHand( int handId, const double* strength, int numFinger );
+
+	/**
+	 * \brief Add turning off tactile feedback on all fingers of a specific hand.
+	 *
+	 * @param[in] handId    Hand id, range 0 ..
+	 * @param[in] numFinger Number of fingers
+	 * @return              Success? (fails if too many fingers are pending)
+	 */
+	bool tactileHandOff( int handId, int numFinger );
+
+	/**
+	 * \brief Add beep on a specific Flystick.
+	 *
+	 * @param[in] flystickId  Flystick id, range 0 ..
+	 * @param[in] durationMs  Time duration of the beep (in milliseconds)
+	 * @param[in] frequencyHz Frequency of the beep (in Hertz)
+	 * @return                Success? (fails if too many Flysticks are pending)
+	 */
+	bool flystickBeep( int flystickId, double durationMs, double frequencyHz );
+
+	/**
+	 * \brief Add vibration pattern on a specific Flystick.
+	 *
+	 * @param[in] flystickId       Flystick id, range 0 ..
+	 * @param[in] vibrationPattern Vibration pattern id, range 1 ..
+	 * @return                     Success? (fails if too many Flysticks are pending)
+	 */
+	bool flystickVibration( int flystickId, int vibrationPattern );
+
+	/**
+	 * \brief Get pending tactile commands of all devices, that may be sent now.
+	 *
+	 * The commands stay pending until commitTactileCommand() is called, i.e. after sending succeeded.
+	 * Numbers are written independent of the actual locale.
+	 *
+	 * @param[out] buffer Buffer for command string, terminated by '\0'
+	 * @param[in]  maxLen Length of buffer in bytes
+	 * @param[in]  now    Actual time in s (clock of DTrackSys::time_monotonic())
+	 * @return            Length of command string; 0 if nothing to send
+	 */
+	int prepareTactileCommand( char* buffer, int maxLen, double now );
+
+	/**
+	 * \brief Remove tactile commands got by last call of prepareTactileCommand(), as they were sent.
+	 *
+	 * @param[in] now Actual time in s, as passed to prepareTactileCommand()
+	 */
+	void commitTactileCommand( double now );
+
+	/**
+	 * \brief Get pending Flystick commands of all devices, that may be sent now.
+	 *
+	 * The commands stay pending until commitFlystickCommand() is called, i.e. after sending succeeded.
+	 *
+	 * @param[out] buffer Buffer for command string, terminated by '\0'
+	 * @param[in]  maxLen Length of buffer in bytes
+	 * @param[in]  now    Actual time in s (clock of DTrackSys::time_monotonic())
+	 * @return            Length of command string; 0 if nothing to send
+	 */
+	int prepareFlystickCommand( char* buffer, int maxLen, double now );
+
+	/**
+	 * \brief Remove Flystick commands got by last call of prepareFlystickCommand(), as they were sent.
+	 *
+	 * @param[in] now Actual time in s, as passed to prepareFlystickCommand()
+	 */
+	void commitFlystickCommand( double now );
+
+private:
+
+	//! Device types for rate limits
+	enum { DEVICE_HAND = 0, DEVICE_FLYSTICK };
+
+	//! Pending tactile feedback of one finger
+	struct TactileEntry
+	{
+		int handId;       //!< hand id
+		int fingerId;     //!< finger id
+		double strength;  //!< strength of feedback
+		bool prepared;    //!< part of the last prepared command
+	};
+
+	//! Pending feedback of one Flystick
+	struct FlystickEntry
+	{
+		int flystickId;   //!< Flystick id
+		int durationMs;   //!< duration of beep in ms (0 if no beep)
+		int frequencyHz;  //!< frequency of beep in Hz (0 if no beep)
+		int pattern;      //!< vibration pattern (0 if no vibration)
+		bool prepared;    //!< part of the last prepared command
+	};
+
+	//! Time of last command for one device
+	struct DeviceEntry
+	{
+		int type;         //!< device type
+		int id;           //!< device id
+		double lastSent;  //!< time of last command in s
+	};
+
+	bool isReady( int type, int id, double now ) const;
+	void setSent( int type, int id, double now );
+
+	double d_minInterval;                         //!< minimum interval per device in s
+
+	int d_numTactile;                             //!< number of pending tactile entries
+	TactileEntry d_tactile[ MAX_TACTILE ];        //!< pending tactile entries
+
+	int d_numFlystick;                            //!< number of pending Flystick entries
+	FlystickEntry d_flystick[ MAX_FLYSTICK ];     //!< pending Flystick entries
+
+	int d_numDevices;                             //!< number of devices with known time of last command
+	DeviceEntry d_devices[ MAX_DEVICES ];         //!< time of last command per device
+};
+
+#endif  // _ART_DTRACKSDK_FEEDBACK_HPP_
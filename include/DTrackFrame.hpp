@@ -0,0 +1,196 @@
+/* DTrackSDK in C++: DTrackFrame.hpp
+ *
+ * Snapshots of tracking data, for access by other threads.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_FRAME_HPP_
+#define _ART_DTRACKSDK_FRAME_HPP_
+
+#include "DTrackParser.hpp"
+
+/**
+ * \brief Snapshot of the tracking data of one frame.
+ *
+ * Provides the same methods to access tracking data as DTrackSDK.
+ */
+class DTrackFrame : public DTrackParser
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackFrame();
+
+	/**
+	 * \brief Destructor.
+	 */
+	virtual ~DTrackFrame();
+
+	/**
+	 * \brief Set tracking data of actual frame.
+	 *
+	 * Copies just the tracking data; doesn't allocate memory, if the frame was set before with
+	 * a similar amount of data.
+	 *
+	 * @param[in] parser Parser (e.g. DTrackSDK), containing tracking data of actual frame
+	 */
+	void setFrame( const DTrackParser& parser );
+
+	/**
+	 * \brief Set tracking data of actual frame from a binary image.
+	 *
+	 * Doesn't allocate memory, if the frame was set before with a similar amount of data.
+	 *
+	 * @param[in] image Binary image, see DTrackParser::writeFrameImage()
+	 * @param[in] len   Length of image in bytes
+	 * @return          Success? (fails for invalid images)
+	 */
+	bool setFrame( const char* image, int len );
+};
+
+
+/**
+ * \brief Lock-free triple buffer, to pass frame snapshots from one thread to another.
+ *
+ * Exactly one thread may publish frames, exactly one other thread may get them. Neither of
+ * them ever waits for the other one.
+ */
+class DTrackFrameBuffer
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackFrameBuffer();
+
+	/**
+	 * \brief Destructor.
+	 */
+	~DTrackFrameBuffer();
+
+	/**
+	 * \brief Publish tracking data of actual frame. Called by publishing thread.
+	 *
+	 * @param[in] parser Parser (e.g. DTrackSDK), containing tracking data of actual frame
+	 */
+	void publish( const DTrackParser& parser );
+
+	/**
+	 * \brief Get latest published frame. Called by reading thread.
+	 *
+	 * The returned frame doesn't change until the next call of this method.
+	 *
+	 * @return Latest published frame; NULL if no frame was published yet
+	 */
+	const DTrackFrame* acquireLatest();
+
+private:
+
+	DTrackFrameBuffer( const DTrackFrameBuffer& );             // not copyable
+	DTrackFrameBuffer& operator=( const DTrackFrameBuffer& );  // not copyable
+
+	static const int FLAG_NEW = 4;  //!< Flag in d_latest: frame not yet read
+
+	DTrackFrame d_frame[ 3 ];  //!< Frames
+
+	volatile int d_latest;     //!< Index of latest published frame, with flag FLAG_NEW
+	int d_write;               //!< Index of frame used by publishing thread
+	int d_read;                //!< Index of frame used by reading thread
+	bool d_isread;             //!< Reading thread got a published frame
+};
+
+
+/**
+ * \brief Lock-free queue (ring buffer) of frame snapshots, to pass all frames from one thread to another.
+ *
+ * Exactly one thread may add frames, exactly one other thread may remove them. Neither of them
+ * ever waits for the other one; if the queue is full, new frames are dropped.
+ */
+class DTrackFrameQueue
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 *
+	 * @param[in] size Maximum number of frames in queue
+	 */
+	DTrackFrameQueue( int size );
+
+	/**
+	 * \brief Destructor.
+	 */
+	~DTrackFrameQueue();
+
+	/**
+	 * \brief Add tracking data of actual frame to queue. Called by adding thread.
+	 *
+	 * @param[in] parser Parser (e.g. DTrackSDK), containing tracking data of actual frame
+	 * @return           Success? (fails if queue is full)
+	 */
+	bool push( const DTrackParser& parser );
+
+	/**
+	 * \brief Get oldest frame in queue. Called by removing thread.
+	 *
+	 * The frame stays valid until pop() is called.
+	 *
+	 * @return Oldest frame; NULL if queue is empty
+	 */
+	const DTrackFrame* front() const;
+
+	/**
+	 * \brief Remove oldest frame from queue. Called by removing thread.
+	 */
+	void pop();
+
+	/**
+	 * \brief Get number of frames dropped by push(), as the queue was full.
+	 *
+	 * @return Number of dropped frames
+	 */
+	int getNumDropped() const;
+
+private:
+
+	DTrackFrameQueue( const DTrackFrameQueue& );             // not copyable
+	DTrackFrameQueue& operator=( const DTrackFrameQueue& );  // not copyable
+
+	int d_size;                //!< Number of entries in d_frame (one more than maximum number of frames)
+	DTrackFrame* d_frame;      //!< Frames
+
+	volatile int d_head;       //!< Index of next frame to be added; written by adding thread
+	volatile int d_tail;       //!< Index of oldest frame; written by removing thread
+	volatile int d_numdropped; //!< Number of dropped frames
+};
+
+
+#endif  // _ART_DTRACKSDK_FRAME_HPP_
+
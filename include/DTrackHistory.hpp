@@ -0,0 +1,215 @@
+/* DTrackSDK in C++: DTrackHistory.hpp
+ *
+ * History of poses, with queries for arbitrary points in time.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_HISTORY_HPP_
+#define _ART_DTRACKSDK_HISTORY_HPP_
+
+#include "DTrackParser.hpp"
+
+#include <vector>
+
+/**
+ * \brief History of poses, with queries for arbitrary points in time.
+ *
+ * Keeps the poses of the latest frames in ring buffers of fixed capacity, one per standard body,
+ * Flystick, Measurement Tool, Fingertracking hand (back of the hand) and joint of an ART-Human model.
+ * Memory for a ring buffer is allocated once, when the target appears for the first time; afterwards
+ * adding a frame doesn't allocate memory. Capacities can be set per type of target, so e.g. a short
+ * history of ART-Human models keeps memory use bounded.
+ *
+ * Not thread-safe.
+ */
+class DTrackHistory
+{
+public:
+
+	/**
+	 * \brief Types of targets.
+	 */
+	enum TargetType
+	{
+		TARGET_BODY = 0,  //!< Standard body
+		TARGET_FLYSTICK,  //!< Flystick
+		TARGET_MEATOOL,   //!< Measurement Tool
+		TARGET_HAND,      //!< Fingertracking hand
+		TARGET_HUMAN,     //!< Joint of an ART-Human model
+		NUM_TARGETTYPES   //!< Number of types
+	};
+
+	/**
+	 * \brief Clocks used for the time of a frame.
+	 */
+	enum TimeSource
+	{
+		TIME_ARRIVAL = 0,  //!< Local arrival time (clock of DTrackSys::time_monotonic())
+		TIME_CONTROLLER    //!< Time of exposure in Controller ('ts2' timestamp; 'ts' timestamp or arrival time if not available)
+	};
+
+	/**
+	 * \brief Pose of a target at one point in time.
+	 */
+	struct Sample
+	{
+		double time;            //!< Time of frame in s
+		double quality;         //!< Quality (no tracking if -1.0)
+		double loc[ 3 ];        //!< Location (in [mm])
+		DTrackQuaternion quat;  //!< Rotation as quaternion
+
+		/**
+		 * \brief Returns if target is tracked.
+		 *
+		 * @return Is tracked?
+		 */
+		bool isTracked() const
+		{ return ( quality >= 0.0 ); }
+	};
+
+	/**
+	 * \brief Constructor.
+	 *
+	 * @param[in] capacity Number of frames kept per target, for all types of targets
+	 */
+	DTrackHistory( int capacity = 120 );
+
+	/**
+	 * \brief Set number of frames kept per target, for one type of targets.
+	 *
+	 * Removes the history of this type.
+	 *
+	 * @param[in] type     Type of targets
+	 * @param[in] capacity Number of frames; 0 disables the history of this type
+	 */
+	void setCapacity( TargetType type, int capacity );
+
+	/**
+	 * \brief Get number of frames kept per target.
+	 *
+	 * @param[in] type Type of targets
+	 * @return         Number of frames
+	 */
+	int getCapacity( TargetType type ) const;
+
+	/**
+	 * \brief Set clock used for the time of a frame.
+	 *
+	 * Removes the complete history.
+	 *
+	 * @param[in] source Clock; default TIME_ARRIVAL
+	 */
+	void setTimeSource( TimeSource source );
+
+	/**
+	 * \brief Remove the complete history.
+	 */
+	void clear();
+
+	/**
+	 * \brief Add poses of a frame.
+	 *
+	 * Appends one sample to each known target of a type; targets missing in the frame get a sample
+	 * without tracking. Frames not newer than the last one are ignored.
+	 *
+	 * @param[in] frame Frame (e.g. DTrackSDK, DTrackFrame)
+	 * @return          Frame was added?
+	 */
+	bool addFrame( const DTrackParser& frame );
+
+	/**
+	 * \brief Get time of a frame, using the clock set by setTimeSource().
+	 *
+	 * @param[in] frame Frame
+	 * @return          Time in s
+	 */
+	double getFrameTime( const DTrackParser& frame ) const;
+
+	/**
+	 * \brief Get number of samples of a target.
+	 *
+	 * @param[in] type  Type of target
+	 * @param[in] id    Id of target, range 0 ..
+	 * @param[in] joint Id of joint, range 0 .. (just for TARGET_HUMAN)
+	 * @return          Number of samples
+	 */
+	int getNumSamples( TargetType type, int id, int joint = 0 ) const;
+
+	/**
+	 * \brief Get one sample of a target.
+	 *
+	 * @param[in]  type   Type of target
+	 * @param[in]  id     Id of target, range 0 ..
+	 * @param[in]  index  Index of sample, range 0 .. getNumSamples() - 1 (0 is the newest one)
+	 * @param[out] sample Sample
+	 * @param[in]  joint  Id of joint, range 0 .. (just for TARGET_HUMAN)
+	 * @return            Sample available?
+	 */
+	bool getSample( TargetType type, int id, int index, Sample& sample, int joint = 0 ) const;
+
+	/**
+	 * \brief Get pose of a target at a point in time, interpolating between neighbouring frames.
+	 *
+	 * Locations are interpolated linearly, rotations by slerp. Fails, if the time is outside of the
+	 * history or if the target isn't tracked in one of the neighbouring frames.
+	 *
+	 * @param[in]  type   Type of target
+	 * @param[in]  id     Id of target, range 0 ..
+	 * @param[in]  time   Time in s, using the clock set by setTimeSource()
+	 * @param[out] sample Interpolated pose
+	 * @param[in]  joint  Id of joint, range 0 .. (just for TARGET_HUMAN)
+	 * @return            Pose available?
+	 */
+	bool sampleAt( TargetType type, int id, double time, Sample& sample, int joint = 0 ) const;
+
+private:
+
+	//! Ring buffer of one target
+	struct Ring
+	{
+		int head;                      //!< index of newest sample
+		int num;                       //!< number of valid samples
+		std::vector< Sample > sample;  //!< samples (empty if target didn't appear yet)
+	};
+
+	const Ring* getRing( TargetType type, int id, int joint ) const;
+	const Sample& at( const Ring& ring, int index ) const;
+
+	void beginType( TargetType type, int num );
+	void add( TargetType type, int index, double quality, const double* loc, const double* rot );
+	void endType( TargetType type );
+
+	TimeSource d_timeSource;  //!< clock used for the time of a frame
+	bool d_hasFrame;          //!< frame available
+	double d_lastTime;        //!< time of latest frame in s
+
+	int d_capacity[ NUM_TARGETTYPES ];              //!< number of frames kept per target
+	std::vector< Ring > d_ring[ NUM_TARGETTYPES ];  //!< ring buffers, by type and id (ART-Human: by id and joint)
+	std::vector< char > d_added;                    //!< targets with sample in current frame (temporary)
+};
+
+#endif  // _ART_DTRACKSDK_HISTORY_HPP_
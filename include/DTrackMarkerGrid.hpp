@@ -0,0 +1,139 @@
+/* DTrackSDK in C++: DTrackMarkerGrid.hpp
+ *
+ * Spatial grid of single markers, for nearest neighbour queries.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_MARKERGRID_HPP_
+#define _ART_DTRACKSDK_MARKERGRID_HPP_
+
+#include "DTrackParser.hpp"
+
+#include <vector>
+
+/**
+ * \brief Spatial grid of single markers, for nearest neighbour queries.
+ *
+ * Keeps a copy of the single markers of one frame, sorted into a uniform grid of cubic cells (hashed,
+ * so there is no limit of the tracking volume). Queries just look at the cells around the query
+ * location. E.g. to find correspondences between frames, update the grid with one frame and query
+ * it with the marker locations of the next frame.
+ *
+ * The cell size should be about the same as the search radius of the queries.
+ */
+class DTrackMarkerGrid
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 *
+	 * @param[in] cellSize Edge length of grid cells (in [mm])
+	 */
+	DTrackMarkerGrid( double cellSize = 50.0 );
+
+	/**
+	 * \brief Destructor.
+	 */
+	~DTrackMarkerGrid();
+
+	/**
+	 * \brief Set edge length of grid cells. Used by next update().
+	 *
+	 * @param[in] cellSize Edge length of grid cells (in [mm])
+	 */
+	void setCellSize( double cellSize );
+
+	/**
+	 * \brief Get edge length of grid cells.
+	 *
+	 * @return Edge length of grid cells (in [mm])
+	 */
+	double getCellSize() const;
+
+	/**
+	 * \brief Set single markers of actual frame.
+	 *
+	 * Doesn't allocate memory, if the grid was updated before with a similar number of markers.
+	 *
+	 * @param[in] parser Parser (e.g. DTrackSDK), containing tracking data of actual frame
+	 */
+	void update( const DTrackParser& parser );
+
+	/**
+	 * \brief Get number of single markers in grid.
+	 *
+	 * @return Number of single markers
+	 */
+	int getNumMarker() const;
+
+	/**
+	 * \brief Get single marker data in grid.
+	 *
+	 * @param[in] index Index, range 0 .. getNumMarker() - 1 (same as index of DTrackParser::getMarker())
+	 * @return          Single marker data; NULL in case of error
+	 */
+	const DTrackMarker* getMarker( int index ) const;
+
+	/**
+	 * \brief Find nearest single marker.
+	 *
+	 * @param[in]  loc         Location (in [mm])
+	 * @param[in]  maxDistance Maximum distance (in [mm])
+	 * @param[out] distance    Distance of found marker (in [mm]; optional)
+	 * @return                 Index of nearest marker; -1 if no marker is within maximum distance
+	 */
+	int findNearest( const double loc[ 3 ], double maxDistance, double* distance = NULL ) const;
+
+	/**
+	 * \brief Find all single markers within a radius.
+	 *
+	 * @param[in]  loc     Location (in [mm])
+	 * @param[in]  radius  Radius (in [mm])
+	 * @param[out] indices Indices of found markers (unordered)
+	 * @return             Number of found markers
+	 */
+	int findInRadius( const double loc[ 3 ], double radius, std::vector< int >& indices ) const;
+
+private:
+
+	template< class Visitor >
+	void visit( const double loc[ 3 ], double radius, Visitor& visitor ) const;
+
+	void getCell( const double loc[ 3 ], int cell[ 3 ] ) const;
+	unsigned int getBucket( const int cell[ 3 ] ) const;
+
+	double d_cellsize;                     //!< Edge length of grid cells, for next update
+	double d_gridcellsize;                 //!< Edge length of grid cells, of actual grid
+	std::vector< DTrackMarker > d_marker;  //!< Single markers
+	std::vector< int > d_bucketstart;      //!< Index of first entry in d_entries of each bucket (one more than number of buckets)
+	std::vector< int > d_entries;          //!< Indices of markers, sorted by bucket
+	std::vector< unsigned int > d_bucket;  //!< Bucket of each marker
+	unsigned int d_mask;                   //!< Mask of bucket numbers
+};
+
+#endif  // _ART_DTRACKSDK_MARKERGRID_HPP_
@@ -0,0 +1,141 @@
+/* DTrackSDK in C++: DTrackMessagePoller.hpp
+ *
+ * Background polling of DTrack2/DTRACK3 event messages.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_MESSAGEPOLLER_HPP_
+#define _ART_DTRACKSDK_MESSAGEPOLLER_HPP_
+
+#include "DTrackDataTypes.hpp"
+#include "DTrackNet.hpp"
+#include "DTrackSys.hpp"
+
+#include <string>
+
+using namespace DTrackSDK_Datatypes;
+
+/**
+ * \brief Background polling of DTrack2/DTRACK3 event messages.
+ *
+ * A thread regularly fetches all event messages from the Controller and passes them through a
+ * lock-free queue (ring buffer) to exactly one other thread. The thread uses its own TCP connection,
+ * so commands of DTrackSDK are never delayed by polling. If the queue is full, new messages are
+ * dropped. A broken connection is established again at the next polling.
+ *
+ * Usually created by DTrackSDK::startMessagePoller().
+ */
+class DTrackMessagePoller
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 *
+	 * @param[in] remoteIp   IP address of Controller
+	 * @param[in] intervalUs Polling interval in us (micro seconds)
+	 * @param[in] queueSize  Maximum number of messages in queue
+	 * @param[in] timeoutUs  Timeout for answers of the Controller in us
+	 */
+	DTrackMessagePoller( unsigned int remoteIp, int intervalUs, int queueSize, int timeoutUs );
+
+	/**
+	 * \brief Destructor. Stops polling thread.
+	 */
+	~DTrackMessagePoller();
+
+	/**
+	 * \brief Start polling thread.
+	 *
+	 * @return Success?
+	 */
+	bool start();
+
+	/**
+	 * \brief Stop polling thread.
+	 */
+	void stop();
+
+	/**
+	 * \brief Returns if polling thread is running.
+	 *
+	 * @return Running?
+	 */
+	bool isRunning() const;
+
+	/**
+	 * \brief Returns if polling thread has a TCP connection to the Controller.
+	 *
+	 * @return Connected?
+	 */
+	bool isConnected() const;
+
+	/**
+	 * \brief Get and remove oldest message in queue. Called by removing thread.
+	 *
+	 * @param[out] message Message
+	 * @return             Message available?
+	 */
+	bool pop( DTrackMessage& message );
+
+	/**
+	 * \brief Get number of messages dropped, as the queue was full.
+	 *
+	 * @return Number of dropped messages
+	 */
+	int getNumDropped() const;
+
+private:
+
+	DTrackMessagePoller( const DTrackMessagePoller& );             // not copyable
+	DTrackMessagePoller& operator=( const DTrackMessagePoller& );  // not copyable
+
+	static void pollThread( void* arg );
+	void pollLoop();
+	bool pollMessages();
+	int request( const std::string& command, std::string& answer );
+
+	unsigned int d_remoteIp;      //!< IP address of Controller
+	int d_intervalUs;             //!< polling interval in us
+	int d_timeoutUs;              //!< timeout for answers of the Controller in us
+
+	DTrackNet::TCP* d_tcp;        //!< TCP connection of polling thread (NULL if not connected)
+	std::string d_tcpbuf;         //!< received TCP data following the last answer
+
+	DTrackSys::Thread* d_thread;  //!< polling thread (NULL if not running)
+	volatile int d_stop;          //!< polling thread: request to stop
+	volatile int d_connected;     //!< polling thread: has TCP connection
+
+	int d_size;                   //!< Number of entries in d_queue (one more than maximum number of messages)
+	DTrackMessage* d_queue;       //!< Messages
+
+	volatile int d_head;          //!< Index of next message to be added; written by polling thread
+	volatile int d_tail;          //!< Index of oldest message; written by removing thread
+	volatile int d_numdropped;    //!< Number of dropped messages
+};
+
+#endif  // _ART_DTRACKSDK_MESSAGEPOLLER_HPP_
@@ -0,0 +1,130 @@
+/* DTrackSDK in C++: DTrackMultiReceiver.hpp
+ *
+ * Receiving tracking data of several sources within one thread.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_MULTIRECEIVER_HPP_
+#define _ART_DTRACKSDK_MULTIRECEIVER_HPP_
+
+#include "DTrackSDK.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * \brief Receiving tracking data of several sources within one thread.
+ *
+ * Each source (e.g. one Controller, data port or multicast group) is handled by its own DTrackSDK
+ * instance, containing the parser state of that source. One call of receive() waits for data on all
+ * sources at once (epoll on Linux) and processes the latest frame of each source with new data.
+ */
+class DTrackMultiReceiver
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackMultiReceiver();
+
+	/**
+	 * \brief Destructor. Deletes all sources created by addSource( const std::string& ).
+	 */
+	~DTrackMultiReceiver();
+
+	/**
+	 * \brief Add a new source.
+	 *
+	 * Creates a DTrackSDK instance, see DTrackSDK::DTrackSDK( const std::string& ).
+	 *
+	 * @param[in] connection Connection string, e.g. "5000" or "224.0.1.0:5000"
+	 * @return               Index of source; -1 if failed
+	 */
+	int addSource( const std::string& connection );
+
+	/**
+	 * \brief Add an existing DTrackSDK instance as source.
+	 *
+	 * The instance isn't deleted by this class and has to stay valid as long as it's used here. Don't
+	 * call its receive methods while it's used here.
+	 *
+	 * @param[in] sdk DTrackSDK instance with valid data interface
+	 * @return        Index of source; -1 if failed
+	 */
+	int addSource( DTrackSDK* sdk );
+
+	/**
+	 * \brief Get number of sources.
+	 *
+	 * @return Number of sources
+	 */
+	int getNumSources() const;
+
+	/**
+	 * \brief Get DTrackSDK instance of one source, e.g. to access its tracking data.
+	 *
+	 * @param[in] index Index of source, range 0 .. getNumSources() - 1
+	 * @return          DTrackSDK instance; NULL if not available
+	 */
+	DTrackSDK* getSource( int index ) const;
+
+	/**
+	 * \brief Receive and process tracking data of all sources.
+	 *
+	 * Waits until data of at least one source becomes available, but no longer than the timeout. Then
+	 * processes the latest frame of each source with new data. Errors of single sources are available
+	 * by their getLastDataError().
+	 *
+	 * @param[in] timeoutUs Timeout in us (micro seconds)
+	 * @return              Number of sources with a new frame (0 also if timeout); -1 if waiting failed
+	 */
+	int receive( int timeoutUs );
+
+	/**
+	 * \brief Get source of one frame processed by last call of receive().
+	 *
+	 * @param[in] index Index of frame, range 0 .. ( return value of receive() ) - 1
+	 * @return          Index of source; -1 if not available
+	 */
+	int getReceivedSource( int index ) const;
+
+private:
+
+	DTrackMultiReceiver( const DTrackMultiReceiver& );             // not copyable
+	DTrackMultiReceiver& operator=( const DTrackMultiReceiver& );  // not copyable
+
+	int addSource( DTrackSDK* sdk, bool isOwner );
+
+	DTrackNet::UDPPoller d_poller;       //!< Waiting for data of all sources
+	std::vector< DTrackSDK* > d_sources; //!< Sources
+	std::vector< char > d_owned;         //!< Source was created by this class
+	std::vector< int > d_ready;          //!< Sources with available data
+	std::vector< int > d_received;       //!< Sources with a new frame by last receive()
+};
+
+#endif  // _ART_DTRACKSDK_MULTIRECEIVER_HPP_
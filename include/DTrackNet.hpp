@@ -34,9 +34,13 @@
 #ifndef _ART_DTRACKNET_H_
 #define _ART_DTRACKNET_H_
 
+#include <cstddef>
+
 namespace DTrackNet {
 
 struct _ip_socket_struct;  // forward declaration
+struct _ip_batch_struct;   // forward declaration
+struct _ip_poll_struct;    // forward declaration
 
 /**
  * \brief Initialize network ressources.
@@ -57,6 +61,16 @@ void net_exit(void);
  */
 unsigned int ip_name2ip(const char* name);
 
+/**
+ * \brief Convert string to IP address, without resolving hostnames.
+ *
+ * Never waits for a name server, unlike ip_name2ip().
+ *
+ * @param[in] str Ipv4 dotted decimal address
+ * @return        IP address, 0 if error occured (e.g. a hostname)
+ */
+unsigned int ip_str2ip( const char* str );
+
 
 /**
  * \brief Handling UDP data.
@@ -99,17 +113,93 @@ public:
 	 */
 	unsigned int getRemoteIp();
 
+	/**
+	 * \brief Get number of packets discarded by latest receive().
+	 *
+	 * @return Number of packets, that were received but replaced by a newer one
+	 */
+	int getNumDiscarded();
+
+	/**
+	 * \brief Get size of largest packet, that didn't fit into the buffer of latest receive() or receiveBatch().
+	 *
+	 * Actual size of the packet is just available on Linux; otherwise it's the usable buffer length.
+	 *
+	 * @return Size in bytes, 0 if no packet was truncated
+	 */
+	int getTruncatedSize();
+
+	/**
+	 * \brief Get number of packets dropped by the kernel, as the receive buffer of the socket was full.
+	 *
+	 * Just supported on Linux (SO_RXQ_OVFL), updated with each received packet. Wraps around after 2^32 packets.
+	 *
+	 * @return Number of packets since opening the socket; 0 if not supported
+	 */
+	unsigned int getNumKernelDropped();
+
+	/**
+	 * \brief Set size of the kernel receive buffer of the socket (SO_RCVBUF).
+	 *
+	 * The system might limit the size (e.g. net.core.rmem_max on Linux), unless the process has according
+	 * privileges.
+	 *
+	 * @param[in] size Size in bytes
+	 * @return         Success?
+	 */
+	bool setReceiveBufferSize( int size );
+
+	/**
+	 * \brief Get size of the kernel receive buffer of the socket.
+	 *
+	 * @return Size in bytes as reported by the system (Linux reports twice the set size), -1 if error occured
+	 */
+	int getReceiveBufferSize();
+
+	/**
+	 * \brief Set busy polling of the socket (SO_BUSY_POLL).
+	 *
+	 * While waiting for data, the kernel polls the network device for this time, reducing latency at the
+	 * expense of CPU usage. Just supported on Linux.
+	 *
+	 * @param[in] us Busy polling time in us (micro seconds); 0 to disable
+	 * @return       Success?
+	 */
+	bool setBusyPoll( int us );
+
 	/**
 	 * \brief Receive UDP data.
 	 *
 	 * Tries to receive one packet, as long as data is available.
 	 *
-	 * @param[out] buffer Buffer for UDP data
-	 * @param[in]  maxLen Length of buffer
-	 * @param[in]  toutUs Timeout in us (micro seconds)
-	 * @return            Number of received bytes, <0 if error/timeout occured
+	 * Arrival time refers to the clock of DTrackSys::time_monotonic(). It is taken from the kernel
+	 * receive timestamp, if supported (SO_TIMESTAMPNS or SO_TIMESTAMP); otherwise it is the time,
+	 * when the packet was fetched from the socket.
+	 *
+	 * @param[out] buffer      Buffer for UDP data
+	 * @param[in]  maxLen      Length of buffer
+	 * @param[in]  toutUs      Timeout in us (micro seconds)
+	 * @param[out] arrivalTime Arrival time of received packet in s (optional)
+	 * @return                 Number of received bytes, <0 if error/timeout occured
 	 */
-	int receive( void *buffer, int maxLen, int toutUs );
+	int receive( void *buffer, int maxLen, int toutUs, double* arrivalTime = NULL );
+
+	/**
+	 * \brief Receive all pending UDP data.
+	 *
+	 * Waits for one packet, then fetches all further packets already waiting in the socket without
+	 * discarding any of them (using one syscall on Linux). Each packet is stored in its own slot and
+	 * terminated by '\0', so at most slotSize - 1 bytes of each packet are received.
+	 *
+	 * @param[out] buffer   Buffer for UDP data, consisting of maxNum slots of slotSize bytes
+	 * @param[in]  slotSize Size of one slot in bytes
+	 * @param[in]  maxNum   Number of slots, i.e. maximum number of packets to receive
+	 * @param[out] len      Array (maxNum entries) for number of received bytes per slot, -4 if buffer overflow
+	 * @param[in]  toutUs   Timeout in us (micro seconds)
+	 * @param[out] arrivalTime Array (maxNum entries) for arrival time per slot in s, see receive() (optional)
+	 * @return              Number of received packets, <0 if error/timeout occured
+	 */
+	int receiveBatch( void* buffer, int slotSize, int maxNum, int* len, int toutUs, double* arrivalTime = NULL );
 
 	/**
  	* \brief Send UDP data.
@@ -123,13 +213,83 @@ public:
  	*/
 	int send( const void* buffer, int len, unsigned int ip, unsigned short port, int toutUs );
 
+	/**
+	 * \brief Set time-to-live of sent multicast packets.
+	 *
+	 * @param[in] ttl Time-to-live (number of routers to pass; default 1)
+	 * @return        Success?
+	 */
+	bool setMulticastTTL( int ttl );
+
 private:
 
+	friend class UDPPoller;
+
 	bool m_isValid;
 	struct _ip_socket_struct* m_socket;
+	struct _ip_batch_struct* m_batch;
 	unsigned short m_port;
 	unsigned int m_multicastIp;
 	unsigned int m_remoteIp;
+	int m_numDiscarded;
+	int m_truncatedSize;
+};
+
+
+/**
+ * \brief Waiting for data on several UDP sockets at once.
+ *
+ * Uses epoll on Linux, poll on other Unix systems and WSAPoll on Windows.
+ */
+class UDPPoller
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	UDPPoller();
+
+	/**
+	 * \brief Destructor.
+	 */
+	~UDPPoller();
+
+	/**
+	 * \brief Add a UDP socket.
+	 *
+	 * The socket has to stay valid as long as it's used by the poller.
+	 *
+	 * @param[in] udp UDP socket
+	 * @param[in] id  Identifier of socket, returned by wait()
+	 * @return        Success?
+	 */
+	bool add( UDP* udp, int id );
+
+	/**
+	 * \brief Remove a UDP socket.
+	 *
+	 * @param[in] udp UDP socket
+	 * @return        Success?
+	 */
+	bool remove( UDP* udp );
+
+	/**
+	 * \brief Wait until data is available on at least one socket.
+	 *
+	 * @param[in]  toutUs Timeout in us (micro seconds); rounded up to milliseconds
+	 * @param[out] ids    Array (maxNum entries) for identifiers of sockets with available data
+	 * @param[in]  maxNum Maximum number of identifiers
+	 * @return            Number of sockets with available data, 0 if timeout, <0 if error occured
+	 */
+	int wait( int toutUs, int* ids, int maxNum );
+
+private:
+
+	UDPPoller( const UDPPoller& );             // not copyable
+	UDPPoller& operator=( const UDPPoller& );  // not copyable
+
+	struct _ip_poll_struct* m_poll;
 };
 
 
@@ -148,6 +308,15 @@ public:
 	 */
 	TCP( unsigned int ip, unsigned short port );
 
+	/**
+	 * \brief Initialize client TCP socket, with timeout for establishing the connection.
+	 *
+	 * @param[in] ip     IP address of TCP server
+	 * @param[in] port   Port number of TCP server
+	 * @param[in] toutUs Timeout in us (micro seconds)
+	 */
+	TCP( unsigned int ip, unsigned short port, int toutUs );
+
 	/**
 	 * \brief Deinitialize TCP socket.
 	 */
@@ -180,6 +349,8 @@ public:
 
 private:
 
+	void connectServer( unsigned int ip, unsigned short port, int toutUs );
+
 	bool m_isValid;
 	struct _ip_socket_struct* m_socket;
 };
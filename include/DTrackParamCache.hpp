@@ -0,0 +1,152 @@
+/* DTrackSDK in C++: DTrackParamCache.hpp
+ *
+ * Client-side cache of DTrack2/DTRACK3 parameters.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_PARAMCACHE_HPP_
+#define _ART_DTRACKSDK_PARAMCACHE_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+
+/**
+ * \brief Client-side cache of DTrack2/DTRACK3 parameters.
+ *
+ * Keeps parameter values together with an expiration time, so repeated reads don't need a TCP round
+ * trip. Parameters are identified by category and name (e.g. "system access"); white spaces and
+ * leading zeros of numbers are ignored like in answers of the Controller. Each entry has its own TTL
+ * (time to live); a TTL of 0 means the entry never expires.
+ *
+ * Not thread-safe; like all DTrack2/DTRACK3 commands it should be used by one thread only.
+ */
+class DTrackParamCache
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 *
+	 * @param[in] defaultTtl TTL of new entries in s; 0 if entries never expire
+	 */
+	DTrackParamCache( double defaultTtl = 0.0 );
+
+	/**
+	 * \brief Set TTL of new entries.
+	 *
+	 * @param[in] ttl TTL in s; 0 if entries never expire
+	 */
+	void setDefaultTtl( double ttl );
+
+	/**
+	 * \brief Get TTL of new entries.
+	 *
+	 * @return TTL in s; 0 if entries never expire
+	 */
+	double getDefaultTtl() const;
+
+	/**
+	 * \brief Get cached value of a parameter.
+	 *
+	 * @param[in]  parameter Parameter string containing category and name
+	 * @param[out] value     Parameter value
+	 * @return               Valid entry available?
+	 */
+	bool get( const std::string& parameter, std::string& value ) const;
+
+	/**
+	 * \brief Store value of a parameter.
+	 *
+	 * @param[in] parameter Parameter string containing category and name
+	 * @param[in] value     Parameter value
+	 * @param[in] ttl       TTL of entry in s (0 if never expiring); <0 to keep TTL of an existing entry, or
+	 *                      to use the default TTL for a new entry
+	 */
+	void set( const std::string& parameter, const std::string& value, double ttl = -1.0 );
+
+	/**
+	 * \brief Remove entry of a parameter.
+	 *
+	 * @param[in] parameter Parameter string containing category and name
+	 */
+	void invalidate( const std::string& parameter );
+
+	/**
+	 * \brief Remove entries changed by a 'dtrack2 set' command.
+	 *
+	 * @param[in] parameter Complete parameter string of command, containing category, name and new value
+	 */
+	void invalidateBySet( const std::string& parameter );
+
+	/**
+	 * \brief Remove all entries.
+	 */
+	void clear();
+
+	/**
+	 * \brief Remove all expired entries.
+	 */
+	void removeExpired();
+
+	/**
+	 * \brief Get number of entries.
+	 *
+	 * Might include expired entries.
+	 *
+	 * @return Number of entries
+	 */
+	int getNumEntries() const;
+
+	/**
+	 * \brief Get all valid entries, sorted by parameter.
+	 *
+	 * @param[out] parameters Parameter strings (normalized)
+	 * @param[out] values     Corresponding parameter values
+	 */
+	void getEntries( std::vector< std::string >& parameters, std::vector< std::string >& values ) const;
+
+private:
+
+	//! Cached parameter value
+	struct Entry
+	{
+		std::string value;  //!< parameter value
+		double ttl;         //!< TTL in s; 0 if never expiring
+		double expire;      //!< expiration time in s (clock of DTrackSys::time_monotonic())
+	};
+
+	typedef std::map< std::string, Entry > EntryMap;
+
+	static std::string normalize( const std::string& parameter );
+	static bool isValid( const Entry& entry, double now );
+
+	EntryMap d_entries;  //!< cached parameter values, by normalized parameter string
+	double d_defaultTtl; //!< TTL of new entries in s
+};
+
+#endif  // _ART_DTRACKSDK_PARAMCACHE_HPP_
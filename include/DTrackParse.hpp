@@ -43,7 +43,7 @@ namespace DTrackSDK_Parse
  *	@param[in] 	len		buffer length in bytes
  *	@return		begin of line, NULL if no new line in buffer
  */
-char* string_nextline(char* str, char* start, int len);
+const char* string_nextline(const char* str, const char* start, int len);
 
 /**
  * 	\brief	Read next 'int' value from string
@@ -52,7 +52,7 @@ char* string_nextline(char* str, char* start, int len);
  *	@param[out] i		read value
  *	@return		pointer behind read value in str; NULL in case of error
  */
-char* string_get_i(char* str, int* i);
+const char* string_get_i(const char* str, int* i);
 
 /**
  * 	\brief	Read next 'unsigned int' value from string
@@ -61,7 +61,7 @@ char* string_get_i(char* str, int* i);
  *	@param[out]	ui		read value
  *	@return		pointer behind read value in str; NULL in case of error
  */
-char* string_get_ui(char* str, unsigned int* ui);
+const char* string_get_ui(const char* str, unsigned int* ui);
 
 /**
  * 	\brief	Read next 'double' value from string
@@ -70,7 +70,7 @@ char* string_get_ui(char* str, unsigned int* ui);
  *	@param[out] d		read value
  *	@return 	pointer behind read value in str; NULL in case of error
  */
-char* string_get_d(char* str, double* d);
+const char* string_get_d(const char* str, double* d);
 
 /**
  * 	\brief	Read next 'float' value from string
@@ -79,11 +79,13 @@ char* string_get_d(char* str, double* d);
  *	@param[out] f 		read value
  *	@return 	pointer behind read value in str; NULL in case of error
  */
-char* string_get_f(char* str, float* f);
+const char* string_get_f(const char* str, float* f);
 
 /**
  * 	\brief Process next block '[...]' in string
  *
+ *	The block has to be located in the actual line. The string is not modified.
+ *
  *	@param[in] 	str		string
  *	@param[in] 	fmt		format string ('i' for 'int', 'f' for 'float')
  *	@param[out] idat	array for 'int' values (long enough due to fmt)
@@ -91,7 +93,7 @@ char* string_get_f(char* str, float* f);
  *	@param[out] ddat	array for 'double' values (long enough due to fmt)
  *	@return 	pointer behind read value in str; NULL in case of error
  */
-char* string_get_block(char* str, const char* fmt, int* idat = NULL, float* fdat = NULL, double *ddat = NULL);
+const char* string_get_block(const char* str, const char* fmt, int* idat = NULL, float* fdat = NULL, double *ddat = NULL);
 
 /**
  * 	\brief	Read next 'word' value from string
@@ -100,7 +102,7 @@ char* string_get_block(char* str, const char* fmt, int* idat = NULL, float* fdat
  *	@param[out] w		read value
  *	@return	pointer behind read value in str; NULL in case of error
  */
-char* string_get_word(char* str, std::string& w);
+const char* string_get_word(const char* str, std::string& w);
 
 /**
  * 	\brief	Read next 'quoted text' value from string
@@ -109,7 +111,7 @@ char* string_get_word(char* str, std::string& w);
  *	@param[out] qt		read value (without quotes)
  *	@return pointer behind read value in str; NULL in case of error
  */
-char* string_get_quoted_text(char* str, std::string& qt);
+const char* string_get_quoted_text(const char* str, std::string& qt);
 
 /**
  * \brief Compare string regarding DTrack2 parameter rules.
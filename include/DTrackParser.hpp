@@ -37,6 +37,7 @@
 
 #include "DTrackDataTypes.hpp"
 
+#include <string>
 #include <vector>
 
 using namespace DTrackSDK_Datatypes;
@@ -46,6 +47,24 @@ using namespace DTrackSDK_Datatypes;
  */
 class DTrackParser
 {
+public:
+
+	//! Types of tracking data, for selective parsing (see setParseMask())
+	typedef enum {
+		PARSE_TIMESTAMP = 0x0001,  //!< Timestamps ('ts', 'ts2'); frame counter is always parsed
+		PARSE_BODY      = 0x0002,  //!< Standard bodies ('6dcal', '6d')
+		PARSE_BODYCOV   = 0x0004,  //!< Covariance of standard bodies ('6dcov'), needs also PARSE_BODY
+		PARSE_FLYSTICK  = 0x0008,  //!< Flysticks ('6df', '6df2')
+		PARSE_MEATOOL   = 0x0010,  //!< Measurement Tools ('6dmt', '6dmt2')
+		PARSE_MEAREF    = 0x0020,  //!< Measurement Tool references ('6dmtr')
+		PARSE_HAND      = 0x0040,  //!< A.R.T. FINGERTRACKING hands ('glcal', 'gl')
+		PARSE_HUMAN     = 0x0080,  //!< ART-Human models ('6dj')
+		PARSE_INERTIAL  = 0x0100,  //!< Hybrid (optical-inertial) bodies ('6di')
+		PARSE_MARKER    = 0x0200,  //!< Single markers ('3d')
+		PARSE_STATUS    = 0x0400,  //!< System status ('st')
+		PARSE_ALL       = 0x07ff   //!< All types of tracking data
+	} ParseMask;
+
 protected:
 
 	/**
@@ -73,10 +92,48 @@ protected:
 	 *
 	 * Updates internal data structures.
 	 *
-	 * @param[in,out] line One line of data in one tracking data packet
+	 * @param[in,out] line One line of data in one tracking data packet (not modified)
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine( char **line );
+	bool parseLine( const char **line );
+
+	/**
+	 * \brief Get type of the line parsed by last call of parseLine().
+	 *
+	 * @return Line type (see DTrackStatistics::RecordType)
+	 */
+	int getLineRecordType() const;
+
+	/**
+	 * \brief Copy tracking data of actual frame from another parser.
+	 *
+	 * Doesn't allocate memory, if enough was allocated by an earlier call.
+	 *
+	 * @param[in] parser Parser containing tracking data
+	 */
+	void copyFrame( const DTrackParser& parser );
+
+	/**
+	 * \brief Set tracking data of actual frame from a binary image.
+	 *
+	 * Doesn't allocate memory, if enough was allocated by an earlier call.
+	 *
+	 * @param[in] image Binary image, written by writeFrameImage()
+	 * @param[in] len   Length of image in bytes
+	 * @return          Success? (fails for invalid images)
+	 */
+	bool readFrameImage( const char* image, int len );
+
+	/**
+	 * \brief Set local timing of actual frame.
+	 *
+	 * All times refer to the clock of DTrackSys::time_monotonic().
+	 *
+	 * @param[in] arrivalTime    Arrival time of tracking data packet in s
+	 * @param[in] parseStartTime Time, when parsing started, in s
+	 * @param[in] parseEndTime   Time, when parsing finished, in s
+	 */
+	void setFrameTimes( double arrivalTime, double parseStartTime, double parseEndTime );
 
 public:
 
@@ -125,6 +182,34 @@ public:
 	 */
 	unsigned int getLatencyUsec() const;
 
+	/**
+	 * \brief Get local arrival time of tracking data packet.
+	 *
+	 * Refers to last received frame. Uses the kernel receive timestamp, if supported by the system.
+	 * Compare with DTrackSys::time_monotonic() to get the delay until the frame is used.
+	 *
+	 * @return Time in seconds, clock of DTrackSys::time_monotonic() (0 if information not available)
+	 */
+	double getArrivalTime() const;
+
+	/**
+	 * \brief Get local time, when parsing of tracking data packet started.
+	 *
+	 * Refers to last received frame.
+	 *
+	 * @return Time in seconds, clock of DTrackSys::time_monotonic() (0 if information not available)
+	 */
+	double getParseStartTime() const;
+
+	/**
+	 * \brief Get local time, when parsing of tracking data packet finished.
+	 *
+	 * Refers to last received frame.
+	 *
+	 * @return Time in seconds, clock of DTrackSys::time_monotonic() (0 if information not available)
+	 */
+	double getParseEndTime() const;
+
 	/**
 	 * \brief Get number of calibrated standard bodies (as far as known).
 	 *
@@ -232,13 +317,27 @@ public:
 	/**
 	 * \brief Get ART-Human model data.
 	 *
-	 * Refers to last received frame.
+	 * Refers to last received frame. The data is copied from the compact joint storage; the first call
+	 * of getHuman() does this on demand, afterwards it is done with each frame. So the first call is not
+	 * thread-safe and might invalidate pointers returned before; later calls just read the data. Pointers
+	 * are valid until the next frame is processed.
 	 *
 	 * @param[in] id Id, range 0 ..
 	 * @return       Id-th ART-Human model data; NULL in case of error
 	 */
 	const DTrackHuman* getHuman( int id ) const;
 
+	/**
+	 * \brief Get ART-Human model data, joints in compact storage.
+	 *
+	 * Refers to last received frame. Faster than getHuman(), as joint data is not copied. The joint data
+	 * is valid until the next frame is processed.
+	 *
+	 * @param[in] id Id, range 0 ..
+	 * @return       Id-th ART-Human model data; no joints in case of error
+	 */
+	DTrackHumanJoints getHumanJoints( int id ) const;
+
 	/**
 	 * \brief Get number of calibrated hybrid (optical-inertial) bodies.
 	 *
@@ -277,6 +376,16 @@ public:
 	 */
 	const DTrackMarker* getMarker( int index ) const;
 
+	/**
+	 * \brief Get single marker data by ID number.
+	 *
+	 * Refers to last received frame. Uses a hash table of ID numbers, so takes constant time.
+	 *
+	 * @param[in] id ID number of marker
+	 * @return       Single marker data; NULL if marker isn't available
+	 */
+	const DTrackMarker* getMarkerById( int id ) const;
+
 	/**
 	 * \brief Returns if system status data is available.
 	 *
@@ -295,9 +404,180 @@ public:
 	 */
 	const DTrackStatus* getStatus() const;
 
+	/**
+	 * \brief Enable detection of changes between frames.
+	 *
+	 * If enabled, the parser reports changes of each frame as events: objects added or removed (e.g.
+	 * by '6dcal' or 'glcal'), tracked or lost objects, pressed or released buttons and changed joystick
+	 * values of Flysticks and Measurement Tools. The first frame after enabling reports all objects
+	 * as added.
+	 *
+	 * @param[in] enable            Enable events?
+	 * @param[in] joystickThreshold Minimum change of a joystick value to be reported
+	 */
+	void enableEvents( bool enable = true, double joystickThreshold = 0.05 );
+
+	/**
+	 * \brief Get number of events of actual frame.
+	 *
+	 * Events have to be enabled by enableEvents().
+	 *
+	 * @return Number of events
+	 */
+	int getNumEvents() const;
+
+	/**
+	 * \brief Get event of actual frame.
+	 *
+	 * Events are ordered by type of object; for each type of object, added or removed objects come first.
+	 *
+	 * @param[in] index Index of event, range 0 .. getNumEvents() - 1
+	 * @return          Event; NULL in case of error
+	 */
+	const DTrackEvent* getEvent( int index ) const;
+
+	/**
+	 * \brief Type of a handler function for lines with an additional identifier.
+	 *
+	 * @param[in] identifier Line identifier
+	 * @param[in] line       Data of the line behind the identifier; ends with line break or '\0'
+	 * @param[in] userData   Pointer given at registration
+	 * @return               Parsing succeeded?
+	 */
+	typedef bool ( *LineHandler )( const char* identifier, const char* line, void* userData );
+
+	/**
+	 * \brief Register a handler for lines with an additional identifier.
+	 *
+	 * Lines with identifiers unknown to the parser are ignored, if no handler is registered for them.
+	 * Identifiers known to the parser cannot be registered. The handler is called while processing
+	 * the tracking data packet.
+	 *
+	 * @param[in] identifier Line identifier (e.g. '6dx'), without blanks
+	 * @param[in] handler    Handler function; NULL to remove a registered handler
+	 * @param[in] userData   Pointer passed to the handler function
+	 * @return               Registration succeeded?
+	 */
+	bool registerLineHandler( const char* identifier, LineHandler handler, void* userData = NULL );
+
+	/**
+	 * \brief Set types of tracking data to be parsed.
+	 *
+	 * Lines of other types are skipped without parsing; the corresponding methods report no data
+	 * (e.g. getNumBody() returns 0). Default is PARSE_ALL.
+	 *
+	 * @param[in] mask Types of tracking data, combination of ParseMask values
+	 */
+	void setParseMask( int mask );
+
+	/**
+	 * \brief Get types of tracking data to be parsed.
+	 *
+	 * @return Types of tracking data, combination of ParseMask values
+	 */
+	int getParseMask() const;
+
+	/**
+	 * \brief Maximum numbers of tracking data, for parsing with fixed capacity (see enableFixedCapacity()).
+	 */
+	struct Capacity
+	{
+		int maxBody;      //!< Maximum number of standard bodies
+		int maxFlyStick;  //!< Maximum number of Flysticks
+		int maxMeaTool;   //!< Maximum number of Measurement Tools
+		int maxMeaRef;    //!< Maximum number of Measurement Tool references
+		int maxHand;      //!< Maximum number of A.R.T. FINGERTRACKING hands
+		int maxHuman;     //!< Maximum number of ART-Human models
+		int maxJoint;     //!< Maximum number of joints, sum of all ART-Human models
+		int maxInertial;  //!< Maximum number of hybrid (optical-inertial) bodies
+		int maxMarker;    //!< Maximum number of single markers
+		int maxCamera;    //!< Maximum number of cameras in system status data
+
+		/**
+		 * \brief Constructor, sets default values.
+		 */
+		Capacity();
+	};
+
+	/**
+	 * \brief Enable parsing with fixed capacity.
+	 *
+	 * If enabled, all memory needed for parsing is allocated at once. Afterwards processing a frame never
+	 * allocates memory, as long as no frame buffer, history, recording or publishing is used. Lines with
+	 * more tracking data than fitting into the capacity fail to parse, which is reported by
+	 * isCapacityExceeded(); numbers of calibrated bodies or hands ('6dcal', 'glcal') are just limited.
+	 * Discards tracking data of the actual frame, so should be called before receiving the first frame.
+	 *
+	 * @param[in] enable   Enable fixed capacity?
+	 * @param[in] capacity Maximum numbers of tracking data
+	 * @return             Enabling succeeded? (fails for negative numbers)
+	 */
+	bool enableFixedCapacity( bool enable = true, const Capacity& capacity = Capacity() );
+
+	/**
+	 * \brief Returns if tracking data exceeded the fixed capacity.
+	 *
+	 * Refers to last received frame. Just possible with fixed capacity (see enableFixedCapacity()).
+	 *
+	 * @return Tracking data was dropped because of exceeded capacity
+	 */
+	bool isCapacityExceeded() const;
+
+	/**
+	 * \brief Get size of the binary image of the actual frame.
+	 *
+	 * @return Size in bytes
+	 */
+	int getFrameImageSize() const;
+
+	/**
+	 * \brief Write tracking data of actual frame into a binary image.
+	 *
+	 * The image is a plain copy of the tracking data, without any conversion. So it's valid just for
+	 * the same version of DTrackSDK on the same system, e.g. to pass frames to other processes.
+	 *
+	 * @param[out] image  Buffer for binary image
+	 * @param[in]  maxLen Length of buffer in bytes
+	 * @return            Length of image in bytes; -1 if buffer is too small
+	 */
+	int writeFrameImage( char* image, int maxLen ) const;
+
 
 private:
 
+	/**
+	 * \brief Detect changes of actual frame, compared to the previous one.
+	 */
+	void detectEvents();
+
+	/**
+	 * \brief Rebuild hash table of marker ID numbers, after single marker data was changed.
+	 */
+	void updateMarkerIndex();
+
+	/**
+	 * \brief Keep ART-Human model data for getHuman() up to date, after joint data was changed.
+	 *
+	 * Builds the data just if getHuman() was used before.
+	 */
+	void updateHuman();
+
+	/**
+	 * \brief Fill ART-Human model data for getHuman() from compact joint data.
+	 */
+	void buildHuman() const;
+
+	/**
+	 * \brief Check a new number of entries against a fixed capacity.
+	 *
+	 * Always succeeds, if parsing with fixed capacity is not enabled.
+	 *
+	 * @param[in] num New number of entries
+	 * @param[in] max Maximum number of entries
+	 * @return        Number of entries fits into capacity? (otherwise exceeded capacity is reported)
+	 */
+	bool checkCapacity( int num, int max );
+
 	/**
 	 * \brief Parses a single line of frame counter data in one tracking data packet.
 	 *
@@ -306,7 +586,7 @@ private:
 	 * @param[in,out] line Line of 'fr' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_fr( char **line );
+	bool parseLine_fr( const char **line );
 
 	/**
 	 * \brief Parses a single line of timestamp data in one tracking data packet.
@@ -316,7 +596,7 @@ private:
 	 * @param[in,out] line Line of 'ts' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_ts( char **line );
+	bool parseLine_ts( const char **line );
 
 	/**
 	 * \brief Parses a single line of extended timestamp data in one tracking data packet.
@@ -326,7 +606,7 @@ private:
 	 * @param[in,out] line Line of 'ts2' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_ts2( char **line );
+	bool parseLine_ts2( const char **line );
 
 	/**
 	 * \brief Parses a single line of additional information about number of calibrated bodies in one tracking data packet.
@@ -336,7 +616,7 @@ private:
 	 * @param[in,out] line Line of '6dcal' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dcal( char **line );
+	bool parseLine_6dcal( const char **line );
 
 	/**
 	 * \brief Parses a single line of standard body data in one tracking data packet.
@@ -346,7 +626,7 @@ private:
 	 * @param[in,out] line Line of '6d' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6d( char **line );
+	bool parseLine_6d( const char **line );
 
 	/**
 	 * \brief Parses a single line of 6d covariance data in one tracking data packet.
@@ -356,7 +636,7 @@ private:
 	 * @param[in,out] line Line of '6dcov' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dcov( char **line );
+	bool parseLine_6dcov( const char **line );
 
 	/**
 	 * \brief Parses a single line of Flystick data (older format) data in one tracking data packet.
@@ -366,7 +646,7 @@ private:
 	 * @param[in,out] line Line of '6df' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6df( char **line );
+	bool parseLine_6df( const char **line );
 
 	/**
 	 * \brief Parses a single line of Flystick data (newer format) data in one tracking data packet.
@@ -376,7 +656,7 @@ private:
 	 * @param[in,out] line Line of '6df2' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6df2( char **line );
+	bool parseLine_6df2( const char **line );
 
 	/**
 	 * \brief Parses a single line of Measurement Tool data (older format) in one tracking data packet.
@@ -386,7 +666,7 @@ private:
 	 * @param[in,out] line Line of '6dmt' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dmt( char **line );
+	bool parseLine_6dmt( const char **line );
 
 	/**
 	 * \brief Parses a single line of Measurement Tool data (newer format) data in one tracking data packet.
@@ -396,7 +676,7 @@ private:
 	 * @param[in,out] line Line of '6dmt2' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dmt2( char **line );
+	bool parseLine_6dmt2( const char **line );
 
 	/**
 	 * \brief Parses a single line of Measurement Tool reference data in one tracking data packet.
@@ -406,7 +686,7 @@ private:
 	 * @param[in,out] line Line of '6dmtr' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dmtr( char **line );
+	bool parseLine_6dmtr( const char **line );
 
 	/**
 	 * \brief Parses a single line of additional information about number of calibrated Fingertracking hands in one tracking data packet.
@@ -416,7 +696,7 @@ private:
 	 * @param[in,out] line Line of 'glcal' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_glcal( char **line );
+	bool parseLine_glcal( const char **line );
 
 	/**
 	 * \brief Parses a single line of A.R.T. Fingertracking hand data in one tracking data packet.
@@ -426,7 +706,7 @@ private:
 	 * @param[in,out] line Line of 'gl' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_gl( char **line );
+	bool parseLine_gl( const char **line );
 
 	/**
 	 * \brief Parses a single line of ART-Human model data in one tracking data packet.
@@ -436,7 +716,7 @@ private:
 	 * @param[in,out] line Line of '6dj' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6dj( char **line );
+	bool parseLine_6dj( const char **line );
 
 	/**
 	 * \brief Parses a single line of hybrid (optical-inertial) body data in one tracking data packet.
@@ -446,7 +726,7 @@ private:
 	 * @param[in,out] line Line of '6di' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_6di( char **line );
+	bool parseLine_6di( const char **line );
 
 	/**
 	 * \brief Parses a single line of single marker data in one tracking data packet.
@@ -456,7 +736,7 @@ private:
 	 * @param[in,out] line Line of '3d' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_3d( char **line );
+	bool parseLine_3d( const char **line );
 
 	/**
 	 * \brief Parses a single line of system status data in one tracking data packet.
@@ -466,15 +746,52 @@ private:
 	 * @param[in,out] line Line of 'st' data in one tracking data packet
 	 * @return             Parsing succeeded?
 	 */
-	bool parseLine_st( char** line );
+	bool parseLine_st( const char** line );
+
+	/**
+	 * \brief Parses a single line with unknown identifier in one tracking data packet.
+	 *
+	 * Calls a registered handler, if available.
+	 *
+	 * @param[in,out] line Line in one tracking data packet, starting with identifier
+	 * @param[in]     len  Length of identifier
+	 * @return             Parsing succeeded?
+	 */
+	bool parseLine_unknown( const char **line, int len );
+
+	/**
+	 * \brief Skips a single line of Flystick or Measurement Tool data (older format) in one tracking data packet.
+	 *
+	 * Just gets the number of Flysticks or Measurement Tools, as needed for the number of calibrated bodies.
+	 *
+	 * @param[in,out] line Line of '6df' or '6dmt' data in one tracking data packet
+	 * @param[out]    num  Number of Flysticks or Measurement Tools
+	 * @return             Parsing succeeded?
+	 */
+	bool skipLine_num( const char **line, int* num );
 
 private:
 
+	/**
+	 * \brief Registered handler for lines with an additional identifier.
+	 */
+	struct LineHandlerEntry
+	{
+		std::string identifier;  //!< Line identifier
+		LineHandler handler;     //!< Handler function
+		void* userData;          //!< Pointer passed to handler function
+	};
+
+	friend class DTrackRelayDecoder;  // decodes binary frames directly into tracking data
+
 	unsigned int act_framecounter;                    //!< Frame counter
 	double act_timestamp;                             //!< Timestamp since midnight (-1, if information not available)
 	unsigned int act_timestamp_sec;                   //!< Timestamp since Unix epoch, seconds (0, if not available)
 	unsigned int act_timestamp_usec;                  //!< Timestamp since Unix epoch, microseconds
 	unsigned int act_latency_usec;                    //!< Latency of current frame (0, if not available)
+	double act_time_arrival;                          //!< Local arrival time of packet in s (0, if not available)
+	double act_time_parsestart;                       //!< Local time when parsing started in s (0, if not available)
+	double act_time_parseend;                         //!< Local time when parsing finished in s (0, if not available)
 
 	int act_num_body;                                 //!< Number of calibrated standard bodies (as far as known)
 	std::vector< DTrackBody > act_body;               //!< Array containing standard body data
@@ -487,18 +804,46 @@ private:
 	int act_num_hand;                                 //!< Number of calibrated A.R.T. FINGERTRACKING hands (as far as known)
 	std::vector< DTrackHand > act_hand;               //!< Array containing A.R.T. FINGERTRACKING hand data
 	int act_num_human;                                //!< Number of calibrated ART-Human models
-	std::vector< DTrackHuman > act_human;             //!< Array containing ART-Human model data
+	std::vector< DTrackJoint > act_joint;             //!< Array containing ART-Human joint data of all models
+	std::vector< int > act_human_joint_index;         //!< Index of first joint in act_joint, for all ART-Human models
+	std::vector< int > act_human_num_joints;          //!< Number of joints, for all ART-Human models
+	mutable std::vector< DTrackHuman > act_human;     //!< Array containing ART-Human model data, for getHuman()
 	int act_num_inertial;                             //!< Number of calibrated hybrid (optical-inertial) bodies
 	std::vector< DTrackInertial > act_inertial;       //!< Array containing hybrid (optical-inertial) body data
 	int act_num_marker;                               //!< Number of tracked single markers
 	std::vector< DTrackMarker > act_marker;           //!< Array containing single marker data
+	std::vector< int > loc_marker_index;              //!< internal use, hash table of marker ID numbers (index + 1; 0 if empty)
+	int loc_marker_shift;                             //!< internal use, shift of hash function for loc_marker_index
+	bool act_capacity_exceeded;                       //!< Tracking data was dropped because of exceeded capacity
 	bool act_is_status_available;                     //!< System status data is available
 	DTrackStatus act_status;                          //!< System status data
+	std::vector< DTrackEvent > act_events;            //!< Events of actual frame
 
 	int loc_num_bodycal;    //!< internal use, local number of calibrated bodies
 	int loc_num_handcal;    //!< internal use, local number of hands
 	int loc_num_flystick1;  //!< internal use, local number of old flysticks
 	int loc_num_meatool1;   //!< internal use, local number of old measurementtools
+
+	std::vector< int > loc_dirty_body;      //!< internal use, standard bodies set by last frame
+	std::vector< int > loc_dirty_hand;      //!< internal use, hands set by last frame
+	std::vector< int > loc_dirty_inertial;  //!< internal use, hybrid bodies set by last frame
+
+	mutable bool loc_human_built;   //!< internal use, ART-Human model data in act_human is up to date
+	mutable bool loc_human_legacy;  //!< internal use, getHuman() was used, so act_human is built with each frame
+
+	bool loc_events_enabled;                   //!< internal use, detection of changes is enabled
+	double loc_events_threshold;               //!< internal use, minimum change of joystick values
+	std::vector< char > loc_events_tracked[ DTrackEvent::NUM_OBJECTTYPES ];  //!< internal use, objects tracked in previous frame
+	std::vector< unsigned int > loc_events_flystickbutton;  //!< internal use, Flystick buttons in previous frame
+	std::vector< unsigned int > loc_events_meatoolbutton;   //!< internal use, Measurement Tool buttons in previous frame
+	std::vector< double > loc_events_joystick;  //!< internal use, Flystick joystick values of latest events
+
+	bool loc_fixed;          //!< internal use, parsing with fixed capacity is enabled
+	Capacity loc_capacity;  //!< internal use, maximum numbers of tracking data for fixed capacity
+
+	int loc_parsemask;      //!< internal use, types of tracking data to be parsed
+	int loc_linetype;       //!< internal use, type of last parsed line
+	std::vector< LineHandlerEntry > loc_linehandler;  //!< internal use, registered handlers for additional line identifiers
 };
 
 
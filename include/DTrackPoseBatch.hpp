@@ -0,0 +1,223 @@
+/* DTrackSDK in C++: DTrackPoseBatch.hpp
+ *
+ * Converting poses of all bodies at once.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_POSEBATCH_HPP_
+#define _ART_DTRACKSDK_POSEBATCH_HPP_
+
+#include "DTrackParser.hpp"
+
+#include <vector>
+
+/**
+ * \brief Converting poses of all bodies of one type at once.
+ *
+ * Converts location and rotation matrix of all bodies (or Flysticks, Measurement Tools, hybrid bodies,
+ * ART-Human joints) of a frame into location and quaternion, optionally applying a room-to-world
+ * transformation. Optionally the results are also provided as packed float arrays, e.g. to upload them
+ * to a GPU. Uses SIMD instructions (SSE2 or NEON) if available.
+ *
+ * Without transformation, quaternions are identical to getQuaternion() of the single bodies. Bodies that
+ * are not tracked get location ( 0 0 0 ) and the identity quaternion.
+ * Memory is allocated only if the number of poses grows.
+ */
+class DTrackPoseBatch
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackPoseBatch();
+
+	/**
+	 * \brief Set room-to-world transformation applied to all poses.
+	 *
+	 * Resulting poses are loc_world = rot * loc_room + loc and rot_world = rot * rot_room.
+	 *
+	 * @param[in] loc Location of room coordinate system in world coordinates (in [mm])
+	 * @param[in] rot Rotation matrix of room coordinate system in world coordinates (column-wise)
+	 */
+	void setTransform( const double loc[ 3 ], const double rot[ 9 ] );
+
+	/**
+	 * \brief Remove room-to-world transformation.
+	 */
+	void resetTransform();
+
+	/**
+	 * \brief Enable or disable packed float output.
+	 *
+	 * @param[in] enable Provide results also by getLocFloat() and getQuatFloat()?
+	 */
+	void enableFloatOutput( bool enable = true );
+
+	/**
+	 * \brief Convert all standard bodies of a frame.
+	 *
+	 * @param[in] frame Frame (e.g. DTrackSDK, DTrackFrame)
+	 * @return          Number of converted poses
+	 */
+	int convertBodies( const DTrackParser& frame );
+
+	/**
+	 * \brief Convert all Flysticks of a frame.
+	 *
+	 * @param[in] frame Frame (e.g. DTrackSDK, DTrackFrame)
+	 * @return          Number of converted poses
+	 */
+	int convertFlySticks( const DTrackParser& frame );
+
+	/**
+	 * \brief Convert all Measurement Tools of a frame.
+	 *
+	 * @param[in] frame Frame (e.g. DTrackSDK, DTrackFrame)
+	 * @return          Number of converted poses
+	 */
+	int convertMeaTools( const DTrackParser& frame );
+
+	/**
+	 * \brief Convert all hybrid (optical-inertial) bodies of a frame.
+	 *
+	 * @param[in] frame Frame (e.g. DTrackSDK, DTrackFrame)
+	 * @return          Number of converted poses
+	 */
+	int convertInertials( const DTrackParser& frame );
+
+	/**
+	 * \brief Convert all joints of all ART-Human models of a frame.
+	 *
+	 * Joints of all models are stored one after the other; refer to getHumanOffset().
+	 *
+	 * @param[in] frame Frame (e.g. DTrackSDK, DTrackFrame)
+	 * @return          Number of converted poses
+	 */
+	int convertHumans( const DTrackParser& frame );
+
+	/**
+	 * \brief Convert rotation matrices into quaternions.
+	 *
+	 * Doesn't apply the room-to-world transformation.
+	 *
+	 * @param[in]  rot  Rotation matrices (column-wise), num * 9 values
+	 * @param[out] quat Quaternions, num entries
+	 * @param[in]  num  Number of rotation matrices
+	 */
+	static void rot2quat( const double* rot, DTrackQuaternion* quat, int num );
+
+	/**
+	 * \brief Get number of converted poses.
+	 *
+	 * @return Number of poses
+	 */
+	int getNum() const;
+
+	/**
+	 * \brief Get id of a converted pose (e.g. body id, joint id).
+	 *
+	 * @param[in] index Index, range 0 .. getNum() - 1
+	 * @return          Id
+	 */
+	int getId( int index ) const;
+
+	/**
+	 * \brief Returns if body of a converted pose is tracked.
+	 *
+	 * @param[in] index Index, range 0 .. getNum() - 1
+	 * @return          Is tracked?
+	 */
+	bool isTracked( int index ) const;
+
+	/**
+	 * \brief Get location of a converted pose.
+	 *
+	 * @param[in] index Index, range 0 .. getNum() - 1
+	 * @return          Location (in [mm]), 3 values
+	 */
+	const double* getLoc( int index ) const;
+
+	/**
+	 * \brief Get quaternion of a converted pose.
+	 *
+	 * @param[in] index Index, range 0 .. getNum() - 1
+	 * @return          Quaternion
+	 */
+	const DTrackQuaternion& getQuaternion( int index ) const;
+
+	/**
+	 * \brief Get locations of all converted poses as packed float array.
+	 *
+	 * Float output has to be enabled by enableFloatOutput().
+	 *
+	 * @return Locations (in [mm]), 3 values ( x y z ) per pose; NULL if not available
+	 */
+	const float* getLocFloat() const;
+
+	/**
+	 * \brief Get quaternions of all converted poses as packed float array.
+	 *
+	 * Float output has to be enabled by enableFloatOutput().
+	 *
+	 * @return Quaternions, 4 values ( x y z w ) per pose; NULL if not available
+	 */
+	const float* getQuatFloat() const;
+
+	/**
+	 * \brief Get index of first joint of an ART-Human model, after convertHumans().
+	 *
+	 * @param[in] humanId Id of ART-Human model, range 0 ..
+	 * @return            Index of first joint; -1 in case of error
+	 */
+	int getHumanOffset( int humanId ) const;
+
+private:
+
+	void prepare( int num );
+	void add( int id, bool tracked, const double* loc, const double* rot );
+	int convert();
+
+	bool d_hasTransform;               //!< room-to-world transformation is set
+	double d_transformLoc[ 3 ];        //!< room-to-world transformation: location
+	double d_transformRot[ 9 ];        //!< room-to-world transformation: rotation matrix
+	DTrackQuaternion d_transformQuat;  //!< room-to-world transformation: rotation as quaternion
+	bool d_floatOutput;                //!< provide packed float output
+
+	int d_num;                                //!< number of poses
+	std::vector< const double* > d_srcLoc;    //!< source locations
+	std::vector< const double* > d_srcRot;    //!< source rotation matrices
+	std::vector< int > d_id;                  //!< ids
+	std::vector< char > d_tracked;            //!< tracking flags
+	std::vector< double > d_loc;              //!< resulting locations
+	std::vector< DTrackQuaternion > d_quat;   //!< resulting quaternions
+	std::vector< float > d_locFloat;          //!< resulting locations as float
+	std::vector< float > d_quatFloat;         //!< resulting quaternions as float
+	std::vector< int > d_humanOffset;         //!< index of first joint per ART-Human model
+};
+
+#endif  // _ART_DTRACKSDK_POSEBATCH_HPP_
@@ -0,0 +1,189 @@
+/* DTrackSDK in C++: DTrackPredictor.hpp
+ *
+ * Prediction of poses for a local point in time.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_PREDICTOR_HPP_
+#define _ART_DTRACKSDK_PREDICTOR_HPP_
+
+#include "DTrackParser.hpp"
+
+#include <vector>
+
+/**
+ * \brief Prediction of poses for a local point in time (e.g. the expected photon time of a display).
+ *
+ * Keeps a short history of poses per standard body, Flystick and Fingertracking hand, and extrapolates
+ * them with constant velocity and constant angular velocity. Poses are related to the exposure time of
+ * the Controller ('ts2' timestamp and latency, or 'ts' timestamp); the Controller clock is mapped to the
+ * local clock DTrackSys::time_monotonic() using the arrival times of the frames.
+ *
+ * Not thread-safe. A typical render loop gets the latest frame (e.g. DTrackSDK::acquireLatestFrame()),
+ * passes it to addFrame() and calls predictBody() etc. just before rendering.
+ */
+class DTrackPredictor
+{
+public:
+
+	/**
+	 * \brief Predicted pose.
+	 */
+	struct Pose
+	{
+		double loc[ 3 ];        //!< Location (in [mm])
+		double rot[ 9 ];        //!< Rotation matrix (column-wise)
+		DTrackQuaternion quat;  //!< Rotation as quaternion
+	};
+
+	static const int HISTORY_SIZE = 4;     //!< Number of poses kept per body
+	static const int OFFSET_WINDOW = 128;  //!< Number of frames used to map the Controller clock
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackPredictor();
+
+	/**
+	 * \brief Set maximum time span of prediction.
+	 *
+	 * Predictions further into the future return the pose at the maximum time span, e.g. to limit errors
+	 * if a body got lost.
+	 *
+	 * @param[in] maxPrediction Maximum time span in s; default 0.1 s
+	 */
+	void setMaxPrediction( double maxPrediction );
+
+	/**
+	 * \brief Set number of frames used to calculate velocities.
+	 *
+	 * A larger number reduces noise, but reacts slower to changes of the velocity.
+	 *
+	 * @param[in] numFrames Number of frames, range 1 .. HISTORY_SIZE - 1; default 2
+	 */
+	void setVelocityFrames( int numFrames );
+
+	/**
+	 * \brief Remove all poses.
+	 */
+	void reset();
+
+	/**
+	 * \brief Add poses of a frame.
+	 *
+	 * Needs the arrival time of the frame (see DTrackParser::getArrivalTime()). Frames not newer than
+	 * the last one are ignored.
+	 *
+	 * @param[in] frame Frame (e.g. DTrackSDK, DTrackFrame)
+	 * @return          Frame was added?
+	 */
+	bool addFrame( const DTrackParser& frame );
+
+	/**
+	 * \brief Predict pose of a standard body.
+	 *
+	 * @param[in]  id         Id of body, range 0 ..
+	 * @param[in]  targetTime Local time in s (clock of DTrackSys::time_monotonic())
+	 * @param[out] pose       Predicted pose
+	 * @return                Prediction available? (fails if body is not tracked in latest frame)
+	 */
+	bool predictBody( int id, double targetTime, Pose& pose ) const;
+
+	/**
+	 * \brief Predict pose of a Flystick.
+	 *
+	 * @param[in]  id         Id of Flystick, range 0 ..
+	 * @param[in]  targetTime Local time in s (clock of DTrackSys::time_monotonic())
+	 * @param[out] pose       Predicted pose
+	 * @return                Prediction available? (fails if Flystick is not tracked in latest frame)
+	 */
+	bool predictFlyStick( int id, double targetTime, Pose& pose ) const;
+
+	/**
+	 * \brief Predict pose of the back of a Fingertracking hand.
+	 *
+	 * @param[in]  id         Id of hand, range 0 ..
+	 * @param[in]  targetTime Local time in s (clock of DTrackSys::time_monotonic())
+	 * @param[out] pose       Predicted pose
+	 * @return                Prediction available? (fails if hand is not tracked in latest frame)
+	 */
+	bool predictHand( int id, double targetTime, Pose& pose ) const;
+
+	/**
+	 * \brief Get local time of exposure of latest frame.
+	 *
+	 * @return Time in s (clock of DTrackSys::time_monotonic()); 0 if no frame available
+	 */
+	double getFrameTime() const;
+
+	/**
+	 * \brief Convert time of Controller clock into local time.
+	 *
+	 * @param[in] controllerTime Time of Controller clock in s (like 'ts2' timestamp)
+	 * @return                   Local time in s (clock of DTrackSys::time_monotonic())
+	 */
+	double toLocalTime( double controllerTime ) const;
+
+private:
+
+	//! Types of tracked objects
+	enum { TRACK_BODY = 0, TRACK_FLYSTICK, TRACK_HAND, NUM_TRACK };
+
+	//! Pose at one point in time
+	struct Sample
+	{
+		double time;            //!< time of Controller clock in s
+		double loc[ 3 ];        //!< location
+		DTrackQuaternion quat;  //!< rotation
+	};
+
+	//! History of one tracked object
+	struct Track
+	{
+		bool tracked;                     //!< tracked in latest frame
+		int num;                          //!< number of valid samples
+		int head;                         //!< index of newest sample
+		Sample sample[ HISTORY_SIZE ];    //!< samples (ring buffer)
+	};
+
+	void addPose( int type, int id, bool tracked, double time, const double* loc, const double* rot );
+	bool predict( int type, int id, double targetTime, Pose& pose ) const;
+
+	double d_maxPrediction;          //!< maximum time span of prediction in s
+	int d_velocityFrames;            //!< number of frames used to calculate velocities
+
+	bool d_hasFrame;                 //!< frame available
+	double d_lastTime;               //!< time of latest frame (Controller clock) in s
+	double d_offset[ OFFSET_WINDOW ];  //!< differences between local and Controller clock in s (ring buffer)
+	int d_numOffset;                 //!< number of valid entries in d_offset
+	int d_headOffset;                //!< index of next entry in d_offset
+	double d_clockOffset;            //!< estimated difference between local and Controller clock in s
+
+	std::vector< Track > d_track[ NUM_TRACK ];  //!< history of tracked objects, by type and id
+};
+
+#endif  // _ART_DTRACKSDK_PREDICTOR_HPP_
@@ -0,0 +1,273 @@
+/* DTrackSDK in C++: DTrackRecord.hpp
+ *
+ * Recording of tracking data packets into binary files, and replay of such recordings.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_RECORD_HPP_
+#define _ART_DTRACKSDK_RECORD_HPP_
+
+#include "DTrackSys.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class DTrackSDK;  // forward declaration
+
+/*! \page record_format Format of recording files
+ *
+ * All values are stored in the byte order of the recording system (little-endian on all supported systems).
+ *
+ * - File header (16 bytes): magic "DTRKREC1", version (uint32), size of file header (uint32)
+ * - For each packet (aligned to 8 bytes): arrival time in s (double), frame counter (uint32), length of
+ *   packet in bytes (uint32), packet data, terminating '\0', padding to 8 bytes
+ * - Index header (16 bytes, written when closing): magic "DTRKIDX1", number of packets (uint32), reserved (uint32)
+ * - For each packet (24 bytes): file offset (uint64), frame counter (uint32), reserved (uint32), arrival time (double)
+ * - File trailer (16 bytes): file offset of index header (uint64), magic "DTRKEND1"
+ *
+ * If the index is missing, e.g. because the recording was aborted, it's rebuilt when opening the file.
+ */
+
+/**
+ * \brief Entry of the index of a recording.
+ */
+struct DTrackRecordIndex
+{
+	size_t offset;              //!< File offset of packet
+	unsigned int frameCounter;  //!< Frame counter
+	double arrivalTime;         //!< Arrival time in s
+};
+
+
+/**
+ * \brief Recording of tracking data packets into a binary file.
+ *
+ * Stores the raw packets together with frame counter and arrival time, and an index for fast seeking
+ * (see \ref record_format).
+ */
+class DTrackRecorder
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackRecorder();
+
+	/**
+	 * \brief Destructor. Closes the file, if open.
+	 */
+	~DTrackRecorder();
+
+	/**
+	 * \brief Create a new recording file.
+	 *
+	 * @param[in] filename Name of file; an existing file is overwritten
+	 * @return             Success?
+	 */
+	bool open( const std::string& filename );
+
+	/**
+	 * \brief Finish recording file, writing the index.
+	 *
+	 * @return Success?
+	 */
+	bool close();
+
+	/**
+	 * \brief Returns if a recording file is open.
+	 *
+	 * @return Open?
+	 */
+	bool isOpen() const;
+
+	/**
+	 * \brief Append one tracking data packet.
+	 *
+	 * @param[in] data         Data packet
+	 * @param[in] len          Length of data packet in bytes (without terminating '\0')
+	 * @param[in] frameCounter Frame counter of packet
+	 * @param[in] arrivalTime  Arrival time of packet in s
+	 * @return                 Success?
+	 */
+	bool addPacket( const char* data, size_t len, unsigned int frameCounter, double arrivalTime );
+
+	/**
+	 * \brief Get number of recorded packets.
+	 *
+	 * @return Number of packets
+	 */
+	int getNumPackets() const;
+
+private:
+
+	DTrackRecorder( const DTrackRecorder& );             // not copyable
+	DTrackRecorder& operator=( const DTrackRecorder& );  // not copyable
+
+	FILE* d_file;                              //!< Recording file, NULL if not open
+	size_t d_offset;                           //!< Actual size of file
+	std::vector< DTrackRecordIndex > d_index;  //!< Index of recorded packets
+};
+
+
+/**
+ * \brief Replay of a recording file.
+ *
+ * The file is mapped into memory, so packets are neither read nor copied. Frames can be sought by
+ * frame counter or arrival time in O(log n), assuming both are increasing within the recording.
+ */
+class DTrackReplay
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackReplay();
+
+	/**
+	 * \brief Destructor. Closes the file, if open.
+	 */
+	~DTrackReplay();
+
+	/**
+	 * \brief Open a recording file.
+	 *
+	 * @param[in] filename Name of file
+	 * @return             Success?
+	 */
+	bool open( const std::string& filename );
+
+	/**
+	 * \brief Close recording file.
+	 */
+	void close();
+
+	/**
+	 * \brief Returns if a recording file is open.
+	 *
+	 * @return Open?
+	 */
+	bool isOpen() const;
+
+	/**
+	 * \brief Get number of packets in recording.
+	 *
+	 * @return Number of packets
+	 */
+	int getNumPackets() const;
+
+	/**
+	 * \brief Get actual position, i.e. index of the packet returned by next call of getNextPacket().
+	 *
+	 * @return Index of packet, range 0 .. getNumPackets(); getNumPackets() at end of recording
+	 */
+	int getPosition() const;
+
+	/**
+	 * \brief Set actual position.
+	 *
+	 * @param[in] index Index of packet, range 0 .. getNumPackets()
+	 * @return          Success?
+	 */
+	bool seek( int index );
+
+	/**
+	 * \brief Set actual position to the first packet with a frame counter not less than the given one.
+	 *
+	 * @param[in] frameCounter Frame counter
+	 * @return                 Success? (fails if there is no such packet)
+	 */
+	bool seekFrameCounter( unsigned int frameCounter );
+
+	/**
+	 * \brief Set actual position to the first packet with an arrival time not less than the given one.
+	 *
+	 * @param[in] arrivalTime Arrival time in s
+	 * @return                Success? (fails if there is no such packet)
+	 */
+	bool seekTime( double arrivalTime );
+
+	/**
+	 * \brief Get one packet.
+	 *
+	 * @param[in]  index        Index of packet, range 0 .. getNumPackets() - 1
+	 * @param[out] data         Data packet, terminated by '\0'; valid until the file is closed
+	 * @param[out] len          Length of data packet in bytes (without terminating '\0')
+	 * @param[out] frameCounter Frame counter of packet (optional)
+	 * @param[out] arrivalTime  Arrival time of packet in s (optional)
+	 * @return                  Success?
+	 */
+	bool getPacket( int index, const char** data, size_t* len, unsigned int* frameCounter = NULL,
+	                double* arrivalTime = NULL ) const;
+
+	/**
+	 * \brief Get packet at actual position and advance position.
+	 *
+	 * @param[out] data         Data packet, terminated by '\0'; valid until the file is closed
+	 * @param[out] len          Length of data packet in bytes (without terminating '\0')
+	 * @param[out] frameCounter Frame counter of packet (optional)
+	 * @param[out] arrivalTime  Arrival time of packet in s (optional)
+	 * @return                  Success? (fails at end of recording)
+	 */
+	bool getNextPacket( const char** data, size_t* len, unsigned int* frameCounter = NULL,
+	                    double* arrivalTime = NULL );
+
+	/**
+	 * \brief Process packet at actual position and advance position.
+	 *
+	 * Uses DTrackSDK::processPacket(), so no memory is allocated. If requested, waits until the packet is
+	 * due according to the arrival times in the recording, starting with the first packet processed after
+	 * opening or seeking.
+	 *
+	 * @param[in] sdk      DTrackSDK instance to process packet
+	 * @param[in] realTime Replay at original speed? Otherwise as fast as possible
+	 * @return             Processing succeeded? (fails also at end of recording)
+	 */
+	bool processNextPacket( DTrackSDK& sdk, bool realTime = false );
+
+private:
+
+	DTrackReplay( const DTrackReplay& );             // not copyable
+	DTrackReplay& operator=( const DTrackReplay& );  // not copyable
+
+	DTrackRecordIndex getIndex( int index ) const;
+	bool buildIndex();
+
+	DTrackSys::MappedFile d_file;              //!< Mapped recording file
+	const char* d_mappedindex;                 //!< Index stored in file, NULL if not available
+	std::vector< DTrackRecordIndex > d_index;  //!< Index rebuilt when opening, if not available in file
+	int d_num;                                 //!< Number of packets
+	int d_pos;                                 //!< Actual position
+
+	bool d_has_start;   //!< Start time for replay at original speed is set
+	double d_start;     //!< Start time for replay at original speed (clock of DTrackSys::time_monotonic())
+	double d_start_rec; //!< Arrival time of first replayed packet in s
+};
+
+#endif  // _ART_DTRACKSDK_RECORD_HPP_
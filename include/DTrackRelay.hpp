@@ -0,0 +1,296 @@
+/* DTrackSDK in C++: DTrackRelay.hpp
+ *
+ * Relaying tracking data to remote consumers in a compact binary format.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_RELAY_HPP_
+#define _ART_DTRACKSDK_RELAY_HPP_
+
+#include "DTrackParser.hpp"
+#include "DTrackNet.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * \brief Decoder of compact binary frames, as sent by DTrackRelay.
+ *
+ * Provides the same methods to access tracking data as DTrackSDK.
+ *
+ * Most frames are delta-encoded against the previous frame. After a lost packet, frames cannot be
+ * decoded until the next key frame arrives.
+ */
+class DTrackRelayDecoder : public DTrackParser
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackRelayDecoder();
+
+	/**
+	 * \brief Destructor.
+	 */
+	virtual ~DTrackRelayDecoder();
+
+	/**
+	 * \brief Decode one binary frame.
+	 *
+	 * Keeps the previous frame, if the frame is waiting for a key frame or invalid. If decoding fails
+	 * later on, no tracking data is available until the next key frame. Frames with more entries of a
+	 * type than any real system sends (e.g. more than 1000 bodies or 100 Flysticks) are invalid.
+	 *
+	 * @param[in] data        Binary frame, see DTrackRelay::encode()
+	 * @param[in] len         Length of binary frame in bytes
+	 * @param[in] arrivalTime Local arrival time of binary frame in s (optional), see getArrivalTime()
+	 * @return                Success? (fails for invalid frames and while waiting for a key frame)
+	 */
+	bool decode( const char* data, int len, double arrivalTime = 0.0 );
+
+	/**
+	 * \brief Forget previous frame; next frame to be decoded has to be a key frame.
+	 */
+	void reset();
+
+	/**
+	 * \brief Returns if delta-encoded frames can be decoded.
+	 *
+	 * @return Key frame was received and no frame got lost since then?
+	 */
+	bool isSynchronized() const;
+
+	/**
+	 * \brief Get number of frames lost so far.
+	 *
+	 * Counts frames missing in the sequence and frames that couldn't be decoded, as a key frame was missing.
+	 *
+	 * @return Number of frames
+	 */
+	unsigned int getNumLost() const;
+
+private:
+
+	bool decodeFrame( const char* data, int len, bool isKey );
+
+	bool d_issync;                         //!< Previous frame is available for delta-encoded frames
+	bool d_hasseq;                         //!< Sequence number of previous frame is available
+	unsigned int d_seq;                    //!< Sequence number of previous frame
+	unsigned int d_numlost;                //!< Number of lost frames
+
+	std::vector< DTrackJoint > d_joint;    //!< Decoding ART-Human joint data
+	std::vector< int > d_jointindex;       //!< Decoding index of first joint of ART-Human models
+	std::vector< int > d_numjoints;        //!< Decoding number of joints of ART-Human models
+	std::vector< DTrackMarker > d_marker;  //!< Decoding single marker data
+};
+
+
+/**
+ * \brief Receiving compact binary frames, as sent by DTrackRelay.
+ */
+class DTrackRelayReceiver : public DTrackRelayDecoder
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 *
+	 * @param[in] port           Port number to receive binary frames (0 to choose a free one)
+	 * @param[in] multicastGroup Multicast IP address (or name) to join (optional)
+	 */
+	DTrackRelayReceiver( unsigned short port, const std::string& multicastGroup = "" );
+
+	/**
+	 * \brief Destructor.
+	 */
+	virtual ~DTrackRelayReceiver();
+
+	/**
+	 * \brief Returns if UDP socket is open to receive binary frames.
+	 *
+	 * @return Socket is open?
+	 */
+	bool isValid();
+
+	/**
+	 * \brief Get port number, where binary frames are received.
+	 *
+	 * @return Port number
+	 */
+	unsigned short getPort();
+
+	/**
+	 * \brief Receive and decode next binary frame.
+	 *
+	 * @param[in] timeoutUs Timeout in us (micro seconds)
+	 * @return              Success? (fails if timeout occured or frame couldn't be decoded)
+	 */
+	bool receive( int timeoutUs = 1000000 );
+
+private:
+
+	DTrackRelayReceiver( const DTrackRelayReceiver& );             // not copyable
+	DTrackRelayReceiver& operator=( const DTrackRelayReceiver& );  // not copyable
+
+	DTrackNet::UDP* d_udp;         //!< Socket for receiving
+	std::vector< char > d_buffer;  //!< Buffer for received packets
+};
+
+
+/**
+ * \brief Relaying tracking data to remote consumers in a compact binary format.
+ *
+ * Each frame is encoded into one packet of a versioned binary format: poses are quantized to the
+ * precision of DTrack's ASCII output and delta-encoded against the previous frame, untracked
+ * entries take a single bit. Values that aren't exactly representable that way (e.g. covariance)
+ * are sent in double or, optionally, single precision. Every few frames a key frame is sent, that
+ * doesn't need any previous frame.
+ *
+ * The packets are sent by UDP to any number of subscribers (unicast or multicast). They are decoded
+ * by DTrackRelayDecoder or DTrackRelayReceiver.
+ */
+class DTrackRelay
+{
+public:
+
+	//! Precision of values, that aren't sent as fixed-point numbers
+	typedef enum {
+		PRECISION_DOUBLE,  //!< Double precision (no loss of information)
+		PRECISION_FLOAT    //!< Single precision
+	} Precision;
+
+	static const int MAX_PACKET_SIZE = 65507;         //!< Maximum size of one encoded frame in bytes
+	static const int DEFAULT_KEYFRAME_INTERVAL = 60;  //!< Default interval of key frames in frames
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackRelay();
+
+	/**
+	 * \brief Destructor.
+	 */
+	~DTrackRelay();
+
+	/**
+	 * \brief Returns if UDP socket is open to send frames.
+	 *
+	 * @return Socket is open?
+	 */
+	bool isValid();
+
+	/**
+	 * \brief Add a subscriber.
+	 *
+	 * @param[in] host Hostname or IP address of subscriber, or multicast IP address
+	 * @param[in] port Port number of subscriber
+	 * @return         Success? (fails if host is unknown)
+	 */
+	bool addSubscriber( const std::string& host, unsigned short port );
+
+	/**
+	 * \brief Remove all subscribers.
+	 */
+	void removeSubscribers();
+
+	/**
+	 * \brief Get number of subscribers.
+	 *
+	 * @return Number of subscribers
+	 */
+	int getNumSubscribers() const;
+
+	/**
+	 * \brief Set time-to-live of multicast packets (default: 1, i.e. local network only).
+	 *
+	 * @param[in] ttl Time-to-live (number of routers to pass)
+	 * @return        Success?
+	 */
+	bool setMulticastTTL( int ttl );
+
+	/**
+	 * \brief Set precision of values, that aren't sent as fixed-point numbers (default: PRECISION_DOUBLE).
+	 *
+	 * @param[in] precision Precision
+	 */
+	void setPrecision( Precision precision );
+
+	/**
+	 * \brief Set interval of key frames (default: DEFAULT_KEYFRAME_INTERVAL).
+	 *
+	 * After a lost packet, subscribers have to wait for the next key frame.
+	 *
+	 * @param[in] numFrames Interval in frames; 1 just sends key frames
+	 */
+	void setKeyFrameInterval( int numFrames );
+
+	/**
+	 * \brief Encode next frame as key frame, e.g. when a new subscriber was added.
+	 */
+	void requestKeyFrame();
+
+	/**
+	 * \brief Encode tracking data of actual frame.
+	 *
+	 * Frames are encoded in sequence: each encoded frame has to be passed to the decoders, to allow
+	 * decoding of the following frames. Can be used for other transports than UDP.
+	 *
+	 * @param[in]  parser Parser (e.g. DTrackSDK), containing tracking data of actual frame
+	 * @param[out] buffer Buffer for encoded frame
+	 * @param[in]  maxLen Length of buffer in bytes
+	 * @return            Length of encoded frame in bytes; -1 if buffer is too small or frame is invalid
+	 */
+	int encode( const DTrackParser& parser, char* buffer, int maxLen );
+
+	/**
+	 * \brief Encode tracking data of actual frame and send it to all subscribers.
+	 *
+	 * @param[in] parser Parser (e.g. DTrackSDK), containing tracking data of actual frame
+	 * @return           Success? (fails if frame is too large or sending to one subscriber failed)
+	 */
+	bool send( const DTrackParser& parser );
+
+private:
+
+	DTrackRelay( const DTrackRelay& );             // not copyable
+	DTrackRelay& operator=( const DTrackRelay& );  // not copyable
+
+	DTrackNet::UDP* d_udp;                 //!< Socket for sending
+	std::vector< unsigned int > d_ip;      //!< IP addresses of subscribers
+	std::vector< unsigned short > d_port;  //!< Port numbers of subscribers
+
+	Precision d_precision;                 //!< Precision of values, that aren't sent as fixed-point numbers
+	int d_keyinterval;                     //!< Interval of key frames
+	int d_numsincekey;                     //!< Number of frames since last key frame; -1 if key frame requested
+	unsigned int d_seq;                    //!< Sequence number of next frame
+
+	DTrackRelayDecoder d_ref;              //!< Last encoded frame, as seen by decoders
+	std::vector< char > d_buffer;          //!< Buffer for encoded frames
+};
+
+#endif  // _ART_DTRACKSDK_RELAY_HPP_
@@ -28,7 +28,7 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
- * Version v2.9.0
+ * Version v2.10.0
  *
  * Purpose:
  *  - receives DTrack UDP packets (ASCII protocol) and converts them into easier to handle data
@@ -62,9 +62,20 @@
 #include "DTrackDataTypes.hpp"
 #include "DTrackNet.hpp"
 #include "DTrackParser.hpp"
+#include "DTrackFrame.hpp"
+#include "DTrackStatistics.hpp"
+#include "DTrackRecord.hpp"
+#include "DTrackParamCache.hpp"
+#include "DTrackMessagePoller.hpp"
+#include "DTrackConnector.hpp"
+#include "DTrackFeedback.hpp"
+#include "DTrackHistory.hpp"
+#include "DTrackShared.hpp"
+#include "DTrackSys.hpp"
 
 #include <string>
 #include <vector>
+#include <deque>
 
 //! Max message size; DEPRECATED
 #define DTRACK_PROT_MAXLEN  DTrackSDK::DTRACK2_PROT_MAXLEN
@@ -106,8 +117,11 @@ public:
 	 * - "atc-301422002:5000" : Hostname of Controller and port number (UDP), use for communicating mode.
 	 * - "192.168.0.1:5000" : IP address of Controller and port number (UDP), use for communicating mode.
 	 * - "atc-301422002:5000:fw" : Hostname of C. and port number (UDP), use for listening mode with stateful firewall.
+	 * - "atc-301422002:5000:async" : Hostname of C. and port number (UDP), use for communicating mode without waiting
+	 *   for the Controller; see enableAutoReconnect().
 	 *
-	 * @param[in] connection Connection string ("<data port>" or "<ip/host>:<data port>" or "<ip/host>:<data port>:fw")
+	 * @param[in] connection Connection string ("<data port>" or "<ip/host>:<data port>" or "<ip/host>:<data port>:fw"
+	 *                       or "<ip/host>:<data port>:async")
 	 */
 	DTrackSDK( const std::string& connection );
 
@@ -243,6 +257,29 @@ public:
 	 */
 	bool isCommandInterfaceFullAccess();
 
+	/**
+	 * \brief Enable or disable establishing the TCP connection for DTrack2/DTRACK3 commands in background.
+	 *
+	 * A thread resolves the hostname and connects to the Controller, repeating failed attempts with increasing
+	 * waiting times (between 0.1 s and 5 s). A broken connection is established again in the same way. Receiving
+	 * tracking data never waits for this. The connection is used by the next command sent after it got
+	 * established.
+	 *
+	 * Enabled at once by connection string "<ip/host>:<data port>:async"; then isValid() fails until connected.
+	 * Just for communicating mode with DTrack2/DTRACK3.
+	 *
+	 * @param[in] enable Enable?
+	 * @return           Success?
+	 */
+	bool enableAutoReconnect( bool enable = true );
+
+	/**
+	 * \brief Returns if TCP connection for DTrack2/DTRACK3 commands is being established in background.
+	 *
+	 * @return Connecting? (also if started by enableAutoReconnect() and connection is broken)
+	 */
+	bool isCommandInterfaceConnecting() const;
+
 	/**
 	 * \brief Get current remote system type (e.g. DTrack1, DTrack2/DTRACK3).
 	 *
@@ -284,6 +321,63 @@ public:
 	 */
 	bool setDataBufferSize( int bufSize );
 
+	/**
+	 * \brief Get UDP buffer size for receiving tracking data.
+	 *
+	 * @return Buffer size in bytes
+	 */
+	int getDataBufferSize() const;
+
+	/**
+	 * \brief Enable or disable automatic growth of the UDP buffer for receiving tracking data.
+	 *
+	 * A packet, that didn't fit into the buffer, is lost. Then the buffer size is doubled until the packet would
+	 * fit, not exceeding the maximum size; the new buffer is used from the next receive on. Enabled by default.
+	 *
+	 * @param[in] enable     Enable?
+	 * @param[in] maxBufSize Maximum buffer size in bytes; 0 to set default (65536, fits any UDP packet)
+	 * @return               Success? (i.e. valid size)
+	 */
+	bool enableDataBufferGrowth( bool enable = true, int maxBufSize = 0 );
+
+	/**
+	 * \brief Set size of the kernel receive buffer of the UDP socket for tracking data (SO_RCVBUF).
+	 *
+	 * A larger buffer keeps more packets, if receive() is not called often enough; otherwise the kernel drops
+	 * packets (see DTrackStatistics::getNumKernelDropped()). The system might limit the size, e.g. by
+	 * net.core.rmem_max on Linux.
+	 *
+	 * @param[in] bufSize Buffer size in bytes
+	 * @return            Success?
+	 */
+	bool setDataSocketBufferSize( int bufSize );
+
+	/**
+	 * \brief Get size of the kernel receive buffer of the UDP socket for tracking data.
+	 *
+	 * @return Buffer size in bytes as reported by the system (Linux reports twice the set size), -1 if error occured
+	 */
+	int getDataSocketBufferSize() const;
+
+	/**
+	 * \brief Set busy polling of the UDP socket for tracking data (SO_BUSY_POLL).
+	 *
+	 * Reduces latency at the expense of CPU usage. Just supported on Linux; needs according privileges to
+	 * increase the time above the system default.
+	 *
+	 * @param[in] us Busy polling time in us (micro seconds); 0 to disable
+	 * @return       Success?
+	 */
+	bool setDataBusyPoll( int us );
+
+	/**
+	 * \brief Set maximum number of tracking data packets received at once by receiveAll().
+	 *
+	 * @param[in] numPackets Maximum number of packets; 0 to set default (32)
+	 * @return               Success? (i.e. valid number)
+	 */
+	bool setDataBatchSize( int numPackets );
+
 	/**
 	 * \brief Enable UDP connection through a stateful firewall.
 	 *
@@ -307,6 +401,30 @@ public:
 	 */
 	bool receive();
 
+	/**
+	 * \brief Receive all waiting tracking data packets at once.
+	 *
+	 * This method waits until a data packet becomes available, but no longer than the timeout. Then all
+	 * further packets already waiting are received as well, up to the batch size (see setDataBatchSize());
+	 * remaining packets stay queued for the next call. Unlike receive(), no packet is discarded.
+	 *
+	 * Does not update internal data structures; call processFrame() for each received packet.
+	 *
+	 * @return Number of received packets; 0 in case of error (refer to getLastDataError())
+	 */
+	int receiveAll();
+
+	/**
+	 * \brief Process one tracking data packet received by last call of receiveAll().
+	 *
+	 * Updates internal data structures. Data of the previous frame stays unchanged, if there is no packet
+	 * at this index.
+	 *
+	 * @param[in] index Index of packet (oldest first), range 0 .. ( return value of receiveAll() ) - 1
+	 * @return          Processing succeeded?
+	 */
+	bool processFrame( int index );
+
 	/**
 	 * \brief Process one tracking packet manually.
 	 *
@@ -317,6 +435,20 @@ public:
 	 */
 	bool processPacket( const std::string& data );
 
+	/**
+	 * \brief Process one tracking packet manually, parsing a buffer in place.
+	 *
+	 * This requires no connection to a Controller. Updates internal data structures. The buffer is
+	 * neither copied nor modified, as long as it ends with a line break or '\0' (otherwise it's copied
+	 * into the UDP buffer first). No memory is allocated. The arrival time of the frame (see
+	 * getArrivalTime()) is set to the time of this call.
+	 *
+	 * @param[in] data Data packet to be processed
+	 * @param[in] len  Length of data packet in bytes
+	 * @return         Processing succeeded?
+	 */
+	bool processPacket( const char* data, size_t len );
+
 	/**
 	 * \brief Get content of the UDP buffer.
 	 * 
@@ -324,6 +456,197 @@ public:
 	 */
 	std::string getBuf() const;
 
+	/**
+	 * \brief Enable or disable snapshots of tracking data for other threads.
+	 *
+	 * If enabled, each processed frame is published as snapshot, that one other thread can get by
+	 * acquireLatestFrame() without blocking or being blocked by the thread receiving tracking data.
+	 * Enable before receiving tracking data.
+	 *
+	 * @param[in] enable Enable snapshots?
+	 * @return           Success?
+	 */
+	bool enableFrameSnapshots( bool enable = true );
+
+	/**
+	 * \brief Get snapshot of latest processed frame.
+	 *
+	 * To be called by exactly one thread, which may be different from the thread receiving tracking
+	 * data. Snapshots have to be enabled by enableFrameSnapshots(). The returned snapshot doesn't
+	 * change until the next call of this method.
+	 *
+	 * @return Snapshot of latest processed frame; NULL if not available
+	 */
+	const DTrackFrame* acquireLatestFrame();
+
+	/**
+	 * \brief Enable or disable statistics about received tracking data.
+	 *
+	 * If enabled, received and processed frames are counted, i.e. discarded or missing frames and
+	 * packets too large for the UDP buffer. Additionally the inter-arrival jitter and the parse time
+	 * of each line are collected. Enable before receiving tracking data; disable just if no other
+	 * thread is accessing the statistics.
+	 *
+	 * @param[in] enable Enable statistics?
+	 * @return           Success?
+	 */
+	bool enableStatistics( bool enable = true );
+
+	/**
+	 * \brief Get statistics about received tracking data.
+	 *
+	 * Statistics have to be enabled by enableStatistics(). May be read by any thread, while tracking
+	 * data is received.
+	 *
+	 * @return Statistics; NULL if not enabled
+	 */
+	DTrackStatistics* getStatistics();
+
+	/**
+	 * \brief Start recording of tracking data into a binary file.
+	 *
+	 * Each successfully processed frame is appended as raw packet, together with its frame counter and
+	 * arrival time. Recordings can be replayed by DTrackReplay.
+	 *
+	 * @param[in] filename Name of file; an existing file is overwritten
+	 * @return             Success?
+	 */
+	bool startRecording( const std::string& filename );
+
+	/**
+	 * \brief Stop recording of tracking data, writing the index of the file.
+	 *
+	 * @return Success? (fails also if no recording was started)
+	 */
+	bool stopRecording();
+
+	/**
+	 * \brief Returns if tracking data is recorded.
+	 *
+	 * @return Recording?
+	 */
+	bool isRecording() const;
+
+	/**
+	 * \brief Enable or disable history of poses.
+	 *
+	 * If enabled, the poses of each processed frame are appended to ring buffers, see DTrackHistory.
+	 * Enable before receiving tracking data. The history is not thread-safe; access it just by the
+	 * thread receiving tracking data (e.g. within the function called by startReceiving()).
+	 *
+	 * @param[in] enable   Enable history?
+	 * @param[in] capacity Number of frames kept per target; adjustable per type by DTrackHistory::setCapacity()
+	 * @return             Success?
+	 */
+	bool enableHistory( bool enable = true, int capacity = 120 );
+
+	/**
+	 * \brief Get history of poses.
+	 *
+	 * History has to be enabled by enableHistory().
+	 *
+	 * @return History; NULL if not enabled
+	 */
+	DTrackHistory* getHistory();
+
+	/**
+	 * \brief Start publishing of tracking data into shared memory.
+	 *
+	 * Each successfully processed frame is published, so other processes on the same system can read it
+	 * by DTrackSharedReader without receiving and parsing it again.
+	 *
+	 * @param[in] name     Name of shared memory (e.g. 'dtrack'), without slashes; an existing one is replaced
+	 * @param[in] numSlots Number of recent frames available to readers
+	 * @param[in] slotSize Maximum size of one frame in bytes (see DTrackParser::getFrameImageSize())
+	 * @return             Success?
+	 */
+	bool startPublishing( const std::string& name, int numSlots = DTrackSharedPublisher::DEFAULT_NUM_SLOTS,
+	                      int slotSize = DTrackSharedPublisher::DEFAULT_SLOT_SIZE );
+
+	/**
+	 * \brief Stop publishing of tracking data, removing the shared memory.
+	 */
+	void stopPublishing();
+
+	/**
+	 * \brief Returns if tracking data is published into shared memory.
+	 *
+	 * @return Publishing?
+	 */
+	bool isPublishing() const;
+
+	/**
+	 * \brief Type of a function called by the receiving thread for each frame.
+	 *
+	 * @param[in] frame    Tracking data of actual frame; valid just during the call
+	 * @param[in] userData Pointer given when starting the thread
+	 */
+	typedef void ( *FrameCallback )( const DTrackParser& frame, void* userData );
+
+	/**
+	 * \brief Start thread receiving and processing tracking data, calling a function for each frame.
+	 *
+	 * All received packets are processed, none is discarded. While the thread is running, tracking
+	 * data should be accessed just by the callback function or by snapshots (see enableFrameSnapshots()).
+	 * The other methods of DTrackSDK shouldn't be used, except for commands to the Controller.
+	 * After a receiving error (other than a timeout) the thread waits up to 0.1 s before trying again.
+	 *
+	 * @param[in] callback Function called by the receiving thread for each frame
+	 * @param[in] userData Pointer passed to the callback function
+	 * @param[in] cpu      Index of CPU to bind the receiving thread to; -1 if not
+	 * @param[in] realtime Try to set real-time priority for the receiving thread (usually requires privileges)
+	 * @return             Success? (fails also if already running)
+	 */
+	bool startReceiving( FrameCallback callback, void* userData = NULL, int cpu = -1, bool realtime = false );
+
+	/**
+	 * \brief Start thread receiving and processing tracking data, adding each frame to a queue.
+	 *
+	 * Another thread gets the frames with acquireQueuedFrame() and releaseQueuedFrame(). If the
+	 * queue is full, new frames are dropped. Also refer to startReceiving().
+	 *
+	 * @param[in] queueSize Maximum number of frames in queue
+	 * @param[in] cpu       Index of CPU to bind the receiving thread to; -1 if not
+	 * @param[in] realtime  Try to set real-time priority for the receiving thread (usually requires privileges)
+	 * @return              Success? (fails also if already running)
+	 */
+	bool startReceivingQueued( int queueSize, int cpu = -1, bool realtime = false );
+
+	/**
+	 * \brief Stop thread receiving and processing tracking data.
+	 *
+	 * Waits until the thread is finished.
+	 */
+	void stopReceiving();
+
+	/**
+	 * \brief Returns if thread receiving and processing tracking data is running.
+	 *
+	 * @return Thread is running?
+	 */
+	bool isReceiving() const;
+
+	/**
+	 * \brief Get oldest frame in queue of receiving thread.
+	 *
+	 * To be called by exactly one thread. The frame stays valid until releaseQueuedFrame() is called.
+	 *
+	 * @return Oldest frame; NULL if queue is empty
+	 */
+	const DTrackFrame* acquireQueuedFrame();
+
+	/**
+	 * \brief Remove oldest frame from queue of receiving thread.
+	 */
+	void releaseQueuedFrame();
+
+	/**
+	 * \brief Get number of frames dropped as the queue of receiving thread was full.
+	 *
+	 * @return Number of dropped frames
+	 */
+	int getNumDroppedQueuedFrames() const;
+
 
 	/**
 	 * \brief Get last error at receiving tracking data (data transmission).
@@ -444,6 +767,112 @@ public:
 	 */
 	bool getParam(const std::string& parameter, std::string& value);
 
+	/**
+	 * \brief Set several DTrack2/DTRACK3 parameters at once.
+	 *
+	 * The commands are pipelined on the TCP connection, so setting many parameters doesn't need a
+	 * network round trip per parameter.
+	 *
+	 * @param[in] parameters Complete parameter strings without starting "dtrack set "
+	 * @return               Success of all parameters? (if not, a DTrack error message is available)
+	 */
+	bool setParams( const std::vector< std::string >& parameters );
+
+	/**
+	 * \brief Get several DTrack2/DTRACK3 parameters at once.
+	 *
+	 * The commands are pipelined on the TCP connection, so getting many parameters doesn't need a
+	 * network round trip per parameter.
+	 *
+	 * @param[in]  parameters Complete parameter strings without starting "dtrack get "
+	 * @param[out] values     Parameter values, same order as parameters (empty string if failed)
+	 * @return                Success of all parameters? (if not, a DTrack error message is available)
+	 */
+	bool getParams( const std::vector< std::string >& parameters, std::vector< std::string >& values );
+
+	/**
+	 * \brief Type of function called with the answer of an asynchronous DTrack2/DTRACK3 command.
+	 *
+	 * @param[in] result   Result of command, see return values of sendDTrack2Command()
+	 * @param[in] answer   Answer string of DTrack (empty string in case of error)
+	 * @param[in] userData Pointer given to sendDTrack2CommandAsync()
+	 */
+	typedef void ( *CommandCallback )( int result, const std::string& answer, void* userData );
+
+	/**
+	 * \brief Send DTrack2/DTRACK3 command to DTrack without waiting for the answer (TCP command interface).
+	 *
+	 * Several commands can be pending; their answers arrive in order and are handled by
+	 * processDTrack2Answers() or waitDTrack2Commands(). If already DTRACK2_PIPELINE_DEPTH commands are
+	 * pending, waits for the oldest answer before sending.
+	 *
+	 * @param[in] command  DTrack2 command string
+	 * @param[in] callback Function called with the answer; NULL if answer is not needed
+	 * @param[in] userData Pointer passed to the callback function
+	 * @return 0   Command was sent
+	 * @return <0  if error occured (see sendDTrack2Command())
+	 */
+	int sendDTrack2CommandAsync( const std::string& command, CommandCallback callback = NULL, void* userData = NULL );
+
+	/**
+	 * \brief Process answers of pending asynchronous DTrack2/DTRACK3 commands.
+	 *
+	 * Calls the callback function for each answer that has been received.
+	 *
+	 * @param[in] timeoutUs Timeout in us (micro seconds) to wait for the first answer, 0 if not waiting
+	 * @return              Number of processed answers; <0 if error occured (see sendDTrack2Command())
+	 */
+	int processDTrack2Answers( int timeoutUs = 0 );
+
+	/**
+	 * \brief Wait for answers of all pending asynchronous DTrack2/DTRACK3 commands.
+	 *
+	 * @return Success? (if not, a transmission error is available)
+	 */
+	bool waitDTrack2Commands();
+
+	/**
+	 * \brief Get number of pending asynchronous DTrack2/DTRACK3 commands.
+	 *
+	 * @return Number of commands waiting for their answer
+	 */
+	int getNumPendingDTrack2Commands() const;
+
+	/**
+	 * \brief Enable or disable client-side cache of DTrack2/DTRACK3 parameters.
+	 *
+	 * If enabled, getParam() and getParams() use cached values where available, and store the values
+	 * they got from the Controller. Entries are removed when the parameter is set by this DTrackSDK.
+	 * Changes done by other clients are noticed only after the TTL of an entry expired.
+	 *
+	 * @param[in] enable Enable cache?
+	 * @param[in] ttl    TTL (time to live) of new entries in s; 0 if entries never expire
+	 * @return           Success?
+	 */
+	bool enableParamCache( bool enable = true, double ttl = 0.0 );
+
+	/**
+	 * \brief Get client-side cache of DTrack2/DTRACK3 parameters.
+	 *
+	 * Cache has to be enabled by enableParamCache().
+	 *
+	 * @return Parameter cache; NULL if not enabled
+	 */
+	DTrackParamCache* getParamCache();
+
+	/**
+	 * \brief Fill client-side cache with several DTrack2/DTRACK3 parameters.
+	 *
+	 * Gets all parameters from the Controller in one pipelined pass, also if they are already cached.
+	 * Cache has to be enabled by enableParamCache().
+	 *
+	 * @param[in] parameters Parameter strings containing category and name, e.g. all parameters of a category
+	 * @param[in] ttl        TTL of entries in s (0 if never expiring); <0 to use TTL of existing entries,
+	 *                       or the default TTL
+	 * @return               Success of all parameters? (if not, a DTrack error message is available)
+	 */
+	bool prefetchParams( const std::vector< std::string >& parameters, double ttl = -1.0 );
+
 
 	/**
 	 * \brief Get DTrack2/DTRACK3 event message from the Controller.
@@ -490,6 +919,42 @@ public:
 	 */
 	std::string getMessageMsg() const;
 
+	/**
+	 * \brief Get all waiting DTrack2/DTRACK3 event messages from the Controller.
+	 *
+	 * Requests are pipelined on the TCP connection, so a backlog of messages doesn't need a network
+	 * round trip per message. Doesn't change the last message returned by getMessage().
+	 *
+	 * @param[out] messages Messages, oldest first; existing entries are reused
+	 * @param[in]  maxCount Maximum number of messages to get
+	 * @return              Number of messages (if error occured, refer to getLastServerError())
+	 */
+	int getMessages( std::vector< DTrackMessage >& messages, int maxCount = 100 );
+
+	/**
+	 * \brief Start thread polling DTrack2/DTRACK3 event messages in background.
+	 *
+	 * The thread uses its own TCP connection to the Controller, so commands are not blocked by
+	 * polling. Get the messages by getMessagePoller()->pop(), from exactly one thread.
+	 *
+	 * @param[in] intervalUs Polling interval in us (micro seconds)
+	 * @param[in] queueSize  Maximum number of messages in queue
+	 * @return               Success?
+	 */
+	bool startMessagePoller( int intervalUs = 1000000, int queueSize = 256 );
+
+	/**
+	 * \brief Stop thread polling DTrack2/DTRACK3 event messages.
+	 */
+	void stopMessagePoller();
+
+	/**
+	 * \brief Get background polling of DTrack2/DTRACK3 event messages.
+	 *
+	 * @return Message poller; NULL if not started by startMessagePoller()
+	 */
+	DTrackMessagePoller* getMessagePoller();
+
 
 	/**
 	 * \brief Send tactile FINGERTRACKING command to set feedback on a specific finger of a specific hand.
@@ -558,9 +1023,27 @@ public:
 	 */
 	bool flystickVibration( int flystickId, int vibrationPattern );
 
+	/**
+	 * \brief Send collected feedback commands for tactile FINGERTRACKING devices and Flysticks.
+	 *
+	 * Sends at most one datagram for all tactile feedback and one for all Flystick feedback. Commands
+	 * kept back due to the rate limit of their device stay in the batch for the next call, as well as
+	 * commands whose datagram couldn't be sent.
+	 *
+	 * Sends commands to the sender IP address of the latest received UDP data, if no hostname or IP address
+	 * of a Controller is defined.
+	 *
+	 * @param[in,out] batch Collected feedback commands; sent commands are removed
+	 * @return              Success? (if not, getLastDataError() reports the error)
+	 */
+	bool sendFeedback( DTrackFeedbackBatch& batch );
+
 
 private:
 
+	friend class DTrackMultiReceiver;  // needs access to UDP socket
+	friend class DTrackMessagePoller;  // needs access to message parsing
+
 	static const unsigned short DTRACK2_PORT_COMMAND = 50105;  //!< Controller port number (TCP) for 'dtrack2' commands
 	static const unsigned short DTRACK2_PORT_UDPSENDER = 50107;  //!< Controller port number (UDP) of tracking data sender
 	static const unsigned short DTRACK2_PORT_FEEDBACK = 50110;  //!< Controller port number (UDP) for feedback commands
@@ -568,6 +1051,20 @@ private:
 	static const int DEFAULT_TCP_TIMEOUT = 10000000;  //!< default TCP timeout (in us)
 	static const int DEFAULT_UDP_TIMEOUT = 1000000;   //!< default UDP timeout (in us)
 	static const int DEFAULT_UDP_BUFSIZE = 32768;     //!< default UDP buffer size (in bytes)
+	static const int DEFAULT_UDP_MAXBUFSIZE = 65536;  //!< default maximum size of growing UDP buffer (in bytes)
+	static const int DEFAULT_UDP_BATCHSIZE = 32;      //!< default number of UDP packets received at once
+	static const int RECEIVE_THREAD_TIMEOUT = 100000; //!< maximum UDP timeout of receiving thread (in us)
+	static const int DTRACK2_PIPELINE_DEPTH = 32;     //!< maximum number of pending 'dtrack2' commands
+	static const int CONNECT_TIMEOUT = 1000000;       //!< timeout of one connection attempt in background (in us)
+	static const int RECONNECT_MIN_BACKOFF = 100000;  //!< waiting time after first failed connection attempt (in us)
+	static const int RECONNECT_MAX_BACKOFF = 5000000; //!< maximum waiting time between connection attempts (in us)
+
+	//! Pending asynchronous 'dtrack2' command
+	struct PendingCommand
+	{
+		CommandCallback callback;  //!< function called with the answer (NULL if not used)
+		void* userData;            //!< pointer passed to callback function
+	};
 
 	/**
 	 * \brief Set last DTrack2/DTRACK3 command error.
@@ -584,9 +1081,84 @@ private:
 	 * @param[in] server_port Port number (UDP) of DTrack1 PC to send commands to (0 if not used)
 	 * @param[in] data_port   Port number (UDP) to receive tracking data from DTrack (0 if to be chosen)
 	 * @param[in] remote_type Type of system to connect to
+	 * @param[in] isAsync     Establish TCP connection in background, see enableAutoReconnect()
 	 */
 	void init( const std::string& server_host, unsigned short server_port, unsigned short data_port,
-	           RemoteSystemType remote_type );
+	           RemoteSystemType remote_type, bool isAsync = false );
+
+	/**
+	 * \brief Private init of default values called by constructor.
+	 *
+	 * @param[in] remote_type Type of system to connect to
+	 */
+	void initDefaults( RemoteSystemType remote_type );
+
+	/**
+	 * \brief Take TCP connection established in background, if available.
+	 */
+	void updateCommandInterface();
+
+	/**
+	 * \brief Receive and process one tracking data packet, with timeout.
+	 *
+	 * @param[in] timeoutUs Timeout in us (micro seconds), 0 if not waiting
+	 * @return              Receive succeeded?
+	 */
+	bool receiveFrame( int timeoutUs );
+
+	/**
+	 * \brief Enlarge UDP buffer, if planned by checkDataSocket().
+	 */
+	void growDataBuffer();
+
+	/**
+	 * \brief Check UDP socket after receiving: plan growth of UDP buffer, count packets dropped by the kernel.
+	 */
+	void checkDataSocket();
+
+	/**
+	 * \brief Process all lines of one tracking data packet.
+	 *
+	 * Updates internal data structures and last data error. Expects startFrame() to be called before.
+	 *
+	 * @param[in] data        Data packet, terminated by '\0' or line break
+	 * @param[in] len         Length of data packet in bytes
+	 * @param[in] arrivalTime Arrival time of data packet in s (clock of DTrackSys::time_monotonic())
+	 * @return                Processing succeeded?
+	 */
+	bool parsePacket( const char* data, int len, double arrivalTime );
+
+	/**
+	 * \brief Receive all waiting tracking data packets at once, with timeout.
+	 *
+	 * @param[in] timeoutUs Timeout for receiving tracking data in us
+	 * @return              Number of received packets; 0 in case of error (refer to getLastDataError())
+	 */
+	int receiveBatch( int timeoutUs );
+
+	/**
+	 * \brief Start thread receiving and processing tracking data.
+	 *
+	 * @param[in] callback  Function called for each frame; NULL if not used
+	 * @param[in] userData  Pointer passed to the callback function
+	 * @param[in] queueSize Maximum number of frames in queue; 0 if no queue
+	 * @param[in] cpu       Index of CPU to bind the receiving thread to; -1 if not
+	 * @param[in] realtime  Try to set real-time priority for the receiving thread
+	 * @return              Success?
+	 */
+	bool startReceiveThread( FrameCallback callback, void* userData, int queueSize, int cpu, bool realtime );
+
+	/**
+	 * \brief Thread function of receiving thread.
+	 *
+	 * @param[in] arg Pointer to DTrackSDK
+	 */
+	static void receiveThread( void* arg );
+
+	/**
+	 * \brief Receive and process tracking data, until receiving thread is stopped.
+	 */
+	void receiveLoop();
 
 	/**
 	 * \brief Send dummy UDP packet for stateful firewall.
@@ -600,10 +1172,100 @@ private:
 	/**
 	 * \brief Send feedback command via UDP.
 	 *
-	 * @param[in] command Command string
-	 * @return            Sending command succeeded? If not, a DTrack error is available
+	 * @param[in] command Command string, terminated by '\0'
+	 * @param[in] len     Length of command string
+	 * @return            Sending command succeeded? If not, getLastDataError() reports the error
+	 */
+	bool sendFeedbackCommand( const char* command, int len );
+
+	/**
+	 * \brief Send DTrack2/DTRACK3 command to DTrack, without receiving the answer.
+	 *
+	 * @param[in] command DTrack2 command string
+	 * @return            0 if sent; <0 if error occured (see sendDTrack2Command())
 	 */
-	bool sendFeedbackCommand( const std::string& command );
+	int sendDTrack2Request( const std::string& command );
+
+	/**
+	 * \brief Receive next answer of DTrack2/DTRACK3 from TCP connection.
+	 *
+	 * Answers are terminated by '\0'; data following an answer is kept for the next call.
+	 *
+	 * @param[out] ans       Answer string
+	 * @param[in]  timeoutUs Timeout in us (micro seconds)
+	 * @return               0 if received; <0 if error occured (see sendDTrack2Command())
+	 */
+	int receiveDTrack2Answer( std::string& ans, int timeoutUs );
+
+	/**
+	 * \brief Close TCP connection to DTrack2/DTRACK3 after an error.
+	 *
+	 * Reconnects in background, if enabled. Callback functions of pending asynchronous commands are called
+	 * with error -9.
+	 */
+	void dropCommandInterface();
+
+	/**
+	 * \brief Parse answer of DTrack2/DTRACK3.
+	 *
+	 * @param[in]  ans    Answer string
+	 * @param[out] answer Buffer for specific answer; NULL if not needed
+	 * @return            0 specific answer, 1 "dtrack2 ok", 2 "dtrack2 err ..", <0 if parse error
+	 */
+	int parseDTrack2Answer( const std::string& ans, std::string* answer );
+
+	/**
+	 * \brief Receive answer of oldest pending asynchronous command and call its callback function.
+	 *
+	 * @param[in] timeoutUs Timeout in us (micro seconds)
+	 * @return              0 if processed; <0 if error occured (see sendDTrack2Command())
+	 */
+	int processDTrack2Answer( int timeoutUs );
+
+	/**
+	 * \brief Send several DTrack2/DTRACK3 commands pipelined, and receive their answers.
+	 *
+	 * If an answer times out, the commands still on the way are kept as pending commands, so their late
+	 * answers are skipped by the next command. Other errors close the TCP connection.
+	 *
+	 * @param[in]  commands DTrack2 command strings
+	 * @param[out] results  Result per command, see return values of sendDTrack2Command()
+	 * @param[out] answers  Specific answer per command (empty string if none)
+	 * @return              Transmission succeeded? (if not, not all results are valid)
+	 */
+	bool sendDTrack2Commands( const std::vector< std::string >& commands, std::vector< int >& results,
+	                          std::vector< std::string >& answers );
+
+	/**
+	 * \brief Get parameter value from answer to "dtrack2 get" command.
+	 *
+	 * @param[in]  res       Answer of DTrack2/DTRACK3
+	 * @param[in]  parameter Parameter string without starting "dtrack get "
+	 * @param[out] value     Parameter value
+	 * @return               Parsing succeeded?
+	 */
+	bool parseParamAnswer( const std::string& res, const std::string& parameter, std::string& value );
+
+	/**
+	 * \brief Get several DTrack2/DTRACK3 parameters, optionally using the parameter cache.
+	 *
+	 * @param[in]  parameters Parameter strings containing category and name
+	 * @param[out] values     Parameter values, same order as parameters (empty string if failed)
+	 * @param[in]  useCache   Use cached values if available?
+	 * @param[in]  ttl        TTL for storing values in cache (see DTrackParamCache::set())
+	 * @return                Success of all parameters?
+	 */
+	bool fetchParams( const std::vector< std::string >& parameters, std::vector< std::string >& values,
+	                  bool useCache, double ttl );
+
+	/**
+	 * \brief Parse answer to "dtrack2 getmsg" command.
+	 *
+	 * @param[in]  res     Answer of DTrack2/DTRACK3
+	 * @param[out] message Message
+	 * @return             Answer contains a message?
+	 */
+	static bool parseMessage( const std::string& res, DTrackMessage& message );
 
 	RemoteSystemType rsType;            //!< Remote system type
 	Errors lastDataError;               //!< last transmission error (tracking data)
@@ -614,6 +1276,12 @@ private:
 
 	DTrackNet::TCP* d_tcp;              //!< socket for TCP
 	int d_tcptimeout_us;                //!< timeout for receiving and sending TCP data
+	std::string d_tcpbuf;               //!< received TCP data following the last processed answer
+	std::deque< PendingCommand > d_tcppending;  //!< asynchronous commands waiting for their answer
+	DTrackParamCache* d_paramcache;     //!< cache of DTrack2/DTRACK3 parameters (NULL if disabled)
+	DTrackMessagePoller* d_msgpoller;   //!< background polling of event messages (NULL if not running)
+	DTrackConnector* d_connector;       //!< background connecting of TCP connection (NULL if disabled)
+	std::string d_remoteHost;           //!< hostname or IP address of Controller/DTrack1 PC (empty if unknown)
 
 	DTrackNet::UDP* d_udp;              //!< socket for UDP
 	unsigned int d_remoteIp;            //!< IP address of Controller/DTrack1 PC (0 if unknown)
@@ -623,13 +1291,33 @@ private:
 	unsigned short d_udpSenderPort;     //<! Port number from which Controller is sending tracking data
 
 	int d_udpbufsize;                   //!< size of UDP buffer
+	int d_udpbufmaxsize;                //!< maximum size of UDP buffer when growing (0 if growth is disabled)
+	int d_udpbufgrowsize;               //!< new size of UDP buffer before next receive (0 if not growing)
+	unsigned int d_udpkerneldropped;    //!< number of packets dropped by the kernel, as of latest receive
 	char* d_udpbuf;                     //!< UDP buffer
-
-	std::string d_message_origin;       //!< last DTrack2 message: origin of message
-	std::string d_message_status;       //!< last DTrack2 message: status of message
-	unsigned int d_message_framenr;     //!< last DTrack2 message: frame counter
-	unsigned int d_message_errorid;     //!< last DTrack2 message: error id
-	std::string d_message_msg;          //!< last DTrack2 message: message string
+	const char* d_udpdata;              //!< last processed packet within UDP buffers
+
+	int d_udpbatchsize;                 //!< maximum number of UDP packets received at once
+	char* d_udpbatchbuf;                //!< UDP buffer for receiving several packets (d_udpbatchsize slots)
+	int* d_udpbatchlen;                 //!< length of received packets per slot
+	double* d_udpbatchtime;             //!< arrival time of received packets per slot
+	int d_udpbatchnum;                  //!< number of packets received by last receiveAll()
+
+	DTrackFrameBuffer* d_framebuf;      //!< snapshots of processed frames for other threads (NULL if disabled)
+	DTrackStatistics* d_statistics;     //!< statistics about received tracking data (NULL if disabled)
+	DTrackRecorder* d_recorder;         //!< recording of tracking data (NULL if not recording)
+	DTrackHistory* d_history;           //!< history of poses (NULL if disabled)
+	DTrackSharedPublisher* d_publisher; //!< publishing into shared memory (NULL if not publishing)
+
+	DTrackSys::Thread* d_thread;        //!< receiving thread (NULL if not running)
+	volatile int d_threadstop;          //!< receiving thread: request to stop
+	FrameCallback d_threadcallback;     //!< receiving thread: function called for each frame (NULL if not used)
+	void* d_threadcallbackdata;         //!< receiving thread: pointer passed to callback function
+	DTrackFrameQueue* d_threadqueue;    //!< receiving thread: queue of frames (NULL if not used)
+	int d_threadcpu;                    //!< receiving thread: index of CPU to bind to (-1 if not)
+	bool d_threadrealtime;              //!< receiving thread: try to set real-time priority
+
+	DTrackMessage d_message;            //!< last DTrack2 message
 };
 
 
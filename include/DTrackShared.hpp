@@ -0,0 +1,196 @@
+/* DTrackSDK in C++: DTrackShared.hpp
+ *
+ * Passing frames to other processes by shared memory.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_SHARED_HPP_
+#define _ART_DTRACKSDK_SHARED_HPP_
+
+#include "DTrackParser.hpp"
+#include "DTrackFrame.hpp"
+#include "DTrackSys.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * \brief Publishing frames into shared memory, for other processes on the same system.
+ *
+ * Frames are stored as binary images (see DTrackParser::writeFrameImage()) in a ring of slots. Each slot
+ * is protected by a sequence counter (seqlock), so the publisher never waits for readers and readers
+ * never block the publisher. Readers (see DTrackSharedReader) have to use the same version of DTrackSDK.
+ */
+class DTrackSharedPublisher
+{
+public:
+
+	static const int DEFAULT_NUM_SLOTS = 16;          //!< Default number of slots
+	static const int DEFAULT_SLOT_SIZE = 256 * 1024;  //!< Default size of one slot in bytes
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackSharedPublisher();
+
+	/**
+	 * \brief Destructor. Removes the shared memory.
+	 */
+	~DTrackSharedPublisher();
+
+	/**
+	 * \brief Create shared memory.
+	 *
+	 * An existing shared memory with the same name is replaced.
+	 *
+	 * @param[in] name     Name of shared memory (e.g. 'dtrack'), without slashes
+	 * @param[in] numSlots Number of slots, i.e. number of recent frames available to readers; rounded up to a power of two
+	 * @param[in] slotSize Size of one slot in bytes; limits the size of a frame
+	 * @return             Success?
+	 */
+	bool open( const std::string& name, int numSlots = DEFAULT_NUM_SLOTS, int slotSize = DEFAULT_SLOT_SIZE );
+
+	/**
+	 * \brief Remove shared memory.
+	 */
+	void close();
+
+	/**
+	 * \brief Returns if shared memory was created.
+	 *
+	 * @return Created?
+	 */
+	bool isOpen() const;
+
+	/**
+	 * \brief Publish tracking data of actual frame.
+	 *
+	 * @param[in] parser Parser (e.g. DTrackSDK), containing tracking data of actual frame
+	 * @return           Success? (fails also if the frame is too large for one slot)
+	 */
+	bool publish( const DTrackParser& parser );
+
+	/**
+	 * \brief Get number of published frames.
+	 *
+	 * @return Number of frames
+	 */
+	unsigned int getNumPublished() const;
+
+private:
+
+	DTrackSharedPublisher( const DTrackSharedPublisher& );             // not copyable
+	DTrackSharedPublisher& operator=( const DTrackSharedPublisher& );  // not copyable
+
+	DTrackSys::SharedMemory d_shm;  //!< shared memory
+	unsigned int d_numpublished;    //!< number of published frames
+};
+
+
+/**
+ * \brief Reading frames from shared memory, published by another process.
+ *
+ * Reading doesn't need system calls or parsing: the binary image of a frame is copied out of the
+ * shared memory and checked for consistency. Several processes may read at the same time.
+ */
+class DTrackSharedReader
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackSharedReader();
+
+	/**
+	 * \brief Destructor.
+	 */
+	~DTrackSharedReader();
+
+	/**
+	 * \brief Attach to shared memory created by a publisher.
+	 *
+	 * @param[in] name Name of shared memory, without slashes
+	 * @return         Success? (fails also for shared memory of another version of DTrackSDK)
+	 */
+	bool open( const std::string& name );
+
+	/**
+	 * \brief Detach from shared memory.
+	 */
+	void close();
+
+	/**
+	 * \brief Returns if attached to shared memory.
+	 *
+	 * @return Attached?
+	 */
+	bool isOpen() const;
+
+	/**
+	 * \brief Get number of frames published so far.
+	 *
+	 * Changes, if a new frame is available.
+	 *
+	 * @return Number of frames
+	 */
+	unsigned int getNumPublished() const;
+
+	/**
+	 * \brief Get number of slots, i.e. number of recent frames available.
+	 *
+	 * @return Number of slots; 0 if not attached
+	 */
+	int getNumSlots() const;
+
+	/**
+	 * \brief Read latest published frame.
+	 *
+	 * @param[out] frame Frame
+	 * @return           Success? (fails also if no frame was published yet)
+	 */
+	bool readLatest( DTrackFrame& frame );
+
+	/**
+	 * \brief Read a recent frame.
+	 *
+	 * @param[in]  age   Age of frame: 0 latest frame, 1 frame before, ... up to getNumSlots() - 1
+	 * @param[out] frame Frame
+	 * @return           Success? (fails also if the frame is not available any more)
+	 */
+	bool read( int age, DTrackFrame& frame );
+
+private:
+
+	DTrackSharedReader( const DTrackSharedReader& );             // not copyable
+	DTrackSharedReader& operator=( const DTrackSharedReader& );  // not copyable
+
+	DTrackSys::SharedMemory d_shm;  //!< shared memory
+	std::vector< char > d_buf;      //!< copy of one slot
+};
+
+#endif  // _ART_DTRACKSDK_SHARED_HPP_
@@ -0,0 +1,230 @@
+/* DTrackSDK in C++: DTrackStatistics.hpp
+ *
+ * Statistics about received tracking data, for monitoring.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_STATISTICS_HPP_
+#define _ART_DTRACKSDK_STATISTICS_HPP_
+
+/**
+ * \brief Statistics about received tracking data.
+ *
+ * Counts received, discarded and missing frames, and collects histograms of the inter-arrival jitter
+ * and of the time needed to parse each line type. Updated by the thread receiving tracking data, while
+ * any other thread may read it at the same time. Each value is read atomically, but different values
+ * may refer to slightly different moments. Counters wrap around after 2^32 events.
+ *
+ * Histograms use logarithmic buckets: bucket 0 contains times below 128 ns, bucket i contains times
+ * below 2^( i + 7 ) ns, the last bucket contains all longer times (see getBucketLimit()).
+ */
+class DTrackStatistics
+{
+public:
+
+	/**
+	 * \brief Line types for parse time histograms.
+	 */
+	typedef enum
+	{
+		RECORD_FRAMECOUNTER = 0,  //!< Frame counter ('fr')
+		RECORD_TIMESTAMP,         //!< Timestamps ('ts', 'ts2')
+		RECORD_BODY,              //!< Standard bodies ('6dcal', '6d')
+		RECORD_BODYCOV,           //!< Covariance of standard bodies ('6dcov')
+		RECORD_FLYSTICK,          //!< Flysticks ('6df', '6df2')
+		RECORD_MEATOOL,           //!< Measurement Tools ('6dmt', '6dmt2')
+		RECORD_MEAREF,            //!< Measurement references ('6dmtr')
+		RECORD_HAND,              //!< Fingertracking hands ('glcal', 'gl')
+		RECORD_HUMAN,             //!< ART-Human models ('6dj')
+		RECORD_INERTIAL,          //!< Hybrid bodies ('6di')
+		RECORD_MARKER,            //!< Single markers ('3d')
+		RECORD_STATUS,            //!< System status ('st')
+		RECORD_OTHER,             //!< Unknown or skipped lines
+		NUM_RECORD                //!< Number of line types
+	} RecordType;
+
+	static const int NUM_BUCKETS = 24;  //!< Number of buckets per histogram
+
+	/**
+	 * \brief Constructor.
+	 */
+	DTrackStatistics();
+
+	/**
+	 * \brief Reset all counters and histograms.
+	 *
+	 * May be called by any thread.
+	 */
+	void reset();
+
+	/**
+	 * \brief Get number of processed frames.
+	 *
+	 * @return Number of frames
+	 */
+	unsigned int getNumFrames() const;
+
+	/**
+	 * \brief Get number of frames, that were received but discarded for a newer one.
+	 *
+	 * Happens if DTrackSDK::receive() is not called often enough.
+	 *
+	 * @return Number of frames
+	 */
+	unsigned int getNumDiscarded() const;
+
+	/**
+	 * \brief Get number of frames missing according to the frame counter.
+	 *
+	 * Includes lost frames as well as discarded frames (see getNumDiscarded()).
+	 *
+	 * @return Number of frames
+	 */
+	unsigned int getNumMissing() const;
+
+	/**
+	 * \brief Get number of gaps in the frame counter.
+	 *
+	 * @return Number of gaps, each consisting of one or more missing frames
+	 */
+	unsigned int getNumGaps() const;
+
+	/**
+	 * \brief Get number of packets, that didn't fit into the UDP buffer.
+	 *
+	 * @return Number of packets
+	 */
+	unsigned int getNumOverflows() const;
+
+	/**
+	 * \brief Get number of packets dropped by the kernel, as the receive buffer of the socket was full.
+	 *
+	 * Just supported on Linux, see DTrackNet::UDP::getNumKernelDropped(). Such frames are also missing
+	 * according to the frame counter.
+	 *
+	 * @return Number of packets
+	 */
+	unsigned int getNumKernelDropped() const;
+
+	/**
+	 * \brief Get number of frames, that couldn't be parsed.
+	 *
+	 * @return Number of frames
+	 */
+	unsigned int getNumParseErrors() const;
+
+	/**
+	 * \brief Get number of inter-arrival jitter values in one histogram bucket.
+	 *
+	 * Jitter is the absolute difference between the arrival intervals of two subsequent frames.
+	 *
+	 * @param[in] bucket Index of bucket, range 0 .. NUM_BUCKETS - 1
+	 * @return           Number of values in this bucket
+	 */
+	unsigned int getJitterHistogram( int bucket ) const;
+
+	/**
+	 * \brief Get number of parsed lines in one histogram bucket of parse times.
+	 *
+	 * @param[in] recordType Line type
+	 * @param[in] bucket     Index of bucket, range 0 .. NUM_BUCKETS - 1
+	 * @return               Number of lines in this bucket
+	 */
+	unsigned int getParseTimeHistogram( RecordType recordType, int bucket ) const;
+
+	/**
+	 * \brief Get upper limit of one histogram bucket.
+	 *
+	 * @param[in] bucket Index of bucket, range 0 .. NUM_BUCKETS - 1
+	 * @return           Upper limit (excluded) in s; -1 for last bucket (unlimited)
+	 */
+	static double getBucketLimit( int bucket );
+
+	/**
+	 * \brief Record one processed frame.
+	 *
+	 * To be called by the thread receiving tracking data.
+	 *
+	 * @param[in] frameCounter Frame counter of frame
+	 * @param[in] arrivalTime  Arrival time of frame in s
+	 */
+	void addFrame( unsigned int frameCounter, double arrivalTime );
+
+	/**
+	 * \brief Record discarded frames.
+	 *
+	 * @param[in] num Number of discarded frames
+	 */
+	void addDiscarded( int num );
+
+	/**
+	 * \brief Record one packet, that didn't fit into the UDP buffer.
+	 */
+	void addOverflow();
+
+	/**
+	 * \brief Record packets dropped by the kernel.
+	 *
+	 * @param[in] num Number of dropped packets
+	 */
+	void addKernelDropped( int num );
+
+	/**
+	 * \brief Record one frame, that couldn't be parsed.
+	 */
+	void addParseError();
+
+	/**
+	 * \brief Record parse time of one line.
+	 *
+	 * @param[in] recordType Line type
+	 * @param[in] time       Parse time in s
+	 */
+	void addParseTime( RecordType recordType, double time );
+
+private:
+
+	static int bucket_index( double time );
+
+	volatile int d_num_frames;         //!< Number of processed frames
+	volatile int d_num_discarded;      //!< Number of discarded frames
+	volatile int d_num_missing;        //!< Number of missing frames
+	volatile int d_num_gaps;           //!< Number of gaps in frame counter
+	volatile int d_num_overflows;      //!< Number of packets too large for UDP buffer
+	volatile int d_num_kerneldropped;  //!< Number of packets dropped by the kernel
+	volatile int d_num_parseerrors;    //!< Number of frames with parse errors
+
+	volatile int d_jitter[ NUM_BUCKETS ];                   //!< Histogram of inter-arrival jitter
+	volatile int d_parsetime[ NUM_RECORD ][ NUM_BUCKETS ];  //!< Histograms of parse times
+
+	bool d_has_last;                     //!< Data of a previous frame available
+	unsigned int d_last_framecounter;    //!< Frame counter of previous frame
+	double d_last_arrival;               //!< Arrival time of previous frame in s
+	double d_last_interval;              //!< Arrival interval of previous frame in s, -1 if not available
+};
+
+#endif  // _ART_DTRACKSDK_STATISTICS_HPP_
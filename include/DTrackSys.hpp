@@ -0,0 +1,301 @@
+/* DTrackSDK in C++: DTrackSys.hpp
+ *
+ * Operating system functions: atomic operations, threads.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ART_DTRACKSDK_SYS_HPP_
+#define _ART_DTRACKSDK_SYS_HPP_
+
+#include <cstddef>
+
+namespace DTrackSys {
+
+/**
+ * \brief Read integer value atomically (acquire semantics).
+ *
+ * @param[in] p Pointer to value
+ * @return      Value
+ */
+int atomic_load( const volatile int* p );
+
+/**
+ * \brief Write integer value atomically (release semantics).
+ *
+ * @param[in] p     Pointer to value
+ * @param[in] value New value
+ */
+void atomic_store( volatile int* p, int value );
+
+/**
+ * \brief Exchange integer value atomically (acquire and release semantics).
+ *
+ * @param[in] p     Pointer to value
+ * @param[in] value New value
+ * @return          Old value
+ */
+int atomic_exchange( volatile int* p, int value );
+
+/**
+ * \brief Add to integer value atomically (acquire and release semantics).
+ *
+ * @param[in] p     Pointer to value
+ * @param[in] value Value to add
+ * @return          New value
+ */
+int atomic_add( volatile int* p, int value );
+
+/**
+ * \brief Full memory barrier.
+ *
+ * No memory access is moved across this barrier, neither by the compiler nor by the CPU.
+ */
+void atomic_fence();
+
+
+struct _thread_struct;  // forward declaration
+
+/**
+ * \brief Type of a thread function.
+ *
+ * @param[in] arg Argument given when starting the thread
+ */
+typedef void ( *ThreadFunction )( void* arg );
+
+/**
+ * \brief Handling a thread.
+ */
+class Thread
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	Thread();
+
+	/**
+	 * \brief Destructor. Waits for the thread to finish, if running.
+	 */
+	~Thread();
+
+	/**
+	 * \brief Start thread.
+	 *
+	 * @param[in] func Thread function
+	 * @param[in] arg  Argument for thread function
+	 * @return         Success? (fails also if thread is already running)
+	 */
+	bool start( ThreadFunction func, void* arg );
+
+	/**
+	 * \brief Wait for the thread to finish.
+	 */
+	void join();
+
+	/**
+	 * \brief Returns if thread was started and not joined yet.
+	 *
+	 * @return Thread was started?
+	 */
+	bool isStarted() const;
+
+private:
+
+	Thread( const Thread& );             // not copyable
+	Thread& operator=( const Thread& );  // not copyable
+
+	_thread_struct* d_thread;  //!< Thread handle, NULL if not started
+};
+
+/**
+ * \brief Set real-time priority for the calling thread.
+ *
+ * Usually requires according privileges.
+ *
+ * @return Success?
+ */
+bool thread_set_realtime();
+
+/**
+ * \brief Bind the calling thread to one CPU.
+ *
+ * @param[in] cpu Index of CPU, range 0 ..
+ * @return        Success? (not supported by all systems)
+ */
+bool thread_set_affinity( int cpu );
+
+
+/**
+ * \brief Get time of a monotonic clock.
+ *
+ * The clock is not affected by changes of the system time; its origin is unspecified. All
+ * timestamps of DTrackSDK, like the arrival time of a frame, refer to this clock.
+ *
+ * @return Time in s
+ */
+double time_monotonic();
+
+/**
+ * \brief Suspend the calling thread.
+ *
+ * @param[in] seconds Time in s; accuracy depends on the system
+ */
+void time_sleep( double seconds );
+
+
+struct _mappedfile_struct;  // forward declaration
+
+/**
+ * \brief Read-only memory mapping of a file.
+ */
+class MappedFile
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	MappedFile();
+
+	/**
+	 * \brief Destructor. Removes the mapping, if any.
+	 */
+	~MappedFile();
+
+	/**
+	 * \brief Map a file into memory.
+	 *
+	 * @param[in] filename Name of file
+	 * @return             Success? (fails also for an empty file)
+	 */
+	bool open( const char* filename );
+
+	/**
+	 * \brief Remove the mapping.
+	 */
+	void close();
+
+	/**
+	 * \brief Get content of the file.
+	 *
+	 * @return Pointer to content; NULL if not mapped
+	 */
+	const char* getData() const;
+
+	/**
+	 * \brief Get size of the file.
+	 *
+	 * @return Size in bytes; 0 if not mapped
+	 */
+	size_t getSize() const;
+
+private:
+
+	MappedFile( const MappedFile& );             // not copyable
+	MappedFile& operator=( const MappedFile& );  // not copyable
+
+	_mappedfile_struct* d_file;  //!< File handles, NULL if not mapped
+	const char* d_data;          //!< Content of file
+	size_t d_size;               //!< Size of file in bytes
+};
+
+
+struct _sharedmemory_struct;  // forward declaration
+
+/**
+ * \brief Named shared memory, accessible by several processes.
+ *
+ * Unix: POSIX shared memory (may need linking with 'librt'); MS Windows: named file mapping.
+ */
+class SharedMemory
+{
+public:
+
+	/**
+	 * \brief Constructor.
+	 */
+	SharedMemory();
+
+	/**
+	 * \brief Destructor. Removes the mapping, if any.
+	 */
+	~SharedMemory();
+
+	/**
+	 * \brief Create shared memory, with read and write access.
+	 *
+	 * An existing shared memory with the same name is replaced. The content is initialized with zeros.
+	 *
+	 * @param[in] name Name of shared memory (e.g. 'dtrack'), without slashes
+	 * @param[in] size Size in bytes
+	 * @return         Success?
+	 */
+	bool create( const char* name, size_t size );
+
+	/**
+	 * \brief Open existing shared memory, with read access.
+	 *
+	 * @param[in] name Name of shared memory, without slashes
+	 * @return         Success?
+	 */
+	bool open( const char* name );
+
+	/**
+	 * \brief Remove the mapping; shared memory created by this object is removed as well.
+	 */
+	void close();
+
+	/**
+	 * \brief Get content of the shared memory.
+	 *
+	 * @return Pointer to content; NULL if not mapped
+	 */
+	char* getData() const;
+
+	/**
+	 * \brief Get size of the shared memory.
+	 *
+	 * @return Size in bytes (may be rounded up to page size); 0 if not mapped
+	 */
+	size_t getSize() const;
+
+private:
+
+	SharedMemory( const SharedMemory& );             // not copyable
+	SharedMemory& operator=( const SharedMemory& );  // not copyable
+
+	_sharedmemory_struct* d_shm;  //!< Handles, NULL if not mapped
+	char* d_data;                 //!< Content of shared memory
+	size_t d_size;                //!< Size in bytes
+};
+
+
+}  // namespace DTrackSys
+
+#endif  // _ART_DTRACKSDK_SYS_HPP_
+
@@ -0,0 +1,252 @@
+/* DTrackSDK in C++: DTrackConnector.cpp
+ *
+ * Background connecting of the DTrack2/DTRACK3 command interface.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackConnector.hpp"
+
+using namespace DTrackSys;
+
+#define CONNECTOR_SLICE_US  100000  // maximum time between checks for stop and reconnect requests (in us)
+
+
+/*
+ * Constructor.
+ */
+DTrackConnector::DTrackConnector( const std::string& host, unsigned short port, int connectTimeoutUs,
+                                  int minBackoffUs, int maxBackoffUs )
+{
+	d_host = host;
+	d_port = port;
+	d_connecttimeoutUs = connectTimeoutUs;
+	d_minbackoffUs = ( minBackoffUs > 0 ) ? minBackoffUs : 1;
+	d_maxbackoffUs = ( maxBackoffUs > d_minbackoffUs ) ? maxBackoffUs : d_minbackoffUs;
+
+	d_tcp = NULL;
+	d_thread = NULL;
+	d_stop = 0;
+	d_state = STATE_CONNECTING;
+	d_remoteip = 0;
+	d_numfailed = 0;
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackConnector::~DTrackConnector()
+{
+	stop();
+
+	delete d_tcp;
+}
+
+
+/*
+ * Start connecting thread.
+ */
+bool DTrackConnector::start( bool isConnected )
+{
+	if ( d_thread != NULL )  // already running
+		return false;
+
+	d_stop = 0;
+	d_state = isConnected ? STATE_TAKEN : STATE_CONNECTING;
+
+	d_thread = new Thread;
+	if ( ! d_thread->start( connectThread, this ) )
+	{
+		delete d_thread;
+		d_thread = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+
+/*
+ * Stop connecting thread.
+ */
+void DTrackConnector::stop()
+{
+	if ( d_thread == NULL )
+		return;
+
+	atomic_store( &d_stop, 1 );
+	d_thread->join();
+
+	delete d_thread;
+	d_thread = NULL;
+}
+
+
+/*
+ * Returns if connecting thread is running.
+ */
+bool DTrackConnector::isRunning() const
+{
+	return ( d_thread != NULL );
+}
+
+
+/*
+ * Returns if the thread is trying to establish a connection.
+ */
+bool DTrackConnector::isConnecting() const
+{
+	return ( d_thread != NULL ) && ( atomic_load( &d_state ) == STATE_CONNECTING );
+}
+
+
+/*
+ * Returns if an established connection is waiting to be taken.
+ */
+bool DTrackConnector::isConnected() const
+{
+	return ( atomic_load( &d_state ) == STATE_CONNECTED );
+}
+
+
+/*
+ * Get IP address of Controller.
+ */
+unsigned int DTrackConnector::getRemoteIp() const
+{
+	return static_cast< unsigned int >( atomic_load( &d_remoteip ) );
+}
+
+
+/*
+ * Get number of failed connection attempts since the last established connection.
+ */
+int DTrackConnector::getNumFailed() const
+{
+	return atomic_load( &d_numfailed );
+}
+
+
+/*
+ * Take established connection.
+ */
+DTrackNet::TCP* DTrackConnector::takeConnection()
+{
+	if ( atomic_load( &d_state ) != STATE_CONNECTED )
+		return NULL;
+
+	DTrackNet::TCP* tcp = d_tcp;  // written by connecting thread before changing the state
+	d_tcp = NULL;
+
+	atomic_store( &d_state, STATE_TAKEN );
+	return tcp;
+}
+
+
+/*
+ * Start establishing a new connection.
+ */
+void DTrackConnector::reconnect()
+{
+	if ( atomic_load( &d_state ) == STATE_TAKEN )
+		atomic_store( &d_state, STATE_CONNECTING );
+}
+
+
+/*
+ * Thread function of connecting thread.
+ */
+void DTrackConnector::connectThread( void* arg )
+{
+	static_cast< DTrackConnector* >( arg )->connectLoop();
+}
+
+
+/*
+ * Establish connections when requested, until connecting thread is stopped.
+ */
+void DTrackConnector::connectLoop()
+{
+	int backoffUs = d_minbackoffUs;
+
+	while ( ! atomic_load( &d_stop ) )
+	{
+		if ( atomic_load( &d_state ) != STATE_CONNECTING )
+		{	// wait for request to reconnect
+			backoffUs = d_minbackoffUs;
+			waitUs( CONNECTOR_SLICE_US );
+			continue;
+		}
+
+		if ( connectServer() )
+			continue;
+
+		atomic_store( &d_numfailed, d_numfailed + 1 );  // just written by this thread
+
+		waitUs( backoffUs );
+		backoffUs = ( backoffUs > d_maxbackoffUs / 2 ) ? d_maxbackoffUs : 2 * backoffUs;
+	}
+}
+
+
+/*
+ * Resolve hostname and establish connection. Returns if succeeded.
+ */
+bool DTrackConnector::connectServer()
+{
+	unsigned int ip = DTrackNet::ip_name2ip( d_host.c_str() );  // resolved again, address might change
+	if ( ip == 0 )
+		return false;
+
+	atomic_store( &d_remoteip, static_cast< int >( ip ) );
+
+	DTrackNet::TCP* tcp = new DTrackNet::TCP( ip, d_port, d_connecttimeoutUs );
+	if ( ! tcp->isValid() )
+	{
+		delete tcp;
+		return false;
+	}
+
+	d_tcp = tcp;
+	atomic_store( &d_numfailed, 0 );
+	atomic_store( &d_state, STATE_CONNECTED );  // publishes d_tcp
+	return true;
+}
+
+
+/*
+ * Wait, check for stop regularly.
+ */
+void DTrackConnector::waitUs( int us )
+{
+	while ( us > 0 && ! atomic_load( &d_stop ) )
+	{
+		int sliceUs = ( us < CONNECTOR_SLICE_US ) ? us : CONNECTOR_SLICE_US;
+		time_sleep( sliceUs * 1e-6 );
+		us -= sliceUs;
+	}
+}
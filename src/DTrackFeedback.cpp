@@ -0,0 +1,382 @@
+/* DTrackSDK in C++: DTrackFeedback.cpp
+ *
+ * Collecting feedback commands for Flysticks and tactile FINGERTRACKING devices.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackFeedback.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <clocale>
+
+#define FEEDBACK_HEADER_MAXLEN  16  // maximum length of 'tfb <n> ' or 'ffb <n> ' (see MAX_COMMANDLEN)
+#define FEEDBACK_ENTRY_MAXLEN   64  // maximum length of one entry (see MAX_COMMANDLEN)
+
+
+/*
+ * Write a 'double' value like printf( "%g" ), independent of the actual locale.
+ *
+ * Returns length of written string.
+ */
+static int feedback_write_g( char* buffer, double value )
+{
+	int len = sprintf( buffer, "%g", value );
+
+	const char* dp = localeconv()->decimal_point;
+	size_t dplen = strlen( dp );
+	if ( dplen == 0 || ( dplen == 1 && *dp == '.' ) )  // 'C' conventions
+		return len;
+
+	char* p = strstr( buffer, dp );
+	if ( p == NULL )  // no fractional part
+		return len;
+
+	*p = '.';
+	memmove( p + 1, p + dplen, strlen( p + dplen ) + 1 );  // including terminating '\0'
+	return len - ( int )dplen + 1;
+}
+
+
+/*
+ * Constructor.
+ */
+DTrackFeedbackBatch::DTrackFeedbackBatch( double minInterval )
+{
+	d_minInterval = minInterval;
+	d_numTactile = 0;
+	d_numFlystick = 0;
+	d_numDevices = 0;
+}
+
+
+/*
+ * Set minimum interval between two commands for the same device.
+ */
+void DTrackFeedbackBatch::setMinInterval( double minInterval )
+{
+	d_minInterval = minInterval;
+}
+
+
+/*
+ * Remove all pending commands.
+ */
+void DTrackFeedbackBatch::clear()
+{
+	d_numTactile = 0;
+	d_numFlystick = 0;
+}
+
+
+/*
+ * Returns if no commands are pending.
+ */
+bool DTrackFeedbackBatch::isEmpty() const
+{
+	return ( d_numTactile == 0 ) && ( d_numFlystick == 0 );
+}
+
+
+/*
+ * Add tactile feedback on a specific finger of a specific hand.
+ */
+bool DTrackFeedbackBatch::tactileFinger( int handId, int fingerId, double strength )
+{
+	if ( strength > 1.0 || strength < 0.0 )
+		return false;
+
+	int i = 0;
+	while ( i < d_numTactile && ( d_tactile[ i ].handId != handId || d_tactile[ i ].fingerId != fingerId ) )
+		i++;
+
+	if ( i == d_numTactile )
+	{	// new finger
+		if ( d_numTactile >= MAX_TACTILE )
+			return false;
+
+		d_numTactile++;
+		d_tactile[ i ].handId = handId;
+		d_tactile[ i ].fingerId = fingerId;
+	}
+
+	d_tactile[ i ].strength = strength;
+	d_tactile[ i ].prepared = false;  // changed, so has to be sent again
+	return true;
+}
+
+
+/*
+ * Add tactile feedback on all fingers of a specific hand.
+ */
+bool DTrackFeedbackBatch::tactileHand( int handId, const double* strength, int numFinger )
+{
+	for ( int i = 0; i < numFinger; i++ )
+	{
+		if ( strength[ i ] > 1.0 || strength[ i ] < 0.0 )
+			return false;
+	}
+
+	for ( int i = 0; i < numFinger; i++ )
+	{
+		if ( ! tactileFinger( handId, i, strength[ i ] ) )
+			return false;
+	}
+
+	return true;
+}
+
+
+/*
+ * Add turning off tactile feedback on all fingers of a specific hand.
+ */
+bool DTrackFeedbackBatch::tactileHandOff( int handId, int numFinger )
+{
+	for ( int i = 0; i < numFinger; i++ )
+	{
+		if ( ! tactileFinger( handId, i, 0.0 ) )
+			return false;
+	}
+
+	return true;
+}
+
+
+/*
+ * Add beep on a specific Flystick.
+ */
+bool DTrackFeedbackBatch::flystickBeep( int flystickId, double durationMs, double frequencyHz )
+{
+	int i = 0;
+	while ( i < d_numFlystick && d_flystick[ i ].flystickId != flystickId )
+		i++;
+
+	if ( i == d_numFlystick )
+	{	// new Flystick
+		if ( d_numFlystick >= MAX_FLYSTICK )
+			return false;
+
+		d_numFlystick++;
+		d_flystick[ i ].flystickId = flystickId;
+		d_flystick[ i ].pattern = 0;
+	}
+
+	d_flystick[ i ].durationMs = ( int )durationMs;
+	d_flystick[ i ].frequencyHz = ( int )frequencyHz;
+	d_flystick[ i ].prepared = false;  // changed, so has to be sent again
+	return true;
+}
+
+
+/*
+ * Add vibration pattern on a specific Flystick.
+ */
+bool DTrackFeedbackBatch::flystickVibration( int flystickId, int vibrationPattern )
+{
+	int i = 0;
+	while ( i < d_numFlystick && d_flystick[ i ].flystickId != flystickId )
+		i++;
+
+	if ( i == d_numFlystick )
+	{	// new Flystick
+		if ( d_numFlystick >= MAX_FLYSTICK )
+			return false;
+
+		d_numFlystick++;
+		d_flystick[ i ].flystickId = flystickId;
+		d_flystick[ i ].durationMs = 0;
+		d_flystick[ i ].frequencyHz = 0;
+	}
+
+	d_flystick[ i ].pattern = vibrationPattern;
+	d_flystick[ i ].prepared = false;  // changed, so has to be sent again
+	return true;
+}
+
+
+/*
+ * Get pending tactile commands of all devices, that may be sent now.
+ */
+int DTrackFeedbackBatch::prepareTactileCommand( char* buffer, int maxLen, double now )
+{
+	// select entries; rate limits are checked before updating them
+	int maxNum = ( maxLen - FEEDBACK_HEADER_MAXLEN ) / FEEDBACK_ENTRY_MAXLEN;
+	int num = 0;
+	for ( int i = 0; i < d_numTactile; i++ )
+	{
+		d_tactile[ i ].prepared = ( num < maxNum ) && isReady( DEVICE_HAND, d_tactile[ i ].handId, now );
+		if ( d_tactile[ i ].prepared )
+			num++;
+	}
+
+	if ( num == 0 )
+		return 0;
+
+	int len = sprintf( buffer, "tfb %d ", num );
+
+	for ( int i = 0; i < d_numTactile; i++ )
+	{
+		if ( ! d_tactile[ i ].prepared )
+			continue;
+
+		len += sprintf( buffer + len, "[%d %d 1.0 ", d_tactile[ i ].handId, d_tactile[ i ].fingerId );
+		len += feedback_write_g( buffer + len, d_tactile[ i ].strength );
+		len += sprintf( buffer + len, "]" );
+	}
+
+	return len;
+}
+
+
+/*
+ * Remove tactile commands got by last call of prepareTactileCommand().
+ */
+void DTrackFeedbackBatch::commitTactileCommand( double now )
+{
+	int numKept = 0;
+	for ( int i = 0; i < d_numTactile; i++ )
+	{
+		if ( ! d_tactile[ i ].prepared )
+		{
+			d_tactile[ numKept++ ] = d_tactile[ i ];
+			continue;
+		}
+
+		setSent( DEVICE_HAND, d_tactile[ i ].handId, now );
+	}
+
+	d_numTactile = numKept;
+}
+
+
+/*
+ * Get pending Flystick commands of all devices, that may be sent now.
+ */
+int DTrackFeedbackBatch::prepareFlystickCommand( char* buffer, int maxLen, double now )
+{
+	// select entries; rate limits are checked before updating them
+	int maxNum = ( maxLen - FEEDBACK_HEADER_MAXLEN ) / FEEDBACK_ENTRY_MAXLEN;
+	int num = 0;
+	for ( int i = 0; i < d_numFlystick; i++ )
+	{
+		d_flystick[ i ].prepared = ( num < maxNum ) && isReady( DEVICE_FLYSTICK, d_flystick[ i ].flystickId, now );
+		if ( d_flystick[ i ].prepared )
+			num++;
+	}
+
+	if ( num == 0 )
+		return 0;
+
+	int len = sprintf( buffer, "ffb %d ", num );
+
+	for ( int i = 0; i < d_numFlystick; i++ )
+	{
+		if ( ! d_flystick[ i ].prepared )
+			continue;
+
+		len += sprintf( buffer + len, "[%d %d %d %d 0][]", d_flystick[ i ].flystickId,
+		                d_flystick[ i ].durationMs, d_flystick[ i ].frequencyHz, d_flystick[ i ].pattern );
+	}
+
+	return len;
+}
+
+
+/*
+ * Remove Flystick commands got by last call of prepareFlystickCommand().
+ */
+void DTrackFeedbackBatch::commitFlystickCommand( double now )
+{
+	int numKept = 0;
+	for ( int i = 0; i < d_numFlystick; i++ )
+	{
+		if ( ! d_flystick[ i ].prepared )
+		{
+			d_flystick[ numKept++ ] = d_flystick[ i ];
+			continue;
+		}
+
+		setSent( DEVICE_FLYSTICK, d_flystick[ i ].flystickId, now );
+	}
+
+	d_numFlystick = numKept;
+}
+
+
+/*
+ * Check rate limit of a device.
+ */
+bool DTrackFeedbackBatch::isReady( int type, int id, double now ) const
+{
+	if ( d_minInterval <= 0.0 )
+		return true;
+
+	for ( int i = 0; i < d_numDevices; i++ )
+	{
+		if ( d_devices[ i ].type == type && d_devices[ i ].id == id )
+			return ( now - d_devices[ i ].lastSent >= d_minInterval );
+	}
+
+	return true;
+}
+
+
+/*
+ * Update time of last command of a device.
+ */
+void DTrackFeedbackBatch::setSent( int type, int id, double now )
+{
+	if ( d_minInterval <= 0.0 )
+		return;
+
+	int i = 0;
+	while ( i < d_numDevices && ( d_devices[ i ].type != type || d_devices[ i ].id != id ) )
+		i++;
+
+	if ( i == d_numDevices )
+	{
+		if ( d_numDevices < MAX_DEVICES )
+		{
+			d_numDevices++;
+		}
+		else
+		{	// replace device with oldest command
+			i = 0;
+			for ( int j = 1; j < d_numDevices; j++ )
+			{
+				if ( d_devices[ j ].lastSent < d_devices[ i ].lastSent )
+					i = j;
+			}
+		}
+
+		d_devices[ i ].type = type;
+		d_devices[ i ].id = id;
+	}
+
+	d_devices[ i ].lastSent = now;
+}
+
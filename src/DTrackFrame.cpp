@@ -0,0 +1,203 @@
+/* DTrackSDK in C++: DTrackFrame.cpp
+ *
+ * Snapshots of tracking data, for access by other threads.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackFrame.hpp"
+#include "DTrackSys.hpp"
+
+using namespace DTrackSys;
+
+
+/*
+ * Constructor.
+ */
+DTrackFrame::DTrackFrame()
+{
+	//
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackFrame::~DTrackFrame()
+{
+	//
+}
+
+
+/*
+ * Set tracking data of actual frame.
+ */
+void DTrackFrame::setFrame( const DTrackParser& parser )
+{
+	copyFrame( parser );
+}
+
+
+/*
+ * Set tracking data of actual frame from a binary image.
+ */
+bool DTrackFrame::setFrame( const char* image, int len )
+{
+	return readFrameImage( image, len );
+}
+
+
+/*
+ * Constructor.
+ */
+DTrackFrameBuffer::DTrackFrameBuffer()
+{
+	d_write = 0;
+	d_latest = 1;
+	d_read = 2;
+	d_isread = false;
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackFrameBuffer::~DTrackFrameBuffer()
+{
+	//
+}
+
+
+/*
+ * Publish tracking data of actual frame.
+ */
+void DTrackFrameBuffer::publish( const DTrackParser& parser )
+{
+	d_frame[ d_write ].setFrame( parser );
+
+	// swap with latest frame; the old one is free, even if not read
+	d_write = atomic_exchange( &d_latest, d_write | FLAG_NEW ) & ~FLAG_NEW;
+}
+
+
+/*
+ * Get latest published frame.
+ */
+const DTrackFrame* DTrackFrameBuffer::acquireLatest()
+{
+	if ( atomic_load( &d_latest ) & FLAG_NEW )
+	{	// swap with latest frame
+		d_read = atomic_exchange( &d_latest, d_read ) & ~FLAG_NEW;
+		d_isread = true;
+	}
+
+	if ( ! d_isread )
+		return NULL;
+
+	return &d_frame[ d_read ];
+}
+
+
+/*
+ * Constructor.
+ */
+DTrackFrameQueue::DTrackFrameQueue( int size )
+{
+	if ( size < 1 )
+		size = 1;
+
+	d_size = size + 1;  // one entry always stays free
+	d_frame = new DTrackFrame[ d_size ];
+	d_head = 0;
+	d_tail = 0;
+	d_numdropped = 0;
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackFrameQueue::~DTrackFrameQueue()
+{
+	delete[] d_frame;
+}
+
+
+/*
+ * Add tracking data of actual frame to queue.
+ */
+bool DTrackFrameQueue::push( const DTrackParser& parser )
+{
+	int head = d_head;  // just written by this thread
+	int next = ( head + 1 ) % d_size;
+
+	if ( next == atomic_load( &d_tail ) )
+	{	// queue is full
+		atomic_store( &d_numdropped, d_numdropped + 1 );
+		return false;
+	}
+
+	d_frame[ head ].setFrame( parser );
+	atomic_store( &d_head, next );
+	return true;
+}
+
+
+/*
+ * Get oldest frame in queue.
+ */
+const DTrackFrame* DTrackFrameQueue::front() const
+{
+	int tail = d_tail;  // just written by this thread
+
+	if ( tail == atomic_load( &d_head ) )  // queue is empty
+		return NULL;
+
+	return &d_frame[ tail ];
+}
+
+
+/*
+ * Remove oldest frame from queue.
+ */
+void DTrackFrameQueue::pop()
+{
+	int tail = d_tail;  // just written by this thread
+
+	if ( tail == atomic_load( &d_head ) )  // queue is empty
+		return;
+
+	atomic_store( &d_tail, ( tail + 1 ) % d_size );
+}
+
+
+/*
+ * Get number of frames dropped by push().
+ */
+int DTrackFrameQueue::getNumDropped() const
+{
+	return atomic_load( &d_numdropped );
+}
@@ -0,0 +1,413 @@
+/* DTrackSDK in C++: DTrackHistory.cpp
+ *
+ * History of poses, with queries for arbitrary points in time.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackHistory.hpp"
+
+#include <cmath>
+
+// -----------------------------------------------------------------------------------------------------
+
+/*
+ * Constructor.
+ */
+DTrackHistory::DTrackHistory( int capacity )
+	: d_timeSource( TIME_ARRIVAL ), d_hasFrame( false ), d_lastTime( 0.0 )
+{
+	if ( capacity < 0 )  capacity = 0;
+
+	for ( int i = 0; i < NUM_TARGETTYPES; i++ )
+		d_capacity[ i ] = capacity;
+}
+
+
+/*
+ * Set number of frames kept per target, for one type of targets.
+ */
+void DTrackHistory::setCapacity( TargetType type, int capacity )
+{
+	if ( type < 0 || type >= NUM_TARGETTYPES )
+		return;
+
+	d_capacity[ type ] = ( capacity > 0 ) ? capacity : 0;
+	d_ring[ type ].clear();
+}
+
+
+/*
+ * Get number of frames kept per target.
+ */
+int DTrackHistory::getCapacity( TargetType type ) const
+{
+	if ( type < 0 || type >= NUM_TARGETTYPES )
+		return 0;
+
+	return d_capacity[ type ];
+}
+
+
+/*
+ * Set clock used for the time of a frame.
+ */
+void DTrackHistory::setTimeSource( TimeSource source )
+{
+	d_timeSource = source;
+	clear();
+}
+
+
+/*
+ * Remove the complete history.
+ */
+void DTrackHistory::clear()
+{
+	d_hasFrame = false;
+	d_lastTime = 0.0;
+
+	for ( int i = 0; i < NUM_TARGETTYPES; i++ )
+		d_ring[ i ].clear();
+}
+
+
+/*
+ * Get time of a frame, using the clock set by setTimeSource().
+ */
+double DTrackHistory::getFrameTime( const DTrackParser& frame ) const
+{
+	if ( d_timeSource == TIME_CONTROLLER )
+	{
+		if ( frame.getTimeStampSec() > 0 )
+			return ( double )frame.getTimeStampSec() + ( double )frame.getTimeStampUsec() * 1e-6;
+
+		if ( frame.getTimeStamp() >= 0.0 )
+			return frame.getTimeStamp();
+	}
+
+	return frame.getArrivalTime();
+}
+
+
+/*
+ * Add poses of a frame.
+ */
+bool DTrackHistory::addFrame( const DTrackParser& frame )
+{
+	double time = getFrameTime( frame );
+
+	if ( d_hasFrame && ( time <= d_lastTime ) )
+		return false;
+
+	d_hasFrame = true;
+	d_lastTime = time;
+
+	int num = frame.getNumBody();
+	beginType( TARGET_BODY, num );
+	for ( int i = 0; i < num; i++ )
+	{
+		const DTrackBody* body = frame.getBody( i );
+		add( TARGET_BODY, i, body->quality, body->loc, body->rot );
+	}
+	endType( TARGET_BODY );
+
+	num = frame.getNumFlyStick();
+	beginType( TARGET_FLYSTICK, num );
+	for ( int i = 0; i < num; i++ )
+	{
+		const DTrackFlyStick* flystick = frame.getFlyStick( i );
+		add( TARGET_FLYSTICK, i, flystick->quality, flystick->loc, flystick->rot );
+	}
+	endType( TARGET_FLYSTICK );
+
+	num = frame.getNumMeaTool();
+	beginType( TARGET_MEATOOL, num );
+	for ( int i = 0; i < num; i++ )
+	{
+		const DTrackMeaTool* meatool = frame.getMeaTool( i );
+		add( TARGET_MEATOOL, i, meatool->quality, meatool->loc, meatool->rot );
+	}
+	endType( TARGET_MEATOOL );
+
+	num = frame.getNumHand();
+	beginType( TARGET_HAND, num );
+	for ( int i = 0; i < num; i++ )
+	{
+		const DTrackHand* hand = frame.getHand( i );
+		add( TARGET_HAND, i, hand->quality, hand->loc, hand->rot );
+	}
+	endType( TARGET_HAND );
+
+	num = frame.getNumHuman();
+	beginType( TARGET_HUMAN, num * DTRACKSDK_HUMAN_MAX_JOINTS );
+	for ( int i = 0; i < num; i++ )
+	{
+		DTrackHumanJoints human = frame.getHumanJoints( i );
+
+		for ( int j = 0; j < human.num_joints; j++ )
+		{
+			const DTrackJoint& joint = human.joint[ j ];
+			if ( joint.id < 0 || joint.id >= DTRACKSDK_HUMAN_MAX_JOINTS )
+				continue;
+
+			add( TARGET_HUMAN, i * DTRACKSDK_HUMAN_MAX_JOINTS + joint.id, joint.quality, joint.loc, joint.rot );
+		}
+	}
+	endType( TARGET_HUMAN );
+
+	return true;
+}
+
+
+/*
+ * Prepare adding samples of one type of targets.
+ */
+void DTrackHistory::beginType( TargetType type, int num )
+{
+	if ( d_capacity[ type ] == 0 )
+		return;
+
+	int size = static_cast< int >( d_ring[ type ].size() );
+	d_added.assign( ( num > size ) ? num : size, 0 );
+}
+
+
+/*
+ * Add sample of one target.
+ */
+void DTrackHistory::add( TargetType type, int index, double quality, const double* loc, const double* rot )
+{
+	int capacity = d_capacity[ type ];
+	if ( capacity == 0 )
+		return;
+
+	std::vector< Ring >& rings = d_ring[ type ];
+	if ( index >= static_cast< int >( rings.size() ) )
+	{
+		Ring ring;
+		ring.head = 0;
+		ring.num = 0;
+
+		rings.resize( index + 1, ring );
+	}
+
+	Ring& ring = rings[ index ];
+	if ( ring.sample.empty() )  // first appearance of target
+		ring.sample.resize( capacity );
+
+	ring.head = ( ring.head + 1 ) % capacity;
+	if ( ring.num < capacity )  ring.num++;
+
+	Sample& s = ring.sample[ ring.head ];
+	s.time = d_lastTime;
+	s.quality = quality;
+	s.loc[ 0 ] = loc[ 0 ];
+	s.loc[ 1 ] = loc[ 1 ];
+	s.loc[ 2 ] = loc[ 2 ];
+	s.quat = rot2quat( rot );
+
+	d_added[ index ] = 1;
+}
+
+
+/*
+ * Finish adding samples of one type of targets: add samples without tracking for missing targets.
+ */
+void DTrackHistory::endType( TargetType type )
+{
+	int capacity = d_capacity[ type ];
+	if ( capacity == 0 )
+		return;
+
+	std::vector< Ring >& rings = d_ring[ type ];
+	int size = static_cast< int >( rings.size() );
+
+	for ( int i = 0; i < size; i++ )
+	{
+		Ring& ring = rings[ i ];
+		if ( d_added[ i ] || ring.sample.empty() )
+			continue;
+
+		const Sample& last = ring.sample[ ring.head ];
+
+		ring.head = ( ring.head + 1 ) % capacity;
+		if ( ring.num < capacity )  ring.num++;
+
+		Sample& s = ring.sample[ ring.head ];
+		s = last;
+		s.time = d_lastTime;
+		s.quality = -1.0;
+	}
+}
+
+
+/*
+ * Get ring buffer of a target.
+ */
+const DTrackHistory::Ring* DTrackHistory::getRing( TargetType type, int id, int joint ) const
+{
+	if ( type < 0 || type >= NUM_TARGETTYPES || id < 0 )
+		return NULL;
+
+	int index = id;
+	if ( type == TARGET_HUMAN )
+	{
+		if ( joint < 0 || joint >= DTRACKSDK_HUMAN_MAX_JOINTS )
+			return NULL;
+
+		index = id * DTRACKSDK_HUMAN_MAX_JOINTS + joint;
+	}
+
+	if ( index >= static_cast< int >( d_ring[ type ].size() ) )
+		return NULL;
+
+	return &d_ring[ type ][ index ];
+}
+
+
+/*
+ * Get sample of a ring buffer (0 is the newest one).
+ */
+const DTrackHistory::Sample& DTrackHistory::at( const Ring& ring, int index ) const
+{
+	int capacity = static_cast< int >( ring.sample.size() );
+
+	return ring.sample[ ( ring.head - index + capacity ) % capacity ];
+}
+
+
+/*
+ * Get number of samples of a target.
+ */
+int DTrackHistory::getNumSamples( TargetType type, int id, int joint ) const
+{
+	const Ring* ring = getRing( type, id, joint );
+	if ( ring == NULL )
+		return 0;
+
+	return ring->num;
+}
+
+
+/*
+ * Get one sample of a target.
+ */
+bool DTrackHistory::getSample( TargetType type, int id, int index, Sample& sample, int joint ) const
+{
+	const Ring* ring = getRing( type, id, joint );
+	if ( ring == NULL || index < 0 || index >= ring->num )
+		return false;
+
+	sample = at( *ring, index );
+	return true;
+}
+
+
+/*
+ * Get pose of a target at a point in time, interpolating between neighbouring frames.
+ */
+bool DTrackHistory::sampleAt( TargetType type, int id, double time, Sample& sample, int joint ) const
+{
+	const Ring* ring = getRing( type, id, joint );
+	if ( ring == NULL || ring->num == 0 )
+		return false;
+
+	if ( time > at( *ring, 0 ).time || time < at( *ring, ring->num - 1 ).time )
+		return false;
+
+	// binary search for newest sample not later than time:
+
+	int lo = 0, hi = ring->num - 1;
+	while ( lo < hi )
+	{
+		int mid = ( lo + hi ) / 2;
+
+		if ( at( *ring, mid ).time <= time )
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+
+	const Sample& s0 = at( *ring, lo );
+	if ( ! s0.isTracked() )
+		return false;
+
+	if ( s0.time == time )
+	{
+		sample = s0;
+		return true;
+	}
+
+	const Sample& s1 = at( *ring, lo - 1 );
+	if ( ! s1.isTracked() )
+		return false;
+
+	double f = ( time - s0.time ) / ( s1.time - s0.time );
+
+	sample.time = time;
+	sample.quality = ( f < 0.5 ) ? s0.quality : s1.quality;
+
+	for ( int i = 0; i < 3; i++ )
+		sample.loc[ i ] = s0.loc[ i ] + ( s1.loc[ i ] - s0.loc[ i ] ) * f;
+
+	// slerp along shortest path:
+
+	DTrackQuaternion q1 = s1.quat;
+	double d = s0.quat.w * q1.w + s0.quat.x * q1.x + s0.quat.y * q1.y + s0.quat.z * q1.z;
+	if ( d < 0.0 )
+	{
+		d = -d;
+		q1.w = -q1.w;  q1.x = -q1.x;  q1.y = -q1.y;  q1.z = -q1.z;
+	}
+
+	double w0, w1;
+	if ( d > 0.9995 )  // nearly equal rotations: linear interpolation, normalized below
+	{
+		w0 = 1.0 - f;
+		w1 = f;
+	}
+	else
+	{
+		double theta = std::acos( d );
+		double s = std::sin( theta );
+
+		w0 = std::sin( ( 1.0 - f ) * theta ) / s;
+		w1 = std::sin( f * theta ) / s;
+	}
+
+	DTrackQuaternion& q = sample.quat;
+	q.w = w0 * s0.quat.w + w1 * q1.w;
+	q.x = w0 * s0.quat.x + w1 * q1.x;
+	q.y = w0 * s0.quat.y + w1 * q1.y;
+	q.z = w0 * s0.quat.z + w1 * q1.z;
+
+	double n = std::sqrt( q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z );
+	q.w /= n;  q.x /= n;  q.y /= n;  q.z /= n;
+
+	return true;
+}
+
@@ -0,0 +1,292 @@
+/* DTrackSDK in C++: DTrackMarkerGrid.cpp
+ *
+ * Spatial grid of single markers, for nearest neighbour queries.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackMarkerGrid.hpp"
+
+#include <cmath>
+
+#define GRID_MAXCELL   1073741824.0  // maximum cell coordinate (2^30)
+#define GRID_MAXRANGE  8             // maximum number of cells to search in each direction
+
+namespace {
+
+/*
+ * Collects nearest marker.
+ */
+struct NearestVisitor
+{
+	int index;
+	double dist2;
+
+	void operator()( int i, double d2 )
+	{
+		if ( d2 < dist2 )
+		{
+			dist2 = d2;
+			index = i;
+		}
+	}
+};
+
+/*
+ * Collects all markers.
+ */
+struct RadiusVisitor
+{
+	std::vector< int >* indices;
+
+	void operator()( int i, double )
+	{
+		indices->push_back( i );
+	}
+};
+
+}  // namespace
+
+
+/*
+ * Constructor.
+ */
+DTrackMarkerGrid::DTrackMarkerGrid( double cellSize )
+	: d_gridcellsize( 1.0 ), d_mask( 0 )
+{
+	setCellSize( cellSize );
+	d_bucketstart.assign( 2, 0 );
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackMarkerGrid::~DTrackMarkerGrid()
+{
+	//
+}
+
+
+/*
+ * Set edge length of grid cells.
+ */
+void DTrackMarkerGrid::setCellSize( double cellSize )
+{
+	d_cellsize = ( cellSize > 0.0 ) ? cellSize : 1.0;
+}
+
+
+/*
+ * Get edge length of grid cells.
+ */
+double DTrackMarkerGrid::getCellSize() const
+{
+	return d_cellsize;
+}
+
+
+/*
+ * Get cell of a location.
+ */
+void DTrackMarkerGrid::getCell( const double loc[ 3 ], int cell[ 3 ] ) const
+{
+	for ( int i = 0; i < 3; i++ )
+	{
+		double c = floor( loc[ i ] / d_gridcellsize );
+		if ( ! ( c > -GRID_MAXCELL ) )  // also for NaN
+			c = -GRID_MAXCELL;
+		else if ( c > GRID_MAXCELL )
+			c = GRID_MAXCELL;
+
+		cell[ i ] = static_cast< int >( c );
+	}
+}
+
+
+/*
+ * Get bucket of a cell.
+ */
+unsigned int DTrackMarkerGrid::getBucket( const int cell[ 3 ] ) const
+{
+	unsigned int h = static_cast< unsigned int >( cell[ 0 ] ) * 73856093u ^ static_cast< unsigned int >( cell[ 1 ] ) * 19349663u
+	                 ^ static_cast< unsigned int >( cell[ 2 ] ) * 83492791u;
+	return ( h ^ ( h >> 16 ) ) & d_mask;
+}
+
+
+/*
+ * Set single markers of actual frame.
+ */
+void DTrackMarkerGrid::update( const DTrackParser& parser )
+{
+	int num = parser.getNumMarker();
+	d_gridcellsize = d_cellsize;
+
+	d_marker.resize( num );
+	for ( int i = 0; i < num; i++ )
+		d_marker[ i ] = *parser.getMarker( i );
+
+	// buckets (about twice as much as markers), counting sort of markers:
+	unsigned int numBuckets = 16;
+	while ( numBuckets < 2 * static_cast< unsigned int >( num ) )
+		numBuckets *= 2;
+
+	d_mask = numBuckets - 1;
+	d_bucketstart.assign( numBuckets + 1, 0 );
+	d_bucket.resize( num );
+	d_entries.resize( num );
+
+	for ( int i = 0; i < num; i++ )
+	{
+		int cell[ 3 ];
+		getCell( d_marker[ i ].loc, cell );
+		d_bucket[ i ] = getBucket( cell );
+		d_bucketstart[ d_bucket[ i ] + 1 ]++;
+	}
+
+	for ( unsigned int b = 0; b < numBuckets; b++ )  // now end of each bucket
+		d_bucketstart[ b + 1 ] += d_bucketstart[ b ];
+
+	for ( int i = num - 1; i >= 0; i-- )  // keeps order of markers within buckets
+		d_entries[ --d_bucketstart[ d_bucket[ i ] + 1 ] ] = i;
+
+	for ( unsigned int b = 0; b < numBuckets; b++ )  // now start of next bucket
+		d_bucketstart[ b ] = d_bucketstart[ b + 1 ];
+
+	d_bucketstart[ numBuckets ] = num;
+}
+
+
+/*
+ * Get number of single markers in grid.
+ */
+int DTrackMarkerGrid::getNumMarker() const
+{
+	return static_cast< int >( d_marker.size() );
+}
+
+
+/*
+ * Get single marker data in grid.
+ */
+const DTrackMarker* DTrackMarkerGrid::getMarker( int index ) const
+{
+	if ( index < 0 || index >= static_cast< int >( d_marker.size() ) )
+		return NULL;
+
+	return &d_marker[ index ];
+}
+
+
+/*
+ * Visit all markers within a radius.
+ */
+template< class Visitor >
+void DTrackMarkerGrid::visit( const double loc[ 3 ], double radius, Visitor& visitor ) const
+{
+	int num = static_cast< int >( d_marker.size() );
+	if ( num == 0 || ! ( radius >= 0.0 ) )
+		return;
+
+	double r2 = radius * radius;
+	int range = static_cast< int >( ceil( radius / d_gridcellsize ) );
+
+	if ( range > GRID_MAXRANGE || ( 2 * range + 1 ) * ( 2 * range + 1 ) * ( 2 * range + 1 ) > num )
+	{	// checking all markers is faster
+		for ( int i = 0; i < num; i++ )
+		{
+			const double* p = d_marker[ i ].loc;
+			double d2 = ( p[ 0 ] - loc[ 0 ] ) * ( p[ 0 ] - loc[ 0 ] ) + ( p[ 1 ] - loc[ 1 ] ) * ( p[ 1 ] - loc[ 1 ] )
+			            + ( p[ 2 ] - loc[ 2 ] ) * ( p[ 2 ] - loc[ 2 ] );
+			if ( d2 <= r2 )
+				visitor( i, d2 );
+		}
+		return;
+	}
+
+	int center[ 3 ];
+	getCell( loc, center );
+
+	int cell[ 3 ];
+	for ( cell[ 0 ] = center[ 0 ] - range; cell[ 0 ] <= center[ 0 ] + range; cell[ 0 ]++ )
+	{
+		for ( cell[ 1 ] = center[ 1 ] - range; cell[ 1 ] <= center[ 1 ] + range; cell[ 1 ]++ )
+		{
+			for ( cell[ 2 ] = center[ 2 ] - range; cell[ 2 ] <= center[ 2 ] + range; cell[ 2 ]++ )
+			{
+				unsigned int b = getBucket( cell );
+				for ( int k = d_bucketstart[ b ]; k < d_bucketstart[ b + 1 ]; k++ )
+				{
+					int i = d_entries[ k ];
+					int c[ 3 ];
+					getCell( d_marker[ i ].loc, c );
+					if ( c[ 0 ] != cell[ 0 ] || c[ 1 ] != cell[ 1 ] || c[ 2 ] != cell[ 2 ] )  // other cell in same bucket
+						continue;
+
+					const double* p = d_marker[ i ].loc;
+					double d2 = ( p[ 0 ] - loc[ 0 ] ) * ( p[ 0 ] - loc[ 0 ] ) + ( p[ 1 ] - loc[ 1 ] ) * ( p[ 1 ] - loc[ 1 ] )
+					            + ( p[ 2 ] - loc[ 2 ] ) * ( p[ 2 ] - loc[ 2 ] );
+					if ( d2 <= r2 )
+						visitor( i, d2 );
+				}
+			}
+		}
+	}
+}
+
+
+/*
+ * Find nearest single marker.
+ */
+int DTrackMarkerGrid::findNearest( const double loc[ 3 ], double maxDistance, double* distance ) const
+{
+	NearestVisitor v;
+	v.index = -1;
+	v.dist2 = maxDistance * maxDistance + 1.0;  // larger than any visited marker
+
+	visit( loc, maxDistance, v );
+
+	if ( distance != NULL && v.index >= 0 )
+		*distance = sqrt( v.dist2 );
+
+	return v.index;
+}
+
+
+/*
+ * Find all single markers within a radius.
+ */
+int DTrackMarkerGrid::findInRadius( const double loc[ 3 ], double radius, std::vector< int >& indices ) const
+{
+	indices.clear();
+
+	RadiusVisitor v;
+	v.indices = &indices;
+
+	visit( loc, radius, v );
+	return static_cast< int >( indices.size() );
+}
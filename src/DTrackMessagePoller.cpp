@@ -0,0 +1,270 @@
+/* DTrackSDK in C++: DTrackMessagePoller.cpp
+ *
+ * Background polling of DTrack2/DTRACK3 event messages.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackMessagePoller.hpp"
+#include "DTrackSDK.hpp"
+
+using namespace DTrackSys;
+
+
+/*
+ * Constructor.
+ */
+DTrackMessagePoller::DTrackMessagePoller( unsigned int remoteIp, int intervalUs, int queueSize, int timeoutUs )
+{
+	if ( queueSize < 1 )
+		queueSize = 1;
+
+	d_remoteIp = remoteIp;
+	d_intervalUs = intervalUs;
+	d_timeoutUs = timeoutUs;
+
+	d_tcp = NULL;
+	d_thread = NULL;
+	d_stop = 0;
+	d_connected = 0;
+
+	d_size = queueSize + 1;  // one entry always stays free
+	d_queue = new DTrackMessage[ d_size ];
+	d_head = 0;
+	d_tail = 0;
+	d_numdropped = 0;
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackMessagePoller::~DTrackMessagePoller()
+{
+	stop();
+
+	delete d_tcp;
+	delete[] d_queue;
+}
+
+
+/*
+ * Start polling thread.
+ */
+bool DTrackMessagePoller::start()
+{
+	if ( d_thread != NULL )  // already running
+		return false;
+
+	d_stop = 0;
+
+	d_thread = new Thread;
+	if ( ! d_thread->start( pollThread, this ) )
+	{
+		delete d_thread;
+		d_thread = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+
+/*
+ * Stop polling thread.
+ */
+void DTrackMessagePoller::stop()
+{
+	if ( d_thread == NULL )
+		return;
+
+	atomic_store( &d_stop, 1 );
+	d_thread->join();
+
+	delete d_thread;
+	d_thread = NULL;
+}
+
+
+/*
+ * Returns if polling thread is running.
+ */
+bool DTrackMessagePoller::isRunning() const
+{
+	return ( d_thread != NULL );
+}
+
+
+/*
+ * Returns if polling thread has a TCP connection to the Controller.
+ */
+bool DTrackMessagePoller::isConnected() const
+{
+	return ( atomic_load( &d_connected ) != 0 );
+}
+
+
+/*
+ * Get and remove oldest message in queue.
+ */
+bool DTrackMessagePoller::pop( DTrackMessage& message )
+{
+	int tail = d_tail;  // just written by this thread
+
+	if ( tail == atomic_load( &d_head ) )  // queue is empty
+		return false;
+
+	message = d_queue[ tail ];
+	atomic_store( &d_tail, ( tail + 1 ) % d_size );
+	return true;
+}
+
+
+/*
+ * Get number of messages dropped, as the queue was full.
+ */
+int DTrackMessagePoller::getNumDropped() const
+{
+	return atomic_load( &d_numdropped );
+}
+
+
+/*
+ * Thread function of polling thread.
+ */
+void DTrackMessagePoller::pollThread( void* arg )
+{
+	static_cast< DTrackMessagePoller* >( arg )->pollLoop();
+}
+
+
+/*
+ * Poll messages regularly, until polling thread is stopped.
+ */
+void DTrackMessagePoller::pollLoop()
+{
+	while ( ! atomic_load( &d_stop ) )
+	{
+		if ( ! pollMessages() )
+		{	// start again with a new connection
+			delete d_tcp;
+			d_tcp = NULL;
+			d_tcpbuf.clear();
+			atomic_store( &d_connected, 0 );
+		}
+
+		// wait for next polling, check for stop regularly
+		int waitUs = d_intervalUs;
+		while ( waitUs > 0 && ! atomic_load( &d_stop ) )
+		{
+			int sliceUs = ( waitUs < DTrackSDK::RECEIVE_THREAD_TIMEOUT ) ? waitUs : DTrackSDK::RECEIVE_THREAD_TIMEOUT;
+			time_sleep( sliceUs * 1e-6 );
+			waitUs -= sliceUs;
+		}
+	}
+}
+
+
+/*
+ * Fetch all waiting messages from the Controller. Returns false if the connection has to be renewed.
+ */
+bool DTrackMessagePoller::pollMessages()
+{
+	if ( d_tcp == NULL )
+	{
+		d_tcp = new DTrackNet::TCP( d_remoteIp, DTrackSDK::DTRACK2_PORT_COMMAND );
+		if ( ! d_tcp->isValid() )
+			return false;
+
+		atomic_store( &d_connected, 1 );
+	}
+
+	// at most one queue length per polling, to check for stop regularly
+	for ( int i = 0; i < d_size && ! atomic_load( &d_stop ); i++ )
+	{
+		std::string ans;
+		if ( request( "dtrack2 getmsg", ans ) != 0 )
+			return false;
+
+		int head = d_head;  // just written by this thread
+		if ( ! DTrackSDK::parseMessage( ans, d_queue[ head ] ) )  // usually "dtrack2 ok" if no more messages
+			break;
+
+		int next = ( head + 1 ) % d_size;
+		if ( next == atomic_load( &d_tail ) )
+		{	// queue is full
+			atomic_store( &d_numdropped, d_numdropped + 1 );
+			continue;
+		}
+
+		atomic_store( &d_head, next );
+	}
+
+	return true;
+}
+
+
+/*
+ * Send command to the Controller and receive answer. Returns 0 if succeeded.
+ */
+int DTrackMessagePoller::request( const std::string& command, std::string& answer )
+{
+	if ( d_tcp->send( command.c_str(), static_cast< int >( command.length() ) + 1, d_timeoutUs ) != 0 )
+		return -11;
+
+	int waitedUs = 0;
+	size_t pos;
+	while ( ( pos = d_tcpbuf.find( '\0' ) ) == std::string::npos )
+	{
+		if ( static_cast< int >( d_tcpbuf.length() ) > DTrackSDK::DTRACK2_PROT_MAXLEN )
+			return -4;
+
+		// receive in slices to check for stop regularly
+		if ( waitedUs >= d_timeoutUs || atomic_load( &d_stop ) )
+			return -1;
+
+		char buf[ DTrackSDK::DTRACK2_PROT_MAXLEN ];
+		int err = d_tcp->receive( buf, DTrackSDK::DTRACK2_PROT_MAXLEN, DTrackSDK::RECEIVE_THREAD_TIMEOUT );
+		if ( err == -1 )
+		{
+			waitedUs += DTrackSDK::RECEIVE_THREAD_TIMEOUT;
+			continue;
+		}
+
+		if ( err == -4 )  // buffer completely filled; more data follows in next call
+			err = DTrackSDK::DTRACK2_PROT_MAXLEN;
+
+		if ( err < 0 )
+			return err;
+
+		d_tcpbuf.append( buf, err );
+	}
+
+	answer = d_tcpbuf.substr( 0, pos );
+	d_tcpbuf.erase( 0, pos + 1 );
+	return 0;
+}
+
@@ -0,0 +1,154 @@
+/* DTrackSDK in C++: DTrackMultiReceiver.cpp
+ *
+ * Receiving tracking data of several sources within one thread.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackMultiReceiver.hpp"
+
+
+/*
+ * Constructor.
+ */
+DTrackMultiReceiver::DTrackMultiReceiver()
+{
+	//
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackMultiReceiver::~DTrackMultiReceiver()
+{
+	for ( size_t i = 0; i < d_sources.size(); i++ )
+	{
+		if ( d_owned[ i ] )
+			delete d_sources[ i ];  // poller doesn't access sockets anymore
+	}
+}
+
+
+/*
+ * Add a new source.
+ */
+int DTrackMultiReceiver::addSource( const std::string& connection )
+{
+	DTrackSDK* sdk = new DTrackSDK( connection );
+
+	int index = addSource( sdk, true );
+	if ( index < 0 )
+		delete sdk;
+
+	return index;
+}
+
+
+/*
+ * Add an existing DTrackSDK instance as source.
+ */
+int DTrackMultiReceiver::addSource( DTrackSDK* sdk )
+{
+	return addSource( sdk, false );
+}
+
+
+/*
+ * Add a source.
+ */
+int DTrackMultiReceiver::addSource( DTrackSDK* sdk, bool isOwner )
+{
+	if ( ( sdk == NULL ) || ! sdk->isDataInterfaceValid() )
+		return -1;
+
+	int index = static_cast< int >( d_sources.size() );
+	if ( ! d_poller.add( sdk->d_udp, index ) )
+		return -1;
+
+	d_sources.push_back( sdk );
+	d_owned.push_back( isOwner ? 1 : 0 );
+	d_ready.resize( d_sources.size() );
+	return index;
+}
+
+
+/*
+ * Get number of sources.
+ */
+int DTrackMultiReceiver::getNumSources() const
+{
+	return static_cast< int >( d_sources.size() );
+}
+
+
+/*
+ * Get DTrackSDK instance of one source.
+ */
+DTrackSDK* DTrackMultiReceiver::getSource( int index ) const
+{
+	if ( ( index < 0 ) || ( index >= static_cast< int >( d_sources.size() ) ) )
+		return NULL;
+
+	return d_sources[ index ];
+}
+
+
+/*
+ * Receive and process tracking data of all sources.
+ */
+int DTrackMultiReceiver::receive( int timeoutUs )
+{
+	d_received.clear();
+
+	if ( d_sources.empty() )
+		return -1;
+
+	int num = d_poller.wait( timeoutUs, &d_ready[ 0 ], static_cast< int >( d_ready.size() ) );
+	if ( num < 0 )
+		return -1;
+
+	for ( int i = 0; i < num; i++ )
+	{
+		int index = d_ready[ i ];
+		if ( d_sources[ index ]->receiveFrame( 0 ) )  // data is available, so no waiting
+			d_received.push_back( index );
+	}
+
+	return static_cast< int >( d_received.size() );
+}
+
+
+/*
+ * Get source of one frame processed by last call of receive().
+ */
+int DTrackMultiReceiver::getReceivedSource( int index ) const
+{
+	if ( ( index < 0 ) || ( index >= static_cast< int >( d_received.size() ) ) )
+		return -1;
+
+	return d_received[ index ];
+}
@@ -31,11 +31,17 @@
  * 
  */
 
+#if defined( __linux__ ) && ! defined( _GNU_SOURCE )
+	#define _GNU_SOURCE  // for 'recvmmsg'
+#endif
+
 #include "DTrackNet.hpp"
+#include "DTrackSys.hpp"
 
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 // usually the following should work; otherwise define OS_* manually:
 #if defined(_WIN32) || defined(WIN32) || defined(_WIN64)
@@ -45,10 +51,17 @@
 #endif
 
 #ifdef OS_UNIX
+	#include <cerrno>
+	#include <fcntl.h>
 	#include <unistd.h>
+	#include <poll.h>
+#ifdef __linux__
+	#include <sys/epoll.h>
+#endif
 	#include <netdb.h>
 	#include <sys/socket.h>
 	#include <sys/time.h>
+	#include <time.h>
 	#include <netinet/in.h>
 	#include <arpa/inet.h>
 #endif
@@ -58,6 +71,23 @@
 	#include <windows.h>
 #endif
 
+#if defined( OS_UNIX ) && defined( __linux__ )
+	#define NET_RECVMMSG  // receive several UDP packets with one syscall
+#endif
+
+#if defined( OS_UNIX ) && defined( __linux__ )
+	#define NET_EPOLL  // waiting for several sockets by epoll
+#endif
+
+#if defined( OS_UNIX ) && ( defined( SO_TIMESTAMPNS ) || defined( SO_TIMESTAMP ) )
+	#define NET_TIMESTAMP  // kernel receive timestamps of UDP packets
+	#define NET_CTRLLEN 64  // size of buffer for ancillary data (timestamp) per packet
+#endif
+
+#if defined( NET_TIMESTAMP ) && defined( SO_RXQ_OVFL )
+	#define NET_RXQOVFL  // number of packets dropped by the kernel, sharing the buffer for ancillary data
+#endif
+
 namespace DTrackNet {
 
 /**
@@ -66,6 +96,8 @@ namespace DTrackNet {
 struct _ip_socket_struct {
 #ifdef OS_UNIX
 	int ossock;  // Unix socket
+	int rcvtimeo_us;  // actual receive timeout of socket (SO_RCVTIMEO) in us, 0 if not set
+	unsigned int rxq_dropped;  // number of packets dropped by the kernel (SO_RXQ_OVFL), as of latest packet
 #endif
 #ifdef OS_WIN
 	SOCKET ossock;  // Windows socket
@@ -73,6 +105,313 @@ struct _ip_socket_struct {
 };
 
 
+/**
+ * \brief Internal buffers for receiving several UDP packets at once.
+ */
+struct _ip_batch_struct {
+	int num;  // number of allocated entries
+#ifdef NET_RECVMMSG
+	struct mmsghdr* msgs;
+	struct iovec* iov;
+	struct sockaddr_in* addr;
+#ifdef NET_TIMESTAMP
+	char* ctrl;
+#endif
+#endif
+};
+
+
+/**
+ * \brief Internal state for waiting for several sockets.
+ */
+struct _ip_poll_struct {
+	std::vector< UDP* > udp;  // added sockets
+	std::vector< int > ids;   // identifiers of added sockets
+#ifdef NET_EPOLL
+	int epfd;  // epoll instance
+	std::vector< struct epoll_event > events;
+#else
+#ifdef OS_UNIX
+	std::vector< struct pollfd > pfds;
+#endif
+#ifdef OS_WIN
+	std::vector< WSAPOLLFD > pfds;
+#endif
+#endif
+};
+
+
+/*
+ * Wait until socket is ready for reading or writing.
+ *
+ * Returns 1 if socket is ready, 0 if timeout, -1 if error occured.
+ */
+static int socket_wait( struct _ip_socket_struct* s, bool isWrite, int toutUs )
+{
+#ifdef OS_UNIX
+	// poll() does not limit the value of the socket descriptor, unlike select() with FD_SETSIZE
+	struct pollfd pfd;
+	pfd.fd = s->ossock;
+	pfd.events = isWrite ? POLLOUT : POLLIN;
+	pfd.revents = 0;
+
+#ifdef __linux__
+	struct timespec tout;
+	tout.tv_sec = toutUs / 1000000;
+	tout.tv_nsec = ( toutUs % 1000000 ) * 1000;
+
+	int err = ppoll( &pfd, 1, &tout, NULL );
+#else
+	int err = poll( &pfd, 1, ( toutUs + 999 ) / 1000 );
+#endif
+	if ( err < 0 )  return -1;
+	if ( err == 0 )  return 0;
+
+	return ( pfd.revents & ( isWrite ? POLLOUT : POLLIN ) ) ? 1 : -1;
+#endif
+#ifdef OS_WIN
+	// Windows' fd_set is a list of sockets, so select() does not limit the value of the socket
+	fd_set set;
+	struct timeval tout;
+
+	FD_ZERO(&set);
+	FD_SET( s->ossock, &set );
+	tout.tv_sec = toutUs / 1000000;
+	tout.tv_usec = toutUs % 1000000;
+
+	int err;
+	if ( isWrite )
+	{
+		err = select( 0, NULL, &set, NULL, &tout );
+	}
+	else
+	{
+		err = select( 0, &set, NULL, NULL, &tout );
+	}
+	if ( err < 0 )  return -1;
+
+	return ( err > 0 ) ? 1 : 0;
+#endif
+}
+
+
+#ifdef OS_UNIX
+
+/*
+ * Set receive timeout of socket (SO_RCVTIMEO), if changed.
+ *
+ * Returns if setting succeeded.
+ */
+static bool socket_set_rcvtimeo( struct _ip_socket_struct* s, int toutUs )
+{
+	if ( s->rcvtimeo_us == toutUs )  return true;
+
+	struct timeval tout;
+	tout.tv_sec = toutUs / 1000000;
+	tout.tv_usec = toutUs % 1000000;
+
+	if ( setsockopt( s->ossock, SOL_SOCKET, SO_RCVTIMEO, ( char* )&tout, sizeof( tout ) ) < 0 )
+		return false;
+
+	s->rcvtimeo_us = toutUs;
+	return true;
+}
+
+
+/*
+ * Get error code for failed receive.
+ *
+ * Returns -1 if timeout, -2 if interrupted, -3 if other error occured.
+ */
+static int socket_recv_error()
+{
+	if ( ( errno == EAGAIN ) || ( errno == EWOULDBLOCK ) )  return -1;
+	if ( errno == EINTR )  return -2;
+
+	return -3;
+}
+
+#endif
+
+
+#ifdef NET_TIMESTAMP
+
+/*
+ * Get kernel receive timestamp (system time) out of ancillary data of a received packet.
+ *
+ * Returns if timestamp was found.
+ */
+static bool udp_kerneltime( struct msghdr* msg, struct timespec* ts )
+{
+	if ( msg->msg_flags & MSG_CTRUNC )
+		return false;
+
+	for ( struct cmsghdr* cmsg = CMSG_FIRSTHDR( msg ); cmsg != NULL; cmsg = CMSG_NXTHDR( msg, cmsg ) )
+	{
+		if ( cmsg->cmsg_level != SOL_SOCKET )
+			continue;
+
+#ifdef SCM_TIMESTAMPNS
+		if ( cmsg->cmsg_type == SCM_TIMESTAMPNS )
+		{
+			memcpy( ts, CMSG_DATA( cmsg ), sizeof( struct timespec ) );
+			return true;
+		}
+#endif
+#ifdef SCM_TIMESTAMP
+		if ( cmsg->cmsg_type == SCM_TIMESTAMP )
+		{
+			struct timeval tv;
+			memcpy( &tv, CMSG_DATA( cmsg ), sizeof( struct timeval ) );
+			ts->tv_sec = tv.tv_sec;
+			ts->tv_nsec = tv.tv_usec * 1000;
+			return true;
+		}
+#endif
+	}
+	return false;
+}
+
+
+/*
+ * Convert kernel receive timestamp to monotonic clock.
+ *
+ * Returns arrival time in s, monoNow if no (plausible) kernel timestamp is available.
+ */
+static double udp_arrivaltime( struct msghdr* msg, double monoNow, const struct timespec* realNow )
+{
+	struct timespec ts;
+	if ( ! udp_kerneltime( msg, &ts ) )
+		return monoNow;
+
+	double delay = ( double )( realNow->tv_sec - ts.tv_sec ) + ( double )( realNow->tv_nsec - ts.tv_nsec ) * 1e-9;
+	if ( ( delay < 0.0 ) || ( delay > 10.0 ) )  // system time was changed meanwhile
+		return monoNow;
+
+	return monoNow - delay;
+}
+
+#endif
+
+
+#ifdef NET_RXQOVFL
+
+/*
+ * Get number of packets dropped by the kernel out of ancillary data of a received packet.
+ *
+ * Just available if packets were dropped at all.
+ */
+static void udp_kerneldropped( struct msghdr* msg, struct _ip_socket_struct* s )
+{
+	if ( msg->msg_flags & MSG_CTRUNC )
+		return;
+
+	for ( struct cmsghdr* cmsg = CMSG_FIRSTHDR( msg ); cmsg != NULL; cmsg = CMSG_NXTHDR( msg, cmsg ) )
+	{
+		if ( ( cmsg->cmsg_level == SOL_SOCKET ) && ( cmsg->cmsg_type == SO_RXQ_OVFL ) )
+		{
+			unsigned int num;
+			memcpy( &num, CMSG_DATA( cmsg ), sizeof( num ) );
+			s->rxq_dropped = num;
+			return;
+		}
+	}
+}
+
+#endif
+
+
+/*
+ * Receive one UDP packet.
+ *
+ * Returns number of received bytes, <0 if error occured. A truncated packet returns at least maxLen
+ * (its actual size on Linux).
+ */
+static int udp_recvfrom( struct _ip_socket_struct* s, char* buffer, int maxLen, int flags, unsigned int* remoteIp,
+                         double* arrivalTime )
+{
+	struct sockaddr_in addr;
+#ifdef OS_UNIX
+	struct iovec iov;
+	struct msghdr msg;
+#ifdef NET_TIMESTAMP
+	union {
+		struct cmsghdr align;
+		char buf[ NET_CTRLLEN ];
+	} ctrl;
+#endif
+
+	iov.iov_base = buffer;
+	iov.iov_len = maxLen;
+
+	memset( &msg, 0, sizeof( msg ) );
+	msg.msg_name = &addr;
+	msg.msg_namelen = sizeof( struct sockaddr_in );
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+#ifdef NET_TIMESTAMP
+	msg.msg_control = ctrl.buf;
+	msg.msg_controllen = sizeof( ctrl.buf );
+#endif
+
+#ifdef __linux__
+	flags |= MSG_TRUNC;  // returns actual size of a truncated packet
+#endif
+
+	int nbytes = static_cast< int >( recvmsg( s->ossock, &msg, flags ) );  // receive one packet
+	if ( nbytes < 0 )
+		return nbytes;
+
+	if ( msg.msg_flags & MSG_TRUNC )
+	{
+		if ( nbytes < maxLen )
+			nbytes = maxLen;
+	}
+
+#ifdef NET_RXQOVFL
+	udp_kerneldropped( &msg, s );
+#endif
+
+	if ( arrivalTime != NULL )
+	{
+#ifdef NET_TIMESTAMP
+		struct timespec realNow;
+		clock_gettime( CLOCK_REALTIME, &realNow );
+		*arrivalTime = udp_arrivaltime( &msg, DTrackSys::time_monotonic(), &realNow );
+#else
+		*arrivalTime = DTrackSys::time_monotonic();
+#endif
+	}
+#endif
+#ifdef OS_WIN
+	int addrlen = sizeof( struct sockaddr_in );
+
+	int nbytes = static_cast< int >( recvfrom( s->ossock, buffer, maxLen, flags,
+	                                           ( struct sockaddr* )&addr, &addrlen ) );  // receive one packet
+	if ( nbytes < 0 )
+	{
+		if ( WSAGetLastError() != WSAEMSGSIZE )
+			return nbytes;
+
+		nbytes = maxLen;  // truncated packet
+	}
+
+	if ( arrivalTime != NULL )
+	{
+		*arrivalTime = DTrackSys::time_monotonic();  // no kernel timestamp available
+	}
+#endif
+
+	if ( addr.sin_family == AF_INET )  // only IPv4 supported
+	{
+		*remoteIp = ntohl( addr.sin_addr.s_addr );
+	}
+
+	return nbytes;
+}
+
+
+
 /*
  * Initialize network ressources.
  */
@@ -129,6 +468,34 @@ unsigned int ip_name2ip( const char* name )
 }
 
 
+/*
+ * Convert string to IP address (IPv4 only), without resolving hostnames.
+ */
+unsigned int ip_str2ip( const char* str )
+{
+	int err;
+	struct addrinfo hints, *res;
+
+	memset( &hints, 0, sizeof( hints ) );
+	hints.ai_family = AF_INET;  // only IPv4 supported
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_NUMERICHOST;
+
+	res = NULL;
+	err = getaddrinfo( str, NULL, &hints, &res );
+	if ( err != 0 || res == NULL )
+		return 0;
+
+	unsigned int ip;
+	struct sockaddr_in sin;
+	memcpy( &sin, res->ai_addr, sizeof( sin ) );  // casting is causing warnings (-Wcast-align) by some compilers
+	ip = ntohl( ( (struct in_addr )( sin.sin_addr ) ).s_addr );
+
+	freeaddrinfo( res );
+	return ip;
+}
+
+
 // ---------------------------------------------------------------------------------------------------
 // Handling UDP data:
 // ---------------------------------------------------------------------------------------------------
@@ -137,7 +504,8 @@ unsigned int ip_name2ip( const char* name )
  * Initialize UDP socket.
  */
 UDP::UDP( unsigned short port, unsigned int multicastIp )
-	: m_isValid( false ), m_socket( NULL ), m_port( port ), m_multicastIp( 0 ), m_remoteIp( 0 )
+	: m_isValid( false ), m_socket( NULL ), m_batch( NULL ), m_port( port ), m_multicastIp( 0 ), m_remoteIp( 0 ),
+	  m_numDiscarded( 0 ), m_truncatedSize( 0 )
 {
 	struct _ip_socket_struct* s;
 	struct sockaddr_in addr;
@@ -179,6 +547,27 @@ UDP::UDP( unsigned short port, unsigned int multicastIp )
 			return;
 		}
 	}
+
+#ifdef NET_TIMESTAMP
+	// enable kernel receive timestamps (optional):
+	{
+		int flag_on = 1;
+#ifdef SO_TIMESTAMPNS
+		if ( setsockopt( m_socket->ossock, SOL_SOCKET, SO_TIMESTAMPNS, ( char* )&flag_on, sizeof( flag_on ) ) < 0 )
+#endif
+		{
+			setsockopt( m_socket->ossock, SOL_SOCKET, SO_TIMESTAMP, ( char* )&flag_on, sizeof( flag_on ) );
+		}
+	}
+#endif
+
+#ifdef NET_RXQOVFL
+	// enable number of packets dropped by the kernel (optional):
+	{
+		int flag_on = 1;
+		setsockopt( m_socket->ossock, SOL_SOCKET, SO_RXQ_OVFL, ( char* )&flag_on, sizeof( flag_on ) );
+	}
+#endif
 	
 	// name socket:
 	addr.sin_family = AF_INET;
@@ -221,6 +610,19 @@ UDP::UDP( unsigned short port, unsigned int multicastIp )
  */
 UDP::~UDP()
 {
+	if ( m_batch != NULL )
+	{
+#ifdef NET_RECVMMSG
+		delete[] m_batch->msgs;
+		delete[] m_batch->iov;
+		delete[] m_batch->addr;
+#ifdef NET_TIMESTAMP
+		delete[] m_batch->ctrl;
+#endif
+#endif
+		delete m_batch;
+	}
+
 	if ( m_socket == NULL )  return;
 
 	if ( m_multicastIp != 0 )
@@ -273,71 +675,365 @@ unsigned int UDP::getRemoteIp()
 
 
 /*
- * Receive UDP data.
+ * Get number of packets discarded by latest receive().
  */
-int UDP::receive( void *buffer, int maxLen, int toutUs )
+int UDP::getNumDiscarded()
 {
-	int err;
-	fd_set set;
-	struct timeval tout;
+	return m_numDiscarded;
+}
 
-	// waiting for data:
-	FD_ZERO(&set);
-	FD_SET( m_socket->ossock, &set );
-	tout.tv_sec = toutUs / 1000000;
-	tout.tv_usec = toutUs % 1000000;
 
-	err = select( FD_SETSIZE, &set, NULL, NULL, &tout );
-	switch ( err )
-	{
-		case 1:
-			break;        // data available
-		case 0:
-			return -1;    // timeout
-		default:
-			return -2;    // error
-	}
+/*
+ * Get size of largest packet truncated by latest receive() or receiveBatch().
+ */
+int UDP::getTruncatedSize()
+{
+	return m_truncatedSize;
+}
 
-	// receiving packet:
-	while ( true )
-	{
-		struct sockaddr_in addr;
-#ifdef OS_UNIX
-		socklen_t addrlen;
-#endif
-#ifdef OS_WIN
-		int addrlen;
+
+/*
+ * Get number of packets dropped by the kernel.
+ */
+unsigned int UDP::getNumKernelDropped()
+{
+#ifdef NET_RXQOVFL
+	if ( m_socket != NULL )
+		return m_socket->rxq_dropped;
 #endif
-		addrlen = sizeof( struct sockaddr_in );
+	return 0;
+}
 
-		int nbytes = static_cast< int >( recvfrom( m_socket->ossock, ( char* )buffer, maxLen, 0,
-		                                           ( struct sockaddr* )&addr, &addrlen ) );  // receive one packet
-		if (nbytes < 0)
-		{	// receive error
-			return -3;
-		}
 
-		if ( addr.sin_family == AF_INET )  // only IPv4 supported
-		{
-			m_remoteIp = ntohl( addr.sin_addr.s_addr );
-		}
+/*
+ * Set size of the kernel receive buffer of the socket.
+ */
+bool UDP::setReceiveBufferSize( int size )
+{
+	if ( ! m_isValid || size <= 0 )
+		return false;
 
-		// check, if more data available: if so, receive another packet
-		FD_ZERO(&set);
-		FD_SET( m_socket->ossock, &set );
+#ifdef SO_RCVBUFFORCE
+	// exceeding the system limit needs according privileges
+	if ( setsockopt( m_socket->ossock, SOL_SOCKET, SO_RCVBUFFORCE, ( char* )&size, sizeof( size ) ) == 0 )
+		return true;
+#endif
+	if ( setsockopt( m_socket->ossock, SOL_SOCKET, SO_RCVBUF, ( char* )&size, sizeof( size ) ) < 0 )
+		return false;
 
-		tout.tv_sec = 0;   // no timeout
-		tout.tv_usec = 0;
-		if (select(FD_SETSIZE, &set, NULL, NULL, &tout) != 1)
+	return true;
+}
+
+
+/*
+ * Get size of the kernel receive buffer of the socket.
+ */
+int UDP::getReceiveBufferSize()
+{
+	if ( ! m_isValid )
+		return -1;
+
+	int size = 0;
+#ifdef OS_UNIX
+	socklen_t len = sizeof( size );
+#endif
+#ifdef OS_WIN
+	int len = sizeof( size );
+#endif
+	if ( getsockopt( m_socket->ossock, SOL_SOCKET, SO_RCVBUF, ( char* )&size, &len ) < 0 )
+		return -1;
+
+	return size;
+}
+
+
+/*
+ * Set busy polling of the socket.
+ */
+bool UDP::setBusyPoll( int us )
+{
+	if ( ! m_isValid || us < 0 )
+		return false;
+
+#ifdef SO_BUSY_POLL
+	if ( setsockopt( m_socket->ossock, SOL_SOCKET, SO_BUSY_POLL, ( char* )&us, sizeof( us ) ) < 0 )
+		return false;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+/*
+ * Receive UDP data.
+ */
+int UDP::receive( void *buffer, int maxLen, int toutUs, double* arrivalTime )
+{
+	int nbytes;
+
+	m_numDiscarded = 0;
+	m_truncatedSize = 0;
+
+#ifdef OS_UNIX
+	// waiting for data and receiving packet with a single syscall:
+	int flags = MSG_DONTWAIT;
+	if ( toutUs > 0 )
+	{
+		if ( ! socket_set_rcvtimeo( m_socket, toutUs ) )
+			return -2;
+
+		flags = 0;
+	}
+
+	nbytes = udp_recvfrom( m_socket, ( char* )buffer, maxLen, flags, &m_remoteIp, arrivalTime );
+	if ( nbytes < 0 )
+		return socket_recv_error();
+
+	if ( nbytes >= maxLen )
+		m_truncatedSize = nbytes;
+
+	// as long as more data is available, receive another packet:
+	while ( true )
+	{
+		int n = udp_recvfrom( m_socket, ( char* )buffer, maxLen, MSG_DONTWAIT, &m_remoteIp, arrivalTime );
+		if ( n < 0 )
+			break;  // no more data available
+
+		nbytes = n;
+		m_numDiscarded++;
+
+		if ( nbytes >= maxLen && nbytes > m_truncatedSize )
+			m_truncatedSize = nbytes;
+	}
+#endif
+#ifdef OS_WIN
+	// waiting for data:
+	switch ( socket_wait( m_socket, false, toutUs ) )
+	{
+		case 1:
+			break;        // data available
+		case 0:
+			return -1;    // timeout
+		default:
+			return -2;    // error
+	}
+
+	// receiving packet:
+	while ( true )
+	{
+		nbytes = udp_recvfrom( m_socket, ( char* )buffer, maxLen, 0, &m_remoteIp, arrivalTime );
+		if ( nbytes < 0 )
+		{	// receive error
+			return -3;
+		}
+
+		if ( nbytes >= maxLen && nbytes > m_truncatedSize )
+			m_truncatedSize = nbytes;
+
+		// check, if more data available: if so, receive another packet
+		if ( socket_wait( m_socket, false, 0 ) != 1 )
+			break;
+
+		m_numDiscarded++;
+	}
+#endif
+
+	// no more data available: check length of received packet and return
+	if ( nbytes >= maxLen )
+	{   // buffer overflow
+		return -4;
+	}
+	return nbytes;
+}
+
+
+/*
+ * Receive all pending UDP data.
+ */
+int UDP::receiveBatch( void* buffer, int slotSize, int maxNum, int* len, int toutUs, double* arrivalTime )
+{
+	if ( ( maxNum <= 0 ) || ( slotSize <= 1 ) )
+		return -2;
+
+	char* slot = ( char* )buffer;
+	int maxLen = slotSize - 1;  // keep space for terminating '\0'
+	int num = 0;
+
+	m_truncatedSize = 0;
+
+#ifdef NET_RECVMMSG
+	// waiting for data and receiving all packets with a single syscall:
+	int flags = MSG_DONTWAIT;
+	if ( toutUs > 0 )
+	{
+		if ( ! socket_set_rcvtimeo( m_socket, toutUs ) )
+			return -2;
+
+		flags = MSG_WAITFORONE;  // block just until first packet arrived
+	}
+
+	flags |= MSG_TRUNC;  // returns actual size of truncated packets
+
+	if ( m_batch == NULL )
+	{
+		m_batch = new struct _ip_batch_struct();
+		m_batch->num = 0;
+		m_batch->msgs = NULL;
+		m_batch->iov = NULL;
+		m_batch->addr = NULL;
+#ifdef NET_TIMESTAMP
+		m_batch->ctrl = NULL;
+#endif
+	}
+
+	if ( m_batch->num < maxNum )
+	{
+		delete[] m_batch->msgs;
+		delete[] m_batch->iov;
+		delete[] m_batch->addr;
+#ifdef NET_TIMESTAMP
+		delete[] m_batch->ctrl;
+#endif
+
+		m_batch->msgs = new struct mmsghdr[ maxNum ];
+		m_batch->iov = new struct iovec[ maxNum ];
+		m_batch->addr = new struct sockaddr_in[ maxNum ];
+#ifdef NET_TIMESTAMP
+		m_batch->ctrl = new char[ maxNum * NET_CTRLLEN ];  // alignment of 'new' suits 'struct cmsghdr'
+#endif
+		m_batch->num = maxNum;
+	}
+
+	for ( int i = 0; i < maxNum; i++ )
+	{
+		m_batch->iov[ i ].iov_base = slot + i * slotSize;
+		m_batch->iov[ i ].iov_len = maxLen;
+
+		memset( &m_batch->msgs[ i ], 0, sizeof( struct mmsghdr ) );
+		m_batch->msgs[ i ].msg_hdr.msg_name = &m_batch->addr[ i ];
+		m_batch->msgs[ i ].msg_hdr.msg_namelen = sizeof( struct sockaddr_in );
+		m_batch->msgs[ i ].msg_hdr.msg_iov = &m_batch->iov[ i ];
+		m_batch->msgs[ i ].msg_hdr.msg_iovlen = 1;
+#ifdef NET_TIMESTAMP
+		m_batch->msgs[ i ].msg_hdr.msg_control = m_batch->ctrl + i * NET_CTRLLEN;
+		m_batch->msgs[ i ].msg_hdr.msg_controllen = NET_CTRLLEN;
+#endif
+	}
+
+	num = recvmmsg( m_socket->ossock, m_batch->msgs, maxNum, flags, NULL );
+	if ( num < 0 )
+		return socket_recv_error();
+
+	if ( num == 0 )
+	{	// receive error
+		return -3;
+	}
+
+	if ( arrivalTime != NULL )
+	{
+		double monoNow = DTrackSys::time_monotonic();
+#ifdef NET_TIMESTAMP
+		struct timespec realNow;
+		clock_gettime( CLOCK_REALTIME, &realNow );
+#endif
+
+		for ( int i = 0; i < num; i++ )
 		{
-			// no more data available: check length of received packet and return
-			if ( nbytes >= maxLen )
-			{   // buffer overflow
-				return -4;
-			}
-			return nbytes;
+#ifdef NET_TIMESTAMP
+			arrivalTime[ i ] = udp_arrivaltime( &m_batch->msgs[ i ].msg_hdr, monoNow, &realNow );
+#else
+			arrivalTime[ i ] = monoNow;
+#endif
+		}
+	}
+
+	for ( int i = 0; i < num; i++ )
+	{
+		int nbytes = static_cast< int >( m_batch->msgs[ i ].msg_len );
+
+#ifdef NET_RXQOVFL
+		udp_kerneldropped( &m_batch->msgs[ i ].msg_hdr, m_socket );
+#endif
+
+		if ( ( nbytes >= maxLen ) || ( m_batch->msgs[ i ].msg_hdr.msg_flags & MSG_TRUNC ) )
+		{   // buffer overflow
+			if ( nbytes < maxLen )
+				nbytes = maxLen;
+
+			if ( nbytes > m_truncatedSize )
+				m_truncatedSize = nbytes;
+
+			len[ i ] = -4;
+			nbytes = 0;
+		}
+		else
+		{
+			len[ i ] = nbytes;
+		}
+		slot[ i * slotSize + nbytes ] = '\0';
+	}
+
+	if ( m_batch->addr[ num - 1 ].sin_family == AF_INET )  // only IPv4 supported
+	{
+		m_remoteIp = ntohl( m_batch->addr[ num - 1 ].sin_addr.s_addr );
+	}
+#else
+	// waiting for data:
+	switch ( socket_wait( m_socket, false, toutUs ) )
+	{
+		case 1:
+			break;        // data available
+		case 0:
+			return -1;    // timeout
+		default:
+			return -2;    // error
+	}
+
+	// receiving packets:
+	while ( num < maxNum )
+	{
+		char* s = slot + num * slotSize;
+#ifdef OS_UNIX
+		int nbytes = udp_recvfrom( m_socket, s, maxLen, MSG_DONTWAIT, &m_remoteIp,
+		                           ( arrivalTime != NULL ) ? &arrivalTime[ num ] : NULL );
+#endif
+#ifdef OS_WIN
+		int nbytes = udp_recvfrom( m_socket, s, maxLen, 0, &m_remoteIp,
+		                           ( arrivalTime != NULL ) ? &arrivalTime[ num ] : NULL );
+#endif
+		if ( nbytes < 0 )
+		{
+			if ( num > 0 )  break;  // no more data available
+
+			return -3;  // receive error
+		}
+
+		if ( nbytes >= maxLen )
+		{   // buffer overflow
+			if ( nbytes > m_truncatedSize )
+				m_truncatedSize = nbytes;
+
+			len[ num ] = -4;
+			nbytes = 0;
 		}
+		else
+		{
+			len[ num ] = nbytes;
+		}
+		s[ nbytes ] = '\0';
+		num++;
+
+#ifdef OS_WIN
+		// check, if more data available: if so, receive another packet
+		if ( socket_wait( m_socket, false, 0 ) != 1 )
+			break;
+#endif
 	}
+#endif
+
+	return num;
 }
 
 
@@ -346,9 +1042,6 @@ int UDP::receive( void *buffer, int maxLen, int toutUs )
  */
 int UDP::send( const void* buffer, int len, unsigned int ip, unsigned short port, int toutUs )
 {
-	fd_set set;
-	struct timeval tout;
-	int err;
 	struct sockaddr_in addr;
 
 	// building address:
@@ -357,13 +1050,7 @@ int UDP::send( const void* buffer, int len, unsigned int ip, unsigned short port
 	addr.sin_port = htons(port);
 
 	// waiting to send data:
-	FD_ZERO(&set);
-	FD_SET( m_socket->ossock, &set );
-	tout.tv_sec = toutUs / 1000000;
-	tout.tv_usec = toutUs % 1000000;
-
-	err = select( FD_SETSIZE, NULL, &set, NULL, &tout );
-	switch ( err )
+	switch ( socket_wait( m_socket, true, toutUs ) )
 	{
 		case 1:
 			break;
@@ -384,6 +1071,188 @@ int UDP::send( const void* buffer, int len, unsigned int ip, unsigned short port
 }
 
 
+/*
+ * Set time-to-live of sent multicast packets.
+ */
+bool UDP::setMulticastTTL( int ttl )
+{
+	if ( ! m_isValid || ttl < 0 || ttl > 255 )
+		return false;
+
+#ifdef OS_UNIX
+	unsigned char value = static_cast< unsigned char >( ttl );
+#endif
+#ifdef OS_WIN
+	DWORD value = static_cast< DWORD >( ttl );
+#endif
+	if ( setsockopt( m_socket->ossock, IPPROTO_IP, IP_MULTICAST_TTL, ( char* )&value, sizeof( value ) ) < 0 )
+		return false;
+
+	return true;
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Waiting for several UDP sockets:
+// ---------------------------------------------------------------------------------------------------
+
+/*
+ * Constructor.
+ */
+UDPPoller::UDPPoller()
+{
+	m_poll = new struct _ip_poll_struct();
+#ifdef NET_EPOLL
+	m_poll->epfd = epoll_create( 16 );  // size is just a hint
+#endif
+}
+
+
+/*
+ * Destructor.
+ */
+UDPPoller::~UDPPoller()
+{
+#ifdef NET_EPOLL
+	if ( m_poll->epfd >= 0 )
+		close( m_poll->epfd );
+#endif
+	delete m_poll;
+}
+
+
+/*
+ * Add a UDP socket.
+ */
+bool UDPPoller::add( UDP* udp, int id )
+{
+	if ( ( udp == NULL ) || ( udp->m_socket == NULL ) )
+		return false;
+
+	for ( size_t i = 0; i < m_poll->udp.size(); i++ )
+	{
+		if ( m_poll->udp[ i ] == udp )
+			return false;  // already added
+	}
+
+#ifdef NET_EPOLL
+	if ( m_poll->epfd < 0 )
+		return false;
+
+	struct epoll_event ev;
+	memset( &ev, 0, sizeof( ev ) );
+	ev.events = EPOLLIN;
+	ev.data.u32 = static_cast< unsigned int >( m_poll->udp.size() );  // index of socket
+	if ( epoll_ctl( m_poll->epfd, EPOLL_CTL_ADD, udp->m_socket->ossock, &ev ) < 0 )
+		return false;
+
+	m_poll->events.resize( m_poll->udp.size() + 1 );
+#else
+#ifdef OS_UNIX
+	struct pollfd pfd;
+#endif
+#ifdef OS_WIN
+	WSAPOLLFD pfd;
+#endif
+	pfd.fd = udp->m_socket->ossock;
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+	m_poll->pfds.push_back( pfd );
+#endif
+
+	m_poll->udp.push_back( udp );
+	m_poll->ids.push_back( id );
+	return true;
+}
+
+
+/*
+ * Remove a UDP socket.
+ */
+bool UDPPoller::remove( UDP* udp )
+{
+	size_t index = 0;
+	while ( ( index < m_poll->udp.size() ) && ( m_poll->udp[ index ] != udp ) )
+		index++;
+
+	if ( index >= m_poll->udp.size() )
+		return false;
+
+#ifdef NET_EPOLL
+	epoll_ctl( m_poll->epfd, EPOLL_CTL_DEL, udp->m_socket->ossock, NULL );
+
+	size_t last = m_poll->udp.size() - 1;
+	if ( index != last )
+	{	// move last socket to free index
+		struct epoll_event ev;
+		memset( &ev, 0, sizeof( ev ) );
+		ev.events = EPOLLIN;
+		ev.data.u32 = static_cast< unsigned int >( index );
+		epoll_ctl( m_poll->epfd, EPOLL_CTL_MOD, m_poll->udp[ last ]->m_socket->ossock, &ev );
+	}
+	m_poll->events.resize( last );
+#else
+	m_poll->pfds[ index ] = m_poll->pfds.back();
+	m_poll->pfds.pop_back();
+#endif
+
+	m_poll->udp[ index ] = m_poll->udp.back();
+	m_poll->udp.pop_back();
+	m_poll->ids[ index ] = m_poll->ids.back();
+	m_poll->ids.pop_back();
+	return true;
+}
+
+
+/*
+ * Wait until data is available on at least one socket.
+ */
+int UDPPoller::wait( int toutUs, int* ids, int maxNum )
+{
+	if ( m_poll->udp.empty() || ( maxNum <= 0 ) )
+		return -2;
+
+	int toutMs = ( toutUs > 0 ) ? ( toutUs + 999 ) / 1000 : 0;
+	int num = 0;
+
+#ifdef NET_EPOLL
+	int maxEvents = static_cast< int >( m_poll->events.size() );
+	if ( maxEvents > maxNum )
+		maxEvents = maxNum;
+
+	int n = epoll_wait( m_poll->epfd, &m_poll->events[ 0 ], maxEvents, toutMs );
+	if ( n < 0 )
+		return ( errno == EINTR ) ? 0 : -1;
+
+	for ( int i = 0; i < n; i++ )
+	{
+		unsigned int index = m_poll->events[ i ].data.u32;
+		if ( index < m_poll->ids.size() )
+			ids[ num++ ] = m_poll->ids[ index ];
+	}
+#else
+#ifdef OS_UNIX
+	int n = poll( &m_poll->pfds[ 0 ], static_cast< nfds_t >( m_poll->pfds.size() ), toutMs );
+	if ( n < 0 )
+		return ( errno == EINTR ) ? 0 : -1;
+#endif
+#ifdef OS_WIN
+	int n = WSAPoll( &m_poll->pfds[ 0 ], static_cast< ULONG >( m_poll->pfds.size() ), toutMs );
+	if ( n == SOCKET_ERROR )
+		return -1;
+#endif
+
+	for ( size_t i = 0; ( i < m_poll->pfds.size() ) && ( num < maxNum ); i++ )
+	{
+		if ( m_poll->pfds[ i ].revents != 0 )
+			ids[ num++ ] = m_poll->ids[ i ];
+	}
+#endif
+
+	return num;
+}
+
+
 // ---------------------------------------------------------------------------------------------------
 // Handling TCP data:
 // ---------------------------------------------------------------------------------------------------
@@ -393,6 +1262,25 @@ int UDP::send( const void* buffer, int len, unsigned int ip, unsigned short port
  */
 TCP::TCP( unsigned int ip, unsigned short port )
 	: m_isValid( false ), m_socket( NULL )
+{
+	connectServer( ip, port, -1 );
+}
+
+
+/*
+ * Initialize client TCP socket, with timeout for establishing the connection.
+ */
+TCP::TCP( unsigned int ip, unsigned short port, int toutUs )
+	: m_isValid( false ), m_socket( NULL )
+{
+	connectServer( ip, port, ( toutUs < 0 ) ? 0 : toutUs );
+}
+
+
+/*
+ * Create socket and connect with server. Blocking if timeout is negative.
+ */
+void TCP::connectServer( unsigned int ip, unsigned short port, int toutUs )
 {
 	struct _ip_socket_struct* s;
 	struct sockaddr_in addr;
@@ -422,8 +1310,61 @@ TCP::TCP( unsigned int ip, unsigned short port )
 	addr.sin_family = AF_INET;
 	addr.sin_addr.s_addr = htonl(ip);
 	addr.sin_port = htons(port);
+	if ( toutUs < 0 )
+	{
+		if ( connect( m_socket->ossock, (struct sockaddr *)&addr, (size_t )sizeof( addr ) ) != 0 )
+			return;
+
+		m_isValid = true;
+		return;
+	}
+
+	// non-blocking connect, waiting until socket gets writable:
+#ifdef OS_UNIX
+	int flags = fcntl( m_socket->ossock, F_GETFL, 0 );
+	if ( flags < 0 || fcntl( m_socket->ossock, F_SETFL, flags | O_NONBLOCK ) < 0 )
+		return;
+
 	if ( connect( m_socket->ossock, (struct sockaddr *)&addr, (size_t )sizeof( addr ) ) != 0 )
+	{
+		if ( errno != EINPROGRESS )
+			return;
+
+		if ( socket_wait( m_socket, true, toutUs ) != 1 )
+			return;
+
+		int err = 0;
+		socklen_t len = sizeof( err );
+		if ( getsockopt( m_socket->ossock, SOL_SOCKET, SO_ERROR, &err, &len ) != 0 || err != 0 )
+			return;
+	}
+
+	if ( fcntl( m_socket->ossock, F_SETFL, flags ) < 0 )
+		return;
+#endif
+#ifdef OS_WIN
+	u_long nonblocking = 1;
+	if ( ioctlsocket( m_socket->ossock, FIONBIO, &nonblocking ) != 0 )
+		return;
+
+	if ( connect( m_socket->ossock, (struct sockaddr *)&addr, (int )sizeof( addr ) ) != 0 )
+	{
+		if ( WSAGetLastError() != WSAEWOULDBLOCK )
+			return;
+
+		if ( socket_wait( m_socket, true, toutUs ) != 1 )  // failed connection is not writable
+			return;
+
+		int err = 0;
+		int len = sizeof( err );
+		if ( getsockopt( m_socket->ossock, SOL_SOCKET, SO_ERROR, (char* )&err, &len ) != 0 || err != 0 )
+			return;
+	}
+
+	nonblocking = 0;
+	if ( ioctlsocket( m_socket->ossock, FIONBIO, &nonblocking ) != 0 )
 		return;
+#endif
 
 	m_isValid = true;
 }
@@ -460,18 +1401,8 @@ bool TCP::isValid()
  */
 int TCP::receive( void *buffer, int maxLen, int toutUs )
 {
-	int err;
-	fd_set set;
-	struct timeval tout;
-
 	// waiting for data:
-	FD_ZERO(&set);
-	FD_SET( m_socket->ossock, &set );
-	tout.tv_sec = toutUs / 1000000;
-	tout.tv_usec = toutUs % 1000000;
-
-	err = select( FD_SETSIZE, &set, NULL, NULL, &tout );
-	switch ( err )
+	switch ( socket_wait( m_socket, false, toutUs ) )
 	{
 		case 1:
 			break;        // data available
@@ -504,18 +1435,8 @@ int TCP::receive( void *buffer, int maxLen, int toutUs )
  */
 int TCP::send( const void* buffer, int len, int toutUs )
 {
-	fd_set set;
-	struct timeval tout;
-	int err;
-
 	// waiting to send data:
-	FD_ZERO(&set);
-	FD_SET( m_socket->ossock, &set );
-	tout.tv_sec = toutUs / 1000000;
-	tout.tv_usec = toutUs % 1000000;
-
-	err = select( FD_SETSIZE, NULL, &set, NULL, &tout );
-	switch ( err )
+	switch ( socket_wait( m_socket, true, toutUs ) )
 	{
 		case 1:
 			break;
@@ -0,0 +1,241 @@
+/* DTrackSDK in C++: DTrackParamCache.cpp
+ *
+ * Client-side cache of DTrack2/DTRACK3 parameters.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackParamCache.hpp"
+#include "DTrackSys.hpp"
+
+using namespace DTrackSys;
+
+
+/*
+ * Constructor.
+ */
+DTrackParamCache::DTrackParamCache( double defaultTtl )
+	: d_defaultTtl( defaultTtl )
+{
+}
+
+
+/*
+ * Set TTL of new entries.
+ */
+void DTrackParamCache::setDefaultTtl( double ttl )
+{
+	d_defaultTtl = ttl;
+}
+
+
+/*
+ * Get TTL of new entries.
+ */
+double DTrackParamCache::getDefaultTtl() const
+{
+	return d_defaultTtl;
+}
+
+
+/*
+ * Get cached value of a parameter.
+ */
+bool DTrackParamCache::get( const std::string& parameter, std::string& value ) const
+{
+	EntryMap::const_iterator it = d_entries.find( normalize( parameter ) );
+	if ( it == d_entries.end() )
+		return false;
+
+	if ( ! isValid( it->second, time_monotonic() ) )
+		return false;
+
+	value = it->second.value;
+	return true;
+}
+
+
+/*
+ * Store value of a parameter.
+ */
+void DTrackParamCache::set( const std::string& parameter, const std::string& value, double ttl )
+{
+	std::string key = normalize( parameter );
+	EntryMap::iterator it = d_entries.find( key );
+
+	if ( ttl < 0.0 )
+		ttl = ( it != d_entries.end() ) ? it->second.ttl : d_defaultTtl;
+
+	Entry& entry = ( it != d_entries.end() ) ? it->second : d_entries[ key ];
+	entry.value = value;
+	entry.ttl = ttl;
+	entry.expire = time_monotonic() + ttl;
+}
+
+
+/*
+ * Remove entry of a parameter.
+ */
+void DTrackParamCache::invalidate( const std::string& parameter )
+{
+	d_entries.erase( normalize( parameter ) );
+}
+
+
+/*
+ * Remove entries changed by a 'dtrack2 set' command.
+ */
+void DTrackParamCache::invalidateBySet( const std::string& parameter )
+{
+	// an entry is affected, if its parameter is a leading word sequence of the command
+	std::string cmd = normalize( parameter );
+
+	EntryMap::iterator it = d_entries.begin();
+	while ( it != d_entries.end() )
+	{
+		const std::string& key = it->first;
+		if ( ( cmd.compare( 0, key.length(), key ) == 0 ) &&
+		     ( cmd.length() == key.length() || cmd[ key.length() ] == ' ' ) )
+		{
+			d_entries.erase( it++ );
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+
+/*
+ * Remove all entries.
+ */
+void DTrackParamCache::clear()
+{
+	d_entries.clear();
+}
+
+
+/*
+ * Remove all expired entries.
+ */
+void DTrackParamCache::removeExpired()
+{
+	double now = time_monotonic();
+
+	EntryMap::iterator it = d_entries.begin();
+	while ( it != d_entries.end() )
+	{
+		if ( ! isValid( it->second, now ) )
+			d_entries.erase( it++ );
+		else
+			++it;
+	}
+}
+
+
+/*
+ * Get number of entries.
+ */
+int DTrackParamCache::getNumEntries() const
+{
+	return static_cast< int >( d_entries.size() );
+}
+
+
+/*
+ * Get all valid entries, sorted by parameter.
+ */
+void DTrackParamCache::getEntries( std::vector< std::string >& parameters, std::vector< std::string >& values ) const
+{
+	double now = time_monotonic();
+
+	parameters.clear();
+	values.clear();
+	for ( EntryMap::const_iterator it = d_entries.begin(); it != d_entries.end(); ++it )
+	{
+		if ( ! isValid( it->second, now ) )
+			continue;
+
+		parameters.push_back( it->first );
+		values.push_back( it->second.value );
+	}
+}
+
+
+/*
+ * Normalize parameter string: single white spaces between words, no leading zeros of numbers.
+ */
+std::string DTrackParamCache::normalize( const std::string& parameter )
+{
+	std::string res;
+	res.reserve( parameter.length() );
+
+	bool lastwasdigit = false;
+	size_t i = 0;
+	while ( i < parameter.length() )
+	{
+		char c = parameter[ i ];
+		if ( c == ' ' )
+		{
+			while ( i < parameter.length() && parameter[ i ] == ' ' )
+				i++;
+
+			if ( ! res.empty() && i < parameter.length() )
+				res += ' ';
+
+			lastwasdigit = false;
+			continue;
+		}
+
+		if ( ! lastwasdigit && c == '0' )
+		{	// skip leading zeros, but keep a single zero
+			while ( i + 1 < parameter.length() && parameter[ i + 1 ] >= '0' && parameter[ i + 1 ] <= '9' &&
+			        parameter[ i ] == '0' )
+			{
+				i++;
+			}
+
+			c = parameter[ i ];
+		}
+
+		res += c;
+		lastwasdigit = ( c >= '0' ) && ( c <= '9' );
+		i++;
+	}
+
+	return res;
+}
+
+
+/*
+ * Check if entry is not expired.
+ */
+bool DTrackParamCache::isValid( const Entry& entry, double now )
+{
+	return ( entry.ttl <= 0.0 ) || ( now < entry.expire );
+}
+
@@ -33,9 +33,178 @@
 #include <cstdio>
 #include <cstring>
 #include <cstdlib>
+#include <climits>
+#include <clocale>
+
+// SIMD instructions comparing 16 characters at once
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#define PARSE_SSE2
+	#include <emmintrin.h>
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+	#define PARSE_NEON
+	#include <arm_neon.h>
+#endif
 
 namespace DTrackSDK_Parse {
 
+// maximum number of significant decimal digits, which are exactly representable in a 'double' mantissa:
+#define DTRACK_PARSE_MAXDIGITS_EXACT  15
+
+// maximum length of a number, converted by the C library:
+#define DTRACK_PARSE_MAXLEN_SLOW  64
+
+/**
+ *	\brief	Exact powers of ten in 'double'
+ */
+static const double s_pow10[] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+/**
+ *	\brief	Skip blanks in front of a value, without leaving the actual line
+ *	@param[in] 	str		string
+ *	@return		begin of value, NULL if end of line or string reached
+ */
+static const char* string_skip_blanks(const char* str)
+{
+	while (*str == ' ' || *str == '\t')
+	{
+		str++;
+	}
+	return (*str == '\0' || *str == '\r' || *str == '\n') ? NULL : str;
+}
+
+
+/**
+ *	\brief	Read an unsigned decimal integer, saturating at a maximum value
+ *	@param[in] 	str		string (behind optional sign)
+ *	@param[in] 	maxval	maximum value
+ *	@param[out]	val		read value
+ *	@return		pointer behind read value in str; NULL if no digit found
+ */
+static const char* string_scan_uint(const char* str, unsigned long maxval, unsigned long* val)
+{
+	const char* s = str;
+	unsigned long v = 0;
+
+	while (*s >= '0' && *s <= '9')
+	{
+		unsigned long digit = (unsigned long )(*s - '0');
+		if (v > (maxval - digit) / 10)
+		{
+			v = maxval;  // saturate, but read remaining digits
+		} else {
+			v = v * 10 + digit;
+		}
+		s++;
+	}
+	*val = v;
+	return (s == str) ? NULL : s;
+}
+
+
+/**
+ *	\brief	Read a 'double' value using the C library, independent of the actual locale
+ *
+ *	Used for numbers that cannot be converted exactly by string_get_d().
+ *
+ *	@param[in] 	str		string
+ *	@param[out] d		read value
+ *	@return 	pointer behind read value in str; NULL in case of error
+ */
+static const char* string_get_d_slow(const char* str, double* d)
+{
+	char buf[ DTRACK_PARSE_MAXLEN_SLOW ];
+	char* s;
+	const char* dp = localeconv()->decimal_point;
+	size_t dplen = strlen( dp );
+	size_t n = 0, ndp = 0;
+
+	if ( dplen == 1 && *dp == '.' )
+	{	// 'C' conventions
+		*d = strtod( str, &s );
+		return (s == str) ? NULL : s;
+	}
+
+	while ( str[ n ] != '\0' && strchr( "0123456789+-.eEinfatyINFATY", str[ n ] ) != NULL )
+	{	// copy number (also 'inf' or 'nan'), with decimal point of actual locale
+		if ( str[ n ] == '.' )
+		{
+			if ( ndp + dplen > sizeof( buf ) - 1 )
+				return NULL;
+
+			memcpy( buf + ndp, dp, dplen );
+			ndp += dplen;
+		} else {
+			if ( ndp + 1 > sizeof( buf ) - 1 )
+				return NULL;
+
+			buf[ ndp++ ] = str[ n ];
+		}
+		n++;
+	}
+	buf[ ndp ] = '\0';
+
+	*d = strtod( buf, &s );
+	if ( s == buf )
+		return NULL;
+
+	for ( n = 0, ndp = 0; buf + ndp < s; n++ )
+	{	// get corresponding position in str
+		ndp += ( str[ n ] == '.' ) ? dplen : 1;
+	}
+	return str + n;
+}
+
+
+/**
+ *	\brief	Search first line break (CR or LF) in buffer
+ *
+ *	Compares 16 characters at once, if SIMD instructions (SSE2 or NEON) are available.
+ *
+ *	@param[in] 	s		start position within buffer
+ *	@param[in] 	se		end of buffer
+ *	@return		position of line break, se if no line break found
+ */
+static const char* string_find_linebreak(const char* s, const char* se)
+{
+#if defined( PARSE_SSE2 )
+	const __m128i cr = _mm_set1_epi8( '\r' );
+	const __m128i lf = _mm_set1_epi8( '\n' );
+
+	while ( se - s >= 16 )
+	{
+		__m128i v = _mm_loadu_si128( reinterpret_cast< const __m128i* >( s ) );
+		if ( _mm_movemask_epi8( _mm_or_si128( _mm_cmpeq_epi8( v, cr ), _mm_cmpeq_epi8( v, lf ) ) ) != 0 )
+			break;  // exact position is found below
+
+		s += 16;
+	}
+#elif defined( PARSE_NEON )
+	const uint8x16_t cr = vdupq_n_u8( '\r' );
+	const uint8x16_t lf = vdupq_n_u8( '\n' );
+
+	while ( se - s >= 16 )
+	{
+		uint8x16_t v = vld1q_u8( reinterpret_cast< const uint8_t* >( s ) );
+		if ( vmaxvq_u8( vorrq_u8( vceqq_u8( v, cr ), vceqq_u8( v, lf ) ) ) != 0 )
+			break;  // exact position is found below
+
+		s += 16;
+	}
+#endif
+
+	while ( s < se && *s != '\r' && *s != '\n' )
+	{
+		s++;
+	}
+	return s;
+}
+
+
 /**
  *	\brief	Search next line in buffer
  *	@param[in] 	str		buffer (total)
@@ -43,70 +212,185 @@ namespace DTrackSDK_Parse {
  *	@param[in] 	len		buffer length in bytes
  *	@return		begin of line, NULL if no new line in buffer
  */
-char* string_nextline(char* str, char* start, int len)
+const char* string_nextline(const char* str, const char* start, int len)
 {
-	char* s = start;
-	char* se = str + len;
-	int crlffound = 0;
-	while (s < se)
-	{
-		if (*s == '\r' || *s == '\n')
-		{	// crlf
-			crlffound = 1;
-		} else {
-			if(crlffound)
-			{	// begin of new line found
-				return (*s) ? s : NULL;	// first character is '\0': end of buffer
-			}
-		}
+	const char* se = str + len;
+	const char* s = string_find_linebreak( start, se );
+
+	while ( s < se && ( *s == '\r' || *s == '\n' ) )
+	{	// crlf
 		s++;
 	}
-	return NULL;	// no new line found in buffer
+	if ( s >= se )
+		return NULL;	// no new line found in buffer
+
+	return (*s) ? s : NULL;	// first character is '\0': end of buffer
 }
 
 
 /**
  * 	\brief	Read next 'int' value from string
  *
+ *	Values out of range are clamped to the range of 'int'.
+ *
  *	@param[in] 	str		string
  *	@param[out] i		read value
  *	@return		pointer behind read value in str; NULL in case of error
  */
-char* string_get_i(char* str, int* i)
+const char* string_get_i(const char* str, int* i)
 {
-	char* s;
-	*i = ( int )strtol( str, &s, 10 );
-	return (s == str) ? NULL : s;
+	unsigned long v;
+	bool neg = false;
+
+	str = string_skip_blanks( str );
+	if ( str == NULL )
+		return NULL;
+
+	if ( *str == '-' || *str == '+' )
+		neg = ( *str++ == '-' );
+
+	str = string_scan_uint( str, neg ? ( unsigned long )INT_MAX + 1 : ( unsigned long )INT_MAX, &v );
+	if ( str == NULL )
+		return NULL;
+
+	*i = neg ? ( ( v > ( unsigned long )INT_MAX ) ? INT_MIN : -( int )v ) : ( int )v;
+	return str;
 }
 
 
 /**
  * 	\brief	Read next 'unsigned int' value from string
  *
+ *	Values out of range are clamped to the range of 'unsigned int'.
+ *
  *	@param[in] 	str		string
  *	@param[out]	ui		read value
  *	@return		pointer behind read value in str; NULL in case of error
  */
-char* string_get_ui(char* str, unsigned int* ui)
+const char* string_get_ui(const char* str, unsigned int* ui)
 {
-	char* s;
-	*ui = ( unsigned int )strtoul( str, &s, 10 );
-	return (s == str) ? NULL : s;
+	unsigned long v;
+	bool neg = false;
+
+	str = string_skip_blanks( str );
+	if ( str == NULL )
+		return NULL;
+
+	if ( *str == '-' || *str == '+' )
+		neg = ( *str++ == '-' );
+
+	str = string_scan_uint( str, UINT_MAX, &v );
+	if ( str == NULL )
+		return NULL;
+
+	*ui = neg ? 0U - ( unsigned int )v : ( unsigned int )v;  // like strtoul()
+	return str;
 }
 
 
 /**
  * 	\brief	Read next 'double' value from string
  *
+ *	Independent of the actual locale. Numbers with up to 15 significant digits and a small
+ *	decimal exponent (like DTrack output) are converted directly and exactly; all other numbers
+ *	are converted by the C library.
+ *
  *	@param[in] 	str		string
  *	@param[out] d		read value
  *	@return 	pointer behind read value in str; NULL in case of error
  */
-char* string_get_d(char* str, double* d)
+const char* string_get_d(const char* str, double* d)
 {
-	char* s;
-	*d = strtod(str, &s);
-	return (s == str) ? NULL : s;
+	const char* s;
+	double m = 0.0;  // significant digits, exact as long as less than 2^53
+	int ndigit = 0;
+	int exp10 = 0;
+	bool neg = false, anydigit = false;
+
+	str = string_skip_blanks( str );
+	if ( str == NULL )
+		return NULL;
+
+	s = str;
+	if ( *s == '-' || *s == '+' )
+		neg = ( *s++ == '-' );
+
+	while ( *s == '0' )
+	{	// skip leading zeros
+		anydigit = true;
+		s++;
+	}
+
+	while ( *s >= '0' && *s <= '9' )
+	{	// integer part
+		if ( ndigit == DTRACK_PARSE_MAXDIGITS_EXACT )
+			return string_get_d_slow( str, d );
+
+		m = m * 10.0 + ( double )( *s - '0' );
+		ndigit++;
+		anydigit = true;
+		s++;
+	}
+
+	if ( *s == '.' )
+	{	// fractional part
+		s++;
+		if ( ndigit == 0 )
+		{
+			while ( *s == '0' )
+			{
+				exp10--;
+				anydigit = true;
+				s++;
+			}
+		}
+
+		while ( *s >= '0' && *s <= '9' )
+		{
+			if ( ndigit == DTRACK_PARSE_MAXDIGITS_EXACT )
+				return string_get_d_slow( str, d );
+
+			m = m * 10.0 + ( double )( *s - '0' );
+			ndigit++;
+			exp10--;
+			anydigit = true;
+			s++;
+		}
+	}
+
+	if ( ! anydigit )  // e.g. 'inf' or 'nan'
+		return string_get_d_slow( str, d );
+
+	if ( *s == 'e' || *s == 'E' )
+	{	// exponent
+		const char* se = s + 1;
+		unsigned long e;
+		bool eneg = false;
+
+		if ( *se == '-' || *se == '+' )
+			eneg = ( *se++ == '-' );
+
+		se = string_scan_uint( se, 100000, &e );
+		if ( se != NULL )
+		{	// otherwise 'e' doesn't belong to number
+			exp10 += eneg ? -( int )e : ( int )e;
+			s = se;
+		}
+	}
+
+	if ( m == 0.0 )
+	{
+		*d = neg ? -0.0 : 0.0;
+		return s;
+	}
+
+	if ( exp10 < -22 || exp10 > 22 )  // power of ten not exactly representable
+		return string_get_d_slow( str, d );
+
+	// both factors are exact, so the result is rounded correctly:
+	m = ( exp10 < 0 ) ? m / s_pow10[ -exp10 ] : m * s_pow10[ exp10 ];
+	*d = neg ? -m : m;
+	return s;
 }
 
 
@@ -117,17 +401,25 @@ char* string_get_d(char* str, double* d)
  *	@param[out] f 		read value
  *	@return 	pointer behind read value in str; NULL in case of error
  */
-char* string_get_f(char* str, float* f)
+const char* string_get_f(const char* str, float* f)
 {
-	char* s;
-	*f = (float )strtod(str, &s);	// strtof() only available in GNU-C
-	return (s == str) ? NULL : s;
+	double d;
+
+	str = string_get_d( str, &d );
+	if ( str == NULL )
+		return NULL;
+
+	*f = ( float )d;
+	return str;
 }
 
 
 /**
  * 	\brief Process next block '[...]' in string
  *
+ *	The block has to be located in the actual line. The string is not modified. Reads the block in a
+ *	single pass: values are converted while searching for the end of the block.
+ *
  *	@param[in] 	str		string
  *	@param[in] 	fmt		format string ('i' for 'int', 'f' for 'float')
  *	@param[out] idat	array for 'int' values (long enough due to fmt)
@@ -135,23 +427,17 @@ char* string_get_f(char* str, float* f)
  *	@param[out] ddat	array for 'double' values (long enough due to fmt)
  *	@return 	pointer behind read value in str; NULL in case of error
  */
-char* string_get_block(char* str, const char* fmt, int* idat, float* fdat, double *ddat)
+const char* string_get_block(const char* str, const char* fmt, int* idat, float* fdat, double *ddat)
 {
-	char* strend;
 	int index_i, index_f;
 
-	str = strchr( str, '[' );
-	if ( str == NULL)
+	while ( *str != '[' )
 	{       // search begin of block
-		return NULL;
-	}
-	strend = strchr( str, ']' );
-	if ( strend == NULL )
-	{    // search end of block
-		return NULL;
+		if ( *str == '\0' || *str == '\r' || *str == '\n' )
+			return NULL;
+		str++;
 	}
 	str++;                               // remove delimiters
-	*strend = '\0';
 	index_i = index_f = 0;
 	while(*fmt)
 	{
@@ -159,36 +445,26 @@ char* string_get_block(char* str, const char* fmt, int* idat, float* fdat, doubl
 		{
 			case 'i':
 				str = string_get_i( str, &idat[ index_i++ ] );
-				if ( str == NULL )
-				{
-					*strend = ']';
-					return NULL;
-				}
 				break;
 			case 'f':
 				str = string_get_f( str, &fdat[ index_f++ ] );
-				if ( str == NULL )
-				{
-					*strend = ']';
-					return NULL;
-				}
 				break;
 			case 'd':
 				str = string_get_d( str, &ddat[ index_f++ ] );
-				if ( str == NULL )
-				{
-					*strend = ']';
-					return NULL;
-				}
 				break;
 			default:	// unknown format character
-				*strend = ']';
 				return NULL;
 		}
+		if ( str == NULL )  // values never contain ']', so are located inside the block
+			return NULL;
 	}
-	// ignore additional data inside the block
-	*strend = ']';
-	return strend + 1;
+	while ( *str != ']' )
+	{    // search end of block, ignoring additional data inside the block
+		if ( *str == '\0' || *str == '\r' || *str == '\n' )
+			return NULL;
+		str++;
+	}
+	return str + 1;
 }
 
 
@@ -199,9 +475,9 @@ char* string_get_block(char* str, const char* fmt, int* idat, float* fdat, doubl
  *	@param[out] w		read value
  *	@return		pointer behind read value in str; NULL in case of error
  */
-char* string_get_word(char* str, std::string& w)
+const char* string_get_word(const char* str, std::string& w)
 {
-	char* strend;
+	const char* strend;
 	while (*str == ' ')
 	{	// search begin of 'word'
 		str++;
@@ -230,9 +506,9 @@ char* string_get_word(char* str, std::string& w)
  *	@param[out] qt		read value (without quotes)
  *	@return		pointer behind read value in str; NULL in case of error
  */
-char* string_get_quoted_text(char* str, std::string& qt)
+const char* string_get_quoted_text(const char* str, std::string& qt)
 {
-	char* strend;
+	const char* strend;
 
 	str = strchr( str, '\"' );	// search begin of 'quoted text'
 	if ( str == NULL )
@@ -34,7 +34,9 @@
 
 #include "DTrackParser.hpp"
 #include "DTrackParse.hpp"
+#include "DTrackStatistics.hpp"
 
+#include <cmath>
 #include <cstring>
 
 #if ! defined( _MSC_VER )
@@ -45,16 +47,143 @@
 using namespace DTrackSDK_Parse;
 
 
-/** Converts a stacked reduced (non-redundant) representation of a covariance matrix to a stacked full representation */
-static void reduced_to_full_cov( double* cov_full, const double* cov_reduced, int dim )
+/*
+ * Line types known by the parser.
+ */
+enum {
+	LINE_UNKNOWN = 0,
+	LINE_FR, LINE_TS, LINE_TS2, LINE_6DCAL, LINE_6D, LINE_6DCOV, LINE_6DF, LINE_6DF2,
+	LINE_6DMT, LINE_6DMT2, LINE_6DMTR, LINE_GLCAL, LINE_GL, LINE_6DJ, LINE_6DI, LINE_3D, LINE_ST
+};
+
+/*
+ * Types of tracking data needed to parse a line, for all line types (0 if always parsed).
+ */
+static const int s_line_parsemask[] = {
+	0,                              // LINE_UNKNOWN
+	0,                              // LINE_FR
+	DTrackParser::PARSE_TIMESTAMP,  // LINE_TS
+	DTrackParser::PARSE_TIMESTAMP,  // LINE_TS2
+	DTrackParser::PARSE_BODY,       // LINE_6DCAL
+	DTrackParser::PARSE_BODY,       // LINE_6D
+	DTrackParser::PARSE_BODY | DTrackParser::PARSE_BODYCOV,  // LINE_6DCOV
+	DTrackParser::PARSE_FLYSTICK,   // LINE_6DF
+	DTrackParser::PARSE_FLYSTICK,   // LINE_6DF2
+	DTrackParser::PARSE_MEATOOL,    // LINE_6DMT
+	DTrackParser::PARSE_MEATOOL,    // LINE_6DMT2
+	DTrackParser::PARSE_MEAREF,     // LINE_6DMTR
+	DTrackParser::PARSE_HAND,       // LINE_GLCAL
+	DTrackParser::PARSE_HAND,       // LINE_GL
+	DTrackParser::PARSE_HUMAN,      // LINE_6DJ
+	DTrackParser::PARSE_INERTIAL,   // LINE_6DI
+	DTrackParser::PARSE_MARKER,     // LINE_3D
+	DTrackParser::PARSE_STATUS      // LINE_ST
+};
+
+/*
+ * Line types used by statistics, for all line types.
+ */
+static const int s_line_record[] = {
+	DTrackStatistics::RECORD_OTHER,        // LINE_UNKNOWN
+	DTrackStatistics::RECORD_FRAMECOUNTER, // LINE_FR
+	DTrackStatistics::RECORD_TIMESTAMP,    // LINE_TS
+	DTrackStatistics::RECORD_TIMESTAMP,    // LINE_TS2
+	DTrackStatistics::RECORD_BODY,         // LINE_6DCAL
+	DTrackStatistics::RECORD_BODY,         // LINE_6D
+	DTrackStatistics::RECORD_BODYCOV,      // LINE_6DCOV
+	DTrackStatistics::RECORD_FLYSTICK,     // LINE_6DF
+	DTrackStatistics::RECORD_FLYSTICK,     // LINE_6DF2
+	DTrackStatistics::RECORD_MEATOOL,      // LINE_6DMT
+	DTrackStatistics::RECORD_MEATOOL,      // LINE_6DMT2
+	DTrackStatistics::RECORD_MEAREF,       // LINE_6DMTR
+	DTrackStatistics::RECORD_HAND,         // LINE_GLCAL
+	DTrackStatistics::RECORD_HAND,         // LINE_GL
+	DTrackStatistics::RECORD_HUMAN,        // LINE_6DJ
+	DTrackStatistics::RECORD_INERTIAL,     // LINE_6DI
+	DTrackStatistics::RECORD_MARKER,       // LINE_3D
+	DTrackStatistics::RECORD_STATUS        // LINE_ST
+};
+
+
+/*
+ * Get type of a line identifier.
+ *
+ * Dispatches on length and first characters of the identifier, so each line needs at most a few
+ * character compares instead of a chain of string compares.
+ */
+static int line_type( const char* s, int len )
 {
-	for (int r=0; r<dim; ++r) {
-		int k = r*(r-1)/2;
-		cov_full[ r*(dim+1) ] = cov_reduced[ r*dim - k ];
-		for (int c=r+1; c<dim; ++c) {
-			cov_full[ r*dim + c ]  =  cov_full[ c*dim + r ]  =  cov_reduced[ r*(dim-1) - k + c ];
-		}
+	switch ( len )
+	{
+		case 2:
+			switch ( s[ 0 ] )
+			{
+				case 'f':  return ( s[ 1 ] == 'r' ) ? LINE_FR : LINE_UNKNOWN;
+				case 't':  return ( s[ 1 ] == 's' ) ? LINE_TS : LINE_UNKNOWN;
+				case '6':  return ( s[ 1 ] == 'd' ) ? LINE_6D : LINE_UNKNOWN;
+				case 'g':  return ( s[ 1 ] == 'l' ) ? LINE_GL : LINE_UNKNOWN;
+				case '3':  return ( s[ 1 ] == 'd' ) ? LINE_3D : LINE_UNKNOWN;
+				case 's':  return ( s[ 1 ] == 't' ) ? LINE_ST : LINE_UNKNOWN;
+			}
+			break;
+
+		case 3:
+			if ( s[ 0 ] == '6' && s[ 1 ] == 'd' )
+			{
+				switch ( s[ 2 ] )
+				{
+					case 'f':  return LINE_6DF;
+					case 'j':  return LINE_6DJ;
+					case 'i':  return LINE_6DI;
+				}
+			}
+			else if ( s[ 0 ] == 't' && s[ 1 ] == 's' && s[ 2 ] == '2' )
+			{
+				return LINE_TS2;
+			}
+			break;
+
+		case 4:
+			if ( memcmp( s, "6df2", 4 ) == 0 )  return LINE_6DF2;
+			if ( memcmp( s, "6dmt", 4 ) == 0 )  return LINE_6DMT;
+			break;
+
+		case 5:
+			if ( s[ 0 ] == '6' && s[ 1 ] == 'd' )
+			{
+				switch ( s[ 2 ] )
+				{
+					case 'c':
+						if ( s[ 3 ] == 'a' && s[ 4 ] == 'l' )  return LINE_6DCAL;
+						if ( s[ 3 ] == 'o' && s[ 4 ] == 'v' )  return LINE_6DCOV;
+						break;
+					case 'm':
+						if ( s[ 3 ] == 't' && s[ 4 ] == '2' )  return LINE_6DMT2;
+						if ( s[ 3 ] == 't' && s[ 4 ] == 'r' )  return LINE_6DMTR;
+						break;
+				}
+			}
+			else if ( memcmp( s, "glcal", 5 ) == 0 )
+			{
+				return LINE_GLCAL;
+			}
+			break;
 	}
+
+	return LINE_UNKNOWN;
+}
+
+
+/*
+ * Size of hash table for marker ID numbers, in bits.
+ */
+static int marker_index_bits( int num )
+{
+	int bits = 4;  // at least twice as much entries as markers
+	while ( ( 1 << bits ) < 2 * num )
+		bits++;
+
+	return bits;
 }
 
 
@@ -69,12 +198,26 @@ DTrackParser::DTrackParser()
 	act_timestamp_sec = 0;
 	act_timestamp_usec = 0;
 	act_latency_usec = 0;
+	act_time_arrival = act_time_parsestart = act_time_parseend = 0.0;
 
 	act_num_body = act_num_flystick = act_num_meatool = act_num_mearef = act_num_hand = act_num_human = 0;
 	act_num_inertial = 0;
 	act_num_marker = 0;
+	loc_marker_shift = 32;
 
 	act_is_status_available = false;
+	act_capacity_exceeded = false;
+
+	loc_human_built = false;
+	loc_human_legacy = false;
+
+	loc_fixed = false;
+
+	loc_parsemask = PARSE_ALL;
+	loc_linetype = LINE_UNKNOWN;
+
+	loc_events_enabled = false;
+	loc_events_threshold = 0.05;
 }
 
 
@@ -97,7 +240,10 @@ void DTrackParser::startFrame()
 	act_timestamp_sec = 0;
 	act_timestamp_usec = 0;
 	act_latency_usec = 0;
+	act_time_arrival = act_time_parsestart = act_time_parseend = 0.0;  // i.e. not available
 	act_is_status_available = false;
+	act_capacity_exceeded = false;
+	act_events.clear();
 
 	loc_num_bodycal = loc_num_handcal = -1;  // i.e. not available
 	loc_num_flystick1 = loc_num_meatool1 = 0;
@@ -114,6 +260,9 @@ void DTrackParser::endFrame()
 	// set number of calibrated standard bodies, if necessary:
 	if (loc_num_bodycal >= 0) {	// '6dcal' information was available
 		n = loc_num_bodycal - loc_num_flystick1 - loc_num_meatool1;
+		if ( ! checkCapacity( n, loc_capacity.maxBody ) )
+			n = loc_capacity.maxBody;  // just limited, bodies beyond capacity are never tracked
+
 		if (n > act_num_body) {  // adjust length of vector
 			act_body.resize(n);
 			for (j=act_num_body; j<n; j++) {
@@ -127,6 +276,9 @@ void DTrackParser::endFrame()
 	
 	// set number of calibrated Fingertracking hands, if necessary:
 	if (loc_num_handcal >= 0) {  // 'glcal' information was available
+		if ( ! checkCapacity( loc_num_handcal, loc_capacity.maxHand ) )
+			loc_num_handcal = loc_capacity.maxHand;
+
 		if (loc_num_handcal > act_num_hand) {  // adjust length of vector
 			act_hand.resize(loc_num_handcal);
 			for (j=act_num_hand; j<loc_num_handcal; j++) {
@@ -137,131 +289,705 @@ void DTrackParser::endFrame()
 		}
 		act_num_hand = loc_num_handcal;
 	}
+
+	updateHuman();
+
+	if ( loc_events_enabled )
+		detectEvents();
 }
 
 
 /*
- * Parses a single line of data in one tracking data packet.
+ * Copy the first entries of a vector into another one.
+ *
+ * Returns number of copied entries.
  */
-bool DTrackParser::parseLine(char **line)
+template< typename T >
+static int copy_vector( std::vector< T >& dst, const std::vector< T >& src, int num )
 {
-	if (!line)
-		return false;
-	
-	// line of frame counter:
-	if (!strncmp(*line, "fr ", 3)) {
-		*line += 3;
-		return parseLine_fr(line);
-	}
+	if ( num > ( int )src.size() )
+		num = ( int )src.size();
+
+	if ( num < 0 )
+		num = 0;
+
+	dst.assign( src.begin(), src.begin() + num );  // keeps allocated memory
+	return num;
+}
+
+
+/*
+ * Copy tracking data of actual frame from another parser.
+ */
+void DTrackParser::copyFrame( const DTrackParser& parser )
+{
+	act_framecounter = parser.act_framecounter;
+	act_timestamp = parser.act_timestamp;
+	act_timestamp_sec = parser.act_timestamp_sec;
+	act_timestamp_usec = parser.act_timestamp_usec;
+	act_latency_usec = parser.act_latency_usec;
+	act_time_arrival = parser.act_time_arrival;
+	act_time_parsestart = parser.act_time_parsestart;
+	act_time_parseend = parser.act_time_parseend;
+
+	act_num_body = copy_vector( act_body, parser.act_body, parser.act_num_body );
+	act_num_flystick = copy_vector( act_flystick, parser.act_flystick, parser.act_num_flystick );
+	act_num_meatool = copy_vector( act_meatool, parser.act_meatool, parser.act_num_meatool );
+	act_num_mearef = copy_vector( act_mearef, parser.act_mearef, parser.act_num_mearef );
+	act_num_hand = copy_vector( act_hand, parser.act_hand, parser.act_num_hand );
+	act_num_inertial = copy_vector( act_inertial, parser.act_inertial, parser.act_num_inertial );
+	act_num_marker = copy_vector( act_marker, parser.act_marker, parser.act_num_marker );
+	updateMarkerIndex();
+
+	act_num_human = copy_vector( act_human_joint_index, parser.act_human_joint_index, parser.act_num_human );
+	copy_vector( act_human_num_joints, parser.act_human_num_joints, act_num_human );
+	act_joint = parser.act_joint;
+	loc_human_built = false;
+	updateHuman();
+
+	act_is_status_available = parser.act_is_status_available;
+	if ( act_is_status_available )
+		act_status = parser.act_status;
+
+	act_events = parser.act_events;
+}
+
+
+// -----------------------------------------------------------------------------------------------------
+// binary image of a frame
+
+#define FRAMEIMAGE_MAGIC  0x49465444  // 'DTFI'
 
-	// line of timestamp:
-	if ( strncmp( *line, "ts ", 3 ) == 0 )
+/*
+ * Header of binary image of a frame.
+ */
+struct FrameImageHeader
+{
+	int magic;                  // identification of image
+	int layout;                 // sizes of data types, to detect images of other DTrackSDK versions
+	int size;                   // total size of image in bytes
+
+	unsigned int framecounter;  // frame counter
+	double timestamp;           // timestamp since midnight
+	unsigned int timestamp_sec;
+	unsigned int timestamp_usec;
+	unsigned int latency_usec;
+	double time_arrival;        // local timing
+	double time_parsestart;
+	double time_parseend;
+
+	int num_body;               // number of entries of each array
+	int num_flystick;
+	int num_meatool;
+	int num_mearef;
+	int num_hand;
+	int num_inertial;
+	int num_marker;
+	int num_human;
+	int num_joint;
+
+	int is_status_available;    // system status, without camera status
+	int status[ 8 ];
+	int num_camerastatus;
+};
+
+
+/*
+ * Get value describing the sizes of all data types in an image.
+ */
+static int image_layout()
+{
+	return ( int )( sizeof( FrameImageHeader ) + sizeof( DTrackBody ) * 3 + sizeof( DTrackFlyStick ) * 5
+	                + sizeof( DTrackMeaTool ) * 7 + sizeof( DTrackMeaRef ) * 11 + sizeof( DTrackHand ) * 13
+	                + sizeof( DTrackInertial ) * 17 + sizeof( DTrackMarker ) * 19 + sizeof( DTrackJoint ) * 23
+	                + sizeof( DTrackCameraStatus ) * 29 );
+}
+
+
+/*
+ * Get size of an array in an image, aligned to 8 bytes.
+ */
+template< typename T >
+static int image_arraysize( int num )
+{
+	return ( int )( ( num * sizeof( T ) + 7 ) & ~( size_t )7 );
+}
+
+
+/*
+ * Check number of entries of an array in an image.
+ */
+template< typename T >
+static bool image_checknum( int num, int len )
+{
+	return ( num >= 0 ) && ( ( size_t )num <= ( size_t )len / sizeof( T ) );
+}
+
+
+/*
+ * Write array into image.
+ */
+template< typename T >
+static char* image_write( char* p, const std::vector< T >& src, int num )
+{
+	if ( num > 0 )
+		memcpy( p, &src[ 0 ], num * sizeof( T ) );
+
+	return p + image_arraysize< T >( num );
+}
+
+
+/*
+ * Read array from image.
+ */
+template< typename T >
+static const char* image_read( const char* p, std::vector< T >& dst, int num )
+{
+	dst.resize( num );  // keeps allocated memory
+	if ( num > 0 )
+		memcpy( &dst[ 0 ], p, num * sizeof( T ) );
+
+	return p + image_arraysize< T >( num );
+}
+
+
+/*
+ * Get size of the binary image of the actual frame.
+ */
+int DTrackParser::getFrameImageSize() const
+{
+	int numCameraStatus = act_is_status_available ? ( int )act_status.cameraStatus.size() : 0;
+
+	return image_arraysize< FrameImageHeader >( 1 ) + image_arraysize< DTrackBody >( act_num_body )
+	       + image_arraysize< DTrackFlyStick >( act_num_flystick ) + image_arraysize< DTrackMeaTool >( act_num_meatool )
+	       + image_arraysize< DTrackMeaRef >( act_num_mearef ) + image_arraysize< DTrackHand >( act_num_hand )
+	       + image_arraysize< DTrackInertial >( act_num_inertial ) + image_arraysize< DTrackMarker >( act_num_marker )
+	       + 2 * image_arraysize< int >( act_num_human ) + image_arraysize< DTrackJoint >( ( int )act_joint.size() )
+	       + image_arraysize< DTrackCameraStatus >( numCameraStatus );
+}
+
+
+/*
+ * Write tracking data of actual frame into a binary image.
+ */
+int DTrackParser::writeFrameImage( char* image, int maxLen ) const
+{
+	int size = getFrameImageSize();
+	if ( image == NULL || size > maxLen )
+		return -1;
+
+	FrameImageHeader h;
+	memset( &h, 0, sizeof( h ) );
+
+	h.magic = FRAMEIMAGE_MAGIC;
+	h.layout = image_layout();
+	h.size = size;
+
+	h.framecounter = act_framecounter;
+	h.timestamp = act_timestamp;
+	h.timestamp_sec = act_timestamp_sec;
+	h.timestamp_usec = act_timestamp_usec;
+	h.latency_usec = act_latency_usec;
+	h.time_arrival = act_time_arrival;
+	h.time_parsestart = act_time_parsestart;
+	h.time_parseend = act_time_parseend;
+
+	h.num_body = act_num_body;
+	h.num_flystick = act_num_flystick;
+	h.num_meatool = act_num_meatool;
+	h.num_mearef = act_num_mearef;
+	h.num_hand = act_num_hand;
+	h.num_inertial = act_num_inertial;
+	h.num_marker = act_num_marker;
+	h.num_human = act_num_human;
+	h.num_joint = ( int )act_joint.size();
+
+	h.is_status_available = act_is_status_available ? 1 : 0;
+	if ( act_is_status_available )
 	{
-		*line += 3;
-		return parseLine_ts( line );
+		h.status[ 0 ] = act_status.numCameras;
+		h.status[ 1 ] = act_status.numTrackedBodies;
+		h.status[ 2 ] = act_status.numTrackedMarkers;
+		h.status[ 3 ] = act_status.numCameraErrorMessages;
+		h.status[ 4 ] = act_status.numCameraWarningMessages;
+		h.status[ 5 ] = act_status.numOtherErrorMessages;
+		h.status[ 6 ] = act_status.numOtherWarningMessages;
+		h.status[ 7 ] = act_status.numInfoMessages;
+		h.num_camerastatus = ( int )act_status.cameraStatus.size();
 	}
 
-	// line of extended timestamp:
-	if ( strncmp( *line, "ts2 ", 4 ) == 0 )
+	memcpy( image, &h, sizeof( h ) );
+	char* p = image + image_arraysize< FrameImageHeader >( 1 );
+
+	p = image_write( p, act_body, act_num_body );
+	p = image_write( p, act_flystick, act_num_flystick );
+	p = image_write( p, act_meatool, act_num_meatool );
+	p = image_write( p, act_mearef, act_num_mearef );
+	p = image_write( p, act_hand, act_num_hand );
+	p = image_write( p, act_inertial, act_num_inertial );
+	p = image_write( p, act_marker, act_num_marker );
+	p = image_write( p, act_human_joint_index, act_num_human );
+	p = image_write( p, act_human_num_joints, act_num_human );
+	p = image_write( p, act_joint, h.num_joint );
+	image_write( p, act_status.cameraStatus, h.num_camerastatus );
+
+	return size;
+}
+
+
+/*
+ * Set tracking data of actual frame from a binary image.
+ */
+bool DTrackParser::readFrameImage( const char* image, int len )
+{
+	FrameImageHeader h;
+
+	if ( image == NULL || len < ( int )sizeof( h ) )
+		return false;
+
+	memcpy( &h, image, sizeof( h ) );
+	if ( h.magic != FRAMEIMAGE_MAGIC || h.layout != image_layout() || h.size > len )
+		return false;
+
+	if ( ! ( image_checknum< DTrackBody >( h.num_body, len ) && image_checknum< DTrackFlyStick >( h.num_flystick, len ) &&
+	         image_checknum< DTrackMeaTool >( h.num_meatool, len ) && image_checknum< DTrackMeaRef >( h.num_mearef, len ) &&
+	         image_checknum< DTrackHand >( h.num_hand, len ) && image_checknum< DTrackInertial >( h.num_inertial, len ) &&
+	         image_checknum< DTrackMarker >( h.num_marker, len ) && image_checknum< int >( h.num_human, len ) &&
+	         image_checknum< DTrackJoint >( h.num_joint, len ) && image_checknum< DTrackCameraStatus >( h.num_camerastatus, len ) ) )
+		return false;
+
+	int size = image_arraysize< FrameImageHeader >( 1 ) + image_arraysize< DTrackBody >( h.num_body )
+	           + image_arraysize< DTrackFlyStick >( h.num_flystick ) + image_arraysize< DTrackMeaTool >( h.num_meatool )
+	           + image_arraysize< DTrackMeaRef >( h.num_mearef ) + image_arraysize< DTrackHand >( h.num_hand )
+	           + image_arraysize< DTrackInertial >( h.num_inertial ) + image_arraysize< DTrackMarker >( h.num_marker )
+	           + 2 * image_arraysize< int >( h.num_human ) + image_arraysize< DTrackJoint >( h.num_joint )
+	           + image_arraysize< DTrackCameraStatus >( h.num_camerastatus );
+	if ( size != h.size )
+		return false;
+
+	act_framecounter = h.framecounter;
+	act_timestamp = h.timestamp;
+	act_timestamp_sec = h.timestamp_sec;
+	act_timestamp_usec = h.timestamp_usec;
+	act_latency_usec = h.latency_usec;
+	act_time_arrival = h.time_arrival;
+	act_time_parsestart = h.time_parsestart;
+	act_time_parseend = h.time_parseend;
+	act_events.clear();  // not part of image
+
+	const char* p = image + image_arraysize< FrameImageHeader >( 1 );
+
+	act_num_body = h.num_body;
+	p = image_read( p, act_body, h.num_body );
+	act_num_flystick = h.num_flystick;
+	p = image_read( p, act_flystick, h.num_flystick );
+	act_num_meatool = h.num_meatool;
+	p = image_read( p, act_meatool, h.num_meatool );
+	act_num_mearef = h.num_mearef;
+	p = image_read( p, act_mearef, h.num_mearef );
+	act_num_hand = h.num_hand;
+	p = image_read( p, act_hand, h.num_hand );
+	act_num_inertial = h.num_inertial;
+	p = image_read( p, act_inertial, h.num_inertial );
+	act_num_marker = h.num_marker;
+	p = image_read( p, act_marker, h.num_marker );
+	updateMarkerIndex();
+
+	act_num_human = h.num_human;
+	p = image_read( p, act_human_joint_index, h.num_human );
+	p = image_read( p, act_human_num_joints, h.num_human );
+	p = image_read( p, act_joint, h.num_joint );
+	loc_human_built = false;
+
+	for ( int i = 0; i < act_num_human; i++ )
 	{
-		*line += 4;
-		return parseLine_ts2( line );
+		if ( act_human_num_joints[ i ] < 0 || ( act_human_num_joints[ i ] > 0 &&
+		     ( act_human_joint_index[ i ] < 0 || act_human_joint_index[ i ] + act_human_num_joints[ i ] > h.num_joint ) ) )
+		{
+			act_num_human = 0;
+			return false;
+		}
 	}
+	updateHuman();
 
-	// line of additional information about number of calibrated bodies:
-	if ( strncmp( *line, "6dcal ", 6 ) == 0 )
+	act_is_status_available = ( h.is_status_available != 0 );
+	if ( act_is_status_available )
 	{
-		*line += 6;
-		return parseLine_6dcal( line );
+		act_status.numCameras = h.status[ 0 ];
+		act_status.numTrackedBodies = h.status[ 1 ];
+		act_status.numTrackedMarkers = h.status[ 2 ];
+		act_status.numCameraErrorMessages = h.status[ 3 ];
+		act_status.numCameraWarningMessages = h.status[ 4 ];
+		act_status.numOtherErrorMessages = h.status[ 5 ];
+		act_status.numOtherWarningMessages = h.status[ 6 ];
+		act_status.numInfoMessages = h.status[ 7 ];
+		image_read( p, act_status.cameraStatus, h.num_camerastatus );
 	}
 
-	// line of standard body data:
-	if (!strncmp(*line, "6d ", 3)) {
-		*line += 3;
-		return parseLine_6d(line);
-	}
+	return true;
+}
 
-	// line of 6d covariance data:
-	if (!strncmp(*line, "6dcov ", 6)) {
-		*line += 6;
-		return parseLine_6dcov(line);
-	}
-	
-	// line of Flystick data (older format):
-	if (!strncmp(*line, "6df ", 4)) {
-		*line += 4;
-		return parseLine_6df(line);
-	}
-	
-	// line of Flystick data (newer format):
-	if (!strncmp(*line, "6df2 ", 5)) {
-		*line += 5;
-		return parseLine_6df2(line);
-	}
-	
-	// line of measurement tool data (older format):
-	if (!strncmp(*line, "6dmt ", 5)) {
-		*line += 5;
-		return parseLine_6dmt(line);
-	}
-	
-	// line of measurement tool data (newer format):
-	if (!strncmp(*line, "6dmt2 ", 6)) {
-		*line += 6;
-		return parseLine_6dmt2(line);
+
+/*
+ * Set local timing of actual frame.
+ */
+void DTrackParser::setFrameTimes( double arrivalTime, double parseStartTime, double parseEndTime )
+{
+	act_time_arrival = arrivalTime;
+	act_time_parsestart = parseStartTime;
+	act_time_parseend = parseEndTime;
+}
+
+
+/*
+ * Parses a single line of data in one tracking data packet.
+ */
+bool DTrackParser::parseLine(const char **line)
+{
+	const char* s;
+	int len;
+
+	if (!line)
+		return false;
+
+	// get length of line identifier:
+	s = *line;
+	len = 0;
+	while ( s[ len ] != ' ' && s[ len ] != '\0' && s[ len ] != '\r' && s[ len ] != '\n' )
+		len++;
+
+	loc_linetype = LINE_UNKNOWN;
+	if ( s[ len ] != ' ' )  // no data behind identifier
+		return parseLine_unknown( line, len );
+
+	*line += len + 1;
+
+	int type = line_type( s, len );
+	if ( ( s_line_parsemask[ type ] & loc_parsemask ) != s_line_parsemask[ type ] )
+	{	// skip line, not to be parsed (counts as unknown line)
+		if ( type == LINE_6DF )
+			return skipLine_num( line, &loc_num_flystick1 );
+
+		if ( type == LINE_6DMT )
+			return skipLine_num( line, &loc_num_meatool1 );
+
+		return true;
 	}
-	
-	// line of measurement reference data:
-	if (!strncmp(*line, "6dmtr ", 6)) {
-		*line += 6;
-		return parseLine_6dmtr(line);
+
+	loc_linetype = type;
+	switch ( type )
+	{
+		case LINE_FR:     return parseLine_fr( line );      // line of frame counter
+		case LINE_TS:     return parseLine_ts( line );      // line of timestamp
+		case LINE_TS2:    return parseLine_ts2( line );     // line of extended timestamp
+		case LINE_6DCAL:  return parseLine_6dcal( line );   // line of additional information about number of calibrated bodies
+		case LINE_6D:     return parseLine_6d( line );      // line of standard body data
+		case LINE_6DCOV:  return parseLine_6dcov( line );   // line of 6d covariance data
+		case LINE_6DF:    return parseLine_6df( line );     // line of Flystick data (older format)
+		case LINE_6DF2:   return parseLine_6df2( line );    // line of Flystick data (newer format)
+		case LINE_6DMT:   return parseLine_6dmt( line );    // line of measurement tool data (older format)
+		case LINE_6DMT2:  return parseLine_6dmt2( line );   // line of measurement tool data (newer format)
+		case LINE_6DMTR:  return parseLine_6dmtr( line );   // line of measurement reference data
+		case LINE_GLCAL:  return parseLine_glcal( line );   // line of additional information about number of calibrated Fingertracking hands
+		case LINE_GL:     return parseLine_gl( line );      // line of A.R.T. Fingertracking hand data
+		case LINE_6DJ:    return parseLine_6dj( line );     // line of 6dj human model data
+		case LINE_6DI:    return parseLine_6di( line );     // line of 6di inertial data
+		case LINE_3D:     return parseLine_3d( line );      // line of single marker data
+		case LINE_ST:     return parseLine_st( line );      // line of system status data
 	}
-	
-	// line of additional inofmation about number of calibrated Fingertracking hands:
-	if (!strncmp(*line, "glcal ", 6)) {
-		*line += 6;
-		return parseLine_glcal(line);
+
+	*line = s;
+	return parseLine_unknown( line, len );
+}
+
+
+/*
+ * Get type of the line parsed by last call of parseLine().
+ */
+int DTrackParser::getLineRecordType() const
+{
+	return s_line_record[ loc_linetype ];
+}
+
+
+/*
+ * Passes a line with unknown identifier to a registered handler.
+ */
+bool DTrackParser::parseLine_unknown( const char **line, int len )
+{
+	const char* s = *line;
+	const char* data = s + len;
+
+	if ( *data == ' ' )
+		data++;
+
+	for ( size_t i = 0; i < loc_linehandler.size(); i++ )
+	{
+		if ( loc_linehandler[ i ].identifier.length() == static_cast< size_t >( len ) &&
+		     memcmp( loc_linehandler[ i ].identifier.c_str(), s, len ) == 0 )
+		{
+			return loc_linehandler[ i ].handler( loc_linehandler[ i ].identifier.c_str(), data, loc_linehandler[ i ].userData );
+		}
 	}
-	
-	// line of A.R.T. Fingertracking hand data:
-	if (!strncmp(*line, "gl ", 3)) {
-		*line += 3;
-		return parseLine_gl(line);
+
+	return true;  // ignore unknown line identifiers (could be valid in future DTracks)
+}
+
+
+/*
+ * Skips a single line of Flystick or Measurement Tool data (older format) in one tracking data packet.
+ */
+bool DTrackParser::skipLine_num( const char **line, int* num )
+{
+	*line = string_get_i( *line, num );
+	if ( *line == NULL )
+		return false;
+
+	return true;
+}
+
+
+/*
+ * Register a handler for lines with an additional identifier.
+ */
+bool DTrackParser::registerLineHandler( const char* identifier, LineHandler handler, void* userData )
+{
+	if ( identifier == NULL )
+		return false;
+
+	int len = static_cast< int >( strlen( identifier ) );
+	if ( len == 0 || strpbrk( identifier, " \r\n" ) != NULL )
+		return false;
+
+	if ( line_type( identifier, len ) != LINE_UNKNOWN )  // identifiers known by the parser cannot be replaced
+		return false;
+
+	for ( size_t i = 0; i < loc_linehandler.size(); i++ )
+	{
+		if ( loc_linehandler[ i ].identifier == identifier )
+		{
+			if ( handler == NULL )
+			{
+				loc_linehandler.erase( loc_linehandler.begin() + i );
+			}
+			else
+			{
+				loc_linehandler[ i ].handler = handler;
+				loc_linehandler[ i ].userData = userData;
+			}
+			return true;
+		}
 	}
-	
-	// line of 6dj human model data:
-	if (!strncmp(*line, "6dj ", 4))	{
-		*line += 4;
-		return parseLine_6dj(line);
+
+	if ( handler == NULL )
+		return true;
+
+	LineHandlerEntry entry;
+	entry.identifier = identifier;
+	entry.handler = handler;
+	entry.userData = userData;
+	loc_linehandler.push_back( entry );
+	return true;
+}
+
+
+/*
+ * Set types of tracking data to be parsed.
+ */
+void DTrackParser::setParseMask( int mask )
+{
+	loc_parsemask = mask & PARSE_ALL;
+
+	// skipped data is not available:
+	if ( ! ( loc_parsemask & PARSE_BODY ) )  act_num_body = 0;
+	if ( ! ( loc_parsemask & PARSE_FLYSTICK ) )  act_num_flystick = 0;
+	if ( ! ( loc_parsemask & PARSE_MEATOOL ) )  act_num_meatool = 0;
+	if ( ! ( loc_parsemask & PARSE_MEAREF ) )  act_num_mearef = 0;
+	if ( ! ( loc_parsemask & PARSE_HAND ) )  act_num_hand = 0;
+	if ( ! ( loc_parsemask & PARSE_HUMAN ) )  act_num_human = 0;
+	if ( ! ( loc_parsemask & PARSE_INERTIAL ) )  act_num_inertial = 0;
+	if ( ! ( loc_parsemask & PARSE_MARKER ) )  act_num_marker = 0;
+	if ( ! ( loc_parsemask & PARSE_STATUS ) )  act_is_status_available = false;
+
+	if ( ! ( loc_parsemask & PARSE_TIMESTAMP ) )
+	{
+		act_timestamp = -1;
+		act_timestamp_sec = 0;
+		act_timestamp_usec = 0;
+		act_latency_usec = 0;
 	}
-	
-	// line of 6di inertial data:
-	if (!strncmp(*line, "6di ", 4))	{
-		*line += 4;
-		return parseLine_6di(line);
+
+	if ( ! ( loc_parsemask & PARSE_BODYCOV ) )
+	{	// reset covariance data
+		for ( int i = 0; i < act_num_body; i++ )
+		{
+			act_body[ i ].covref[ 0 ] = act_body[ i ].covref[ 1 ] = act_body[ i ].covref[ 2 ] = 0.0;
+			memset( act_body[ i ].covreduced, 0, sizeof( act_body[ i ].covreduced ) );
+		}
 	}
-	
-	// line of single marker data:
-	if (!strncmp(*line, "3d ", 3)) {
-		*line += 3;
-		return parseLine_3d(line);
+}
+
+
+/*
+ * Get types of tracking data to be parsed.
+ */
+int DTrackParser::getParseMask() const
+{
+	return loc_parsemask;
+}
+
+
+// -----------------------------------------------------------------------------------------------------
+// fixed capacity
+
+/*
+ * Constructor, sets default values.
+ */
+DTrackParser::Capacity::Capacity()
+{
+	maxBody = 64;
+	maxFlyStick = 8;
+	maxMeaTool = 8;
+	maxMeaRef = 8;
+	maxHand = 8;
+	maxHuman = 4;
+	maxJoint = 4 * DTRACKSDK_HUMAN_MAX_JOINTS;
+	maxInertial = 16;
+	maxMarker = 256;
+	maxCamera = 32;
+}
+
+
+/*
+ * Keep ART-Human model data for getHuman() up to date, after joint data was changed.
+ */
+void DTrackParser::updateHuman()
+{
+	if ( loc_human_legacy && ! loc_human_built )
+		buildHuman();
+}
+
+
+/*
+ * Fill ART-Human model data for getHuman() from compact joint data.
+ */
+void DTrackParser::buildHuman() const
+{
+	if ( ( int )act_human.size() < act_num_human )
+		act_human.resize( act_num_human );
+
+	for ( int id = 0; id < act_num_human; id++ )
+	{
+		DTrackHuman& human = act_human[ id ];
+		memset( human.joint, 0, human.num_joints * sizeof( DTrackJoint ) );  // just joints set before
+		human.id = id;
+		human.num_joints = act_human_num_joints[ id ];
+		if ( human.num_joints > 0 )
+			memcpy( human.joint, &act_joint[ act_human_joint_index[ id ] ], human.num_joints * sizeof( DTrackJoint ) );
 	}
 
-	// line of system status data:
-	if ( strncmp( *line, "st ", 3 ) == 0 )
+	loc_human_built = true;
+}
+
+
+/*
+ * Enable parsing with fixed capacity.
+ */
+bool DTrackParser::enableFixedCapacity( bool enable, const Capacity& capacity )
+{
+	loc_fixed = false;
+	if ( ! enable )
+		return true;
+
+	const Capacity& c = capacity;
+	if ( c.maxBody < 0 || c.maxFlyStick < 0 || c.maxMeaTool < 0 || c.maxMeaRef < 0 || c.maxHand < 0 ||
+	     c.maxHuman < 0 || c.maxJoint < 0 || c.maxInertial < 0 || c.maxMarker < 0 || c.maxCamera < 0 )
 	{
-		*line += 3;
-		return parseLine_st( line );
+		return false;
 	}
 
-	return true;  // ignore unknown line identifiers (could be valid in future DTracks)
+	// discard actual tracking data, as it might exceed the capacity:
+	act_num_body = act_num_flystick = act_num_meatool = act_num_mearef = act_num_hand = act_num_human = 0;
+	act_num_inertial = 0;
+	act_num_marker = 0;
+	act_joint.clear();
+	act_is_status_available = false;
+	act_capacity_exceeded = false;
+	loc_dirty_body.clear();
+	loc_dirty_hand.clear();
+	loc_dirty_inertial.clear();
+	loc_human_built = false;
+
+	// allocate all memory needed for parsing at once:
+	act_body.reserve( c.maxBody );
+	act_flystick.reserve( c.maxFlyStick );
+	act_meatool.reserve( c.maxMeaTool );
+	act_mearef.reserve( c.maxMeaRef );
+	act_hand.reserve( c.maxHand );
+	act_joint.reserve( c.maxJoint );
+	act_human_joint_index.reserve( c.maxHuman );
+	act_human_num_joints.reserve( c.maxHuman );
+	act_human.reserve( c.maxHuman );
+	act_inertial.reserve( c.maxInertial );
+	act_marker.reserve( c.maxMarker );
+	loc_marker_index.reserve( ( size_t )1 << marker_index_bits( c.maxMarker ) );
+	act_status.cameraStatus.reserve( c.maxCamera );
+
+	loc_dirty_body.reserve( 2 * c.maxBody );  // also bodies just set by '6dcov'
+	loc_dirty_hand.reserve( c.maxHand );
+	loc_dirty_inertial.reserve( c.maxInertial );
+
+	// each object is added, removed, tracked or lost at most twice per frame, additionally changes of
+	// buttons and joystick values:
+	int numObjects = c.maxBody + c.maxFlyStick + c.maxMeaTool + c.maxMeaRef + c.maxHand + c.maxHuman + c.maxInertial;
+	act_events.reserve( 2 * numObjects + c.maxFlyStick * ( DTRACKSDK_FLYSTICK_MAX_BUTTON + DTRACKSDK_FLYSTICK_MAX_JOYSTICK )
+	                    + c.maxMeaTool * DTRACKSDK_MEATOOL_MAX_BUTTON );
+	loc_events_tracked[ DTrackEvent::OBJECT_BODY ].reserve( c.maxBody );
+	loc_events_tracked[ DTrackEvent::OBJECT_FLYSTICK ].reserve( c.maxFlyStick );
+	loc_events_tracked[ DTrackEvent::OBJECT_MEATOOL ].reserve( c.maxMeaTool );
+	loc_events_tracked[ DTrackEvent::OBJECT_MEAREF ].reserve( c.maxMeaRef );
+	loc_events_tracked[ DTrackEvent::OBJECT_HAND ].reserve( c.maxHand );
+	loc_events_tracked[ DTrackEvent::OBJECT_HUMAN ].reserve( c.maxHuman );
+	loc_events_tracked[ DTrackEvent::OBJECT_INERTIAL ].reserve( c.maxInertial );
+	loc_events_flystickbutton.reserve( c.maxFlyStick );
+	loc_events_joystick.reserve( c.maxFlyStick * DTRACKSDK_FLYSTICK_MAX_JOYSTICK );
+	loc_events_meatoolbutton.reserve( c.maxMeaTool );
+	enableEvents( loc_events_enabled, loc_events_threshold );  // next frame reports all objects as added
+
+	updateMarkerIndex();
+
+	loc_capacity = capacity;
+	loc_fixed = true;
+	return true;
+}
+
+
+/*
+ * Returns if tracking data exceeded the fixed capacity.
+ */
+bool DTrackParser::isCapacityExceeded() const
+{
+	return act_capacity_exceeded;
+}
+
+
+/*
+ * Check a new number of entries against a fixed capacity.
+ */
+bool DTrackParser::checkCapacity( int num, int max )
+{
+	if ( ! loc_fixed || num <= max )
+		return true;
+
+	act_capacity_exceeded = true;
+	return false;
 }
 
 
 /*
  * Parses a single line of frame counter data in one tracking data packet.
  */
-bool DTrackParser::parseLine_fr(char **line)
+bool DTrackParser::parseLine_fr(const char **line)
 {
 	*line = string_get_ui( *line, &act_framecounter );
 	if ( *line == NULL )
@@ -277,7 +1003,7 @@ bool DTrackParser::parseLine_fr(char **line)
 /*
  * Parses a single line of timestamp data in one tracking data packet.
  */
-bool DTrackParser::parseLine_ts( char **line )
+bool DTrackParser::parseLine_ts( const char **line )
 {
 	*line = string_get_d( *line, &act_timestamp );
 	if ( *line == NULL )
@@ -293,7 +1019,7 @@ bool DTrackParser::parseLine_ts( char **line )
 /*
  * Parses a single line of extended timestamp data in one tracking data packet.
  */
-bool DTrackParser::parseLine_ts2( char **line )
+bool DTrackParser::parseLine_ts2( const char **line )
 {
 	*line = string_get_ui( *line, &act_timestamp_sec );
 
@@ -320,7 +1046,7 @@ bool DTrackParser::parseLine_ts2( char **line )
 /*
  * Parses a single line of additional information about number of calibrated bodies in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dcal( char **line )
+bool DTrackParser::parseLine_6dcal( const char **line )
 {
 	*line = string_get_i( *line, &loc_num_bodycal );
 	if ( *line == NULL )
@@ -333,17 +1059,21 @@ bool DTrackParser::parseLine_6dcal( char **line )
 /*
  * Parses a single line of standard body data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6d(char **line)
+bool DTrackParser::parseLine_6d(const char **line)
 {
 	int i, j, n, id;
 	double d;
 	
-	// disable all existing data
-	for (i=0; i<act_num_body; i++) {
-		memset(&act_body[i], 0, sizeof(DTrack_Body_Type_d));
-		act_body[i].id = i;
-		act_body[i].quality = -1;
+	// disable existing data, just of bodies set by last frame
+	for (i=0; i<(int)loc_dirty_body.size(); i++) {
+		j = loc_dirty_body[i];
+		if (j < (int)act_body.size()) {
+			memset(&act_body[j], 0, sizeof(DTrack_Body_Type_d));
+			act_body[j].id = j;
+			act_body[j].quality = -1;
+		}
 	}
+	loc_dirty_body.clear();
 
 	// get number of standard bodies (in line)
 	*line = string_get_i( *line, &n );
@@ -356,6 +1086,12 @@ bool DTrackParser::parseLine_6d(char **line)
 		if ( *line == NULL )
 			return false;
 
+		if (id < 0)  // not expected
+			return false;
+
+		if ( ! checkCapacity( id + 1, loc_capacity.maxBody ) )
+			return false;
+
 		// adjust length of vector
 		if (id >= act_num_body) {
 			act_body.resize(id + 1);
@@ -368,6 +1104,10 @@ bool DTrackParser::parseLine_6d(char **line)
 		}
 		act_body[id].id = id;
 		act_body[id].quality = d;
+		if ( ! checkCapacity( ( int )loc_dirty_body.size() + 1, ( int )loc_dirty_body.capacity() ) )
+			return false;
+
+		loc_dirty_body.push_back(id);
 
 		*line = string_get_block( *line, "ddd", NULL, NULL, act_body[ id ].loc );
 		if ( *line == NULL )
@@ -384,10 +1124,10 @@ bool DTrackParser::parseLine_6d(char **line)
 /*
  * Parses a single line of 6d covariance data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dcov(char **line)
+bool DTrackParser::parseLine_6dcov(const char **line)
 {
 	int n, id;
-	double cov_reduced[21];
+	double cov_ignored[ 21 ];
 
 	// get number of standard bodies (in line)
 	*line = string_get_i( *line, &n );
@@ -402,14 +1142,27 @@ bool DTrackParser::parseLine_6dcov(char **line)
 		if ( *line == NULL )
 			return false;
 
-		for ( int j = 0; j < 3; j++ )
-			act_body[ id ].covref[ j ] = covref[ j ];
+		bool isKnown = ( id >= 0 && id < act_num_body );  // ignore covariance of unknown bodies
 
-		*line = string_get_block( *line, "ddddddddddddddddddddd", NULL, NULL, cov_reduced );
+		// stored in reduced form, expanded just on request
+		*line = string_get_block( *line, "ddddddddddddddddddddd", NULL, NULL,
+		                          isKnown ? act_body[ id ].covreduced : cov_ignored );
 		if ( *line == NULL )
 			return false;
 
-		reduced_to_full_cov( act_body[id].cov, cov_reduced, 6 );
+		if ( ! isKnown )
+			continue;
+
+		if ( act_body[ id ].quality < 0 )  // body not set by '6d' line, so has to be disabled by next frame
+		{
+			if ( ! checkCapacity( ( int )loc_dirty_body.size() + 1, ( int )loc_dirty_body.capacity() ) )
+				return false;
+
+			loc_dirty_body.push_back( id );
+		}
+
+		for ( int j = 0; j < 3; j++ )
+			act_body[ id ].covref[ j ] = covref[ j ];
 	}
 	return true;
 }
@@ -418,7 +1171,7 @@ bool DTrackParser::parseLine_6dcov(char **line)
 /*
  * Parses a single line of Flystick data (older format) data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6df(char **line)
+bool DTrackParser::parseLine_6df(const char **line)
 {
 	int i, j, k, n, iarr[2];
 	double d;
@@ -429,6 +1182,9 @@ bool DTrackParser::parseLine_6df(char **line)
 		return false;
 
 	loc_num_flystick1 = n;
+	if ( ! checkCapacity( n, loc_capacity.maxFlyStick ) )
+		return false;
+
 	// adjust length of vector
 	if (n != act_num_flystick) {
 		act_flystick.resize(n);
@@ -484,7 +1240,7 @@ bool DTrackParser::parseLine_6df(char **line)
 /*
  * Parses a single line of Flystick data (newer format) data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6df2(char **line)
+bool DTrackParser::parseLine_6df2(const char **line)
 {
 	int i, j, k, l, n, iarr[3];
 	double d;
@@ -495,6 +1251,9 @@ bool DTrackParser::parseLine_6df2(char **line)
 	if ( *line == NULL )
 		return false;
 
+	if ( ! checkCapacity( n, loc_capacity.maxFlyStick ) )
+		return false;
+
 	// adjust length of vector
 	if (n != act_num_flystick) {
 		act_flystick.resize(n);
@@ -569,7 +1328,7 @@ bool DTrackParser::parseLine_6df2(char **line)
 /*
  * Parses a single line of Measurement Tool data (older format) in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dmt(char **line)
+bool DTrackParser::parseLine_6dmt(const char **line)
 {
 	int i, j, k, n, iarr[3];
 	double d;
@@ -580,6 +1339,9 @@ bool DTrackParser::parseLine_6dmt(char **line)
 		return false;
 
 	loc_num_meatool1 = n;
+	if ( ! checkCapacity( n, loc_capacity.maxMeaTool ) )
+		return false;
+
 	// adjust length of vector
 	if (n != act_num_meatool) {
 		act_meatool.resize(n);
@@ -618,8 +1380,8 @@ bool DTrackParser::parseLine_6dmt(char **line)
 		if ( *line == NULL )
 			return false;
 
-		for (j=0; j<9; j++)
-			act_meatool[i].cov[j] = 0.0;
+		for (j=0; j<6; j++)
+			act_meatool[i].covreduced[j] = 0.0;
 	}
 	
 	return true;
@@ -629,12 +1391,11 @@ bool DTrackParser::parseLine_6dmt(char **line)
 /*
  * Parses a single line of Measurement Tool data (newer format) data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dmt2(char **line)
+bool DTrackParser::parseLine_6dmt2(const char **line)
 {
 	int i, j, k, l, n, iarr[2];
 	double darr[2];
 	char sfmt[20];
-	double cov_reduced[6];
 
 	// get number of calibrated measurement tools
 	*line = string_get_i( *line, &n );
@@ -645,6 +1406,9 @@ bool DTrackParser::parseLine_6dmt2(char **line)
 	if ( *line == NULL )
 		return false;
 
+	if ( ! checkCapacity( n, loc_capacity.maxMeaTool ) )
+		return false;
+
 	// adjust length of vector
 	if (n != act_num_meatool) {
 		act_meatool.resize(n);
@@ -703,11 +1467,9 @@ bool DTrackParser::parseLine_6dmt2(char **line)
 			}
 		}
 
-		*line = string_get_block( *line, "dddddd", NULL, NULL, cov_reduced );
+		*line = string_get_block( *line, "dddddd", NULL, NULL, act_meatool[ i ].covreduced );  // expanded just on request
 		if ( *line == NULL )
 			return false;
-
-		reduced_to_full_cov( act_meatool[i].cov, cov_reduced, 3 );
 	}
 	
 	return true;
@@ -717,7 +1479,7 @@ bool DTrackParser::parseLine_6dmt2(char **line)
 /*
  * Parses a single line of Measurement Tool reference data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dmtr(char **line)
+bool DTrackParser::parseLine_6dmtr(const char **line)
 {
 	int i, n, id;
 	double d;
@@ -727,6 +1489,9 @@ bool DTrackParser::parseLine_6dmtr(char **line)
 	if ( *line == NULL )
 		return false;
 
+	if ( ! checkCapacity( n, loc_capacity.maxMeaRef ) )
+		return false;
+
 	// adjust length of vector
 	if (n != act_num_mearef) {
 		act_mearef.resize(n);
@@ -772,7 +1537,7 @@ bool DTrackParser::parseLine_6dmtr(char **line)
 /*
  * Parses a single line of additional information about number of calibrated A.R.T. FINGERTRACKING hands in one tracking data packet.
  */
-bool DTrackParser::parseLine_glcal(char **line)
+bool DTrackParser::parseLine_glcal(const char **line)
 {
 	*line = string_get_i( *line, &loc_num_handcal );  // get number of calibrated hands
 	if ( *line == NULL )
@@ -785,17 +1550,21 @@ bool DTrackParser::parseLine_glcal(char **line)
 /*
  * Parses a single line of A.R.T. FINGERTRACKING hand data in one tracking data packet.
  */
-bool DTrackParser::parseLine_gl(char **line)
+bool DTrackParser::parseLine_gl(const char **line)
 {
 	int i, j, n, iarr[3], id;
 	double d, darr[6];
 	
-	// disable all existing data
-	for (i=0; i<act_num_hand; i++) {
-		memset(&act_hand[i], 0, sizeof(DTrack_Hand_Type_d));
-		act_hand[i].id = i;
-		act_hand[i].quality = -1;
+	// disable existing data, just of hands set by last frame
+	for (i=0; i<(int)loc_dirty_hand.size(); i++) {
+		j = loc_dirty_hand[i];
+		if (j < (int)act_hand.size()) {
+			memset(&act_hand[j], 0, sizeof(DTrack_Hand_Type_d));
+			act_hand[j].id = j;
+			act_hand[j].quality = -1;
+		}
 	}
+	loc_dirty_hand.clear();
 
 	// get number of hands (in line)
 	*line = string_get_i( *line, &n );
@@ -809,6 +1578,12 @@ bool DTrackParser::parseLine_gl(char **line)
 			return false;
 
 		id = iarr[0];
+		if (id < 0)  // not expected
+			return false;
+
+		if ( ! checkCapacity( id + 1, loc_capacity.maxHand ) )
+			return false;
+
 		if (id >= act_num_hand) {  // adjust length of vector
 			act_hand.resize(id + 1);
 			for (j=act_num_hand; j<=id; j++) {
@@ -821,7 +1596,11 @@ bool DTrackParser::parseLine_gl(char **line)
 		act_hand[id].id = iarr[0];
 		act_hand[id].lr = iarr[1];
 		act_hand[id].quality = d;
-		if (iarr[2] > DTRACKSDK_HAND_MAX_FINGER) {
+		if ( ! checkCapacity( ( int )loc_dirty_hand.size() + 1, ( int )loc_dirty_hand.capacity() ) )
+			return false;
+
+		loc_dirty_hand.push_back(id);
+		if (iarr[2] < 0 || iarr[2] > DTRACKSDK_HAND_MAX_FINGER) {
 			return false;
 		}
 		act_hand[id].nfinger = iarr[2];
@@ -864,7 +1643,7 @@ bool DTrackParser::parseLine_gl(char **line)
 /*
  * Parses a single line of ART-Human model data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6dj(char **line)
+bool DTrackParser::parseLine_6dj(const char **line)
 {
 	int i, j, n, iarr[2], id;
 	double d, darr[6];
@@ -874,51 +1653,68 @@ bool DTrackParser::parseLine_6dj(char **line)
 	if ( *line == NULL )
 		return false;
 
-	// adjust length of vector
+	if (n < 0)  // not expected
+		return false;
+
+	if ( ! checkCapacity( n, loc_capacity.maxHuman ) )
+		return false;
+
+	// adjust length of vectors
 	if(n != act_num_human){
-		act_human.resize(n);
+		act_human_joint_index.resize(n);
+		act_human_num_joints.resize(n);
 		act_num_human = n;
 	}
 	for(i=0; i<act_num_human; i++){
-		memset(&act_human[i], 0, sizeof(DTrack_Human_Type_d));
-		act_human[i].id = i;
-		act_human[i].num_joints = 0;
+		act_human_num_joints[i] = 0;
 	}
+	act_joint.clear();  // keeps allocated memory
+	loc_human_built = false;
 
 	// get number of human models
 	*line = string_get_i( *line, &n );
 	if ( *line == NULL )
 		return false;
 
-	int id_human;
+	int id_human, ind;
 	for (i=0; i<n; i++) {
 		*line = string_get_block( *line, "ii", iarr, NULL,NULL );
 		if ( *line == NULL )
 			return false;
 
-		if (iarr[0] > act_num_human - 1) // not expected
+		if (iarr[0] < 0 || iarr[0] > act_num_human - 1) // not expected
 			return false;
-		
+
+		if (iarr[1] < 0 || iarr[1] > DTRACKSDK_HUMAN_MAX_JOINTS) // not expected
+			return false;
+
 		id_human = iarr[0];
-		act_human[id_human].id = iarr[0];
-		act_human[id_human].num_joints = iarr[1];
-		
+		ind = (int)act_joint.size();
+		if ( ! checkCapacity( ind + iarr[1], loc_capacity.maxJoint ) )
+			return false;
+
+		act_joint.resize(ind + iarr[1]);
+		act_human_joint_index[id_human] = ind;
+		act_human_num_joints[id_human] = iarr[1];
+
 		for (j = 0; j < iarr[1]; j++){
+			DTrackJoint& joint = act_joint[ind + j];
+
 			*line = string_get_block( *line, "id", &id, NULL, &d );
 			if ( *line == NULL )
 				return false;
 
-			act_human[id_human].joint[j].id = id;
-			act_human[id_human].joint[j].quality = d;
+			joint.id = id;
+			joint.quality = d;
 
 			*line = string_get_block( *line, "dddddd", NULL, NULL, darr );
 			if ( *line == NULL )
 				return false;
 
-			memcpy(act_human[id_human].joint[j].loc, &darr,  3*sizeof(double));
-			memcpy(act_human[id_human].joint[j].ang, &darr[3],  3*sizeof(double));
+			memcpy(joint.loc, &darr,  3*sizeof(double));
+			memcpy(joint.ang, &darr[3],  3*sizeof(double));
 
-			*line = string_get_block( *line, "ddddddddd", NULL, NULL, act_human[ id_human ].joint[ j ].rot );
+			*line = string_get_block( *line, "ddddddddd", NULL, NULL, joint.rot );
 			if ( *line == NULL )
 				return false;
 		}
@@ -931,18 +1727,22 @@ bool DTrackParser::parseLine_6dj(char **line)
 /*
  * Parses a single line of hybrid (optical-inertial) body data in one tracking data packet.
  */
-bool DTrackParser::parseLine_6di(char **line)
+bool DTrackParser::parseLine_6di(const char **line)
 {
 	int i, j, n, iarr[2], id, st;
 	double d;
 	
-	// disable all existing data
-	for (i=0; i<act_num_inertial; i++) {
-		memset(&act_inertial[i], 0, sizeof(DTrack_Inertial_Type_d));
-		act_inertial[i].id = i;
-		act_inertial[i].st = 0;
-		act_inertial[i].error = 0;
+	// disable existing data, just of bodies set by last frame
+	for (i=0; i<(int)loc_dirty_inertial.size(); i++) {
+		j = loc_dirty_inertial[i];
+		if (j < (int)act_inertial.size()) {
+			memset(&act_inertial[j], 0, sizeof(DTrack_Inertial_Type_d));
+			act_inertial[j].id = j;
+			act_inertial[j].st = 0;
+			act_inertial[j].error = 0;
+		}
 	}
+	loc_dirty_inertial.clear();
 
 	// get number of calibrated inertial bodies
 	*line = string_get_i( *line, &n );
@@ -957,6 +1757,12 @@ bool DTrackParser::parseLine_6di(char **line)
 
 		id = iarr[0];
 		st = iarr[1];
+		if (id < 0)  // not expected
+			return false;
+
+		if ( ! checkCapacity( id + 1, loc_capacity.maxInertial ) )
+			return false;
+
 		// adjust length of vector
 		if (id >= act_num_inertial) {
 			act_inertial.resize(id + 1);
@@ -971,6 +1777,10 @@ bool DTrackParser::parseLine_6di(char **line)
 		act_inertial[id].id = id;
 		act_inertial[id].st = st;
 		act_inertial[id].error = d;
+		if ( ! checkCapacity( ( int )loc_dirty_inertial.size() + 1, ( int )loc_dirty_inertial.capacity() ) )
+			return false;
+
+		loc_dirty_inertial.push_back(id);
 
 		*line = string_get_block( *line, "ddd", NULL, NULL, act_inertial[ id ].loc );
 		if ( *line == NULL )
@@ -988,7 +1798,7 @@ bool DTrackParser::parseLine_6di(char **line)
 /*
  * Parses a single line of single marker data in one tracking data packet.
  */
-bool DTrackParser::parseLine_3d( char **line )
+bool DTrackParser::parseLine_3d( const char **line )
 {
 	// get number of markers
 	*line = string_get_i( *line, &act_num_marker );
@@ -997,6 +1807,12 @@ bool DTrackParser::parseLine_3d( char **line )
 		act_num_marker = 0;
 		return false;
 	}
+	if ( ! checkCapacity( act_num_marker, loc_capacity.maxMarker ) )
+	{
+		act_num_marker = 0;
+		updateMarkerIndex();
+		return false;
+	}
 	if ( act_num_marker > ( int )act_marker.size() )
 	{
 		act_marker.resize( act_num_marker );
@@ -1014,14 +1830,52 @@ bool DTrackParser::parseLine_3d( char **line )
 			return false;
 	}
 
+	updateMarkerIndex();
 	return true;
 }
 
 
+/*
+ * Hash function for marker ID numbers (Fibonacci hashing).
+ */
+static inline unsigned int marker_hash( int id, int shift )
+{
+	return ( ( unsigned int )id * 2654435769u ) >> shift;
+}
+
+
+/*
+ * Rebuild hash table of marker ID numbers.
+ */
+void DTrackParser::updateMarkerIndex()
+{
+	int bits = marker_index_bits( act_num_marker );
+
+	loc_marker_index.assign( ( size_t )1 << bits, 0 );  // keeps allocated memory
+	loc_marker_shift = 32 - bits;
+	unsigned int mask = ( 1u << bits ) - 1;
+
+	for ( int i = 0; i < act_num_marker; i++ )
+	{
+		unsigned int h = marker_hash( act_marker[ i ].id, loc_marker_shift );
+		while ( loc_marker_index[ h ] != 0 )  // linear probing
+		{
+			if ( act_marker[ loc_marker_index[ h ] - 1 ].id == act_marker[ i ].id )  // duplicate ID: keeps first marker
+				break;
+
+			h = ( h + 1 ) & mask;
+		}
+
+		if ( loc_marker_index[ h ] == 0 )
+			loc_marker_index[ h ] = i + 1;
+	}
+}
+
+
 /*
  * Parses a single line of system status data in one tracking data packet.
  */
-bool DTrackParser::parseLine_st( char** line )
+bool DTrackParser::parseLine_st( const char** line )
 {
 	int ngrp, id, ncam, nval;
 	int iarr[ 5 ];
@@ -1090,6 +1944,9 @@ bool DTrackParser::parseLine_st( char** line )
 		{
 			if ( nval < 3 )  return false;  // more sophisticated at future enhancements of status values
 
+			if ( ! checkCapacity( ncam, loc_capacity.maxCamera ) )
+				return false;
+
 			// adjust length of vector
 			act_status.cameraStatus.resize( ncam );
 
@@ -1226,9 +2083,33 @@ int DTrackParser::getNumHuman() const
  */
 const DTrackHuman* DTrackParser::getHuman( int id ) const
 {
-	if ((id >= 0) && (id < act_num_human))
-		return &act_human.at(id);
-	return NULL;
+	if ((id < 0) || (id >= act_num_human))
+		return NULL;
+
+	if (!loc_human_built) {  // first call: data is built now, afterwards with each frame
+		loc_human_legacy = true;
+		buildHuman();
+	}
+	return &act_human[id];
+}
+
+
+/*
+ * Get ART-Human model data, joints in compact storage.
+ */
+DTrackHumanJoints DTrackParser::getHumanJoints( int id ) const
+{
+	DTrackHumanJoints human;
+
+	human.id = id;
+	human.num_joints = 0;
+	human.joint = NULL;
+
+	if ((id >= 0) && (id < act_num_human) && (act_human_num_joints[id] > 0)) {
+		human.num_joints = act_human_num_joints[id];
+		human.joint = &act_joint[act_human_joint_index[id]];
+	}
+	return human;
 }
 
 
@@ -1272,6 +2153,29 @@ const DTrackMarker* DTrackParser::getMarker( int index ) const
 }
 
 
+/*
+ * Get single marker data by ID number.
+ */
+const DTrackMarker* DTrackParser::getMarkerById( int id ) const
+{
+	if ( act_num_marker <= 0 || loc_marker_index.empty() )
+		return NULL;
+
+	unsigned int mask = ( unsigned int )loc_marker_index.size() - 1;
+	unsigned int h = marker_hash( id, loc_marker_shift );
+	while ( loc_marker_index[ h ] != 0 )
+	{
+		int index = loc_marker_index[ h ] - 1;
+		if ( index < act_num_marker && act_marker[ index ].id == id )
+			return &act_marker[ index ];
+
+		h = ( h + 1 ) & mask;
+	}
+
+	return NULL;
+}
+
+
 /*
  * Get frame counter.
  */
@@ -1317,6 +2221,33 @@ unsigned int DTrackParser::getLatencyUsec() const
 }
 
 
+/*
+ * Get local arrival time of tracking data packet.
+ */
+double DTrackParser::getArrivalTime() const
+{
+	return act_time_arrival;
+}
+
+
+/*
+ * Get local time, when parsing started.
+ */
+double DTrackParser::getParseStartTime() const
+{
+	return act_time_parsestart;
+}
+
+
+/*
+ * Get local time, when parsing finished.
+ */
+double DTrackParser::getParseEndTime() const
+{
+	return act_time_parseend;
+}
+
+
 /*
  * Returns if system status data is available.
  */
@@ -1336,3 +2267,181 @@ const DTrackStatus* DTrackParser::getStatus() const
 	return &act_status;
 }
 
+
+// -----------------------------------------------------------------------------------------------------
+// detection of changes between frames
+
+/*
+ * Add one event.
+ */
+static void events_add( std::vector< DTrackEvent >& events, DTrackEvent::EventType type, DTrackEvent::ObjectType objectType,
+                        int id, int index = -1, double value = 0.0 )
+{
+	DTrackEvent ev;
+	ev.type = type;
+	ev.objectType = objectType;
+	ev.id = id;
+	ev.index = index;
+	ev.value = value;
+	events.push_back( ev );
+}
+
+
+/*
+ * Tracking state of all types of objects.
+ */
+template< typename T >
+static bool events_istracked( const T& object )
+{
+	return object.isTracked();
+}
+
+static bool events_istracked( int numJoints )  // ART-Human model
+{
+	return ( numJoints > 0 );
+}
+
+
+/*
+ * Detect added, removed, tracked and lost objects of one type.
+ */
+template< typename T >
+static void events_tracked( std::vector< DTrackEvent >& events, std::vector< char >& prevTracked,
+                            DTrackEvent::ObjectType objectType, const std::vector< T >& objects, int num )
+{
+	int numPrev = ( int )prevTracked.size();
+
+	for ( int i = num; i < numPrev; i++ )
+		events_add( events, DTrackEvent::EVENT_REMOVED, objectType, i );
+
+	for ( int i = numPrev; i < num; i++ )
+		events_add( events, DTrackEvent::EVENT_ADDED, objectType, i );
+
+	prevTracked.resize( num, 0 );  // added objects weren't tracked before
+
+	for ( int i = 0; i < num; i++ )
+	{
+		char tracked = events_istracked( objects[ i ] ) ? 1 : 0;
+		if ( tracked != prevTracked[ i ] )
+		{
+			events_add( events, tracked ? DTrackEvent::EVENT_TRACKED : DTrackEvent::EVENT_LOST, objectType, i );
+			prevTracked[ i ] = tracked;
+		}
+	}
+}
+
+
+/*
+ * Detect pressed and released buttons of one object.
+ */
+static void events_buttons( std::vector< DTrackEvent >& events, unsigned int& prevButtons,
+                            DTrackEvent::ObjectType objectType, int id, const int* button, int num )
+{
+	unsigned int buttons = 0;
+	for ( int i = 0; i < num; i++ )
+	{
+		if ( button[ i ] )
+			buttons |= 1u << i;
+	}
+
+	unsigned int changed = buttons ^ prevButtons;
+	for ( int i = 0; changed != 0; i++, changed >>= 1 )
+	{
+		if ( changed & 1 )
+		{
+			events_add( events, ( buttons & ( 1u << i ) ) ? DTrackEvent::EVENT_BUTTON_PRESSED : DTrackEvent::EVENT_BUTTON_RELEASED,
+			            objectType, id, i );
+		}
+	}
+
+	prevButtons = buttons;
+}
+
+
+/*
+ * Enable detection of changes between frames.
+ */
+void DTrackParser::enableEvents( bool enable, double joystickThreshold )
+{
+	loc_events_enabled = enable;
+	loc_events_threshold = joystickThreshold;
+
+	for ( int i = 0; i < DTrackEvent::NUM_OBJECTTYPES; i++ )  // next frame reports all objects as added
+		loc_events_tracked[ i ].clear();
+
+	loc_events_flystickbutton.clear();
+	loc_events_meatoolbutton.clear();
+	loc_events_joystick.clear();
+	act_events.clear();
+}
+
+
+/*
+ * Get number of events of actual frame.
+ */
+int DTrackParser::getNumEvents() const
+{
+	return ( int )act_events.size();
+}
+
+
+/*
+ * Get event of actual frame.
+ */
+const DTrackEvent* DTrackParser::getEvent( int index ) const
+{
+	if ( index < 0 || index >= ( int )act_events.size() )
+		return NULL;
+
+	return &act_events[ index ];
+}
+
+
+/*
+ * Detect changes of actual frame, compared to the previous one.
+ */
+void DTrackParser::detectEvents()
+{
+	act_events.clear();  // keeps allocated memory
+
+	events_tracked( act_events, loc_events_tracked[ DTrackEvent::OBJECT_BODY ], DTrackEvent::OBJECT_BODY, act_body, act_num_body );
+
+	events_tracked( act_events, loc_events_tracked[ DTrackEvent::OBJECT_FLYSTICK ], DTrackEvent::OBJECT_FLYSTICK,
+	                act_flystick, act_num_flystick );
+	loc_events_flystickbutton.resize( act_num_flystick, 0 );
+	loc_events_joystick.resize( act_num_flystick * DTRACKSDK_FLYSTICK_MAX_JOYSTICK, 0.0 );
+	for ( int i = 0; i < act_num_flystick; i++ )
+	{
+		const DTrackFlyStick& fs = act_flystick[ i ];
+		events_buttons( act_events, loc_events_flystickbutton[ i ], DTrackEvent::OBJECT_FLYSTICK, i, fs.button, fs.num_button );
+
+		double* prev = &loc_events_joystick[ i * DTRACKSDK_FLYSTICK_MAX_JOYSTICK ];
+		for ( int j = 0; j < fs.num_joystick; j++ )
+		{
+			double v = fs.joystick[ j ];
+			if ( ( fabs( v - prev[ j ] ) >= loc_events_threshold ) || ( v == 0.0 && prev[ j ] != 0.0 ) )
+			{
+				events_add( act_events, DTrackEvent::EVENT_JOYSTICK, DTrackEvent::OBJECT_FLYSTICK, i, j, v );
+				prev[ j ] = v;
+			}
+		}
+	}
+
+	events_tracked( act_events, loc_events_tracked[ DTrackEvent::OBJECT_MEATOOL ], DTrackEvent::OBJECT_MEATOOL,
+	                act_meatool, act_num_meatool );
+	loc_events_meatoolbutton.resize( act_num_meatool, 0 );
+	for ( int i = 0; i < act_num_meatool; i++ )
+	{
+		events_buttons( act_events, loc_events_meatoolbutton[ i ], DTrackEvent::OBJECT_MEATOOL, i,
+		                act_meatool[ i ].button, act_meatool[ i ].num_button );
+	}
+
+	events_tracked( act_events, loc_events_tracked[ DTrackEvent::OBJECT_MEAREF ], DTrackEvent::OBJECT_MEAREF,
+	                act_mearef, act_num_mearef );
+	events_tracked( act_events, loc_events_tracked[ DTrackEvent::OBJECT_HAND ], DTrackEvent::OBJECT_HAND, act_hand, act_num_hand );
+	events_tracked( act_events, loc_events_tracked[ DTrackEvent::OBJECT_HUMAN ], DTrackEvent::OBJECT_HUMAN,
+	                act_human_num_joints, act_num_human );
+	events_tracked( act_events, loc_events_tracked[ DTrackEvent::OBJECT_INERTIAL ], DTrackEvent::OBJECT_INERTIAL,
+	                act_inertial, act_num_inertial );
+}
+
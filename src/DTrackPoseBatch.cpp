@@ -0,0 +1,575 @@
+/* DTrackSDK in C++: DTrackPoseBatch.cpp
+ *
+ * Converting poses of all bodies at once.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackPoseBatch.hpp"
+
+// SIMD instructions processing two doubles at once
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#define POSE_SSE2
+	#include <emmintrin.h>
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+	#define POSE_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace {
+
+#if defined( POSE_SSE2 )
+
+typedef __m128d vec2;
+
+inline vec2 v_set( double a, double b )  { return _mm_set_pd( b, a ); }
+inline vec2 v_dup( double a )  { return _mm_set1_pd( a ); }
+inline void v_store( double* p, vec2 a )  { _mm_storeu_pd( p, a ); }
+inline vec2 v_add( vec2 a, vec2 b )  { return _mm_add_pd( a, b ); }
+inline vec2 v_sub( vec2 a, vec2 b )  { return _mm_sub_pd( a, b ); }
+inline vec2 v_mul( vec2 a, vec2 b )  { return _mm_mul_pd( a, b ); }
+inline vec2 v_div( vec2 a, vec2 b )  { return _mm_div_pd( a, b ); }
+inline vec2 v_sqrt( vec2 a )  { return _mm_sqrt_pd( a ); }
+
+typedef __m128d vmask;
+
+inline vmask v_gt( vec2 a, vec2 b )  { return _mm_cmpgt_pd( a, b ); }
+inline vmask v_and( vmask a, vmask b )  { return _mm_and_pd( a, b ); }
+inline vmask v_andnot( vmask a, vmask b )  { return _mm_andnot_pd( b, a ); }  // a and not b
+inline vec2 v_select( vmask m, vec2 a, vec2 b )  { return _mm_or_pd( _mm_and_pd( m, a ), _mm_andnot_pd( m, b ) ); }
+
+#elif defined( POSE_NEON )
+
+typedef float64x2_t vec2;
+
+inline vec2 v_set( double a, double b )  { double t[ 2 ] = { a, b }; return vld1q_f64( t ); }
+inline vec2 v_dup( double a )  { return vdupq_n_f64( a ); }
+inline void v_store( double* p, vec2 a )  { vst1q_f64( p, a ); }
+inline vec2 v_add( vec2 a, vec2 b )  { return vaddq_f64( a, b ); }
+inline vec2 v_sub( vec2 a, vec2 b )  { return vsubq_f64( a, b ); }
+inline vec2 v_mul( vec2 a, vec2 b )  { return vmulq_f64( a, b ); }
+inline vec2 v_div( vec2 a, vec2 b )  { return vdivq_f64( a, b ); }
+inline vec2 v_sqrt( vec2 a )  { return vsqrtq_f64( a ); }
+
+typedef uint64x2_t vmask;
+
+inline vmask v_gt( vec2 a, vec2 b )  { return vcgtq_f64( a, b ); }
+inline vmask v_and( vmask a, vmask b )  { return vandq_u64( a, b ); }
+inline vmask v_andnot( vmask a, vmask b )  { return vbicq_u64( a, b ); }  // a and not b
+inline vec2 v_select( vmask m, vec2 a, vec2 b )  { return vbslq_f64( m, a, b ); }
+
+#else  // scalar fallback
+
+struct vec2 { double v[ 2 ]; };
+
+inline vec2 v_set( double a, double b )  { vec2 r; r.v[ 0 ] = a; r.v[ 1 ] = b; return r; }
+inline vec2 v_dup( double a )  { return v_set( a, a ); }
+inline void v_store( double* p, vec2 a )  { p[ 0 ] = a.v[ 0 ]; p[ 1 ] = a.v[ 1 ]; }
+inline vec2 v_add( vec2 a, vec2 b )  { return v_set( a.v[ 0 ] + b.v[ 0 ], a.v[ 1 ] + b.v[ 1 ] ); }
+inline vec2 v_sub( vec2 a, vec2 b )  { return v_set( a.v[ 0 ] - b.v[ 0 ], a.v[ 1 ] - b.v[ 1 ] ); }
+inline vec2 v_mul( vec2 a, vec2 b )  { return v_set( a.v[ 0 ] * b.v[ 0 ], a.v[ 1 ] * b.v[ 1 ] ); }
+
+#endif
+
+#if ! defined( POSE_SSE2 ) && ! defined( POSE_NEON )
+
+/*
+ * Convert two rotation matrices into quaternions.
+ */
+inline void rot2quat2( const double* rot0, const double* rot1, vec2& w, vec2& x, vec2& y, vec2& z )
+{
+	DTrackQuaternion q0 = DTrackSDK_Datatypes::rot2quat( rot0 );
+	DTrackQuaternion q1 = DTrackSDK_Datatypes::rot2quat( rot1 );
+
+	w = v_set( q0.w, q1.w );
+	x = v_set( q0.x, q1.x );
+	y = v_set( q0.y, q1.y );
+	z = v_set( q0.z, q1.z );
+}
+
+#else
+
+/*
+ * Convert two rotation matrices into quaternions, without branches.
+ *
+ * All four cases of rot2quat() are calculated and selected by masks, with the same arithmetic; so
+ * results are identical to rot2quat().
+ */
+inline void rot2quat2( const double* rot0, const double* rot1, vec2& w, vec2& x, vec2& y, vec2& z )
+{
+	vec2 m[ 9 ];
+	for ( int i = 0; i < 9; i++ )
+		m[ i ] = v_set( rot0[ i ], rot1[ i ] );
+
+	vec2 one = v_dup( 1.0 );
+	vec2 half = v_dup( 0.5 );
+	vec2 zero = v_dup( 0.0 );
+
+	// select case like rot2quat()
+	vec2 tr = v_add( v_add( m[ 0 ], m[ 4 ] ), m[ 8 ] );
+	vmask cw = v_gt( tr, zero );
+	vmask cx = v_andnot( v_and( v_gt( m[ 0 ], m[ 4 ] ), v_gt( m[ 0 ], m[ 8 ] ) ), cw );
+	vmask cy = v_andnot( v_andnot( v_gt( m[ 4 ], m[ 8 ] ), cw ), cx );
+
+	// case w: 1 + trace > 0
+	vec2 s = v_sqrt( v_add( one, tr ) );
+	vec2 qw = v_mul( half, s );
+	s = v_div( half, s );
+	vec2 qx = v_mul( v_sub( m[ 5 ], m[ 7 ] ), s );
+	vec2 qy = v_mul( v_sub( m[ 6 ], m[ 2 ] ), s );
+	vec2 qz = v_mul( v_sub( m[ 1 ], m[ 3 ] ), s );
+
+	// case x
+	s = v_sqrt( v_sub( v_sub( v_add( one, m[ 0 ] ), m[ 4 ] ), m[ 8 ] ) );
+	vec2 xx = v_mul( half, s );
+	s = v_div( half, s );
+	vec2 xy = v_mul( v_add( m[ 1 ], m[ 3 ] ), s );
+	vec2 xz = v_mul( v_add( m[ 2 ], m[ 6 ] ), s );
+	vec2 xw = v_mul( v_sub( m[ 5 ], m[ 7 ] ), s );
+
+	// case y
+	s = v_sqrt( v_sub( v_add( v_sub( one, m[ 0 ] ), m[ 4 ] ), m[ 8 ] ) );
+	vec2 yy = v_mul( half, s );
+	s = v_div( half, s );
+	vec2 yx = v_mul( v_add( m[ 1 ], m[ 3 ] ), s );
+	vec2 yz = v_mul( v_add( m[ 5 ], m[ 7 ] ), s );
+	vec2 yw = v_mul( v_sub( m[ 6 ], m[ 2 ] ), s );
+
+	// case z
+	s = v_sqrt( v_add( v_sub( v_sub( one, m[ 0 ] ), m[ 4 ] ), m[ 8 ] ) );
+	vec2 zz = v_mul( half, s );
+	s = v_div( half, s );
+	vec2 zx = v_mul( v_add( m[ 2 ], m[ 6 ] ), s );
+	vec2 zy = v_mul( v_add( m[ 5 ], m[ 7 ] ), s );
+	vec2 zw = v_mul( v_sub( m[ 1 ], m[ 3 ] ), s );
+
+	// unselected cases might contain NaN, they are dropped
+	w = v_select( cw, qw, v_select( cx, xw, v_select( cy, yw, zw ) ) );
+	x = v_select( cw, qx, v_select( cx, xx, v_select( cy, yx, zx ) ) );
+	y = v_select( cw, qy, v_select( cx, xy, v_select( cy, yy, zy ) ) );
+	z = v_select( cw, qz, v_select( cx, xz, v_select( cy, yz, zz ) ) );
+}
+
+#endif
+
+}  // namespace
+
+
+/*
+ * Constructor.
+ */
+DTrackPoseBatch::DTrackPoseBatch()
+{
+	resetTransform();
+	d_floatOutput = false;
+	d_num = 0;
+}
+
+
+/*
+ * Set room-to-world transformation applied to all poses.
+ */
+void DTrackPoseBatch::setTransform( const double loc[ 3 ], const double rot[ 9 ] )
+{
+	for ( int i = 0; i < 3; i++ )
+		d_transformLoc[ i ] = loc[ i ];
+
+	for ( int i = 0; i < 9; i++ )
+		d_transformRot[ i ] = rot[ i ];
+
+	rot2quat( rot, &d_transformQuat, 1 );
+	d_hasTransform = true;
+}
+
+
+/*
+ * Remove room-to-world transformation.
+ */
+void DTrackPoseBatch::resetTransform()
+{
+	for ( int i = 0; i < 3; i++ )
+		d_transformLoc[ i ] = 0.0;
+
+	for ( int i = 0; i < 9; i++ )
+		d_transformRot[ i ] = ( i % 4 == 0 ) ? 1.0 : 0.0;
+
+	d_transformQuat.w = 1.0;
+	d_transformQuat.x = d_transformQuat.y = d_transformQuat.z = 0.0;
+	d_hasTransform = false;
+}
+
+
+/*
+ * Enable or disable packed float output.
+ */
+void DTrackPoseBatch::enableFloatOutput( bool enable )
+{
+	d_floatOutput = enable;
+}
+
+
+/*
+ * Convert all standard bodies of a frame.
+ */
+int DTrackPoseBatch::convertBodies( const DTrackParser& frame )
+{
+	int num = frame.getNumBody();
+	prepare( num );
+	for ( int i = 0; i < num; i++ )
+	{
+		const DTrackBody* b = frame.getBody( i );
+		add( b->id, b->isTracked(), b->loc, b->rot );
+	}
+
+	return convert();
+}
+
+
+/*
+ * Convert all Flysticks of a frame.
+ */
+int DTrackPoseBatch::convertFlySticks( const DTrackParser& frame )
+{
+	int num = frame.getNumFlyStick();
+	prepare( num );
+	for ( int i = 0; i < num; i++ )
+	{
+		const DTrackFlyStick* f = frame.getFlyStick( i );
+		add( f->id, f->isTracked(), f->loc, f->rot );
+	}
+
+	return convert();
+}
+
+
+/*
+ * Convert all Measurement Tools of a frame.
+ */
+int DTrackPoseBatch::convertMeaTools( const DTrackParser& frame )
+{
+	int num = frame.getNumMeaTool();
+	prepare( num );
+	for ( int i = 0; i < num; i++ )
+	{
+		const DTrackMeaTool* m = frame.getMeaTool( i );
+		add( m->id, m->isTracked(), m->loc, m->rot );
+	}
+
+	return convert();
+}
+
+
+/*
+ * Convert all hybrid (optical-inertial) bodies of a frame.
+ */
+int DTrackPoseBatch::convertInertials( const DTrackParser& frame )
+{
+	int num = frame.getNumInertial();
+	prepare( num );
+	for ( int i = 0; i < num; i++ )
+	{
+		const DTrackInertial* b = frame.getInertial( i );
+		add( b->id, b->isTracked(), b->loc, b->rot );
+	}
+
+	return convert();
+}
+
+
+/*
+ * Convert all joints of all ART-Human models of a frame.
+ */
+int DTrackPoseBatch::convertHumans( const DTrackParser& frame )
+{
+	int numHuman = frame.getNumHuman();
+	d_humanOffset.resize( numHuman );
+
+	int num = 0;
+	for ( int i = 0; i < numHuman; i++ )
+		num += frame.getHumanJoints( i ).num_joints;
+
+	prepare( num );
+	for ( int i = 0; i < numHuman; i++ )
+	{
+		DTrackHumanJoints human = frame.getHumanJoints( i );
+		d_humanOffset[ i ] = d_num;
+
+		for ( int j = 0; j < human.num_joints; j++ )
+			add( human.joint[ j ].id, human.joint[ j ].isTracked(), human.joint[ j ].loc, human.joint[ j ].rot );
+	}
+
+	return convert();
+}
+
+
+/*
+ * Convert rotation matrices into quaternions.
+ */
+void DTrackPoseBatch::rot2quat( const double* rot, DTrackQuaternion* quat, int num )
+{
+	double w[ 2 ], x[ 2 ], y[ 2 ], z[ 2 ];
+	for ( int i = 0; i < num; i += 2 )
+	{
+		const double* rot1 = ( i + 1 < num ) ? rot + 9 * ( i + 1 ) : rot + 9 * i;
+
+		vec2 vw, vx, vy, vz;
+		rot2quat2( rot + 9 * i, rot1, vw, vx, vy, vz );
+		v_store( w, vw );
+		v_store( x, vx );
+		v_store( y, vy );
+		v_store( z, vz );
+
+		for ( int k = 0; k < 2 && i + k < num; k++ )
+		{
+			quat[ i + k ].w = w[ k ];
+			quat[ i + k ].x = x[ k ];
+			quat[ i + k ].y = y[ k ];
+			quat[ i + k ].z = z[ k ];
+		}
+	}
+}
+
+
+/*
+ * Get number of converted poses.
+ */
+int DTrackPoseBatch::getNum() const
+{
+	return d_num;
+}
+
+
+/*
+ * Get id of a converted pose.
+ */
+int DTrackPoseBatch::getId( int index ) const
+{
+	return d_id[ index ];
+}
+
+
+/*
+ * Returns if body of a converted pose is tracked.
+ */
+bool DTrackPoseBatch::isTracked( int index ) const
+{
+	return ( d_tracked[ index ] != 0 );
+}
+
+
+/*
+ * Get location of a converted pose.
+ */
+const double* DTrackPoseBatch::getLoc( int index ) const
+{
+	return &d_loc[ 3 * index ];
+}
+
+
+/*
+ * Get quaternion of a converted pose.
+ */
+const DTrackQuaternion& DTrackPoseBatch::getQuaternion( int index ) const
+{
+	return d_quat[ index ];
+}
+
+
+/*
+ * Get locations of all converted poses as packed float array.
+ */
+const float* DTrackPoseBatch::getLocFloat() const
+{
+	if ( ! d_floatOutput || d_num == 0 )
+		return NULL;
+
+	return &d_locFloat[ 0 ];
+}
+
+
+/*
+ * Get quaternions of all converted poses as packed float array.
+ */
+const float* DTrackPoseBatch::getQuatFloat() const
+{
+	if ( ! d_floatOutput || d_num == 0 )
+		return NULL;
+
+	return &d_quatFloat[ 0 ];
+}
+
+
+/*
+ * Get index of first joint of an ART-Human model, after convertHumans().
+ */
+int DTrackPoseBatch::getHumanOffset( int humanId ) const
+{
+	if ( humanId < 0 || humanId >= static_cast< int >( d_humanOffset.size() ) )
+		return -1;
+
+	return d_humanOffset[ humanId ];
+}
+
+
+/*
+ * Prepare storage for poses; keeps memory already allocated.
+ */
+void DTrackPoseBatch::prepare( int num )
+{
+	d_num = 0;
+
+	if ( static_cast< int >( d_id.size() ) < num )
+	{
+		d_srcLoc.resize( num );
+		d_srcRot.resize( num );
+		d_id.resize( num );
+		d_tracked.resize( num );
+		d_loc.resize( 3 * num );
+		d_quat.resize( num );
+	}
+
+	if ( d_floatOutput && static_cast< int >( d_locFloat.size() ) < 3 * num )
+	{
+		d_locFloat.resize( 3 * num );
+		d_quatFloat.resize( 4 * num );
+	}
+}
+
+
+/*
+ * Add source of one pose.
+ */
+void DTrackPoseBatch::add( int id, bool tracked, const double* loc, const double* rot )
+{
+	d_srcLoc[ d_num ] = loc;
+	d_srcRot[ d_num ] = rot;
+	d_id[ d_num ] = id;
+	d_tracked[ d_num ] = tracked ? 1 : 0;
+	d_num++;
+}
+
+
+/*
+ * Convert all added poses, two at once.
+ */
+int DTrackPoseBatch::convert()
+{
+	const double* tl = d_transformLoc;
+	const double* tr = d_transformRot;
+	const DTrackQuaternion& tq = d_transformQuat;
+
+	double w[ 2 ], x[ 2 ], y[ 2 ], z[ 2 ], l[ 3 ][ 2 ];
+	for ( int i = 0; i < d_num; i += 2 )
+	{
+		int i1 = ( i + 1 < d_num ) ? i + 1 : i;
+		const double* loc0 = d_srcLoc[ i ];
+		const double* loc1 = d_srcLoc[ i1 ];
+
+		vec2 vw, vx, vy, vz;
+		rot2quat2( d_srcRot[ i ], d_srcRot[ i1 ], vw, vx, vy, vz );
+
+		vec2 lx = v_set( loc0[ 0 ], loc1[ 0 ] );
+		vec2 ly = v_set( loc0[ 1 ], loc1[ 1 ] );
+		vec2 lz = v_set( loc0[ 2 ], loc1[ 2 ] );
+
+		if ( d_hasTransform )
+		{
+			// rotation: quaternion product tq * q
+			vec2 aw = v_dup( tq.w ), ax = v_dup( tq.x ), ay = v_dup( tq.y ), az = v_dup( tq.z );
+			vec2 rw = v_sub( v_sub( v_mul( aw, vw ), v_mul( ax, vx ) ), v_add( v_mul( ay, vy ), v_mul( az, vz ) ) );
+			vec2 rx = v_add( v_add( v_mul( aw, vx ), v_mul( ax, vw ) ), v_sub( v_mul( ay, vz ), v_mul( az, vy ) ) );
+			vec2 ry = v_add( v_sub( v_mul( aw, vy ), v_mul( ax, vz ) ), v_add( v_mul( ay, vw ), v_mul( az, vx ) ) );
+			vec2 rz = v_add( v_add( v_mul( aw, vz ), v_mul( ax, vy ) ), v_sub( v_mul( az, vw ), v_mul( ay, vx ) ) );
+
+			vw = rw;
+			vx = rx;
+			vy = ry;
+			vz = rz;
+
+			// location: rot * loc + loc
+			vec2 wx = v_add( v_add( v_mul( v_dup( tr[ 0 ] ), lx ), v_mul( v_dup( tr[ 3 ] ), ly ) ),
+			                 v_add( v_mul( v_dup( tr[ 6 ] ), lz ), v_dup( tl[ 0 ] ) ) );
+			vec2 wy = v_add( v_add( v_mul( v_dup( tr[ 1 ] ), lx ), v_mul( v_dup( tr[ 4 ] ), ly ) ),
+			                 v_add( v_mul( v_dup( tr[ 7 ] ), lz ), v_dup( tl[ 1 ] ) ) );
+			vec2 wz = v_add( v_add( v_mul( v_dup( tr[ 2 ] ), lx ), v_mul( v_dup( tr[ 5 ] ), ly ) ),
+			                 v_add( v_mul( v_dup( tr[ 8 ] ), lz ), v_dup( tl[ 2 ] ) ) );
+			lx = wx;
+			ly = wy;
+			lz = wz;
+		}
+
+		v_store( w, vw );
+		v_store( x, vx );
+		v_store( y, vy );
+		v_store( z, vz );
+		v_store( l[ 0 ], lx );
+		v_store( l[ 1 ], ly );
+		v_store( l[ 2 ], lz );
+
+		for ( int k = 0; k < 2 && i + k < d_num; k++ )
+		{
+			int n = i + k;
+			DTrackQuaternion& q = d_quat[ n ];
+			double* loc = &d_loc[ 3 * n ];
+
+			if ( d_tracked[ n ] )
+			{
+				q.w = w[ k ];
+				q.x = x[ k ];
+				q.y = y[ k ];
+				q.z = z[ k ];
+				loc[ 0 ] = l[ 0 ][ k ];
+				loc[ 1 ] = l[ 1 ][ k ];
+				loc[ 2 ] = l[ 2 ][ k ];
+			}
+			else
+			{
+				q.w = 1.0;
+				q.x = q.y = q.z = 0.0;
+				loc[ 0 ] = loc[ 1 ] = loc[ 2 ] = 0.0;
+			}
+		}
+	}
+
+	if ( d_floatOutput )
+	{
+		for ( int n = 0; n < d_num; n++ )
+		{
+			d_locFloat[ 3 * n + 0 ] = static_cast< float >( d_loc[ 3 * n + 0 ] );
+			d_locFloat[ 3 * n + 1 ] = static_cast< float >( d_loc[ 3 * n + 1 ] );
+			d_locFloat[ 3 * n + 2 ] = static_cast< float >( d_loc[ 3 * n + 2 ] );
+
+			d_quatFloat[ 4 * n + 0 ] = static_cast< float >( d_quat[ n ].x );
+			d_quatFloat[ 4 * n + 1 ] = static_cast< float >( d_quat[ n ].y );
+			d_quatFloat[ 4 * n + 2 ] = static_cast< float >( d_quat[ n ].z );
+			d_quatFloat[ 4 * n + 3 ] = static_cast< float >( d_quat[ n ].w );
+		}
+	}
+
+	return d_num;
+}
+
@@ -0,0 +1,364 @@
+/* DTrackSDK in C++: DTrackPredictor.cpp
+ *
+ * Prediction of poses for a local point in time.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackPredictor.hpp"
+
+#include <cmath>
+
+#define PREDICTOR_DEFAULT_MAXPREDICTION  0.1  // default maximum time span of prediction (in s)
+#define PREDICTOR_DEFAULT_VELOCITYFRAMES  2   // default number of frames used to calculate velocities
+#define PREDICTOR_TIME_JUMP  1.0              // backward jump of Controller clock, that resets history (in s)
+
+namespace {
+
+/*
+ * Product of two quaternions.
+ */
+DTrackQuaternion quatMul( const DTrackQuaternion& a, const DTrackQuaternion& b )
+{
+	DTrackQuaternion q;
+
+	q.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+	q.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+	q.y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+	q.z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+	return q;
+}
+
+/*
+ * Convert quaternion into rotation matrix (column-wise).
+ */
+void quat2rot( const DTrackQuaternion& q, double rot[ 9 ] )
+{
+	rot[ 0 ] = 1.0 - 2.0 * ( q.y * q.y + q.z * q.z );
+	rot[ 1 ] = 2.0 * ( q.x * q.y + q.w * q.z );
+	rot[ 2 ] = 2.0 * ( q.x * q.z - q.w * q.y );
+	rot[ 3 ] = 2.0 * ( q.x * q.y - q.w * q.z );
+	rot[ 4 ] = 1.0 - 2.0 * ( q.x * q.x + q.z * q.z );
+	rot[ 5 ] = 2.0 * ( q.y * q.z + q.w * q.x );
+	rot[ 6 ] = 2.0 * ( q.x * q.z + q.w * q.y );
+	rot[ 7 ] = 2.0 * ( q.y * q.z - q.w * q.x );
+	rot[ 8 ] = 1.0 - 2.0 * ( q.x * q.x + q.y * q.y );
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------------------------------
+
+/*
+ * Constructor.
+ */
+DTrackPredictor::DTrackPredictor()
+	: d_maxPrediction( PREDICTOR_DEFAULT_MAXPREDICTION ), d_velocityFrames( PREDICTOR_DEFAULT_VELOCITYFRAMES )
+{
+	reset();
+}
+
+
+/*
+ * Set maximum time span of prediction.
+ */
+void DTrackPredictor::setMaxPrediction( double maxPrediction )
+{
+	d_maxPrediction = ( maxPrediction > 0.0 ) ? maxPrediction : 0.0;
+}
+
+
+/*
+ * Set number of frames used to calculate velocities.
+ */
+void DTrackPredictor::setVelocityFrames( int numFrames )
+{
+	if ( numFrames < 1 )  numFrames = 1;
+	if ( numFrames > HISTORY_SIZE - 1 )  numFrames = HISTORY_SIZE - 1;
+
+	d_velocityFrames = numFrames;
+}
+
+
+/*
+ * Remove all poses.
+ */
+void DTrackPredictor::reset()
+{
+	d_hasFrame = false;
+	d_lastTime = 0.0;
+	d_numOffset = 0;
+	d_headOffset = 0;
+	d_clockOffset = 0.0;
+
+	for ( int i = 0; i < NUM_TRACK; i++ )
+		d_track[ i ].clear();
+}
+
+
+/*
+ * Add poses of a frame.
+ */
+bool DTrackPredictor::addFrame( const DTrackParser& frame )
+{
+	double arrival = frame.getArrivalTime();
+	if ( arrival <= 0.0 )  return false;
+
+	// time of exposure and sending, Controller clock:
+
+	double time, timeSend;
+	if ( frame.getTimeStampSec() > 0 )
+	{
+		time = ( double )frame.getTimeStampSec() + ( double )frame.getTimeStampUsec() * 1e-6;
+		timeSend = time + ( double )frame.getLatencyUsec() * 1e-6;
+	}
+	else if ( frame.getTimeStamp() >= 0.0 )
+	{
+		time = timeSend = frame.getTimeStamp();
+	}
+	else
+	{
+		time = timeSend = arrival;
+	}
+
+	if ( d_hasFrame )
+	{
+		if ( time < d_lastTime - PREDICTOR_TIME_JUMP )  // e.g. restart of Controller, midnight
+			reset();
+		else if ( time <= d_lastTime )
+			return false;
+	}
+
+	d_hasFrame = true;
+	d_lastTime = time;
+
+	// clock offset: minimum over recent frames, i.e. the frame with the shortest network delay
+
+	d_offset[ d_headOffset ] = arrival - timeSend;
+	d_headOffset = ( d_headOffset + 1 ) % OFFSET_WINDOW;
+	if ( d_numOffset < OFFSET_WINDOW )  d_numOffset++;
+
+	d_clockOffset = d_offset[ 0 ];
+	for ( int i = 1; i < d_numOffset; i++ )
+	{
+		if ( d_offset[ i ] < d_clockOffset )  d_clockOffset = d_offset[ i ];
+	}
+
+	// poses:
+
+	int num = frame.getNumBody();
+	for ( int i = 0; i < num; i++ )
+	{
+		const DTrackBody* body = frame.getBody( i );
+		addPose( TRACK_BODY, i, body->isTracked(), time, body->loc, body->rot );
+	}
+	for ( int i = num; i < ( int )d_track[ TRACK_BODY ].size(); i++ )
+		d_track[ TRACK_BODY ][ i ].tracked = false;
+
+	num = frame.getNumFlyStick();
+	for ( int i = 0; i < num; i++ )
+	{
+		const DTrackFlyStick* flystick = frame.getFlyStick( i );
+		addPose( TRACK_FLYSTICK, i, flystick->isTracked(), time, flystick->loc, flystick->rot );
+	}
+	for ( int i = num; i < ( int )d_track[ TRACK_FLYSTICK ].size(); i++ )
+		d_track[ TRACK_FLYSTICK ][ i ].tracked = false;
+
+	num = frame.getNumHand();
+	for ( int i = 0; i < num; i++ )
+	{
+		const DTrackHand* hand = frame.getHand( i );
+		addPose( TRACK_HAND, i, hand->isTracked(), time, hand->loc, hand->rot );
+	}
+	for ( int i = num; i < ( int )d_track[ TRACK_HAND ].size(); i++ )
+		d_track[ TRACK_HAND ][ i ].tracked = false;
+
+	return true;
+}
+
+
+/*
+ * Add pose of one tracked object.
+ */
+void DTrackPredictor::addPose( int type, int id, bool tracked, double time, const double* loc, const double* rot )
+{
+	std::vector< Track >& tracks = d_track[ type ];
+
+	if ( id >= ( int )tracks.size() )
+	{
+		Track track;
+		track.tracked = false;
+		track.num = 0;
+		track.head = 0;
+
+		tracks.resize( id + 1, track );
+	}
+
+	Track& track = tracks[ id ];
+
+	if ( ! tracked )
+	{
+		track.tracked = false;
+		return;
+	}
+
+	if ( ! track.tracked )  // don't calculate velocities across a gap
+		track.num = 0;
+
+	track.tracked = true;
+	track.head = ( track.num == 0 ) ? 0 : ( track.head + 1 ) % HISTORY_SIZE;
+	if ( track.num < HISTORY_SIZE )  track.num++;
+
+	Sample& s = track.sample[ track.head ];
+	s.time = time;
+	s.loc[ 0 ] = loc[ 0 ];
+	s.loc[ 1 ] = loc[ 1 ];
+	s.loc[ 2 ] = loc[ 2 ];
+	s.quat = rot2quat( rot );
+}
+
+
+/*
+ * Predict pose of a standard body.
+ */
+bool DTrackPredictor::predictBody( int id, double targetTime, Pose& pose ) const
+{
+	return predict( TRACK_BODY, id, targetTime, pose );
+}
+
+
+/*
+ * Predict pose of a Flystick.
+ */
+bool DTrackPredictor::predictFlyStick( int id, double targetTime, Pose& pose ) const
+{
+	return predict( TRACK_FLYSTICK, id, targetTime, pose );
+}
+
+
+/*
+ * Predict pose of the back of a Fingertracking hand.
+ */
+bool DTrackPredictor::predictHand( int id, double targetTime, Pose& pose ) const
+{
+	return predict( TRACK_HAND, id, targetTime, pose );
+}
+
+
+/*
+ * Predict pose of one tracked object.
+ */
+bool DTrackPredictor::predict( int type, int id, double targetTime, Pose& pose ) const
+{
+	const std::vector< Track >& tracks = d_track[ type ];
+
+	if ( ( id < 0 ) || ( id >= ( int )tracks.size() ) )  return false;
+
+	const Track& track = tracks[ id ];
+	if ( ( ! track.tracked ) || ( track.num == 0 ) )  return false;
+
+	const Sample& s1 = track.sample[ track.head ];
+
+	double dt = targetTime - d_clockOffset - s1.time;
+	if ( dt < 0.0 )  dt = 0.0;
+	if ( dt > d_maxPrediction )  dt = d_maxPrediction;
+
+	pose.loc[ 0 ] = s1.loc[ 0 ];
+	pose.loc[ 1 ] = s1.loc[ 1 ];
+	pose.loc[ 2 ] = s1.loc[ 2 ];
+	pose.quat = s1.quat;
+
+	int k = ( track.num - 1 < d_velocityFrames ) ? track.num - 1 : d_velocityFrames;
+	if ( ( k > 0 ) && ( dt > 0.0 ) )
+	{
+		const Sample& s0 = track.sample[ ( track.head - k + HISTORY_SIZE ) % HISTORY_SIZE ];
+		double span = s1.time - s0.time;
+
+		if ( span > 0.0 )
+		{
+			double f = dt / span;
+
+			// constant velocity:
+
+			pose.loc[ 0 ] += ( s1.loc[ 0 ] - s0.loc[ 0 ] ) * f;
+			pose.loc[ 1 ] += ( s1.loc[ 1 ] - s0.loc[ 1 ] ) * f;
+			pose.loc[ 2 ] += ( s1.loc[ 2 ] - s0.loc[ 2 ] ) * f;
+
+			// constant angular velocity: rotation between both samples, scaled by f
+
+			DTrackQuaternion q0c;
+			q0c.w = s0.quat.w;
+			q0c.x = -s0.quat.x;
+			q0c.y = -s0.quat.y;
+			q0c.z = -s0.quat.z;
+
+			DTrackQuaternion dq = quatMul( s1.quat, q0c );
+			if ( dq.w < 0.0 )  // shortest path
+			{
+				dq.w = -dq.w;  dq.x = -dq.x;  dq.y = -dq.y;  dq.z = -dq.z;
+			}
+
+			double sinHalf = std::sqrt( dq.x * dq.x + dq.y * dq.y + dq.z * dq.z );
+			if ( sinHalf > 1e-12 )
+			{
+				double halfAngle = std::atan2( sinHalf, dq.w ) * f;
+				double s = std::sin( halfAngle ) / sinHalf;
+
+				DTrackQuaternion dqf;
+				dqf.w = std::cos( halfAngle );
+				dqf.x = dq.x * s;
+				dqf.y = dq.y * s;
+				dqf.z = dq.z * s;
+
+				pose.quat = quatMul( dqf, s1.quat );
+			}
+		}
+	}
+
+	quat2rot( pose.quat, pose.rot );
+	return true;
+}
+
+
+/*
+ * Get local time of exposure of latest frame.
+ */
+double DTrackPredictor::getFrameTime() const
+{
+	if ( ! d_hasFrame )  return 0.0;
+
+	return toLocalTime( d_lastTime );
+}
+
+
+/*
+ * Convert time of Controller clock into local time.
+ */
+double DTrackPredictor::toLocalTime( double controllerTime ) const
+{
+	return controllerTime + d_clockOffset;
+}
+
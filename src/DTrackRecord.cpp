@@ -0,0 +1,552 @@
+/* DTrackSDK in C++: DTrackRecord.cpp
+ *
+ * Recording of tracking data packets into binary files, and replay of such recordings.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackRecord.hpp"
+#include "DTrackSDK.hpp"
+
+#include <cstring>
+
+using namespace DTrackSys;
+
+#define REC_VERSION      1   // version of file format
+#define REC_HEADERSIZE  16   // size of file header, packet header, index header and file trailer
+#define REC_INDEXSIZE   24   // size of one index entry
+#define REC_ALIGN        8   // alignment of packets
+
+static const char s_magic_file[]  = "DTRKREC1";
+static const char s_magic_index[] = "DTRKIDX1";
+static const char s_magic_end[]   = "DTRKEND1";
+
+
+/*
+ * Store/load values in file format.
+ */
+static void rec_put_ui( char* p, unsigned int value )
+{
+	memcpy( p, &value, sizeof( value ) );
+}
+
+static void rec_put_d( char* p, double value )
+{
+	memcpy( p, &value, sizeof( value ) );
+}
+
+static void rec_put_offset( char* p, size_t offset )
+{
+	rec_put_ui( p, static_cast< unsigned int >( offset & 0xffffffffu ) );
+	rec_put_ui( p + 4, static_cast< unsigned int >( ( offset >> 16 ) >> 16 ) );  // avoids warning if size_t has 32 bit
+}
+
+static unsigned int rec_get_ui( const char* p )
+{
+	unsigned int value;
+	memcpy( &value, p, sizeof( value ) );
+	return value;
+}
+
+static double rec_get_d( const char* p )
+{
+	double value;
+	memcpy( &value, p, sizeof( value ) );
+	return value;
+}
+
+static bool rec_get_offset( const char* p, size_t* offset )
+{
+	unsigned int hi = rec_get_ui( p + 4 );
+	size_t value = ( ( static_cast< size_t >( hi ) << 16 ) << 16 ) | rec_get_ui( p );
+
+	if ( ( ( value >> 16 ) >> 16 ) != hi )  // offset too large for address space
+		return false;
+
+	*offset = value;
+	return true;
+}
+
+
+/*
+ * Size of one packet in file, including header and padding.
+ */
+static size_t rec_packetsize( size_t len )
+{
+	return ( REC_HEADERSIZE + len + 1 + REC_ALIGN - 1 ) & ~static_cast< size_t >( REC_ALIGN - 1 );
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Recording:
+// ---------------------------------------------------------------------------------------------------
+
+/*
+ * Constructor.
+ */
+DTrackRecorder::DTrackRecorder()
+	: d_file( NULL ), d_offset( 0 )
+{
+	//
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackRecorder::~DTrackRecorder()
+{
+	close();
+}
+
+
+/*
+ * Create a new recording file.
+ */
+bool DTrackRecorder::open( const std::string& filename )
+{
+	close();
+
+	d_file = fopen( filename.c_str(), "wb" );
+	if ( d_file == NULL )
+		return false;
+
+	char header[ REC_HEADERSIZE ];
+	memcpy( header, s_magic_file, 8 );
+	rec_put_ui( header + 8, REC_VERSION );
+	rec_put_ui( header + 12, REC_HEADERSIZE );
+
+	if ( fwrite( header, 1, REC_HEADERSIZE, d_file ) != REC_HEADERSIZE )
+	{
+		fclose( d_file );
+		d_file = NULL;
+		return false;
+	}
+
+	d_offset = REC_HEADERSIZE;
+	d_index.clear();
+	return true;
+}
+
+
+/*
+ * Finish recording file, writing the index.
+ */
+bool DTrackRecorder::close()
+{
+	if ( d_file == NULL )
+		return false;
+
+	bool ok = true;
+	char buf[ REC_INDEXSIZE ];
+
+	memcpy( buf, s_magic_index, 8 );
+	rec_put_ui( buf + 8, static_cast< unsigned int >( d_index.size() ) );
+	rec_put_ui( buf + 12, 0 );
+	ok = ok && ( fwrite( buf, 1, REC_HEADERSIZE, d_file ) == REC_HEADERSIZE );
+
+	for ( size_t i = 0; ok && ( i < d_index.size() ); i++ )
+	{
+		rec_put_offset( buf, d_index[ i ].offset );
+		rec_put_ui( buf + 8, d_index[ i ].frameCounter );
+		rec_put_ui( buf + 12, 0 );
+		rec_put_d( buf + 16, d_index[ i ].arrivalTime );
+		ok = ( fwrite( buf, 1, REC_INDEXSIZE, d_file ) == REC_INDEXSIZE );
+	}
+
+	rec_put_offset( buf, d_offset );
+	memcpy( buf + 8, s_magic_end, 8 );
+	ok = ok && ( fwrite( buf, 1, REC_HEADERSIZE, d_file ) == REC_HEADERSIZE );
+
+	ok = ( fclose( d_file ) == 0 ) && ok;
+	d_file = NULL;
+	d_index.clear();
+	return ok;
+}
+
+
+/*
+ * Returns if a recording file is open.
+ */
+bool DTrackRecorder::isOpen() const
+{
+	return ( d_file != NULL );
+}
+
+
+/*
+ * Append one tracking data packet.
+ */
+bool DTrackRecorder::addPacket( const char* data, size_t len, unsigned int frameCounter, double arrivalTime )
+{
+	static const char zeros[ REC_ALIGN + 1 ] = { 0 };
+
+	if ( ( d_file == NULL ) || ( data == NULL ) || ( len > 0xffffffffu - REC_HEADERSIZE - REC_ALIGN ) )
+		return false;
+
+	size_t size = rec_packetsize( len );
+	if ( d_offset + size < d_offset )  // file too large
+		return false;
+
+	char header[ REC_HEADERSIZE ];
+	rec_put_d( header, arrivalTime );
+	rec_put_ui( header + 8, frameCounter );
+	rec_put_ui( header + 12, static_cast< unsigned int >( len ) );
+
+	size_t npad = size - REC_HEADERSIZE - len;  // including terminating '\0'
+	if ( ( fwrite( header, 1, REC_HEADERSIZE, d_file ) != REC_HEADERSIZE ) ||
+	     ( fwrite( data, 1, len, d_file ) != len ) ||
+	     ( fwrite( zeros, 1, npad, d_file ) != npad ) )
+	{
+		return false;
+	}
+
+	DTrackRecordIndex entry;
+	entry.offset = d_offset;
+	entry.frameCounter = frameCounter;
+	entry.arrivalTime = arrivalTime;
+	d_index.push_back( entry );
+
+	d_offset += size;
+	return true;
+}
+
+
+/*
+ * Get number of recorded packets.
+ */
+int DTrackRecorder::getNumPackets() const
+{
+	return static_cast< int >( d_index.size() );
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Replay:
+// ---------------------------------------------------------------------------------------------------
+
+/*
+ * Constructor.
+ */
+DTrackReplay::DTrackReplay()
+	: d_mappedindex( NULL ), d_num( 0 ), d_pos( 0 ), d_has_start( false ), d_start( 0.0 ), d_start_rec( 0.0 )
+{
+	//
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackReplay::~DTrackReplay()
+{
+	close();
+}
+
+
+/*
+ * Open a recording file.
+ */
+bool DTrackReplay::open( const std::string& filename )
+{
+	close();
+
+	if ( ! d_file.open( filename.c_str() ) )
+		return false;
+
+	const char* data = d_file.getData();
+	size_t size = d_file.getSize();
+
+	if ( ( size < REC_HEADERSIZE ) || ( memcmp( data, s_magic_file, 8 ) != 0 ) ||
+	     ( rec_get_ui( data + 8 ) != REC_VERSION ) || ( rec_get_ui( data + 12 ) != REC_HEADERSIZE ) )
+	{
+		close();
+		return false;
+	}
+
+	// use index stored in file, if complete:
+	size_t offset;
+	if ( ( size >= 3 * REC_HEADERSIZE ) && ( memcmp( data + size - 8, s_magic_end, 8 ) == 0 ) &&
+	     rec_get_offset( data + size - REC_HEADERSIZE, &offset ) &&
+	     ( offset >= REC_HEADERSIZE ) && ( offset <= size - 2 * REC_HEADERSIZE ) &&
+	     ( memcmp( data + offset, s_magic_index, 8 ) == 0 ) )
+	{
+		unsigned int num = rec_get_ui( data + offset + 8 );
+
+		if ( ( num <= 0x7fffffffu ) &&
+		     ( ( size - 2 * REC_HEADERSIZE - offset ) / REC_INDEXSIZE == num ) &&
+		     ( ( size - 2 * REC_HEADERSIZE - offset ) % REC_INDEXSIZE == 0 ) )
+		{
+			d_mappedindex = data + offset + REC_HEADERSIZE;
+			d_num = static_cast< int >( num );
+			return true;
+		}
+	}
+
+	// otherwise rebuild index:
+	return buildIndex();
+}
+
+
+/*
+ * Rebuild index by scanning all packets.
+ */
+bool DTrackReplay::buildIndex()
+{
+	const char* data = d_file.getData();
+	size_t size = d_file.getSize();
+	size_t offset = REC_HEADERSIZE;
+
+	d_index.clear();
+	while ( size - offset >= REC_HEADERSIZE )
+	{
+		if ( memcmp( data + offset, s_magic_index, 8 ) == 0 )
+			break;  // start of (incomplete) index
+
+		size_t len = rec_get_ui( data + offset + 12 );
+		if ( ( len > size ) || ( rec_packetsize( len ) > size - offset ) ||
+		     ( data[ offset + REC_HEADERSIZE + len ] != '\0' ) )
+		{
+			break;  // incomplete packet at end of file
+		}
+
+		DTrackRecordIndex entry;
+		entry.offset = offset;
+		entry.frameCounter = rec_get_ui( data + offset + 8 );
+		entry.arrivalTime = rec_get_d( data + offset );
+		d_index.push_back( entry );
+
+		if ( d_index.size() >= 0x7fffffffu )
+			break;
+
+		offset += rec_packetsize( len );
+	}
+
+	d_num = static_cast< int >( d_index.size() );
+	return true;
+}
+
+
+/*
+ * Close recording file.
+ */
+void DTrackReplay::close()
+{
+	d_file.close();
+	d_mappedindex = NULL;
+	d_index.clear();
+	d_num = 0;
+	d_pos = 0;
+	d_has_start = false;
+}
+
+
+/*
+ * Returns if a recording file is open.
+ */
+bool DTrackReplay::isOpen() const
+{
+	return ( d_file.getData() != NULL );
+}
+
+
+/*
+ * Get number of packets in recording.
+ */
+int DTrackReplay::getNumPackets() const
+{
+	return d_num;
+}
+
+
+/*
+ * Get actual position.
+ */
+int DTrackReplay::getPosition() const
+{
+	return d_pos;
+}
+
+
+/*
+ * Set actual position.
+ */
+bool DTrackReplay::seek( int index )
+{
+	if ( ( index < 0 ) || ( index > d_num ) )
+		return false;
+
+	d_pos = index;
+	d_has_start = false;
+	return true;
+}
+
+
+/*
+ * Get index entry of one packet.
+ */
+DTrackRecordIndex DTrackReplay::getIndex( int index ) const
+{
+	if ( d_mappedindex == NULL )
+		return d_index[ index ];
+
+	const char* p = d_mappedindex + static_cast< size_t >( index ) * REC_INDEXSIZE;
+	DTrackRecordIndex entry;
+	if ( ! rec_get_offset( p, &entry.offset ) )
+		entry.offset = 0;  // i.e. invalid
+
+	entry.frameCounter = rec_get_ui( p + 8 );
+	entry.arrivalTime = rec_get_d( p + 16 );
+	return entry;
+}
+
+
+/*
+ * Set actual position to the first packet with a frame counter not less than the given one.
+ */
+bool DTrackReplay::seekFrameCounter( unsigned int frameCounter )
+{
+	int lo = 0, hi = d_num;
+	while ( lo < hi )
+	{
+		int mid = lo + ( hi - lo ) / 2;
+		if ( getIndex( mid ).frameCounter < frameCounter )
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+
+	if ( lo >= d_num )
+		return false;
+
+	return seek( lo );
+}
+
+
+/*
+ * Set actual position to the first packet with an arrival time not less than the given one.
+ */
+bool DTrackReplay::seekTime( double arrivalTime )
+{
+	int lo = 0, hi = d_num;
+	while ( lo < hi )
+	{
+		int mid = lo + ( hi - lo ) / 2;
+		if ( getIndex( mid ).arrivalTime < arrivalTime )
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+
+	if ( lo >= d_num )
+		return false;
+
+	return seek( lo );
+}
+
+
+/*
+ * Get one packet.
+ */
+bool DTrackReplay::getPacket( int index, const char** data, size_t* len, unsigned int* frameCounter,
+                              double* arrivalTime ) const
+{
+	if ( ( index < 0 ) || ( index >= d_num ) )
+		return false;
+
+	DTrackRecordIndex entry = getIndex( index );
+	const char* p = d_file.getData();
+	size_t size = d_file.getSize();
+
+	if ( ( entry.offset < REC_HEADERSIZE ) || ( size - entry.offset < REC_HEADERSIZE ) )
+		return false;
+
+	size_t n = rec_get_ui( p + entry.offset + 12 );
+	if ( ( n > size ) || ( rec_packetsize( n ) > size - entry.offset ) )
+		return false;
+
+	*data = p + entry.offset + REC_HEADERSIZE;
+	*len = n;
+
+	if ( frameCounter != NULL )
+		*frameCounter = entry.frameCounter;
+
+	if ( arrivalTime != NULL )
+		*arrivalTime = entry.arrivalTime;
+
+	return true;
+}
+
+
+/*
+ * Get packet at actual position and advance position.
+ */
+bool DTrackReplay::getNextPacket( const char** data, size_t* len, unsigned int* frameCounter, double* arrivalTime )
+{
+	if ( ! getPacket( d_pos, data, len, frameCounter, arrivalTime ) )
+		return false;
+
+	d_pos++;
+	return true;
+}
+
+
+/*
+ * Process packet at actual position and advance position.
+ */
+bool DTrackReplay::processNextPacket( DTrackSDK& sdk, bool realTime )
+{
+	const char* data;
+	size_t len;
+	double arrivalTime;
+
+	if ( ! getNextPacket( &data, &len, NULL, &arrivalTime ) )
+		return false;
+
+	if ( realTime )
+	{
+		if ( ! d_has_start )
+		{
+			d_start = time_monotonic();
+			d_start_rec = arrivalTime;
+			d_has_start = true;
+		}
+		else
+		{
+			time_sleep( d_start + ( arrivalTime - d_start_rec ) - time_monotonic() );
+		}
+	}
+
+	return sdk.processPacket( data, len + 1 );  // including terminating '\0'
+}
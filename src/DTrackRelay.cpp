@@ -0,0 +1,1340 @@
+/* DTrackSDK in C++: DTrackRelay.cpp
+ *
+ * Relaying tracking data to remote consumers in a compact binary format.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackRelay.hpp"
+#include "DTrackSys.hpp"
+
+#include <cmath>
+#include <cstring>
+
+using namespace DTrackNet;
+using namespace DTrackSys;
+
+/*
+ * Binary format of one frame (version 1):
+ * - Header: magic "DTR", version (1 byte), flags (1 byte), sequence number (varint)
+ * - Frame counter and timestamps, delta-encoded
+ * - Sections (tag byte + data) of all types of tracking data with at least one entry, followed by tag 0
+ * - Lists: number of entries (varint), bitmap of entries with data (untracked entries just have a 0 bit),
+ *   followed by the data of these entries
+ *
+ * Integers are sent as zig-zag encoded varints of the difference to the reference value. Real values
+ * are sent the same way as fixed-point numbers, if exactly representable; otherwise as escape token
+ * (varint 1) and raw IEEE 754 value (in byte order of the sending machine). The reference values are
+ * taken from the same entry in the previous frame, for key frames from an untracked entry.
+ */
+
+#define RELAY_VERSION  1
+
+#define RELAY_FLAG_KEY    0x01  // key frame
+#define RELAY_FLAG_FLOAT  0x02  // raw values in single precision
+#define RELAY_FLAG_TS2    0x04  // timestamp is calculated from extended timestamp
+
+// maximum number of entries in a list, far beyond real systems; limits memory for malformed frames:
+#define RELAY_MAXNUM_BODY      1000
+#define RELAY_MAXNUM_FLYSTICK  100
+#define RELAY_MAXNUM_MEATOOL   100
+#define RELAY_MAXNUM_MEAREF    100
+#define RELAY_MAXNUM_HAND      100
+#define RELAY_MAXNUM_HUMAN     100
+#define RELAY_MAXNUM_INERTIAL  1000
+#define RELAY_MAXNUM_MARKER    10000
+#define RELAY_MAXNUM_CAMERA    1000
+
+#define RELAY_MAXFIXED  536870912.0    // maximum of fixed-point numbers (2^29)
+#define RELAY_SENDTIMEOUT_US  1000    // timeout for sending to one subscriber
+
+namespace {
+
+const char s_relay_magic[] = "DTR";
+
+enum {  // section tags
+	RELAY_END = 0, RELAY_BODY, RELAY_FLYSTICK, RELAY_MEATOOL, RELAY_MEAREF, RELAY_HAND, RELAY_HUMAN,
+	RELAY_INERTIAL, RELAY_MARKER, RELAY_STATUS
+};
+
+enum {  // number of decimals of fixed-point numbers, as in DTrack's ASCII output
+	RELAY_DEC_TIME = 3, RELAY_DEC_QUALITY = 3, RELAY_DEC_LOC = 3, RELAY_DEC_ROT = 6, RELAY_DEC_MISC = 4,
+	RELAY_DEC_COV = 6
+};
+
+const double s_relay_scale[] = { 1.0, 10.0, 100.0, 1000.0, 10000.0, 100000.0, 1000000.0 };
+
+/*
+ * Fixed-point representation of a value; 0 if out of range.
+ */
+inline int relay_fixed( double v, int dec )
+{
+	double x = floor( v * s_relay_scale[ dec ] + 0.5 );
+	if ( ! ( fabs( x ) < RELAY_MAXFIXED ) )  // also for NaN
+		return 0;
+
+	return static_cast< int >( x );
+}
+
+/*
+ * Zig-zag encoding of a difference (two's complement), to get small numbers also for negative differences.
+ */
+inline unsigned int relay_zigzag( unsigned int d )
+{
+	return ( d << 1 ) ^ ( 0u - ( d >> 31 ) );
+}
+
+inline unsigned int relay_unzigzag( unsigned int z )
+{
+	return ( z >> 1 ) ^ ( 0u - ( z & 1 ) );
+}
+
+
+/*
+ * Writing a binary frame.
+ */
+class RelayWriter
+{
+public:
+
+	RelayWriter( char* buffer, int maxLen )
+		: d_begin( buffer ), d_p( buffer ), d_end( buffer + maxLen ), d_isfloat( false ), d_ok( true )
+	{}
+
+	void setFloat( bool isFloat )  { d_isfloat = isFloat; }
+	bool isOk() const  { return d_ok; }
+	int getLength() const  { return static_cast< int >( d_p - d_begin ); }
+
+	char* reserve( int n )  // n bytes, set to zero
+	{
+		if ( n > d_end - d_p )
+		{
+			d_ok = false;
+			return NULL;
+		}
+
+		char* p = d_p;
+		memset( p, 0, n );
+		d_p += n;
+		return p;
+	}
+
+	void raw( const void* data, int n )
+	{
+		char* p = reserve( n );
+		if ( p != NULL )
+			memcpy( p, data, n );
+	}
+
+	void byte( unsigned int v )
+	{
+		char c = static_cast< char >( v );
+		raw( &c, 1 );
+	}
+
+	void varint( unsigned int v )
+	{
+		while ( v >= 0x80 )
+		{
+			byte( ( v & 0x7f ) | 0x80 );
+			v >>= 7;
+		}
+		byte( v );
+	}
+
+	void integer( int& v, int ref )
+	{
+		varint( relay_zigzag( static_cast< unsigned int >( v ) - static_cast< unsigned int >( ref ) ) );
+	}
+
+	void uinteger( unsigned int& v, unsigned int ref )
+	{
+		varint( relay_zigzag( v - ref ) );
+	}
+
+	void count( int& v, int ref, int max )
+	{
+		if ( v < 0 || v > max )  // receivers would reject the frame
+			d_ok = false;
+
+		integer( v, ref );
+	}
+
+	void real( double& v, double ref, int dec )
+	{
+		int q = relay_fixed( v, dec );
+		if ( static_cast< double >( q ) / s_relay_scale[ dec ] == v && ! ( v == 0.0 && 1.0 / v < 0.0 ) )  // keeps -0.0
+		{
+			unsigned int d = static_cast< unsigned int >( q ) - static_cast< unsigned int >( relay_fixed( ref, dec ) );
+			varint( relay_zigzag( d ) << 1 );
+			return;
+		}
+
+		varint( 1 );  // escape token
+		if ( d_isfloat )
+		{
+			float f = static_cast< float >( v );
+			raw( &f, sizeof( f ) );
+		}
+		else
+		{
+			raw( &v, sizeof( v ) );
+		}
+	}
+
+	void reals( double* v, const double* ref, int n, int dec )
+	{
+		for ( int i = 0; i < n; i++ )
+			real( v[ i ], ref[ i ], dec );
+	}
+
+	void bits( int* v, const int*, int n )
+	{
+		char* p = reserve( ( n + 7 ) / 8 );
+		if ( p == NULL )
+			return;
+
+		for ( int i = 0; i < n; i++ )
+		{
+			if ( v[ i ] )
+				p[ i >> 3 ] |= static_cast< char >( 1 << ( i & 7 ) );
+		}
+	}
+
+private:
+
+	char* d_begin;
+	char* d_p;
+	char* d_end;
+	bool d_isfloat;
+	bool d_ok;
+};
+
+
+/*
+ * Reading a binary frame.
+ */
+class RelayReader
+{
+public:
+
+	RelayReader( const char* data, int len )
+		: d_p( data ), d_end( data + len ), d_isfloat( false ), d_ok( true )
+	{}
+
+	void setFloat( bool isFloat )  { d_isfloat = isFloat; }
+	bool isOk() const  { return d_ok; }
+
+	const char* reserve( int n )
+	{
+		if ( n < 0 || n > d_end - d_p )
+		{
+			d_ok = false;
+			return NULL;
+		}
+
+		const char* p = d_p;
+		d_p += n;
+		return p;
+	}
+
+	void raw( void* data, int n )
+	{
+		const char* p = reserve( n );
+		if ( p != NULL )
+			memcpy( data, p, n );
+		else
+			memset( data, 0, n );
+	}
+
+	unsigned int byte()
+	{
+		const char* p = reserve( 1 );
+		return ( p != NULL ) ? static_cast< unsigned char >( *p ) : 0;
+	}
+
+	unsigned int varint()
+	{
+		unsigned int v = 0;
+		for ( int shift = 0; shift < 35; shift += 7 )
+		{
+			unsigned int b = byte();
+			v |= ( b & 0x7f ) << shift;
+			if ( ! ( b & 0x80 ) )
+				return v;
+		}
+
+		d_ok = false;
+		return 0;
+	}
+
+	void integer( int& v, int ref )
+	{
+		v = static_cast< int >( static_cast< unsigned int >( ref ) + relay_unzigzag( varint() ) );
+	}
+
+	void uinteger( unsigned int& v, unsigned int ref )
+	{
+		v = ref + relay_unzigzag( varint() );
+	}
+
+	void count( int& v, int ref, int max )
+	{
+		integer( v, ref );
+		if ( v < 0 || v > max )
+		{
+			v = 0;
+			d_ok = false;
+		}
+	}
+
+	// number of entries, each needing at least 'minBits' bits of the remaining data (also if untracked)
+	void count( int& v, int ref, int max, int minBits )
+	{
+		count( v, ref, max );
+		if ( ( v * minBits + 7 ) / 8 > d_end - d_p )
+		{
+			v = 0;
+			d_ok = false;
+		}
+	}
+
+	void real( double& v, double ref, int dec )
+	{
+		unsigned int t = varint();
+		if ( t & 1 )  // escape token
+		{
+			if ( t != 1 )
+				d_ok = false;
+
+			if ( d_isfloat )
+			{
+				float f;
+				raw( &f, sizeof( f ) );
+				v = f;
+			}
+			else
+			{
+				raw( &v, sizeof( v ) );
+			}
+			return;
+		}
+
+		unsigned int q = static_cast< unsigned int >( relay_fixed( ref, dec ) ) + relay_unzigzag( t >> 1 );
+		v = static_cast< double >( static_cast< int >( q ) ) / s_relay_scale[ dec ];
+	}
+
+	void reals( double* v, const double* ref, int n, int dec )
+	{
+		for ( int i = 0; i < n; i++ )
+			real( v[ i ], ref[ i ], dec );
+	}
+
+	void bits( int* v, const int*, int n )
+	{
+		const char* p = reserve( ( n + 7 ) / 8 );
+		for ( int i = 0; i < n; i++ )
+			v[ i ] = ( p != NULL ) ? ( ( p[ i >> 3 ] >> ( i & 7 ) ) & 1 ) : 0;
+	}
+
+private:
+
+	const char* d_p;
+	const char* d_end;
+	bool d_isfloat;
+	bool d_ok;
+};
+
+
+/*
+ * Comparing an entry with a reference, using the same fields as writing and reading.
+ */
+class RelayCompare
+{
+public:
+
+	RelayCompare() : d_equal( true )  {}
+
+	bool isEqual() const  { return d_equal; }
+
+	void integer( int& v, int ref )
+	{
+		if ( v != ref )
+			d_equal = false;
+	}
+
+	void count( int& v, int ref, int )
+	{
+		integer( v, ref );
+	}
+
+	void real( double& v, double ref, int )
+	{
+		if ( memcmp( &v, &ref, sizeof( v ) ) != 0 )
+			d_equal = false;
+	}
+
+	void reals( double* v, const double* ref, int n, int dec )
+	{
+		for ( int i = 0; i < n; i++ )
+			real( v[ i ], ref[ i ], dec );
+	}
+
+	void bits( int* v, const int* ref, int n )
+	{
+		for ( int i = 0; i < n; i++ )
+		{
+			if ( v[ i ] != ref[ i ] )
+				d_equal = false;
+		}
+	}
+
+private:
+
+	bool d_equal;
+};
+
+
+/*
+ * Untracked entries, also used as reference for entries without previous data.
+ */
+template< class T >
+void relay_untracked( T& e, int id )
+{
+	memset( &e, 0, sizeof( T ) );
+	e.id = id;
+	e.quality = -1.0;
+}
+
+void relay_untracked( DTrackInertial& e, int id )
+{
+	memset( &e, 0, sizeof( e ) );
+	e.id = id;
+}
+
+void relay_untracked( DTrackMarker& e, int id )
+{
+	memset( &e, 0, sizeof( e ) );
+	e.id = id;
+}
+
+void relay_untracked( DTrackCameraStatus& e, int id )
+{
+	memset( &e, 0, sizeof( e ) );
+	e.idCamera = id;
+}
+
+
+/*
+ * Fields of all types of tracking data, for writing, reading and comparing.
+ */
+template< class C >
+void relay_pose( C& c, double* loc, double* rot, const double* refLoc, const double* refRot )
+{
+	c.reals( loc, refLoc, 3, RELAY_DEC_LOC );
+	c.reals( rot, refRot, 9, RELAY_DEC_ROT );
+}
+
+int relay_hascov( const DTrackBody& e )
+{
+	for ( int i = 0; i < 3; i++ )
+	{
+		if ( e.covref[ i ] != 0.0 )
+			return 1;
+	}
+
+	for ( int i = 0; i < 21; i++ )
+	{
+		if ( e.covreduced[ i ] != 0.0 )
+			return 1;
+	}
+
+	return 0;
+}
+
+template< class C >
+void relay_code( C& c, DTrackBody& e, const DTrackBody& ref )
+{
+	c.integer( e.id, ref.id );
+	c.real( e.quality, ref.quality, RELAY_DEC_QUALITY );
+	relay_pose( c, e.loc, e.rot, ref.loc, ref.rot );
+
+	int hascov = relay_hascov( e );  // covariance just if available
+	c.integer( hascov, relay_hascov( ref ) );
+	if ( hascov )
+	{
+		c.reals( e.covref, ref.covref, 3, RELAY_DEC_LOC );
+		c.reals( e.covreduced, ref.covreduced, 21, RELAY_DEC_COV );  // symmetric, just upper triangle
+	}
+}
+
+template< class C >
+void relay_code( C& c, DTrackFlyStick& e, const DTrackFlyStick& ref )
+{
+	c.integer( e.id, ref.id );
+	c.real( e.quality, ref.quality, RELAY_DEC_QUALITY );
+	c.count( e.num_button, ref.num_button, DTRACKSDK_FLYSTICK_MAX_BUTTON );
+	c.bits( e.button, ref.button, e.num_button );
+	c.count( e.num_joystick, ref.num_joystick, DTRACKSDK_FLYSTICK_MAX_JOYSTICK );
+	c.reals( e.joystick, ref.joystick, e.num_joystick, RELAY_DEC_MISC );
+	relay_pose( c, e.loc, e.rot, ref.loc, ref.rot );
+}
+
+template< class C >
+void relay_code( C& c, DTrackMeaTool& e, const DTrackMeaTool& ref )
+{
+	c.integer( e.id, ref.id );
+	c.real( e.quality, ref.quality, RELAY_DEC_QUALITY );
+	c.count( e.num_button, ref.num_button, DTRACKSDK_MEATOOL_MAX_BUTTON );
+	c.bits( e.button, ref.button, e.num_button );
+	relay_pose( c, e.loc, e.rot, ref.loc, ref.rot );
+	c.real( e.tipradius, ref.tipradius, RELAY_DEC_LOC );
+	c.reals( e.covreduced, ref.covreduced, 6, RELAY_DEC_COV );
+}
+
+template< class C >
+void relay_code( C& c, DTrackMeaRef& e, const DTrackMeaRef& ref )
+{
+	c.integer( e.id, ref.id );
+	c.real( e.quality, ref.quality, RELAY_DEC_QUALITY );
+	relay_pose( c, e.loc, e.rot, ref.loc, ref.rot );
+}
+
+template< class C >
+void relay_code( C& c, DTrackHand& e, const DTrackHand& ref )
+{
+	c.integer( e.id, ref.id );
+	c.real( e.quality, ref.quality, RELAY_DEC_QUALITY );
+	c.integer( e.lr, ref.lr );
+	c.count( e.nfinger, ref.nfinger, DTRACKSDK_HAND_MAX_FINGER );
+	relay_pose( c, e.loc, e.rot, ref.loc, ref.rot );
+
+	for ( int i = 0; i < e.nfinger; i++ )
+	{
+		DTrackHand::DTrackFinger& f = e.finger[ i ];
+		const DTrackHand::DTrackFinger& rf = ref.finger[ i ];
+
+		relay_pose( c, f.loc, f.rot, rf.loc, rf.rot );
+		c.real( f.radiustip, rf.radiustip, RELAY_DEC_LOC );
+		c.reals( f.lengthphalanx, rf.lengthphalanx, 3, RELAY_DEC_LOC );
+		c.reals( f.anglephalanx, rf.anglephalanx, 2, RELAY_DEC_MISC );
+	}
+}
+
+template< class C >
+void relay_code( C& c, DTrackJoint& e, const DTrackJoint& ref )
+{
+	c.integer( e.id, ref.id );
+	c.real( e.quality, ref.quality, RELAY_DEC_QUALITY );
+	relay_pose( c, e.loc, e.rot, ref.loc, ref.rot );
+	c.reals( e.ang, ref.ang, 3, RELAY_DEC_MISC );
+}
+
+template< class C >
+void relay_code( C& c, DTrackInertial& e, const DTrackInertial& ref )
+{
+	c.integer( e.id, ref.id );
+	c.integer( e.st, ref.st );
+	c.real( e.error, ref.error, RELAY_DEC_MISC );
+	relay_pose( c, e.loc, e.rot, ref.loc, ref.rot );
+}
+
+template< class C >
+void relay_code( C& c, DTrackMarker& e, const DTrackMarker& ref )  // without id
+{
+	c.real( e.quality, ref.quality, RELAY_DEC_QUALITY );
+	c.reals( e.loc, ref.loc, 3, RELAY_DEC_LOC );
+}
+
+template< class C >
+void relay_code( C& c, DTrackCameraStatus& e, const DTrackCameraStatus& ref )
+{
+	c.integer( e.idCamera, ref.idCamera );
+	c.integer( e.numReflections, ref.numReflections );
+	c.integer( e.numReflectionsUsed, ref.numReflectionsUsed );
+	c.integer( e.maxIntensity, ref.maxIntensity );
+}
+
+template< class C >
+void relay_code( C& c, DTrackStatus& e, const DTrackStatus& ref )  // without camera status
+{
+	c.integer( e.numCameras, ref.numCameras );
+	c.integer( e.numTrackedBodies, ref.numTrackedBodies );
+	c.integer( e.numTrackedMarkers, ref.numTrackedMarkers );
+	c.integer( e.numCameraErrorMessages, ref.numCameraErrorMessages );
+	c.integer( e.numCameraWarningMessages, ref.numCameraWarningMessages );
+	c.integer( e.numOtherErrorMessages, ref.numOtherErrorMessages );
+	c.integer( e.numOtherWarningMessages, ref.numOtherWarningMessages );
+	c.integer( e.numInfoMessages, ref.numInfoMessages );
+}
+
+void relay_clear( DTrackStatus& s )
+{
+	s.numCameras = s.numTrackedBodies = s.numTrackedMarkers = 0;
+	s.numCameraErrorMessages = s.numCameraWarningMessages = 0;
+	s.numOtherErrorMessages = s.numOtherWarningMessages = s.numInfoMessages = 0;
+	s.cameraStatus.clear();
+}
+
+
+/*
+ * Write list of entries (bodies, Flysticks, ...).
+ */
+template< class T >
+void relay_write_list( RelayWriter& w, int tag, int maxNum, int num, const T* ( DTrackParser::*get )( int ) const,
+                       const DTrackParser& parser, const DTrackParser* ref, int numRef )
+{
+	if ( num <= 0 )
+		return;
+
+	w.byte( tag );
+	w.count( num, 0, maxNum );
+	char* bitmap = w.reserve( ( num + 7 ) / 8 );
+	if ( bitmap == NULL )
+		return;
+
+	for ( int i = 0; i < num; i++ )
+	{
+		T e = *( parser.*get )( i );
+		T untracked;
+		relay_untracked( untracked, i );
+
+		RelayCompare cmp;
+		relay_code( cmp, e, untracked );
+		if ( cmp.isEqual() )  // just the bit
+			continue;
+
+		bitmap[ i >> 3 ] |= static_cast< char >( 1 << ( i & 7 ) );
+		if ( i < numRef )
+			relay_code( w, e, *( ref->*get )( i ) );
+		else
+			relay_code( w, e, untracked );
+	}
+}
+
+
+/*
+ * Read list of entries (bodies, Flysticks, ...).
+ */
+template< class T >
+bool relay_read_list( RelayReader& r, int maxNum, std::vector< T >& entries, int& num, bool isKey )
+{
+	int n = 0;
+	r.count( n, 0, maxNum, 1 );  // untracked entries just need their bit
+	const char* bitmap = r.reserve( ( n + 7 ) / 8 );
+	if ( ! r.isOk() )
+		return false;
+
+	int numRef = isKey ? 0 : num;
+	if ( static_cast< int >( entries.size() ) < n )
+		entries.resize( n );
+
+	for ( int i = 0; i < n; i++ )
+	{
+		T e;
+		relay_untracked( e, i );
+
+		if ( bitmap[ i >> 3 ] & ( 1 << ( i & 7 ) ) )
+		{
+			if ( i < numRef )
+			{
+				T ref = entries[ i ];
+				relay_code( r, e, ref );
+			}
+			else
+			{
+				T ref = e;
+				relay_code( r, e, ref );
+			}
+		}
+
+		entries[ i ] = e;
+	}
+
+	num = n;
+	return r.isOk();
+}
+
+}  // namespace
+
+
+// -----------------------------------------------------------------------------------------------------
+
+/*
+ * Constructor.
+ */
+DTrackRelayDecoder::DTrackRelayDecoder()
+	: d_issync( false ), d_hasseq( false ), d_seq( 0 ), d_numlost( 0 )
+{
+	//
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackRelayDecoder::~DTrackRelayDecoder()
+{
+	//
+}
+
+
+/*
+ * Forget previous frame.
+ */
+void DTrackRelayDecoder::reset()
+{
+	d_issync = false;
+	d_hasseq = false;
+}
+
+
+/*
+ * Returns if delta-encoded frames can be decoded.
+ */
+bool DTrackRelayDecoder::isSynchronized() const
+{
+	return d_issync;
+}
+
+
+/*
+ * Get number of frames lost so far.
+ */
+unsigned int DTrackRelayDecoder::getNumLost() const
+{
+	return d_numlost;
+}
+
+
+/*
+ * Decode one binary frame.
+ */
+bool DTrackRelayDecoder::decode( const char* data, int len, double arrivalTime )
+{
+	double parseStartTime = time_monotonic();
+
+	if ( data == NULL || len < 6 || memcmp( data, s_relay_magic, 3 ) != 0 || data[ 3 ] != RELAY_VERSION )
+		return false;
+
+	bool isKey = ( data[ 4 ] & RELAY_FLAG_KEY ) != 0;
+
+	RelayReader r( data + 5, len - 5 );
+	unsigned int seq = r.varint();
+	if ( ! r.isOk() )
+		return false;
+
+	unsigned int gap = 0;
+	if ( d_hasseq )
+	{
+		gap = seq - d_seq - 1;
+		if ( gap >= 0x80000000u )  // older or duplicate frame
+		{
+			if ( ! isKey )
+				return false;
+
+			gap = 0;  // sender was restarted
+		}
+	}
+
+	d_hasseq = true;
+	d_seq = seq;
+	d_numlost += gap;
+	if ( gap > 0 )
+		d_issync = false;
+
+	if ( ! isKey && ! d_issync )  // reference is missing
+	{
+		d_numlost++;
+		return false;
+	}
+
+	d_issync = decodeFrame( data, len, isKey );
+	if ( ! d_issync )
+	{	// tracking data is incomplete
+		act_num_body = act_num_flystick = act_num_meatool = act_num_mearef = act_num_hand = 0;
+		act_num_human = act_num_inertial = act_num_marker = 0;
+		act_is_status_available = false;
+		act_events.clear();
+		return false;
+	}
+
+	act_events.clear();
+	if ( loc_events_enabled )
+		detectEvents();
+
+	setFrameTimes( arrivalTime, parseStartTime, time_monotonic() );
+	return true;
+}
+
+
+/*
+ * Decode one binary frame, after checking the header.
+ */
+bool DTrackRelayDecoder::decodeFrame( const char* data, int len, bool isKey )
+{
+	int flags = data[ 4 ];
+
+	RelayReader r( data + 5, len - 5 );
+	r.varint();  // sequence number
+
+	if ( isKey )
+	{
+		act_framecounter = 0;
+		act_timestamp = 0.0;
+		act_timestamp_sec = act_timestamp_usec = act_latency_usec = 0;
+	}
+
+	r.uinteger( act_framecounter, act_framecounter );
+	r.uinteger( act_timestamp_sec, act_timestamp_sec );
+	r.uinteger( act_timestamp_usec, act_timestamp_usec );
+	r.uinteger( act_latency_usec, act_latency_usec );
+
+	if ( flags & RELAY_FLAG_TS2 )
+		act_timestamp = static_cast< double >( act_timestamp_sec % ( 24 * 3600 ) ) + static_cast< double >( act_timestamp_usec ) / 1000000.0;
+	else
+		r.real( act_timestamp, act_timestamp, RELAY_DEC_TIME );
+
+	r.setFloat( ( flags & RELAY_FLAG_FLOAT ) != 0 );
+
+	bool hasBody = false, hasFlyStick = false, hasMeaTool = false, hasMeaRef = false, hasHand = false;
+	bool hasHuman = false, hasInertial = false, hasMarker = false, hasStatus = false;
+
+	int tag = r.byte();
+	while ( r.isOk() && tag != RELAY_END )
+	{
+		switch ( tag )
+		{
+			case RELAY_BODY:
+				hasBody = relay_read_list( r, RELAY_MAXNUM_BODY, act_body, act_num_body, isKey );
+				break;
+
+			case RELAY_FLYSTICK:
+				hasFlyStick = relay_read_list( r, RELAY_MAXNUM_FLYSTICK, act_flystick, act_num_flystick, isKey );
+				break;
+
+			case RELAY_MEATOOL:
+				hasMeaTool = relay_read_list( r, RELAY_MAXNUM_MEATOOL, act_meatool, act_num_meatool, isKey );
+				break;
+
+			case RELAY_MEAREF:
+				hasMeaRef = relay_read_list( r, RELAY_MAXNUM_MEAREF, act_mearef, act_num_mearef, isKey );
+				break;
+
+			case RELAY_HAND:
+				hasHand = relay_read_list( r, RELAY_MAXNUM_HAND, act_hand, act_num_hand, isKey );
+				break;
+
+			case RELAY_INERTIAL:
+				hasInertial = relay_read_list( r, RELAY_MAXNUM_INERTIAL, act_inertial, act_num_inertial, isKey );
+				break;
+
+			case RELAY_HUMAN:
+			{
+				int n = 0;
+				r.count( n, 0, RELAY_MAXNUM_HUMAN, 8 );  // at least the number of joints
+				if ( ! r.isOk() )
+					return false;
+
+				int numRef = isKey ? 0 : act_num_human;
+				d_jointindex.resize( n );
+				d_numjoints.resize( n );
+				d_joint.clear();  // keeps allocated memory
+
+				for ( int i = 0; i < n; i++ )
+				{
+					int numJoints = 0;
+					int numRefJoints = ( i < numRef ) ? act_human_num_joints[ i ] : 0;
+					r.count( numJoints, numRefJoints, DTRACKSDK_HUMAN_MAX_JOINTS, 8 );  // at least one byte per joint
+					if ( ! r.isOk() )
+						return false;
+
+					int ind = static_cast< int >( d_joint.size() );
+					d_joint.resize( ind + numJoints );
+					d_jointindex[ i ] = ind;
+					d_numjoints[ i ] = numJoints;
+
+					for ( int j = 0; j < numJoints; j++ )
+					{
+						DTrackJoint& e = d_joint[ ind + j ];
+						relay_untracked( e, j );
+
+						if ( j < numRefJoints )
+						{
+							relay_code( r, e, act_joint[ act_human_joint_index[ i ] + j ] );
+						}
+						else
+						{
+							DTrackJoint ref = e;
+							relay_code( r, e, ref );
+						}
+					}
+				}
+
+				act_joint.swap( d_joint );
+				act_human_joint_index.swap( d_jointindex );
+				act_human_num_joints.swap( d_numjoints );
+				act_num_human = n;
+				loc_human_built = false;
+				hasHuman = r.isOk();
+				break;
+			}
+
+			case RELAY_MARKER:
+			{
+				int n = 0;
+				r.count( n, 0, RELAY_MAXNUM_MARKER, 8 );  // at least the ID
+				if ( ! r.isOk() )
+					return false;
+
+				int numRef = isKey ? 0 : act_num_marker;
+				d_marker.resize( n );
+
+				int id = 0, k = 0;
+				for ( int i = 0; i < n; i++ )
+				{
+					r.integer( id, id );  // difference to id of previous marker
+
+					while ( k < numRef && act_marker[ k ].id < id )  // previous data of same marker
+						k++;
+
+					DTrackMarker& e = d_marker[ i ];
+					relay_untracked( e, id );
+
+					if ( k < numRef && act_marker[ k ].id == id )
+					{
+						relay_code( r, e, act_marker[ k ] );
+					}
+					else
+					{
+						DTrackMarker ref = e;
+						relay_code( r, e, ref );
+					}
+				}
+
+				act_marker.swap( d_marker );
+				act_num_marker = n;
+				updateMarkerIndex();
+				hasMarker = r.isOk();
+				break;
+			}
+
+			case RELAY_STATUS:
+			{
+				if ( isKey || ! act_is_status_available )
+					relay_clear( act_status );
+
+				relay_code( r, act_status, act_status );
+
+				int n = 0;
+				int numRef = static_cast< int >( act_status.cameraStatus.size() );
+				r.count( n, numRef, RELAY_MAXNUM_CAMERA, 8 );  // at least one byte per camera
+				if ( ! r.isOk() )
+					return false;
+
+				act_status.cameraStatus.resize( n );
+				for ( int i = 0; i < n; i++ )
+				{
+					DTrackCameraStatus& e = act_status.cameraStatus[ i ];
+					if ( i >= numRef )
+						relay_untracked( e, i );
+
+					relay_code( r, e, e );
+				}
+
+				act_is_status_available = r.isOk();
+				hasStatus = act_is_status_available;
+				break;
+			}
+
+			default:  // unknown section
+				return false;
+		}
+
+		tag = r.byte();
+	}
+
+	if ( ! r.isOk() )
+		return false;
+
+	// types of tracking data not in this frame:
+	if ( ! hasBody )  act_num_body = 0;
+	if ( ! hasFlyStick )  act_num_flystick = 0;
+	if ( ! hasMeaTool )  act_num_meatool = 0;
+	if ( ! hasMeaRef )  act_num_mearef = 0;
+	if ( ! hasHand )  act_num_hand = 0;
+	if ( ! hasHuman )  act_num_human = 0;
+	if ( ! hasInertial )  act_num_inertial = 0;
+	if ( ! hasMarker )  act_num_marker = 0;
+	if ( ! hasStatus )  act_is_status_available = false;
+
+	updateHuman();
+	return true;
+}
+
+
+// -----------------------------------------------------------------------------------------------------
+
+/*
+ * Constructor.
+ */
+DTrackRelayReceiver::DTrackRelayReceiver( unsigned short port, const std::string& multicastGroup )
+{
+	unsigned int multicastIp = 0;
+	if ( ! multicastGroup.empty() )
+		multicastIp = ip_name2ip( multicastGroup.c_str() );
+
+	d_udp = NULL;
+	if ( multicastGroup.empty() || multicastIp != 0 )
+		d_udp = new UDP( port, multicastIp );
+
+	d_buffer.resize( DTrackRelay::MAX_PACKET_SIZE );
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackRelayReceiver::~DTrackRelayReceiver()
+{
+	delete d_udp;
+}
+
+
+/*
+ * Returns if UDP socket is open to receive binary frames.
+ */
+bool DTrackRelayReceiver::isValid()
+{
+	return ( d_udp != NULL ) && d_udp->isValid();
+}
+
+
+/*
+ * Get port number, where binary frames are received.
+ */
+unsigned short DTrackRelayReceiver::getPort()
+{
+	if ( ! isValid() )
+		return 0;
+
+	return d_udp->getPort();
+}
+
+
+/*
+ * Receive and decode next binary frame.
+ */
+bool DTrackRelayReceiver::receive( int timeoutUs )
+{
+	if ( ! isValid() )
+		return false;
+
+	double arrivalTime = 0.0;
+	int len = d_udp->receive( &d_buffer[ 0 ], static_cast< int >( d_buffer.size() ), timeoutUs, &arrivalTime );
+	if ( len < 0 )
+		return false;
+
+	return decode( &d_buffer[ 0 ], len, arrivalTime );
+}
+
+
+// -----------------------------------------------------------------------------------------------------
+
+/*
+ * Constructor.
+ */
+DTrackRelay::DTrackRelay()
+	: d_precision( PRECISION_DOUBLE ), d_keyinterval( DEFAULT_KEYFRAME_INTERVAL ), d_numsincekey( -1 ), d_seq( 0 )
+{
+	d_udp = new UDP( 0 );
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackRelay::~DTrackRelay()
+{
+	delete d_udp;
+}
+
+
+/*
+ * Returns if UDP socket is open to send frames.
+ */
+bool DTrackRelay::isValid()
+{
+	return d_udp->isValid();
+}
+
+
+/*
+ * Add a subscriber.
+ */
+bool DTrackRelay::addSubscriber( const std::string& host, unsigned short port )
+{
+	unsigned int ip = ip_name2ip( host.c_str() );
+	if ( ip == 0 || port == 0 )
+		return false;
+
+	d_ip.push_back( ip );
+	d_port.push_back( port );
+	requestKeyFrame();  // new subscriber needs a key frame
+	return true;
+}
+
+
+/*
+ * Remove all subscribers.
+ */
+void DTrackRelay::removeSubscribers()
+{
+	d_ip.clear();
+	d_port.clear();
+}
+
+
+/*
+ * Get number of subscribers.
+ */
+int DTrackRelay::getNumSubscribers() const
+{
+	return static_cast< int >( d_ip.size() );
+}
+
+
+/*
+ * Set time-to-live of multicast packets.
+ */
+bool DTrackRelay::setMulticastTTL( int ttl )
+{
+	return d_udp->setMulticastTTL( ttl );
+}
+
+
+/*
+ * Set precision of values, that aren't sent as fixed-point numbers.
+ */
+void DTrackRelay::setPrecision( Precision precision )
+{
+	d_precision = precision;
+}
+
+
+/*
+ * Set interval of key frames.
+ */
+void DTrackRelay::setKeyFrameInterval( int numFrames )
+{
+	d_keyinterval = ( numFrames < 1 ) ? 1 : numFrames;
+}
+
+
+/*
+ * Encode next frame as key frame.
+ */
+void DTrackRelay::requestKeyFrame()
+{
+	d_numsincekey = -1;
+}
+
+
+/*
+ * Encode tracking data of actual frame.
+ */
+int DTrackRelay::encode( const DTrackParser& parser, char* buffer, int maxLen )
+{
+	if ( buffer == NULL )
+		return -1;
+
+	bool isKey = ( d_numsincekey < 0 ) || ( d_numsincekey >= d_keyinterval - 1 ) || ! d_ref.isSynchronized();
+	const DTrackParser* ref = isKey ? NULL : &d_ref;
+
+	unsigned int sec = parser.getTimeStampSec();
+	unsigned int usec = parser.getTimeStampUsec();
+	bool isTs2 = ( sec != 0 ) &&
+	             ( parser.getTimeStamp() == static_cast< double >( sec % ( 24 * 3600 ) ) + static_cast< double >( usec ) / 1000000.0 );
+
+	int flags = 0;
+	if ( isKey )  flags |= RELAY_FLAG_KEY;
+	if ( d_precision == PRECISION_FLOAT )  flags |= RELAY_FLAG_FLOAT;
+	if ( isTs2 )  flags |= RELAY_FLAG_TS2;
+
+	RelayWriter w( buffer, maxLen );
+	w.raw( s_relay_magic, 3 );
+	w.byte( RELAY_VERSION );
+	w.byte( flags );
+	w.varint( d_seq );
+
+	unsigned int framecounter = parser.getFrameCounter();
+	unsigned int latency = parser.getLatencyUsec();
+	w.uinteger( framecounter, ref ? ref->getFrameCounter() : 0 );
+	w.uinteger( sec, ref ? ref->getTimeStampSec() : 0 );
+	w.uinteger( usec, ref ? ref->getTimeStampUsec() : 0 );
+	w.uinteger( latency, ref ? ref->getLatencyUsec() : 0 );
+	if ( ! isTs2 )
+	{
+		double timestamp = parser.getTimeStamp();
+		w.real( timestamp, ref ? ref->getTimeStamp() : 0.0, RELAY_DEC_TIME );  // always in double precision
+	}
+
+	w.setFloat( d_precision == PRECISION_FLOAT );
+
+	relay_write_list( w, RELAY_BODY, RELAY_MAXNUM_BODY, parser.getNumBody(), &DTrackParser::getBody, parser, ref, ref ? ref->getNumBody() : 0 );
+	relay_write_list( w, RELAY_FLYSTICK, RELAY_MAXNUM_FLYSTICK, parser.getNumFlyStick(), &DTrackParser::getFlyStick, parser, ref, ref ? ref->getNumFlyStick() : 0 );
+	relay_write_list( w, RELAY_MEATOOL, RELAY_MAXNUM_MEATOOL, parser.getNumMeaTool(), &DTrackParser::getMeaTool, parser, ref, ref ? ref->getNumMeaTool() : 0 );
+	relay_write_list( w, RELAY_MEAREF, RELAY_MAXNUM_MEAREF, parser.getNumMeaRef(), &DTrackParser::getMeaRef, parser, ref, ref ? ref->getNumMeaRef() : 0 );
+	relay_write_list( w, RELAY_HAND, RELAY_MAXNUM_HAND, parser.getNumHand(), &DTrackParser::getHand, parser, ref, ref ? ref->getNumHand() : 0 );
+	relay_write_list( w, RELAY_INERTIAL, RELAY_MAXNUM_INERTIAL, parser.getNumInertial(), &DTrackParser::getInertial, parser, ref, ref ? ref->getNumInertial() : 0 );
+
+	int num = parser.getNumHuman();
+	if ( num > 0 )
+	{
+		int numRef = ref ? ref->getNumHuman() : 0;
+
+		w.byte( RELAY_HUMAN );
+		w.count( num, 0, RELAY_MAXNUM_HUMAN );
+		for ( int i = 0; i < num; i++ )
+		{
+			DTrackHumanJoints human = parser.getHumanJoints( i );
+			DTrackHumanJoints refHuman;
+			refHuman.num_joints = 0;
+			if ( i < numRef )
+				refHuman = ref->getHumanJoints( i );
+
+			w.count( human.num_joints, refHuman.num_joints, DTRACKSDK_HUMAN_MAX_JOINTS );
+			for ( int j = 0; j < human.num_joints; j++ )
+			{
+				DTrackJoint e = human.joint[ j ];
+				DTrackJoint refJoint;
+				if ( j < refHuman.num_joints )
+					refJoint = refHuman.joint[ j ];
+				else
+					relay_untracked( refJoint, j );
+
+				relay_code( w, e, refJoint );
+			}
+		}
+	}
+
+	num = parser.getNumMarker();
+	if ( num > 0 )
+	{
+		int numRef = ref ? ref->getNumMarker() : 0;
+
+		w.byte( RELAY_MARKER );
+		w.count( num, 0, RELAY_MAXNUM_MARKER );
+
+		int id = 0, k = 0;
+		for ( int i = 0; i < num; i++ )
+		{
+			DTrackMarker e = *parser.getMarker( i );
+			w.integer( e.id, id );  // difference to id of previous marker
+			id = e.id;
+
+			while ( k < numRef && ref->getMarker( k )->id < id )  // previous data of same marker
+				k++;
+
+			DTrackMarker refMarker;
+			if ( k < numRef && ref->getMarker( k )->id == id )
+				refMarker = *ref->getMarker( k );
+			else
+				relay_untracked( refMarker, id );
+
+			relay_code( w, e, refMarker );
+		}
+	}
+
+	if ( parser.isStatusAvailable() )
+	{
+		DTrackStatus status = *parser.getStatus();
+		DTrackStatus refStatus;
+		if ( ref && ref->isStatusAvailable() )
+			refStatus = *ref->getStatus();
+		else
+			relay_clear( refStatus );
+
+		w.byte( RELAY_STATUS );
+		relay_code( w, status, refStatus );
+
+		num = static_cast< int >( status.cameraStatus.size() );
+		int numRef = static_cast< int >( refStatus.cameraStatus.size() );
+		w.count( num, numRef, RELAY_MAXNUM_CAMERA );
+		for ( int i = 0; i < num; i++ )
+		{
+			DTrackCameraStatus refCamera;
+			if ( i < numRef )
+				refCamera = refStatus.cameraStatus[ i ];
+			else
+				relay_untracked( refCamera, i );
+
+			relay_code( w, status.cameraStatus[ i ], refCamera );
+		}
+	}
+
+	w.byte( RELAY_END );
+	if ( ! w.isOk() )
+		return -1;
+
+	int len = w.getLength();
+	d_seq++;
+
+	if ( ! d_ref.decode( buffer, len ) )  // keeps state of decoders
+	{
+		requestKeyFrame();
+		return -1;
+	}
+
+	d_numsincekey = isKey ? 0 : d_numsincekey + 1;
+	return len;
+}
+
+
+/*
+ * Encode tracking data of actual frame and send it to all subscribers.
+ */
+bool DTrackRelay::send( const DTrackParser& parser )
+{
+	if ( ! d_udp->isValid() )
+		return false;
+
+	if ( d_buffer.empty() )
+		d_buffer.resize( MAX_PACKET_SIZE );
+
+	int len = encode( parser, &d_buffer[ 0 ], MAX_PACKET_SIZE );
+	if ( len < 0 )
+		return false;
+
+	bool ok = true;
+	for ( size_t i = 0; i < d_ip.size(); i++ )
+	{
+		if ( d_udp->send( &d_buffer[ 0 ], len, d_ip[ i ], d_port[ i ], RELAY_SENDTIMEOUT_US ) != 0 )
+			ok = false;
+	}
+
+	return ok;
+}
@@ -28,7 +28,7 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * 
- * Version v2.9.0
+ * Version v2.10.0
  *
  * Purpose:
  *  - receives DTrack UDP packets (ASCII protocol) and converts them into easier to handle data
@@ -41,16 +41,13 @@
 
 #include "DTrackSDK.hpp"
 #include "DTrackParse.hpp"
+#include "DTrackSys.hpp"
 
 #include <cstring>
 #include <cstdlib>
-#include <clocale>
-
-#if ! defined( _MSC_VER )
-	#define strcpy_s( a, b, c )  strcpy( a, c )  // map 'strcpy_s' if not Visual Studio
-#endif
 
 using namespace DTrackNet;
+using namespace DTrackSys;
 using namespace DTrackSDK_Parse;
 
 
@@ -81,11 +78,16 @@ DTrackSDK::DTrackSDK( const std::string& connection )
 			}
 		}
 	}
-	if ( ( args.size() == 0 ) || ( args.size() > 3 ) )  return;  // invalid connection string
+	if ( ( args.size() == 0 ) || ( args.size() > 3 ) )  // invalid connection string
+	{
+		initDefaults( SYS_DTRACK_UNKNOWN );
+		return;
+	}
 
 	std::string host;
 	std::istringstream portstream;
 	bool isFw = false;
+	bool isAsync = false;
 
 	if ( args.size() == 1 )  // argument "<data port>"
 	{
@@ -96,17 +98,31 @@ DTrackSDK::DTrackSDK( const std::string& connection )
 		host = args[ 0 ];
 		portstream.str( args[ 1 ] );
 
-		if ( args.size() == 3 )  // arguments "<ip/host>:<data port>:fw"
+		if ( args.size() == 3 )  // arguments "<ip/host>:<data port>:fw" or "<ip/host>:<data port>:async"
 		{
-			if ( args[ 2 ].compare( "fw" ) != 0 )  return;  // invalid suffix in connection string
-
-			isFw = true;
+			if ( args[ 2 ].compare( "fw" ) == 0 )
+			{
+				isFw = true;
+			}
+			else if ( args[ 2 ].compare( "async" ) == 0 )
+			{
+				isAsync = true;
+			}
+			else  // invalid suffix in connection string
+			{
+				initDefaults( SYS_DTRACK_UNKNOWN );
+				return;
+			}
 		}
 	}
 
 	unsigned short port;
 	portstream >> port;  // data port
-	if ( portstream.fail() || ( ! portstream.eof() ) )  return;  // invalid port number
+	if ( portstream.fail() || ( ! portstream.eof() ) )  // invalid port number
+	{
+		initDefaults( SYS_DTRACK_UNKNOWN );
+		return;
+	}
 
 	if ( host.empty() )
 	{
@@ -124,7 +140,7 @@ DTrackSDK::DTrackSDK( const std::string& connection )
 		}
 		else
 		{
-			init( host, 0, port, SYS_DTRACK_2 );
+			init( host, 0, port, SYS_DTRACK_2, isAsync );
 		}
 	}
 }
@@ -183,19 +199,41 @@ DTrackSDK::DTrackSDK(const std::string& server_host, unsigned short server_port,
 
 
 /*
- * Private init called by constructor.
+ * Private init of default values called by constructor.
  */
-void DTrackSDK::init( const std::string& server_host, unsigned short server_port, unsigned short data_port,
-                      RemoteSystemType remote_type )
+void DTrackSDK::initDefaults( RemoteSystemType remote_type )
 {
-	setlocale( LC_NUMERIC, "C" );
-
 	rsType = remote_type;
 
 	d_udp = NULL;
 	d_tcp = NULL;
 	d_udpbuf = NULL;
 	d_udpbufsize = 0;
+	d_udpbufmaxsize = DEFAULT_UDP_MAXBUFSIZE;
+	d_udpbufgrowsize = 0;
+	d_udpkerneldropped = 0;
+	d_udpdata = NULL;
+	d_udpbatchsize = 0;
+	d_udpbatchbuf = NULL;
+	d_udpbatchlen = NULL;
+	d_udpbatchtime = NULL;
+	d_udpbatchnum = 0;
+	d_framebuf = NULL;
+	d_statistics = NULL;
+	d_recorder = NULL;
+	d_history = NULL;
+	d_publisher = NULL;
+	d_paramcache = NULL;
+	d_msgpoller = NULL;
+	d_connector = NULL;
+
+	d_thread = NULL;
+	d_threadstop = 0;
+	d_threadcallback = NULL;
+	d_threadcallbackdata = NULL;
+	d_threadqueue = NULL;
+	d_threadcpu = -1;
+	d_threadrealtime = false;
 	
 	lastDataError = ERR_NONE;
 	lastServerError = ERR_NONE;
@@ -204,18 +242,41 @@ void DTrackSDK::init( const std::string& server_host, unsigned short server_port
 	setDataTimeoutUS( 0 );
 	setCommandTimeoutUS( 0 );
 	setDataBufferSize( 0 );  // creates also UDP buffer
+	setDataBatchSize( 0 );
 
 	d_remoteIp = 0;
+	d_remoteHost = "";
 	d_remoteDT1Port = 0;
 	d_udpSenderIp = 0;
 	d_udpSenderPort = DTRACK2_PORT_UDPSENDER;
 
+	d_message.origin = "";
+	d_message.status = "";
+	d_message.frameNr = 0;
+	d_message.errorId = 0;
+	d_message.msg = "";
+
 	net_init();
+}
+
+
+/*
+ * Private init called by constructor.
+ */
+void DTrackSDK::init( const std::string& server_host, unsigned short server_port, unsigned short data_port,
+                      RemoteSystemType remote_type, bool isAsync )
+{
+	initDefaults( remote_type );
 
 	// parse remote address if available
 	unsigned int remoteIp = 0;
 	if ( ! server_host.empty() )
-		remoteIp = ip_name2ip( server_host.c_str() );
+	{
+		if ( isAsync )
+			remoteIp = ip_str2ip( server_host.c_str() );  // hostname gets resolved in background
+		else
+			remoteIp = ip_name2ip( server_host.c_str() );
+	}
 
 	bool isMulticast = false;
 	if ( ( remoteIp & 0xf0000000 ) == 0xe0000000 )  // check if multicast IP
@@ -235,8 +296,20 @@ void DTrackSDK::init( const std::string& server_host, unsigned short server_port
 	if ( ! d_udp->isValid() )
 		return;
 
+	if ( isAsync && ( ! server_host.empty() ) && ( ! isMulticast ) )  // TCP connection in background
+	{
+		d_remoteHost = server_host;
+		d_remoteIp = remoteIp;
+		d_udpSenderIp = remoteIp;
+
+		enableAutoReconnect();
+		sendStatefulFirewallPacket();  // try enabling UDP connection at once, if IP is known
+		return;
+	}
+
 	if ( ( remoteIp != 0 ) && ( ! isMulticast ) )  // IP of Controller/DTrack1 PC is known
 	{
+		d_remoteHost = server_host;
 		d_remoteIp = remoteIp;
 		d_udpSenderIp = remoteIp;
 
@@ -264,12 +337,6 @@ void DTrackSDK::init( const std::string& server_host, unsigned short server_port
 			sendStatefulFirewallPacket();  // try enabling UDP connection at once
 		}
 	}
-
-	d_message_origin = "";
-	d_message_status = "";
-	d_message_framenr = 0;
-	d_message_errorid = 0;
-	d_message_msg = "";
 }
 
 
@@ -278,8 +345,22 @@ void DTrackSDK::init( const std::string& server_host, unsigned short server_port
  */
 DTrackSDK::~DTrackSDK()
 {
+	stopReceiving();
+	stopMessagePoller();
+	delete d_connector;
+	delete d_threadqueue;
+
 	// release buffer
 	free(d_udpbuf);
+	free( d_udpbatchbuf );
+	free( d_udpbatchlen );
+	free( d_udpbatchtime );
+	delete d_framebuf;
+	delete d_statistics;
+	delete d_recorder;
+	delete d_history;
+	delete d_publisher;
+	delete d_paramcache;
 	
 	// release sockets & net
 	delete d_udp;
@@ -329,7 +410,8 @@ unsigned short DTrackSDK::getDataPort() const
  */
 bool DTrackSDK::isCommandInterfaceValid() const
 {
-	if ( d_tcp == NULL )  return false;
+	if ( d_tcp == NULL )  // connection established in background is taken by next command
+		return ( d_connector != NULL ) && d_connector->isConnected();
 
 	return d_tcp->isValid();
 }
@@ -350,6 +432,84 @@ bool DTrackSDK::isCommandInterfaceFullAccess()
 }
 
 
+/*
+ * Enable or disable establishing the TCP connection in background.
+ */
+bool DTrackSDK::enableAutoReconnect( bool enable )
+{
+	if ( ! enable )
+	{
+		delete d_connector;
+		d_connector = NULL;
+		return true;
+	}
+
+	if ( d_connector != NULL )  // already enabled
+		return true;
+
+	if ( ( rsType != SYS_DTRACK_2 ) || d_remoteHost.empty() )
+		return false;
+
+	bool isConnected = isCommandInterfaceValid();
+	if ( ! isConnected )
+	{
+		delete d_tcp;
+		d_tcp = NULL;
+		d_tcpbuf.clear();
+	}
+
+	d_connector = new DTrackConnector( d_remoteHost, DTRACK2_PORT_COMMAND, CONNECT_TIMEOUT, RECONNECT_MIN_BACKOFF,
+	                                   RECONNECT_MAX_BACKOFF );
+	if ( ! d_connector->start( isConnected ) )
+	{
+		delete d_connector;
+		d_connector = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+
+/*
+ * Returns if TCP connection is being established in background.
+ */
+bool DTrackSDK::isCommandInterfaceConnecting() const
+{
+	if ( ( d_connector == NULL ) || ( d_tcp != NULL ) )  return false;
+
+	return d_connector->isConnecting();
+}
+
+
+/*
+ * Take TCP connection established in background, if available.
+ */
+void DTrackSDK::updateCommandInterface()
+{
+	if ( ( d_connector == NULL ) || ( d_tcp != NULL ) )
+		return;
+
+	DTrackNet::TCP* tcp = d_connector->takeConnection();
+	if ( tcp == NULL )
+		return;
+
+	d_tcp = tcp;
+	d_tcpbuf.clear();
+
+	unsigned int ip = d_connector->getRemoteIp();
+	if ( ( d_udpSenderIp == 0 ) || ( d_udpSenderIp == d_remoteIp ) )  // keep address set by enableStatefulFirewallConnection()
+		d_udpSenderIp = ip;
+
+	d_remoteIp = ip;
+
+	if ( d_paramcache != NULL )  // parameters might have been changed meanwhile
+		d_paramcache->clear();
+
+	sendStatefulFirewallPacket();
+}
+
+
 /*
  * Get current remote system type (e.g. DTrack1, DTrack2/DTRACK3).
  */
@@ -414,11 +574,113 @@ bool DTrackSDK::setDataBufferSize( int bufSize )
 
 		d_udpbufsize = newBufSize;
 		d_udpbuf = (char *)malloc( d_udpbufsize );
+		d_udpdata = d_udpbuf;
+
+		free( d_udpbatchbuf );  // slots will be created again by next receiveAll()
+		d_udpbatchbuf = NULL;
+		d_udpbatchnum = 0;
 	}
 	return ( d_udpbuf != NULL );
 }
 
 
+/*
+ * Get UDP buffer size for receiving tracking data.
+ */
+int DTrackSDK::getDataBufferSize() const
+{
+	return d_udpbufsize;
+}
+
+
+/*
+ * Enable or disable automatic growth of the UDP buffer.
+ */
+bool DTrackSDK::enableDataBufferGrowth( bool enable, int maxBufSize )
+{
+	d_udpbufgrowsize = 0;
+
+	if ( ! enable )
+	{
+		d_udpbufmaxsize = 0;
+		return true;
+	}
+
+	if ( maxBufSize < 0 )
+		return false;
+
+	d_udpbufmaxsize = ( maxBufSize == 0 ) ? DEFAULT_UDP_MAXBUFSIZE : maxBufSize;
+	return true;
+}
+
+
+/*
+ * Set size of the kernel receive buffer of the UDP socket.
+ */
+bool DTrackSDK::setDataSocketBufferSize( int bufSize )
+{
+	if ( ! isDataInterfaceValid() )
+		return false;
+
+	return d_udp->setReceiveBufferSize( bufSize );
+}
+
+
+/*
+ * Get size of the kernel receive buffer of the UDP socket.
+ */
+int DTrackSDK::getDataSocketBufferSize() const
+{
+	if ( ! isDataInterfaceValid() )
+		return -1;
+
+	return d_udp->getReceiveBufferSize();
+}
+
+
+/*
+ * Set busy polling of the UDP socket.
+ */
+bool DTrackSDK::setDataBusyPoll( int us )
+{
+	if ( ! isDataInterfaceValid() )
+		return false;
+
+	return d_udp->setBusyPoll( us );
+}
+
+
+/*
+ * Set maximum number of tracking data packets received at once by receiveAll().
+ */
+bool DTrackSDK::setDataBatchSize( int numPackets )
+{
+	int newBatchSize;
+	if ( numPackets <= 0 )
+	{
+		newBatchSize = DEFAULT_UDP_BATCHSIZE;
+	}
+	else
+	{
+		newBatchSize = numPackets;
+	}
+
+	if ( newBatchSize != d_udpbatchsize )
+	{
+		free( d_udpbatchbuf );  // slots will be created again by next receiveAll()
+		free( d_udpbatchlen );
+		free( d_udpbatchtime );
+
+		d_udpbatchsize = newBatchSize;
+		d_udpbatchbuf = NULL;
+		d_udpbatchlen = ( int* )malloc( d_udpbatchsize * sizeof( int ) );
+		d_udpbatchtime = ( double* )malloc( d_udpbatchsize * sizeof( double ) );
+		d_udpbatchnum = 0;
+	}
+	return ( d_udpbatchlen != NULL ) && ( d_udpbatchtime != NULL );
+}
+
+
 /*
  * Enable UDP connection through a stateful firewall.
  */
@@ -440,7 +702,15 @@ bool DTrackSDK::enableStatefulFirewallConnection( const std::string& senderHost,
  */
 bool DTrackSDK::receive()
 {
-	char* s;
+	return receiveFrame( d_udptimeout_us );
+}
+
+
+/*
+ * Receive and process one tracking data packet, with timeout.
+ */
+bool DTrackSDK::receiveFrame( int timeoutUs )
+{
 	int len;
 	
 	lastDataError = ERR_NONE;
@@ -454,9 +724,19 @@ bool DTrackSDK::receive()
 
 	// defaults:
 	startFrame();
+	growDataBuffer();
 	
 	// receive UDP packet:
-	len = d_udp->receive( d_udpbuf, d_udpbufsize - 1, d_udptimeout_us );
+	double arrivalTime = 0.0;
+	len = d_udp->receive( d_udpbuf, d_udpbufsize - 1, timeoutUs, &arrivalTime );
+	checkDataSocket();
+	if ( d_statistics != NULL )
+	{
+		d_statistics->addDiscarded( d_udp->getNumDiscarded() );
+		if ( len == -4 )
+			d_statistics->addOverflow();
+	}
+
 	if (len == -1) {
 		lastDataError = ERR_TIMEOUT;
 		return false;
@@ -467,140 +747,668 @@ bool DTrackSDK::receive()
 		return false;
 	}
 	
-	s = d_udpbuf;
-	s[len] = '\0';
-	
-	// process lines:
-	lastDataError = ERR_PARSE;
-	
-	do {
-		if (!parseLine(&s))
-			return false;
+	d_udpbuf[ len ] = '\0';
+	d_udpdata = d_udpbuf;
 
-		s = string_nextline( d_udpbuf, s, d_udpbufsize );
-	} while ( s != NULL );
+	return parsePacket( d_udpbuf, len, arrivalTime );
+}
 
-	endFrame();
-	
-	lastDataError = ERR_NONE;
-	return true;
+
+/*
+ * Receive all waiting tracking data packets at once.
+ */
+int DTrackSDK::receiveAll()
+{
+	return receiveBatch( d_udptimeout_us );
 }
 
 
 /*
- * Process one tracking packet manually.
+ * Receive all waiting tracking data packets at once, with timeout.
  */
-bool DTrackSDK::processPacket( const std::string& data )
+int DTrackSDK::receiveBatch( int timeoutUs )
 {
-	char* sBuf;
-	char* s;
-	
 	lastDataError = ERR_NONE;
 	lastServerError = ERR_NONE;
-	
-	// defaults:
-	startFrame();
-	
-	if ( data.length() == 0 )
+	d_udpbatchnum = 0;
+
+	if ( ! isDataInterfaceValid() )
 	{
-		lastDataError = ERR_PARSE;
-		return false;
+		lastDataError = ERR_NET;
+		return 0;
 	}
 
-	sBuf = (char *)malloc( data.length() + 1 );
-	if ( sBuf == NULL )  return false;
+	growDataBuffer();
 
-	strcpy_s( sBuf, data.length() + 1, data.c_str() );
+	if ( d_udpbatchbuf == NULL )  // create slots at first usage
+	{
+		d_udpbatchbuf = ( char* )malloc( ( size_t )d_udpbatchsize * d_udpbufsize );
+		if ( ( d_udpbatchbuf == NULL ) || ( d_udpbatchlen == NULL ) || ( d_udpbatchtime == NULL ) )
+		{
+			lastDataError = ERR_NET;
+			return 0;
+		}
+	}
 
-	s = sBuf;
-	
-	// process lines:
-	lastDataError = ERR_PARSE;
-	
-	do {
-		if (!parseLine(&s))
-			return false;
+	// receive UDP packets:
+	int num = d_udp->receiveBatch( d_udpbatchbuf, d_udpbufsize, d_udpbatchsize, d_udpbatchlen, timeoutUs,
+	                               d_udpbatchtime );
+	checkDataSocket();
+	if ( num == -1 )
+	{
+		lastDataError = ERR_TIMEOUT;
+		return 0;
+	}
 
-		s = string_nextline( sBuf, s, static_cast< int >( data.length() ) );
-	} while( s != NULL );
+	if ( num <= 0 )
+	{
+		lastDataError = ERR_NET;
+		return 0;
+	}
 
-	endFrame();
-	
-	lastDataError = ERR_NONE;
-	return true;
+	if ( d_statistics != NULL )
+	{
+		for ( int i = 0; i < num; i++ )
+		{
+			if ( d_udpbatchlen[ i ] == -4 )
+				d_statistics->addOverflow();
+		}
+	}
+
+	d_udpbatchnum = num;
+	return num;
 }
 
 
 /*
- * Get content of the UDP buffer.
+ * Enlarge UDP buffer, if planned.
  */
-std::string DTrackSDK::getBuf() const
+void DTrackSDK::growDataBuffer()
 {
-	if ( d_udpbuf == NULL )
-		return std::string( "" );
+	if ( d_udpbufgrowsize <= d_udpbufsize )
+		return;
+
+	int oldSize = d_udpbufsize;
+	if ( ! setDataBufferSize( d_udpbufgrowsize ) )
+		setDataBufferSize( oldSize );
 
-	return std::string( d_udpbuf );
+	d_udpbufgrowsize = 0;
 }
 
 
 /*
- * Get last error at receiving tracking data (data transmission).
+ * Check UDP socket after receiving.
  */
-DTrackSDK::Errors DTrackSDK::getLastDataError() const
+void DTrackSDK::checkDataSocket()
 {
-	return lastDataError;
-}
+	unsigned int dropped = d_udp->getNumKernelDropped();
+	if ( d_statistics != NULL )
+		d_statistics->addKernelDropped( static_cast< int >( dropped - d_udpkerneldropped ) );  // counter might wrap around
 
+	d_udpkerneldropped = dropped;
 
-/*
- * Get last error at exchanging commands with Controller (command transmission).
- */
-DTrackSDK::Errors DTrackSDK::getLastServerError() const
-{
-	return lastServerError;
-}
+	int truncated = d_udp->getTruncatedSize();
+	if ( ( truncated <= 0 ) || ( d_udpbufmaxsize <= d_udpbufsize ) )
+		return;
 
+	int size = d_udpbufsize;
+	while ( ( size < d_udpbufmaxsize ) && ( size - 1 <= truncated ) )  // usable length is one byte less than buffer size
+		size = ( size > d_udpbufmaxsize / 2 ) ? d_udpbufmaxsize : 2 * size;
 
-/*
- * Get last DTrack2/DTRACK3 command error code.
- */
-int DTrackSDK::getLastDTrackError() const
-{
-	return lastDTrackError;
+	if ( size > d_udpbufgrowsize )
+		d_udpbufgrowsize = size;
 }
 
 
 /*
- * Get last DTrack2/DTRACK3 command error description.
+ * Process one tracking data packet received by last call of receiveAll().
  */
-std::string DTrackSDK::getLastDTrackErrorDescription() const
+bool DTrackSDK::processFrame( int index )
 {
-	return lastDTrackErrorString;
-}
+	lastDataError = ERR_NONE;
+	lastServerError = ERR_NONE;
 
+	if ( ( index < 0 ) || ( index >= d_udpbatchnum ) )
+	{
+		lastDataError = ERR_PARSE;
+		return false;
+	}
 
-/*
- * Set last DTrack2/DTRACK3 command error.
- */
-void DTrackSDK::setLastDTrackError(int newError, const std::string& newErrorString)
-{
-	lastDTrackError = newError;
-	lastDTrackErrorString = newErrorString;
+	int len = d_udpbatchlen[ index ];
+	if ( len <= 0 )
+	{
+		lastDataError = ERR_NET;
+		return false;
+	}
+
+	// defaults:
+	startFrame();
+
+	char* s = d_udpbatchbuf + ( size_t )index * d_udpbufsize;
+	d_udpdata = s;
+
+	return parsePacket( s, len, d_udpbatchtime[ index ] );
 }
 
 
 /*
- * Start measurement.
+ * Process all lines of one tracking data packet.
  */
-bool DTrackSDK::startMeasurement()
+bool DTrackSDK::parsePacket( const char* data, int len, double arrivalTime )
 {
-	// Check for special DTrack handling
-	if ( rsType == SYS_DTRACK )
-	{
-		if ( ! sendDTrack1Command( "dtrack 10 3" ) )  return false;
+	const char* s = data;
+	double parseStartTime = time_monotonic();
 
-		return sendDTrack1Command( "dtrack 31" );
-	}
+	// process lines:
+	lastDataError = ERR_PARSE;
+
+	if ( d_statistics == NULL )
+	{
+		do {
+			if (!parseLine(&s))
+				return false;
+
+			s = string_nextline( data, s, len );
+		} while ( s != NULL );
+	}
+	else
+	{	// measuring parse time of each line:
+		double t0 = parseStartTime;
+		do {
+			bool ok = parseLine( &s );
+			if ( ok )
+				s = string_nextline( data, s, len );
+
+			double t1 = time_monotonic();
+			d_statistics->addParseTime( static_cast< DTrackStatistics::RecordType >( getLineRecordType() ), t1 - t0 );
+			t0 = t1;
+
+			if ( ! ok )
+			{
+				d_statistics->addParseError();
+				return false;
+			}
+		} while ( s != NULL );
+	}
+
+	endFrame();
+	setFrameTimes( arrivalTime, parseStartTime, time_monotonic() );
+
+	if ( d_statistics != NULL )
+		d_statistics->addFrame( getFrameCounter(), arrivalTime );
+
+	if ( d_recorder != NULL )
+	{
+		const char* end = static_cast< const char* >( memchr( data, '\0', len ) );
+		d_recorder->addPacket( data, ( end != NULL ) ? ( end - data ) : len, getFrameCounter(), arrivalTime );
+	}
+
+	if ( d_history != NULL )
+		d_history->addFrame( *this );
+
+	if ( d_publisher != NULL )
+		d_publisher->publish( *this );
+
+	if ( d_framebuf != NULL )
+		d_framebuf->publish( *this );
+
+	lastDataError = ERR_NONE;
+	return true;
+}
+
+
+/*
+ * Process one tracking packet manually.
+ */
+bool DTrackSDK::processPacket( const std::string& data )
+{
+	return processPacket( data.c_str(), data.length() + 1 );  // including terminating '\0'
+}
+
+
+/*
+ * Process one tracking packet manually, parsing a buffer in place.
+ */
+bool DTrackSDK::processPacket( const char* data, size_t len )
+{
+	lastDataError = ERR_NONE;
+	lastServerError = ERR_NONE;
+
+	// defaults:
+	startFrame();
+
+	if ( ( data == NULL ) || ( len == 0 ) || ( data[ 0 ] == '\0' ) )
+	{
+		lastDataError = ERR_PARSE;
+		return false;
+	}
+
+	char last = data[ len - 1 ];
+	if ( ( last != '\0' ) && ( last != '\r' ) && ( last != '\n' ) )
+	{
+		// unterminated data: parsing might read beyond the buffer, so use a terminated copy
+		if ( ( d_udpbuf == NULL ) || ( len >= ( size_t )d_udpbufsize ) )
+		{
+			lastDataError = ERR_PARSE;
+			return false;
+		}
+
+		memcpy( d_udpbuf, data, len );
+		d_udpbuf[ len ] = '\0';
+		data = d_udpbuf;
+	}
+
+	return parsePacket( data, static_cast< int >( len ), time_monotonic() );  // arrival time is unknown
+}
+
+
+/*
+ * Enable or disable snapshots of tracking data for other threads.
+ */
+bool DTrackSDK::enableFrameSnapshots( bool enable )
+{
+	if ( ! enable )
+	{
+		delete d_framebuf;
+		d_framebuf = NULL;
+		return true;
+	}
+
+	if ( d_framebuf == NULL )
+		d_framebuf = new DTrackFrameBuffer;
+
+	return true;
+}
+
+
+/*
+ * Get snapshot of latest processed frame.
+ */
+const DTrackFrame* DTrackSDK::acquireLatestFrame()
+{
+	if ( d_framebuf == NULL )
+		return NULL;
+
+	return d_framebuf->acquireLatest();
+}
+
+
+/*
+ * Enable or disable statistics about received tracking data.
+ */
+bool DTrackSDK::enableStatistics( bool enable )
+{
+	if ( ! enable )
+	{
+		delete d_statistics;
+		d_statistics = NULL;
+		return true;
+	}
+
+	if ( d_statistics == NULL )
+		d_statistics = new DTrackStatistics;
+
+	return true;
+}
+
+
+/*
+ * Get statistics about received tracking data.
+ */
+DTrackStatistics* DTrackSDK::getStatistics()
+{
+	return d_statistics;
+}
+
+
+/*
+ * Start recording of tracking data into a binary file.
+ */
+bool DTrackSDK::startRecording( const std::string& filename )
+{
+	stopRecording();
+
+	d_recorder = new DTrackRecorder;
+	if ( ! d_recorder->open( filename ) )
+	{
+		delete d_recorder;
+		d_recorder = NULL;
+		return false;
+	}
+	return true;
+}
+
+
+/*
+ * Stop recording of tracking data.
+ */
+bool DTrackSDK::stopRecording()
+{
+	if ( d_recorder == NULL )
+		return false;
+
+	bool ok = d_recorder->close();
+
+	delete d_recorder;
+	d_recorder = NULL;
+	return ok;
+}
+
+
+/*
+ * Returns if tracking data is recorded.
+ */
+bool DTrackSDK::isRecording() const
+{
+	return ( d_recorder != NULL );
+}
+
+
+/*
+ * Enable or disable history of poses.
+ */
+bool DTrackSDK::enableHistory( bool enable, int capacity )
+{
+	delete d_history;
+	d_history = NULL;
+
+	if ( enable )
+		d_history = new DTrackHistory( capacity );
+
+	return true;
+}
+
+
+/*
+ * Get history of poses.
+ */
+DTrackHistory* DTrackSDK::getHistory()
+{
+	return d_history;
+}
+
+
+/*
+ * Start publishing of tracking data into shared memory.
+ */
+bool DTrackSDK::startPublishing( const std::string& name, int numSlots, int slotSize )
+{
+	stopPublishing();
+
+	d_publisher = new DTrackSharedPublisher;
+	if ( ! d_publisher->open( name, numSlots, slotSize ) )
+	{
+		delete d_publisher;
+		d_publisher = NULL;
+		return false;
+	}
+	return true;
+}
+
+
+/*
+ * Stop publishing of tracking data, removing the shared memory.
+ */
+void DTrackSDK::stopPublishing()
+{
+	delete d_publisher;
+	d_publisher = NULL;
+}
+
+
+/*
+ * Returns if tracking data is published into shared memory.
+ */
+bool DTrackSDK::isPublishing() const
+{
+	return ( d_publisher != NULL );
+}
+
+
+/*
+ * Start thread receiving and processing tracking data, calling a function for each frame.
+ */
+bool DTrackSDK::startReceiving( FrameCallback callback, void* userData, int cpu, bool realtime )
+{
+	if ( callback == NULL )
+		return false;
+
+	return startReceiveThread( callback, userData, 0, cpu, realtime );
+}
+
+
+/*
+ * Start thread receiving and processing tracking data, adding each frame to a queue.
+ */
+bool DTrackSDK::startReceivingQueued( int queueSize, int cpu, bool realtime )
+{
+	if ( queueSize < 1 )
+		return false;
+
+	return startReceiveThread( NULL, NULL, queueSize, cpu, realtime );
+}
+
+
+/*
+ * Start thread receiving and processing tracking data.
+ */
+bool DTrackSDK::startReceiveThread( FrameCallback callback, void* userData, int queueSize, int cpu, bool realtime )
+{
+	if ( d_thread != NULL )  // already running
+		return false;
+
+	if ( ! isDataInterfaceValid() )
+	{
+		lastDataError = ERR_NET;
+		return false;
+	}
+
+	delete d_threadqueue;
+	d_threadqueue = NULL;
+	if ( queueSize > 0 )
+		d_threadqueue = new DTrackFrameQueue( queueSize );
+
+	d_threadcallback = callback;
+	d_threadcallbackdata = userData;
+	d_threadcpu = cpu;
+	d_threadrealtime = realtime;
+	d_threadstop = 0;
+
+	d_thread = new DTrackSys::Thread;
+	if ( ! d_thread->start( receiveThread, this ) )
+	{
+		delete d_thread;
+		d_thread = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+
+/*
+ * Stop thread receiving and processing tracking data.
+ */
+void DTrackSDK::stopReceiving()
+{
+	if ( d_thread == NULL )
+		return;
+
+	atomic_store( &d_threadstop, 1 );
+	d_thread->join();  // at latest after RECEIVE_THREAD_TIMEOUT
+
+	delete d_thread;
+	d_thread = NULL;
+}
+
+
+/*
+ * Returns if thread receiving and processing tracking data is running.
+ */
+bool DTrackSDK::isReceiving() const
+{
+	return ( d_thread != NULL );
+}
+
+
+/*
+ * Get oldest frame in queue of receiving thread.
+ */
+const DTrackFrame* DTrackSDK::acquireQueuedFrame()
+{
+	if ( d_threadqueue == NULL )
+		return NULL;
+
+	return d_threadqueue->front();
+}
+
+
+/*
+ * Remove oldest frame from queue of receiving thread.
+ */
+void DTrackSDK::releaseQueuedFrame()
+{
+	if ( d_threadqueue != NULL )
+		d_threadqueue->pop();
+}
+
+
+/*
+ * Get number of frames dropped as the queue of receiving thread was full.
+ */
+int DTrackSDK::getNumDroppedQueuedFrames() const
+{
+	if ( d_threadqueue == NULL )
+		return 0;
+
+	return d_threadqueue->getNumDropped();
+}
+
+
+/*
+ * Thread function of receiving thread.
+ */
+void DTrackSDK::receiveThread( void* arg )
+{
+	static_cast< DTrackSDK* >( arg )->receiveLoop();
+}
+
+
+/*
+ * Receive and process tracking data, until receiving thread is stopped.
+ */
+void DTrackSDK::receiveLoop()
+{
+	if ( d_threadrealtime )
+		thread_set_realtime();  // just if possible
+
+	if ( d_threadcpu >= 0 )
+		thread_set_affinity( d_threadcpu );  // just if possible
+
+	int timeout = d_udptimeout_us;  // check for stop regularly
+	if ( timeout > RECEIVE_THREAD_TIMEOUT )
+		timeout = RECEIVE_THREAD_TIMEOUT;
+
+	int backoff = 0;  // waiting time after an error (in us)
+	while ( ! atomic_load( &d_threadstop ) )
+	{
+		int num = receiveBatch( timeout );
+		if ( ( num <= 0 ) && ( lastDataError != ERR_TIMEOUT ) )
+		{	// error without waiting (e.g. invalid data interface): don't spin, retry after growing delay
+			backoff = ( backoff == 0 ) ? 1000 : backoff * 2;
+			if ( backoff > timeout )
+				backoff = timeout;
+
+			time_sleep( backoff / 1000000.0 );
+			continue;
+		}
+
+		backoff = 0;
+		for ( int i = 0; i < num; i++ )
+		{
+			if ( ! processFrame( i ) )
+				continue;
+
+			if ( d_threadcallback != NULL )
+				d_threadcallback( *this, d_threadcallbackdata );
+
+			if ( d_threadqueue != NULL )
+				d_threadqueue->push( *this );
+		}
+	}
+}
+
+
+/*
+ * Get content of the UDP buffer.
+ */
+std::string DTrackSDK::getBuf() const
+{
+	if ( d_udpdata == NULL )
+		return std::string( "" );
+
+	return std::string( d_udpdata );
+}
+
+
+/*
+ * Get last error at receiving tracking data (data transmission).
+ */
+DTrackSDK::Errors DTrackSDK::getLastDataError() const
+{
+	return lastDataError;
+}
+
+
+/*
+ * Get last error at exchanging commands with Controller (command transmission).
+ */
+DTrackSDK::Errors DTrackSDK::getLastServerError() const
+{
+	return lastServerError;
+}
+
+
+/*
+ * Get last DTrack2/DTRACK3 command error code.
+ */
+int DTrackSDK::getLastDTrackError() const
+{
+	return lastDTrackError;
+}
+
+
+/*
+ * Get last DTrack2/DTRACK3 command error description.
+ */
+std::string DTrackSDK::getLastDTrackErrorDescription() const
+{
+	return lastDTrackErrorString;
+}
+
+
+/*
+ * Set last DTrack2/DTRACK3 command error.
+ */
+void DTrackSDK::setLastDTrackError(int newError, const std::string& newErrorString)
+{
+	lastDTrackError = newError;
+	lastDTrackErrorString = newErrorString;
+}
+
+
+/*
+ * Start measurement.
+ */
+bool DTrackSDK::startMeasurement()
+{
+	// Check for special DTrack handling
+	if ( rsType == SYS_DTRACK )
+	{
+		if ( ! sendDTrack1Command( "dtrack 10 3" ) )  return false;
+
+		return sendDTrack1Command( "dtrack 31" );
+	}
 
 	sendStatefulFirewallPacket();  // try enabling UDP connection
 
@@ -683,14 +1491,46 @@ bool DTrackSDK::sendDTrack1Command( const std::string& command )
  * Send DTrack2/DTRACK3 command to DTrack and receive answer (TCP command interface).
  */
 int DTrackSDK::sendDTrack2Command(const std::string& command, std::string* answer)
+{
+	if (answer)
+		*answer = "";
+
+	// answers of pending asynchronous commands arrive first
+	while ( ! d_tcppending.empty() )
+	{
+		int err = processDTrack2Answer( d_tcptimeout_us );
+		if ( err < 0 )
+			return err;
+	}
+
+	// reset dtrack error
+	setLastDTrackError();
+
+	int err = sendDTrack2Request( command );
+	if ( err < 0 )
+		return err;
+
+	// receive TCP response string:
+	std::string ans;
+	err = receiveDTrack2Answer( ans, d_tcptimeout_us );
+	if ( err < 0 )
+		return err;
+
+	return parseDTrack2Answer( ans, answer );
+}
+
+
+/*
+ * Send DTrack2/DTRACK3 command to DTrack, without receiving the answer.
+ */
+int DTrackSDK::sendDTrack2Request( const std::string& command )
 {
 	// Params via TCP are not supported in DTrack
 	if (rsType != SYS_DTRACK_2)
 		return -2;
-	
-	// reset dtrack error
-	setLastDTrackError();
 
+	updateCommandInterface();
+	
 	// command too long?
 	if ( static_cast< int >( command.length() ) > DTRACK2_PROT_MAXLEN )
 	{
@@ -704,49 +1544,114 @@ int DTrackSDK::sendDTrack2Command(const std::string& command, std::string* answe
 		return -10;
 	}
 	
+	// cached values of changed parameters get invalid
+	if ( d_paramcache != NULL && command.compare( 0, 12, "dtrack2 set " ) == 0 )
+		d_paramcache->invalidateBySet( command.substr( 12 ) );
+
 	// send TCP command string:
 	if ( d_tcp->send( command.c_str(), static_cast< int >( command.length() ) + 1, d_tcptimeout_us ) != 0 )
 	{
 		lastServerError = ERR_NET;
 		return -11;
 	}
-	
-	// receive TCP response string:
-	char ans[ DTRACK2_PROT_MAXLEN ];
-	int err;
-	err = d_tcp->receive( ans, DTRACK2_PROT_MAXLEN, d_tcptimeout_us );
-	if ( err < 0 )
+
+	return 0;
+}
+
+
+/*
+ * Receive next answer of DTrack2/DTRACK3 from TCP connection.
+ */
+int DTrackSDK::receiveDTrack2Answer( std::string& ans, int timeoutUs )
+{
+	ans = "";
+
+	updateCommandInterface();
+
+	if (!isCommandInterfaceValid()) {
+		lastServerError = ERR_NET;
+		return -10;
+	}
+
+	// several answers might arrive in one TCP segment, an answer might be split into several
+	size_t pos;
+	while ( ( pos = d_tcpbuf.find( '\0' ) ) == std::string::npos )
 	{
-		if (err == -1) {	// timeout
-			lastServerError = ERR_TIMEOUT;
+		if ( static_cast< int >( d_tcpbuf.length() ) > DTRACK2_PROT_MAXLEN )
+		{	// answer too long
+			d_tcpbuf.clear();
+			lastServerError = ERR_NET;
+			return -4;
 		}
-		else
-			if (err == -9) {	// broken connection
-				delete d_tcp;
-				d_tcp = NULL;
+
+		char buf[ DTRACK2_PROT_MAXLEN ];
+		int err = d_tcp->receive( buf, DTRACK2_PROT_MAXLEN, timeoutUs );
+		if ( err == -4 )  // buffer completely filled; more data follows in next call
+			err = DTRACK2_PROT_MAXLEN;
+
+		if ( err < 0 )
+		{
+			if (err == -1) {	// timeout
+				lastServerError = ERR_TIMEOUT;
 			}
 			else
-				lastServerError = ERR_NET;	// network error
-		
-		if (answer)
-			*answer = "";
-		
-		return err;
+				if (err == -9) {	// broken connection
+					dropCommandInterface();
+				}
+				else
+					lastServerError = ERR_NET;	// network error
+
+			return err;
+		}
+
+		d_tcpbuf.append( buf, err );
 	}
-	
-	// parse answer:
-	
+
+	ans = d_tcpbuf.substr( 0, pos );
+	d_tcpbuf.erase( 0, pos + 1 );
+	return 0;
+}
+
+
+/*
+ * Close TCP connection to DTrack2/DTRACK3 after an error.
+ */
+void DTrackSDK::dropCommandInterface()
+{
+	delete d_tcp;
+	d_tcp = NULL;
+	d_tcpbuf.clear();
+
+	if ( d_connector != NULL )  // establish connection again in background
+		d_connector->reconnect();
+
+	// pending commands will never get an answer
+	std::deque< PendingCommand > pending;
+	pending.swap( d_tcppending );
+	for ( size_t i = 0; i < pending.size(); i++ )
+	{
+		if ( pending[ i ].callback != NULL )
+			pending[ i ].callback( -9, "", pending[ i ].userData );
+	}
+}
+
+
+/*
+ * Parse answer of DTrack2/DTRACK3.
+ */
+int DTrackSDK::parseDTrack2Answer( const std::string& ans, std::string* answer )
+{
 	// check for "dtrack2 ok" / no error
-	if (0 == strcmp(ans, "dtrack2 ok"))
+	if ( ans == "dtrack2 ok" )
 		return 1;
 	
 	// got error msg?
-	if (0 == strncmp(ans, "dtrack2 err ", 12)) {
-		char *s = ans + 12;
+	if ( ans.compare( 0, 12, "dtrack2 err " ) == 0 ) {
+		const char *s = ans.c_str() + 12;
 		int i;
 
 		// parse error code
-		s = string_get_i( (char *)s, &i );
+		s = string_get_i( s, &i );
 		if ( s == NULL )
 		{
 			setLastDTrackError(-1100, "SDK error -1100");
@@ -756,7 +1661,7 @@ int DTrackSDK::sendDTrack2Command(const std::string& command, std::string* answe
 		lastDTrackError = i;
 
 		// parse error string
-		s = string_get_quoted_text( (char *)s, lastDTrackErrorString );
+		s = string_get_quoted_text( s, lastDTrackErrorString );
 		if ( s == NULL )
 		{
 			setLastDTrackError(-1100, "SDK error -1100");
@@ -776,6 +1681,169 @@ int DTrackSDK::sendDTrack2Command(const std::string& command, std::string* answe
 }
 
 
+/*
+ * Send DTrack2/DTRACK3 command to DTrack without waiting for the answer (TCP command interface).
+ */
+int DTrackSDK::sendDTrack2CommandAsync( const std::string& command, CommandCallback callback, void* userData )
+{
+	// limit number of pending commands, as DTrack might stop reading if answers are not fetched
+	while ( static_cast< int >( d_tcppending.size() ) >= DTRACK2_PIPELINE_DEPTH )
+	{
+		int err = processDTrack2Answer( d_tcptimeout_us );
+		if ( err < 0 )
+			return err;
+	}
+
+	int err = sendDTrack2Request( command );
+	if ( err < 0 )
+		return err;
+
+	PendingCommand cmd;
+	cmd.callback = callback;
+	cmd.userData = userData;
+	d_tcppending.push_back( cmd );
+	return 0;
+}
+
+
+/*
+ * Receive answer of oldest pending asynchronous command and call its callback function.
+ */
+int DTrackSDK::processDTrack2Answer( int timeoutUs )
+{
+	std::string ans;
+	int err = receiveDTrack2Answer( ans, timeoutUs );
+	if ( err < 0 )
+		return err;
+
+	if ( d_tcppending.empty() )  // unexpected answer
+		return 0;
+
+	PendingCommand cmd = d_tcppending.front();
+	d_tcppending.pop_front();
+
+	setLastDTrackError();
+	std::string answer;
+	int res = parseDTrack2Answer( ans, &answer );
+	if ( cmd.callback != NULL )
+		cmd.callback( res, answer, cmd.userData );
+
+	return 0;
+}
+
+
+/*
+ * Process answers of pending asynchronous DTrack2/DTRACK3 commands.
+ */
+int DTrackSDK::processDTrack2Answers( int timeoutUs )
+{
+	int num = 0;
+	while ( ! d_tcppending.empty() )
+	{
+		int err = processDTrack2Answer( ( num == 0 ) ? timeoutUs : 0 );
+		if ( err == -1 )  // no more answers available
+			break;
+
+		if ( err < 0 )
+			return err;
+
+		num++;
+	}
+
+	return num;
+}
+
+
+/*
+ * Wait for answers of all pending asynchronous DTrack2/DTRACK3 commands.
+ */
+bool DTrackSDK::waitDTrack2Commands()
+{
+	while ( ! d_tcppending.empty() )
+	{
+		if ( processDTrack2Answer( d_tcptimeout_us ) < 0 )
+			return false;
+	}
+
+	return true;
+}
+
+
+/*
+ * Get number of pending asynchronous DTrack2/DTRACK3 commands.
+ */
+int DTrackSDK::getNumPendingDTrack2Commands() const
+{
+	return static_cast< int >( d_tcppending.size() );
+}
+
+
+/*
+ * Send several DTrack2/DTRACK3 commands pipelined, and receive their answers.
+ */
+bool DTrackSDK::sendDTrack2Commands( const std::vector< std::string >& commands, std::vector< int >& results,
+                                     std::vector< std::string >& answers )
+{
+	results.assign( commands.size(), -11 );
+	answers.assign( commands.size(), "" );
+
+	// answers of pending asynchronous commands arrive first
+	if ( ! waitDTrack2Commands() )
+		return false;
+
+	// reset dtrack error; keeps last error of all commands
+	setLastDTrackError();
+
+	size_t numSent = 0, numReceived = 0;
+	bool ok = true;
+	while ( numReceived < commands.size() )
+	{
+		// keep up to DTRACK2_PIPELINE_DEPTH commands on the way
+		while ( ok && numSent < commands.size() &&
+		        numSent - numReceived < static_cast< size_t >( DTRACK2_PIPELINE_DEPTH ) )
+		{
+			int err = sendDTrack2Request( commands[ numSent ] );
+			if ( err < 0 )
+			{
+				results[ numSent ] = err;
+				ok = false;
+				break;
+			}
+
+			numSent++;
+		}
+
+		if ( numReceived == numSent )  // sending failed, no more answers expected
+			return false;
+
+		std::string ans;
+		int err = receiveDTrack2Answer( ans, d_tcptimeout_us );
+		if ( err < 0 )
+		{
+			results[ numReceived ] = err;
+			if ( err == -1 )
+			{	// timeout: answers of commands on the way might still arrive, they are skipped later
+				PendingCommand cmd;
+				cmd.callback = NULL;
+				cmd.userData = NULL;
+				d_tcppending.insert( d_tcppending.end(), numSent - numReceived, cmd );
+			}
+			else if ( d_tcp != NULL )
+			{	// order of answers is lost
+				dropCommandInterface();
+			}
+
+			return false;
+		}
+
+		results[ numReceived ] = parseDTrack2Answer( ans, &answers[ numReceived ] );
+		numReceived++;
+	}
+
+	return ok;
+}
+
+
 /*
  * Send dummy UDP packet for stateful firewall.
  */
@@ -834,10 +1902,28 @@ bool DTrackSDK::getParam(const std::string& category, const std::string& name, s
  */
 bool DTrackSDK::getParam( const std::string& parameter, std::string& value )
 {
+	if ( d_paramcache != NULL && d_paramcache->get( parameter, value ) )
+		return true;
+
 	std::string res;
 	if ( sendDTrack2Command( "dtrack2 get " + parameter, &res ) != 0 )  // checks also for 'err' answer
 		return false;
 
+	if ( ! parseParamAnswer( res, parameter, value ) )
+		return false;
+
+	if ( d_paramcache != NULL )
+		d_paramcache->set( parameter, value );
+
+	return true;
+}
+
+
+/*
+ * Get parameter value from answer to "dtrack2 get" command.
+ */
+bool DTrackSDK::parseParamAnswer( const std::string& res, const std::string& parameter, std::string& value )
+{
 	// parse parameter from answer (expected answer starts with "dtrack2 set")
 	if ( res.compare( 0, 12, "dtrack2 set " ) != 0 )
 	{
@@ -858,6 +1944,129 @@ bool DTrackSDK::getParam( const std::string& parameter, std::string& value )
 }
 
 
+/*
+ * Set several DTrack2/DTRACK3 parameters at once.
+ */
+bool DTrackSDK::setParams( const std::vector< std::string >& parameters )
+{
+	std::vector< std::string > commands( parameters.size() );
+	for ( size_t i = 0; i < parameters.size(); i++ )
+		commands[ i ] = "dtrack2 set " + parameters[ i ];
+
+	std::vector< int > results;
+	std::vector< std::string > answers;
+	if ( ! sendDTrack2Commands( commands, results, answers ) )
+		return false;
+
+	// each parameter needs answer "dtrack2 ok"
+	bool ok = true;
+	for ( size_t i = 0; i < results.size(); i++ )
+	{
+		if ( results[ i ] != 1 )
+			ok = false;
+	}
+
+	return ok;
+}
+
+
+/*
+ * Get several DTrack2/DTRACK3 parameters at once.
+ */
+bool DTrackSDK::getParams( const std::vector< std::string >& parameters, std::vector< std::string >& values )
+{
+	return fetchParams( parameters, values, true, -1.0 );
+}
+
+
+/*
+ * Get several DTrack2/DTRACK3 parameters, optionally using the parameter cache.
+ */
+bool DTrackSDK::fetchParams( const std::vector< std::string >& parameters, std::vector< std::string >& values,
+                             bool useCache, double ttl )
+{
+	values.assign( parameters.size(), "" );
+
+	std::vector< size_t > index;  // parameters to get from the Controller
+	std::vector< std::string > commands;
+	for ( size_t i = 0; i < parameters.size(); i++ )
+	{
+		if ( useCache && d_paramcache != NULL && d_paramcache->get( parameters[ i ], values[ i ] ) )
+			continue;
+
+		index.push_back( i );
+		commands.push_back( "dtrack2 get " + parameters[ i ] );
+	}
+
+	if ( commands.empty() )
+		return true;
+
+	std::vector< int > results;
+	std::vector< std::string > answers;
+	if ( ! sendDTrack2Commands( commands, results, answers ) )
+		return false;
+
+	bool ok = true;
+	for ( size_t k = 0; k < index.size(); k++ )
+	{
+		size_t i = index[ k ];
+		if ( results[ k ] != 0 || ! parseParamAnswer( answers[ k ], parameters[ i ], values[ i ] ) )
+		{
+			ok = false;
+			continue;
+		}
+
+		if ( d_paramcache != NULL )
+			d_paramcache->set( parameters[ i ], values[ i ], ttl );
+	}
+
+	return ok;
+}
+
+
+/*
+ * Enable or disable client-side cache of DTrack2/DTRACK3 parameters.
+ */
+bool DTrackSDK::enableParamCache( bool enable, double ttl )
+{
+	if ( ! enable )
+	{
+		delete d_paramcache;
+		d_paramcache = NULL;
+		return true;
+	}
+
+	if ( d_paramcache == NULL )
+		d_paramcache = new DTrackParamCache( ttl );
+	else
+		d_paramcache->setDefaultTtl( ttl );
+
+	return true;
+}
+
+
+/*
+ * Get client-side cache of DTrack2/DTRACK3 parameters.
+ */
+DTrackParamCache* DTrackSDK::getParamCache()
+{
+	return d_paramcache;
+}
+
+
+/*
+ * Fill client-side cache with several DTrack2/DTRACK3 parameters.
+ */
+bool DTrackSDK::prefetchParams( const std::vector< std::string >& parameters, double ttl )
+{
+	if ( d_paramcache == NULL )
+		return false;
+
+	std::vector< std::string > values;
+	return fetchParams( parameters, values, false, ttl );
+}
+
+
 /*
  * Get DTrack2/DTRACK3 event message from the Controller.
  */
@@ -872,43 +2081,52 @@ bool DTrackSDK::getMessage()
 	if (0 != sendDTrack2Command("dtrack2 getmsg", &res))
 		return false;
 	
+	return parseMessage( res, d_message );
+}
+
+
+/*
+ * Parse answer to "dtrack2 getmsg" command.
+ */
+bool DTrackSDK::parseMessage( const std::string& res, DTrackMessage& message )
+{
 	// check answer
 	if (0 != strncmp(res.c_str(), "dtrack2 msg ", 12))
 		return false;
 	
 	// reset values
-	d_message_origin = d_message_msg = d_message_status = "";
-	d_message_framenr = d_message_errorid = 0;
+	message.origin = message.msg = message.status = "";
+	message.frameNr = message.errorId = 0;
 	
 	// parse message
 	const char* s = res.c_str() + 12;
 	// get 'origin'
-	s = string_get_word( (char *)s, d_message_origin );
+	s = string_get_word( s, message.origin );
 	if ( s == NULL )
 		return false;
 
 	// get 'status'
-	s = string_get_word( (char *)s, d_message_status );
+	s = string_get_word( s, message.status );
 	if ( s == NULL )
 		return false;
 
 	unsigned int ui;
 	// get 'frame counter'
-	s = string_get_ui( (char *)s, &ui );
+	s = string_get_ui( s, &ui );
 	if ( s == NULL )
 		return false;
 
-	d_message_framenr = ui;
+	message.frameNr = ui;
 
 	// get 'error id'
-	s = string_get_ui( (char *)s, &ui );
+	s = string_get_ui( s, &ui );
 	if ( s == NULL )
 		return false;
 
-	d_message_errorid = ui;
+	message.errorId = ui;
 
 	// get 'message'
-	s = string_get_quoted_text( (char *)s, d_message_msg );
+	s = string_get_quoted_text( s, message.msg );
 	if ( s == NULL )
 		return false;
 
@@ -921,7 +2139,7 @@ bool DTrackSDK::getMessage()
  */
 unsigned int DTrackSDK::getMessageFrameNr() const
 {
-	return d_message_framenr;
+	return d_message.frameNr;
 }
 
 
@@ -930,7 +2148,7 @@ unsigned int DTrackSDK::getMessageFrameNr() const
  */
 unsigned int DTrackSDK::getMessageErrorId() const
 {
-	return d_message_errorid;
+	return d_message.errorId;
 }
 
 
@@ -939,7 +2157,7 @@ unsigned int DTrackSDK::getMessageErrorId() const
  */
 std::string DTrackSDK::getMessageOrigin() const
 {
-	return d_message_origin;
+	return d_message.origin;
 }
 
 
@@ -948,7 +2166,7 @@ std::string DTrackSDK::getMessageOrigin() const
  */
 std::string DTrackSDK::getMessageStatus() const
 {
-	return d_message_status;
+	return d_message.status;
 }
 
 
@@ -957,7 +2175,109 @@ std::string DTrackSDK::getMessageStatus() const
  */
 std::string DTrackSDK::getMessageMsg() const
 {
-	return d_message_msg;
+	return d_message.msg;
+}
+
+
+/*
+ * Get all waiting DTrack2/DTRACK3 event messages from the Controller.
+ */
+int DTrackSDK::getMessages( std::vector< DTrackMessage >& messages, int maxCount )
+{
+	int num = 0;
+
+	// Messages via TCP are not supported in DTrack
+	if ( rsType != SYS_DTRACK_2 )
+	{
+		messages.resize( 0 );
+		return 0;
+	}
+
+	// start with a small window of requests, as usually just few messages are waiting
+	int window = 4;
+	bool more = true;
+	while ( more && num < maxCount )
+	{
+		if ( window > maxCount - num )
+			window = maxCount - num;
+
+		std::vector< std::string > commands( window, "dtrack2 getmsg" );
+		std::vector< int > results;
+		std::vector< std::string > answers;
+		bool ok = sendDTrack2Commands( commands, results, answers );
+
+		// a message might arrive between two requests, so all answers are checked
+		int numWindow = 0;
+		bool isEmpty = false;
+		for ( int i = 0; i < window; i++ )
+		{
+			if ( results[ i ] == 1 )  // answer "dtrack2 ok": no more messages at that moment
+			{
+				isEmpty = true;
+				continue;
+			}
+
+			if ( static_cast< int >( messages.size() ) <= num )
+				messages.resize( num + 1 );
+
+			if ( results[ i ] == 0 && parseMessage( answers[ i ], messages[ num ] ) )
+			{
+				num++;
+				numWindow++;
+			}
+		}
+
+		more = ok && ! isEmpty && numWindow > 0;
+
+		if ( window < DTRACK2_PIPELINE_DEPTH )
+			window *= 2;
+	}
+
+	messages.resize( num );
+	return num;
+}
+
+
+/*
+ * Start thread polling DTrack2/DTRACK3 event messages in background.
+ */
+bool DTrackSDK::startMessagePoller( int intervalUs, int queueSize )
+{
+	if ( d_msgpoller != NULL )  // already running
+		return false;
+
+	// Messages via TCP are not supported in DTrack
+	if ( rsType != SYS_DTRACK_2 || d_remoteIp == 0 )
+		return false;
+
+	d_msgpoller = new DTrackMessagePoller( d_remoteIp, intervalUs, queueSize, d_tcptimeout_us );
+	if ( ! d_msgpoller->start() )
+	{
+		delete d_msgpoller;
+		d_msgpoller = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+
+/*
+ * Stop thread polling DTrack2/DTRACK3 event messages.
+ */
+void DTrackSDK::stopMessagePoller()
+{
+	delete d_msgpoller;  // stops thread
+	d_msgpoller = NULL;
+}
+
+
+/*
+ * Get background polling of DTrack2/DTRACK3 event messages.
+ */
+DTrackMessagePoller* DTrackSDK::getMessagePoller()
+{
+	return d_msgpoller;
 }
 
 
@@ -968,16 +2288,14 @@ bool DTrackSDK::tactileFinger( int handId, int fingerId, double strength )
 {
 	setLastDTrackError();
 
-	if ( strength > 1.0 || strength < 0.0 )
+	DTrackFeedbackBatch batch;
+	if ( ! batch.tactileFinger( handId, fingerId, strength ) )
 	{
 		lastServerError = ERR_NET;
 		return false;
 	}
 
-	std::ostringstream os;
-	os << "tfb 1 [" << handId << " " << fingerId << " 1.0 " << strength << "]";
-
-	return sendFeedbackCommand( os.str() );
+	return sendFeedback( batch );
 }
 
 
@@ -988,21 +2306,14 @@ bool DTrackSDK::tactileHand( int handId, const std::vector< double >& strength )
 {
 	setLastDTrackError();
 
-	std::ostringstream os;
-	os << "tfb " << strength.size() << " ";
-
-	for ( size_t i = 0; i < strength.size(); i++ )
+	DTrackFeedbackBatch batch;
+	if ( ! strength.empty() && ! batch.tactileHand( handId, &strength[ 0 ], static_cast< int >( strength.size() ) ) )
 	{
-		if ( strength[ i ] > 1.0 || strength[ i ] < 0.0 )
-		{
-			lastServerError = ERR_NET;
-			return false;
-		}
-
-		os << "[" << handId << " " << i << " 1.0 " << strength[ i ] << "]";
+		lastServerError = ERR_NET;
+		return false;
 	}
 
-	return sendFeedbackCommand( os.str() );
+	return sendFeedback( batch );
 }
 
 
@@ -1013,9 +2324,14 @@ bool DTrackSDK::tactileHandOff( int handId, int numFinger )
 {
 	setLastDTrackError();
 
-	std::vector< double > strength( numFinger, 0.0 );
+	DTrackFeedbackBatch batch;
+	if ( ! batch.tactileHandOff( handId, numFinger ) )
+	{
+		lastServerError = ERR_NET;
+		return false;
+	}
 
-	return tactileHand( handId, strength );
+	return sendFeedback( batch );
 }
 
 
@@ -1026,11 +2342,10 @@ bool DTrackSDK::flystickBeep( int flystickId, double durationMs, double frequenc
 {
 	setLastDTrackError();
 
-	std::ostringstream os;
-	os << "ffb 1 ";
-	os << "[" << flystickId << " " << ( int )durationMs << " " << ( int )frequencyHz << " 0 0][]";
+	DTrackFeedbackBatch batch;
+	batch.flystickBeep( flystickId, durationMs, frequencyHz );
 
-	return sendFeedbackCommand( os.str() );
+	return sendFeedback( batch );
 }
 
 
@@ -1041,23 +2356,57 @@ bool DTrackSDK::flystickVibration( int flystickId, int vibrationPattern )
 {
 	setLastDTrackError();
 
-	std::ostringstream os;
-	os << "ffb 1 ";
-	os << "[" << flystickId << " 0 0 " << vibrationPattern << " 0][]";
+	DTrackFeedbackBatch batch;
+	batch.flystickVibration( flystickId, vibrationPattern );
+
+	return sendFeedback( batch );
+}
+
+
+/*
+ * Send collected feedback commands for tactile FINGERTRACKING devices and Flysticks.
+ */
+bool DTrackSDK::sendFeedback( DTrackFeedbackBatch& batch )
+{
+	char buf[ DTrackFeedbackBatch::MAX_COMMANDLEN ];
+	double now = time_monotonic();
+	bool ok = true;
+
+	// commands are removed from the batch just after sending succeeded:
+	int len = batch.prepareTactileCommand( buf, DTrackFeedbackBatch::MAX_COMMANDLEN, now );
+	if ( len > 0 )
+	{
+		if ( sendFeedbackCommand( buf, len ) )
+			batch.commitTactileCommand( now );
+		else
+			ok = false;
+	}
+
+	len = batch.prepareFlystickCommand( buf, DTrackFeedbackBatch::MAX_COMMANDLEN, now );
+	if ( len > 0 )
+	{
+		if ( sendFeedbackCommand( buf, len ) )
+			batch.commitFlystickCommand( now );
+		else
+			ok = false;
+	}
 
-	return sendFeedbackCommand( os.str() );
+	return ok;
 }
 
 
 /*
  * Send feedback command via UDP.
  */
-bool DTrackSDK::sendFeedbackCommand( const std::string& command )
+bool DTrackSDK::sendFeedbackCommand( const char* command, int len )
 {
 	int err;
 
 	if ( ! isDataInterfaceValid() )
+	{
+		lastDataError = ERR_NET;
 		return false;
+	}
 
 	unsigned int ip = d_remoteIp;
 	if ( ip == 0 )  // if IP of Controller is not known, try IP of latest received UDP data
@@ -1065,10 +2414,13 @@ bool DTrackSDK::sendFeedbackCommand( const std::string& command )
 		ip = d_udp->getRemoteIp();
 
 		if ( ip == 0 )
+		{
+			lastDataError = ERR_NET;
 			return false;
+		}
 	}
 
-	err = d_udp->send( ( void* )command.c_str(), ( int )command.length() + 1, ip, DTRACK2_PORT_FEEDBACK, d_udptimeout_us );
+	err = d_udp->send( ( void* )command, len + 1, ip, DTRACK2_PORT_FEEDBACK, d_udptimeout_us );
 	if ( err != 0 )
 	{
 		lastDataError = ERR_NET;
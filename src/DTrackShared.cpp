@@ -0,0 +1,348 @@
+/* DTrackSDK in C++: DTrackShared.cpp
+ *
+ * Passing frames to other processes by shared memory.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackShared.hpp"
+
+#include <cstring>
+
+using namespace DTrackSys;
+
+#define SHARED_MAGIC    0x4d535444  // 'DTSM'
+#define SHARED_VERSION  2
+#define SHARED_ALIGN    64          // alignment of slots (size of cache line)
+#define SHARED_RETRIES  8           // number of retries, if a slot was changed while reading
+
+namespace {
+
+/*
+ * Header of shared memory.
+ */
+struct SharedHeader
+{
+	int magic;                  // identification of shared memory
+	int version;                // version of layout
+	int numSlots;               // number of slots (power of two)
+	int slotSize;               // size of data of one slot in bytes
+	int slotStride;             // distance between slots in bytes
+	volatile int numPublished;  // number of published frames (wraps around)
+};
+
+/*
+ * Header of one slot.
+ */
+struct SlotHeader
+{
+	volatile int seq;  // sequence counter: odd while writing
+	int len;           // length of frame image in bytes; -1 if invalid
+	int number;        // number of frame (wraps around)
+};
+
+/*
+ * Round up to alignment of slots.
+ */
+inline int shared_align( int size )
+{
+	return ( size + SHARED_ALIGN - 1 ) & ~( SHARED_ALIGN - 1 );
+}
+
+/*
+ * Get header of a slot.
+ */
+inline SlotHeader* shared_slot( char* shm, unsigned int number )
+{
+	const SharedHeader* h = reinterpret_cast< const SharedHeader* >( shm );
+	unsigned int index = number & ( unsigned int )( h->numSlots - 1 );
+
+	return reinterpret_cast< SlotHeader* >( shm + shared_align( sizeof( SharedHeader ) ) + ( size_t )index * h->slotStride );
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------------------------------
+
+/*
+ * Constructor.
+ */
+DTrackSharedPublisher::DTrackSharedPublisher()
+	: d_numpublished( 0 )
+{
+	//
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackSharedPublisher::~DTrackSharedPublisher()
+{
+	close();
+}
+
+
+/*
+ * Create shared memory.
+ */
+bool DTrackSharedPublisher::open( const std::string& name, int numSlots, int slotSize )
+{
+	close();
+
+	if ( numSlots < 2 || numSlots > 65536 || slotSize < 1024 || slotSize > 0x10000000 )
+		return false;
+
+	int n = 2;
+	while ( n < numSlots )
+		n *= 2;
+
+	int stride = shared_align( sizeof( SlotHeader ) + slotSize );
+	size_t size = ( size_t )shared_align( sizeof( SharedHeader ) ) + ( size_t )n * stride;
+
+	if ( ! d_shm.create( name.c_str(), size ) )
+		return false;
+
+	SharedHeader* h = reinterpret_cast< SharedHeader* >( d_shm.getData() );
+	h->numSlots = n;
+	h->slotSize = slotSize;
+	h->slotStride = stride;
+	h->version = SHARED_VERSION;
+	atomic_store( &h->magic, SHARED_MAGIC );  // readers accept shared memory, after header is complete
+
+	d_numpublished = 0;
+	return true;
+}
+
+
+/*
+ * Remove shared memory.
+ */
+void DTrackSharedPublisher::close()
+{
+	d_shm.close();
+	d_numpublished = 0;
+}
+
+
+/*
+ * Returns if shared memory was created.
+ */
+bool DTrackSharedPublisher::isOpen() const
+{
+	return ( d_shm.getData() != NULL );
+}
+
+
+/*
+ * Publish tracking data of actual frame.
+ */
+bool DTrackSharedPublisher::publish( const DTrackParser& parser )
+{
+	char* shm = d_shm.getData();
+	if ( shm == NULL )
+		return false;
+
+	SharedHeader* h = reinterpret_cast< SharedHeader* >( shm );
+	SlotHeader* slot = shared_slot( shm, d_numpublished );
+	char* data = reinterpret_cast< char* >( slot ) + sizeof( SlotHeader );
+
+	int seq = slot->seq;
+	atomic_store( &slot->seq, seq + 1 );  // writing
+	atomic_fence();
+
+	int len = parser.writeFrameImage( data, h->slotSize );
+	slot->len = len;
+	slot->number = ( int )d_numpublished;
+
+	atomic_store( &slot->seq, seq + 2 );  // finished
+	if ( len < 0 )
+		return false;
+
+	d_numpublished++;
+	atomic_store( &h->numPublished, ( int )d_numpublished );
+	return true;
+}
+
+
+/*
+ * Get number of published frames.
+ */
+unsigned int DTrackSharedPublisher::getNumPublished() const
+{
+	return d_numpublished;
+}
+
+
+/*
+ * Constructor.
+ */
+DTrackSharedReader::DTrackSharedReader()
+{
+	//
+}
+
+
+/*
+ * Destructor.
+ */
+DTrackSharedReader::~DTrackSharedReader()
+{
+	close();
+}
+
+
+/*
+ * Attach to shared memory created by a publisher.
+ */
+bool DTrackSharedReader::open( const std::string& name )
+{
+	close();
+
+	if ( ! d_shm.open( name.c_str() ) )
+		return false;
+
+	const SharedHeader* h = reinterpret_cast< const SharedHeader* >( d_shm.getData() );
+	bool ok = ( d_shm.getSize() >= sizeof( SharedHeader ) ) && ( atomic_load( &h->magic ) == SHARED_MAGIC ) &&
+	          ( h->version == SHARED_VERSION ) && ( h->numSlots >= 2 ) && ( ( h->numSlots & ( h->numSlots - 1 ) ) == 0 ) &&
+	          ( h->slotSize > 0 ) && ( h->slotStride >= shared_align( sizeof( SlotHeader ) + h->slotSize ) ) &&
+	          ( d_shm.getSize() >= ( size_t )shared_align( sizeof( SharedHeader ) ) + ( size_t )h->numSlots * h->slotStride );
+	if ( ! ok )
+	{
+		d_shm.close();
+		return false;
+	}
+
+	d_buf.resize( h->slotSize );
+	return true;
+}
+
+
+/*
+ * Detach from shared memory.
+ */
+void DTrackSharedReader::close()
+{
+	d_shm.close();
+}
+
+
+/*
+ * Returns if attached to shared memory.
+ */
+bool DTrackSharedReader::isOpen() const
+{
+	return ( d_shm.getData() != NULL );
+}
+
+
+/*
+ * Get number of frames published so far.
+ */
+unsigned int DTrackSharedReader::getNumPublished() const
+{
+	const SharedHeader* h = reinterpret_cast< const SharedHeader* >( d_shm.getData() );
+	if ( h == NULL )
+		return 0;
+
+	return ( unsigned int )atomic_load( &h->numPublished );
+}
+
+
+/*
+ * Get number of slots.
+ */
+int DTrackSharedReader::getNumSlots() const
+{
+	const SharedHeader* h = reinterpret_cast< const SharedHeader* >( d_shm.getData() );
+	if ( h == NULL )
+		return 0;
+
+	return h->numSlots;
+}
+
+
+/*
+ * Read latest published frame.
+ */
+bool DTrackSharedReader::readLatest( DTrackFrame& frame )
+{
+	return read( 0, frame );
+}
+
+
+/*
+ * Read a recent frame.
+ */
+bool DTrackSharedReader::read( int age, DTrackFrame& frame )
+{
+	char* shm = d_shm.getData();
+	if ( shm == NULL || age < 0 )
+		return false;
+
+	const SharedHeader* h = reinterpret_cast< const SharedHeader* >( shm );
+	if ( age >= h->numSlots )
+		return false;
+
+	for ( int i = 0; i < SHARED_RETRIES; i++ )
+	{
+		unsigned int num = ( unsigned int )atomic_load( &h->numPublished );
+		if ( num <= ( unsigned int )age )  // not published yet (ignoring wrap around of a very long publishing)
+			return false;
+
+		unsigned int number = num - 1 - ( unsigned int )age;
+		const SlotHeader* slot = shared_slot( shm, number );
+
+		int seq = atomic_load( &slot->seq );
+		if ( seq & 1 )  // being written
+			continue;
+
+		int len = slot->len;
+		int slotnumber = slot->number;
+		if ( len > 0 && len <= h->slotSize )
+			memcpy( &d_buf[ 0 ], reinterpret_cast< const char* >( slot ) + sizeof( SlotHeader ), len );
+
+		atomic_fence();
+		if ( atomic_load( &slot->seq ) != seq )  // changed while reading
+			continue;
+
+		if ( ( unsigned int )slotnumber != number )  // already overwritten by a newer frame
+		{
+			if ( age == 0 )
+				continue;
+
+			return false;
+		}
+
+		if ( len <= 0 || len > h->slotSize )
+			return false;
+
+		return frame.setFrame( &d_buf[ 0 ], len );
+	}
+
+	return false;
+}
+
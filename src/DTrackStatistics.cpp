@@ -0,0 +1,283 @@
+/* DTrackSDK in C++: DTrackStatistics.cpp
+ *
+ * Statistics about received tracking data, for monitoring.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DTrackStatistics.hpp"
+#include "DTrackSys.hpp"
+
+using namespace DTrackSys;
+
+#define STAT_JITTER_MAX  10.0  // maximum arrival interval (in s) used for jitter, e.g. to ignore pauses
+
+
+/*
+ * Constructor.
+ */
+DTrackStatistics::DTrackStatistics()
+{
+	reset();
+
+	d_has_last = false;
+	d_last_framecounter = 0;
+	d_last_arrival = 0.0;
+	d_last_interval = -1.0;
+}
+
+
+/*
+ * Reset all counters and histograms.
+ */
+void DTrackStatistics::reset()
+{
+	atomic_store( &d_num_frames, 0 );
+	atomic_store( &d_num_discarded, 0 );
+	atomic_store( &d_num_missing, 0 );
+	atomic_store( &d_num_gaps, 0 );
+	atomic_store( &d_num_overflows, 0 );
+	atomic_store( &d_num_kerneldropped, 0 );
+	atomic_store( &d_num_parseerrors, 0 );
+
+	for ( int i = 0; i < NUM_BUCKETS; i++ )
+	{
+		atomic_store( &d_jitter[ i ], 0 );
+
+		for ( int j = 0; j < NUM_RECORD; j++ )
+			atomic_store( &d_parsetime[ j ][ i ], 0 );
+	}
+}
+
+
+/*
+ * Get number of processed frames.
+ */
+unsigned int DTrackStatistics::getNumFrames() const
+{
+	return static_cast< unsigned int >( atomic_load( &d_num_frames ) );
+}
+
+
+/*
+ * Get number of discarded frames.
+ */
+unsigned int DTrackStatistics::getNumDiscarded() const
+{
+	return static_cast< unsigned int >( atomic_load( &d_num_discarded ) );
+}
+
+
+/*
+ * Get number of missing frames.
+ */
+unsigned int DTrackStatistics::getNumMissing() const
+{
+	return static_cast< unsigned int >( atomic_load( &d_num_missing ) );
+}
+
+
+/*
+ * Get number of gaps in the frame counter.
+ */
+unsigned int DTrackStatistics::getNumGaps() const
+{
+	return static_cast< unsigned int >( atomic_load( &d_num_gaps ) );
+}
+
+
+/*
+ * Get number of packets, that didn't fit into the UDP buffer.
+ */
+unsigned int DTrackStatistics::getNumOverflows() const
+{
+	return static_cast< unsigned int >( atomic_load( &d_num_overflows ) );
+}
+
+
+/*
+ * Get number of packets dropped by the kernel.
+ */
+unsigned int DTrackStatistics::getNumKernelDropped() const
+{
+	return static_cast< unsigned int >( atomic_load( &d_num_kerneldropped ) );
+}
+
+
+/*
+ * Get number of frames, that couldn't be parsed.
+ */
+unsigned int DTrackStatistics::getNumParseErrors() const
+{
+	return static_cast< unsigned int >( atomic_load( &d_num_parseerrors ) );
+}
+
+
+/*
+ * Get number of inter-arrival jitter values in one histogram bucket.
+ */
+unsigned int DTrackStatistics::getJitterHistogram( int bucket ) const
+{
+	if ( ( bucket < 0 ) || ( bucket >= NUM_BUCKETS ) )
+		return 0;
+
+	return static_cast< unsigned int >( atomic_load( &d_jitter[ bucket ] ) );
+}
+
+
+/*
+ * Get number of parsed lines in one histogram bucket of parse times.
+ */
+unsigned int DTrackStatistics::getParseTimeHistogram( RecordType recordType, int bucket ) const
+{
+	if ( ( recordType < 0 ) || ( recordType >= NUM_RECORD ) || ( bucket < 0 ) || ( bucket >= NUM_BUCKETS ) )
+		return 0;
+
+	return static_cast< unsigned int >( atomic_load( &d_parsetime[ recordType ][ bucket ] ) );
+}
+
+
+/*
+ * Get upper limit of one histogram bucket.
+ */
+double DTrackStatistics::getBucketLimit( int bucket )
+{
+	if ( ( bucket < 0 ) || ( bucket >= NUM_BUCKETS - 1 ) )
+		return -1.0;
+
+	return ( double )( 1L << ( bucket + 7 ) ) * 1e-9;
+}
+
+
+/*
+ * Get histogram bucket of a time.
+ */
+int DTrackStatistics::bucket_index( double time )
+{
+	if ( ! ( time >= 128e-9 ) )  // also catches NaN
+		return 0;
+
+	if ( time >= ( double )( 1L << ( NUM_BUCKETS + 5 ) ) * 1e-9 )
+		return NUM_BUCKETS - 1;
+
+	unsigned long ns = static_cast< unsigned long >( time * 1e9 );
+	int bucket = 0;
+	ns >>= 7;
+	while ( ns != 0 )
+	{
+		ns >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+
+/*
+ * Record one processed frame.
+ */
+void DTrackStatistics::addFrame( unsigned int frameCounter, double arrivalTime )
+{
+	atomic_add( &d_num_frames, 1 );
+
+	if ( d_has_last )
+	{
+		if ( frameCounter > d_last_framecounter + 1 )
+		{
+			atomic_add( &d_num_missing, static_cast< int >( frameCounter - d_last_framecounter - 1 ) );
+			atomic_add( &d_num_gaps, 1 );
+		}
+
+		double interval = arrivalTime - d_last_arrival;
+		if ( ( interval < 0.0 ) || ( interval > STAT_JITTER_MAX ) )
+		{
+			interval = -1.0;  // not used for jitter
+		}
+		else if ( d_last_interval >= 0.0 )
+		{
+			double jitter = interval - d_last_interval;
+			if ( jitter < 0.0 )
+				jitter = -jitter;
+
+			atomic_add( &d_jitter[ bucket_index( jitter ) ], 1 );
+		}
+
+		d_last_interval = interval;
+	}
+
+	d_has_last = true;
+	d_last_framecounter = frameCounter;
+	d_last_arrival = arrivalTime;
+}
+
+
+/*
+ * Record discarded frames.
+ */
+void DTrackStatistics::addDiscarded( int num )
+{
+	if ( num > 0 )
+		atomic_add( &d_num_discarded, num );
+}
+
+
+/*
+ * Record one packet, that didn't fit into the UDP buffer.
+ */
+void DTrackStatistics::addOverflow()
+{
+	atomic_add( &d_num_overflows, 1 );
+}
+
+
+/*
+ * Record packets dropped by the kernel.
+ */
+void DTrackStatistics::addKernelDropped( int num )
+{
+	if ( num > 0 )
+		atomic_add( &d_num_kerneldropped, num );
+}
+
+
+/*
+ * Record one frame, that couldn't be parsed.
+ */
+void DTrackStatistics::addParseError()
+{
+	atomic_add( &d_num_parseerrors, 1 );
+}
+
+
+/*
+ * Record parse time of one line.
+ */
+void DTrackStatistics::addParseTime( RecordType recordType, double time )
+{
+	if ( ( recordType < 0 ) || ( recordType >= NUM_RECORD ) )
+		recordType = RECORD_OTHER;
+
+	atomic_add( &d_parsetime[ recordType ][ bucket_index( time ) ], 1 );
+}
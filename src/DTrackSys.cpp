@@ -0,0 +1,707 @@
+/* DTrackSDK in C++: DTrackSys.cpp
+ *
+ * Operating system functions: atomic operations, threads.
+ *
+ * Copyright (c) 2026 Advanced Realtime Tracking GmbH & Co. KG
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#if defined( __linux__ ) && ! defined( _GNU_SOURCE )
+	#define _GNU_SOURCE  // for 'pthread_setaffinity_np'
+#endif
+
+#include "DTrackSys.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+// usually the following should work; otherwise define OS_* manually:
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64)
+	#define OS_WIN   // for MS Windows (2000, XP, Vista, 7, 8, 10)
+#else
+	#define OS_UNIX  // for Unix (Linux, Irix)
+#endif
+
+#ifdef OS_UNIX
+	#include <pthread.h>
+	#include <sched.h>
+	#include <time.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+#ifdef OS_WIN
+	#include <windows.h>
+#endif
+
+namespace DTrackSys {
+
+/*
+ * Read integer value atomically (acquire semantics).
+ */
+int atomic_load( const volatile int* p )
+{
+#if defined( OS_WIN )
+	return InterlockedCompareExchange( ( volatile LONG* )p, 0, 0 );
+#elif defined( __ATOMIC_ACQUIRE )
+	return __atomic_load_n( p, __ATOMIC_ACQUIRE );
+#else
+	int value = *p;
+	__sync_synchronize();
+	return value;
+#endif
+}
+
+
+/*
+ * Write integer value atomically (release semantics).
+ */
+void atomic_store( volatile int* p, int value )
+{
+#if defined( OS_WIN )
+	InterlockedExchange( ( volatile LONG* )p, value );
+#elif defined( __ATOMIC_RELEASE )
+	__atomic_store_n( p, value, __ATOMIC_RELEASE );
+#else
+	__sync_synchronize();
+	*p = value;
+#endif
+}
+
+
+/*
+ * Exchange integer value atomically (acquire and release semantics).
+ */
+int atomic_exchange( volatile int* p, int value )
+{
+#if defined( OS_WIN )
+	return InterlockedExchange( ( volatile LONG* )p, value );
+#elif defined( __ATOMIC_ACQ_REL )
+	return __atomic_exchange_n( p, value, __ATOMIC_ACQ_REL );
+#else
+	__sync_synchronize();  // __sync_lock_test_and_set() is just an acquire barrier
+	return __sync_lock_test_and_set( p, value );
+#endif
+}
+
+
+/*
+ * Add to integer value atomically (acquire and release semantics).
+ */
+int atomic_add( volatile int* p, int value )
+{
+#if defined( OS_WIN )
+	return InterlockedExchangeAdd( ( volatile LONG* )p, value ) + value;
+#elif defined( __ATOMIC_ACQ_REL )
+	return __atomic_add_fetch( p, value, __ATOMIC_ACQ_REL );
+#else
+	return __sync_add_and_fetch( p, value );
+#endif
+}
+
+
+/*
+ * Full memory barrier.
+ */
+void atomic_fence()
+{
+#if defined( OS_WIN )
+	MemoryBarrier();
+#elif defined( __ATOMIC_SEQ_CST )
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );
+#else
+	__sync_synchronize();
+#endif
+}
+
+
+/**
+ * \brief Internal thread type.
+ */
+struct _thread_struct {
+#ifdef OS_UNIX
+	pthread_t osthread;  // Unix thread
+#endif
+#ifdef OS_WIN
+	HANDLE osthread;     // Windows thread
+#endif
+	ThreadFunction func;
+	void* arg;
+};
+
+
+/*
+ * Entry function of all threads, calling the thread function.
+ */
+#ifdef OS_UNIX
+static void* thread_entry( void* p )
+{
+	_thread_struct* t = static_cast< _thread_struct* >( p );
+	t->func( t->arg );
+	return NULL;
+}
+#endif
+#ifdef OS_WIN
+static DWORD WINAPI thread_entry( LPVOID p )
+{
+	_thread_struct* t = static_cast< _thread_struct* >( p );
+	t->func( t->arg );
+	return 0;
+}
+#endif
+
+
+/*
+ * Constructor.
+ */
+Thread::Thread()
+	: d_thread( NULL )
+{
+	//
+}
+
+
+/*
+ * Destructor.
+ */
+Thread::~Thread()
+{
+	join();
+}
+
+
+/*
+ * Start thread.
+ */
+bool Thread::start( ThreadFunction func, void* arg )
+{
+	if ( d_thread != NULL )
+		return false;
+
+	d_thread = new _thread_struct;
+	d_thread->func = func;
+	d_thread->arg = arg;
+
+#ifdef OS_UNIX
+	if ( pthread_create( &d_thread->osthread, NULL, thread_entry, d_thread ) != 0 )
+	{
+		delete d_thread;
+		d_thread = NULL;
+		return false;
+	}
+#endif
+#ifdef OS_WIN
+	d_thread->osthread = CreateThread( NULL, 0, thread_entry, d_thread, 0, NULL );
+	if ( d_thread->osthread == NULL )
+	{
+		delete d_thread;
+		d_thread = NULL;
+		return false;
+	}
+#endif
+	return true;
+}
+
+
+/*
+ * Wait for the thread to finish.
+ */
+void Thread::join()
+{
+	if ( d_thread == NULL )
+		return;
+
+#ifdef OS_UNIX
+	pthread_join( d_thread->osthread, NULL );
+#endif
+#ifdef OS_WIN
+	WaitForSingleObject( d_thread->osthread, INFINITE );
+	CloseHandle( d_thread->osthread );
+#endif
+
+	delete d_thread;
+	d_thread = NULL;
+}
+
+
+/*
+ * Returns if thread was started and not joined yet.
+ */
+bool Thread::isStarted() const
+{
+	return ( d_thread != NULL );
+}
+
+
+/*
+ * Set real-time priority for the calling thread.
+ */
+bool thread_set_realtime()
+{
+#ifdef OS_UNIX
+	struct sched_param param;
+	int pmin = sched_get_priority_min( SCHED_FIFO );
+	int pmax = sched_get_priority_max( SCHED_FIFO );
+	if ( pmin < 0 || pmax < 0 )
+		return false;
+
+	param.sched_priority = pmin + ( pmax - pmin ) / 2;  // leave room above, e.g. for interrupt threads
+	return ( pthread_setschedparam( pthread_self(), SCHED_FIFO, &param ) == 0 );
+#endif
+#ifdef OS_WIN
+	return ( SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL ) != 0 );
+#endif
+}
+
+
+/*
+ * Bind the calling thread to one CPU.
+ */
+bool thread_set_affinity( int cpu )
+{
+	if ( cpu < 0 )
+		return false;
+
+#if defined( OS_UNIX ) && defined( __linux__ )
+	if ( cpu >= CPU_SETSIZE )
+		return false;
+
+	cpu_set_t set;
+	CPU_ZERO( &set );
+	CPU_SET( cpu, &set );
+	return ( pthread_setaffinity_np( pthread_self(), sizeof( set ), &set ) == 0 );
+#elif defined( OS_WIN )
+	if ( cpu >= ( int )( sizeof( DWORD_PTR ) * 8 ) )
+		return false;
+
+	return ( SetThreadAffinityMask( GetCurrentThread(), ( DWORD_PTR )1 << cpu ) != 0 );
+#else
+	return false;  // not supported
+#endif
+}
+
+
+/*
+ * Get time of a monotonic clock.
+ */
+double time_monotonic()
+{
+#ifdef OS_UNIX
+	struct timespec ts;
+	if ( clock_gettime( CLOCK_MONOTONIC, &ts ) != 0 )
+		return 0.0;
+
+	return ( double )ts.tv_sec + ( double )ts.tv_nsec * 1e-9;
+#endif
+#ifdef OS_WIN
+	static LONGLONG freq = 0;  // constant since system boot
+	LARGE_INTEGER count;
+
+	if ( freq == 0 )
+	{
+		LARGE_INTEGER f;
+		if ( ! QueryPerformanceFrequency( &f ) )
+			return 0.0;
+
+		freq = f.QuadPart;
+	}
+
+	QueryPerformanceCounter( &count );
+	return ( double )( count.QuadPart / freq ) + ( double )( count.QuadPart % freq ) / ( double )freq;
+#endif
+}
+
+
+/*
+ * Suspend the calling thread.
+ */
+void time_sleep( double seconds )
+{
+	if ( ! ( seconds > 0.0 ) )
+		return;
+
+#ifdef OS_UNIX
+	struct timespec ts;
+	ts.tv_sec = static_cast< time_t >( seconds );
+	ts.tv_nsec = static_cast< long >( ( seconds - ( double )ts.tv_sec ) * 1e9 );
+
+	while ( nanosleep( &ts, &ts ) != 0 )  // continue, if interrupted by a signal
+		;
+#endif
+#ifdef OS_WIN
+	Sleep( static_cast< DWORD >( seconds * 1000.0 + 0.5 ) );
+#endif
+}
+
+
+/**
+ * \brief Internal type of a mapped file.
+ */
+struct _mappedfile_struct {
+#ifdef OS_WIN
+	HANDLE osfile;     // Windows file
+	HANDLE osmapping;  // Windows file mapping
+#endif
+	int dummy;  // no handles needed for Unix
+};
+
+
+/*
+ * Constructor.
+ */
+MappedFile::MappedFile()
+	: d_file( NULL ), d_data( NULL ), d_size( 0 )
+{
+	//
+}
+
+
+/*
+ * Destructor.
+ */
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+
+/*
+ * Map a file into memory.
+ */
+bool MappedFile::open( const char* filename )
+{
+	close();
+
+#ifdef OS_UNIX
+	int fd = ::open( filename, O_RDONLY );
+	if ( fd < 0 )
+		return false;
+
+	struct stat st;
+	if ( ( fstat( fd, &st ) != 0 ) || ( st.st_size <= 0 ) ||
+	     ( static_cast< off_t >( static_cast< size_t >( st.st_size ) ) != st.st_size ) )  // too large for address space
+	{
+		::close( fd );
+		return false;
+	}
+
+	size_t size = static_cast< size_t >( st.st_size );
+	void* p = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+	::close( fd );  // mapping stays valid
+	if ( p == MAP_FAILED )
+		return false;
+
+	d_file = new _mappedfile_struct;
+#endif
+#ifdef OS_WIN
+	HANDLE f = CreateFileA( filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( f == INVALID_HANDLE_VALUE )
+		return false;
+
+	LARGE_INTEGER fsize;
+	if ( ( ! GetFileSizeEx( f, &fsize ) ) || ( fsize.QuadPart <= 0 ) ||
+	     ( static_cast< LONGLONG >( static_cast< size_t >( fsize.QuadPart ) ) != fsize.QuadPart ) )  // too large for address space
+	{
+		CloseHandle( f );
+		return false;
+	}
+
+	size_t size = static_cast< size_t >( fsize.QuadPart );
+	HANDLE m = CreateFileMappingA( f, NULL, PAGE_READONLY, 0, 0, NULL );
+	if ( m == NULL )
+	{
+		CloseHandle( f );
+		return false;
+	}
+
+	void* p = MapViewOfFile( m, FILE_MAP_READ, 0, 0, 0 );
+	if ( p == NULL )
+	{
+		CloseHandle( m );
+		CloseHandle( f );
+		return false;
+	}
+
+	d_file = new _mappedfile_struct;
+	d_file->osfile = f;
+	d_file->osmapping = m;
+#endif
+
+	d_data = static_cast< const char* >( p );
+	d_size = size;
+	return true;
+}
+
+
+/*
+ * Remove the mapping.
+ */
+void MappedFile::close()
+{
+	if ( d_file == NULL )
+		return;
+
+#ifdef OS_UNIX
+	munmap( const_cast< char* >( d_data ), d_size );
+#endif
+#ifdef OS_WIN
+	UnmapViewOfFile( d_data );
+	CloseHandle( d_file->osmapping );
+	CloseHandle( d_file->osfile );
+#endif
+
+	delete d_file;
+	d_file = NULL;
+	d_data = NULL;
+	d_size = 0;
+}
+
+
+/*
+ * Get content of the file.
+ */
+const char* MappedFile::getData() const
+{
+	return d_data;
+}
+
+
+/*
+ * Get size of the file.
+ */
+size_t MappedFile::getSize() const
+{
+	return d_size;
+}
+
+
+/**
+ * \brief Internal type of shared memory.
+ */
+struct _sharedmemory_struct {
+#ifdef OS_UNIX
+	std::string name;  // name of POSIX shared memory, if created by this object (empty otherwise)
+#endif
+#ifdef OS_WIN
+	HANDLE osmapping;  // Windows file mapping
+#endif
+};
+
+
+/*
+ * Constructor.
+ */
+SharedMemory::SharedMemory()
+	: d_shm( NULL ), d_data( NULL ), d_size( 0 )
+{
+	//
+}
+
+
+/*
+ * Destructor.
+ */
+SharedMemory::~SharedMemory()
+{
+	close();
+}
+
+
+/*
+ * Create shared memory, with read and write access.
+ */
+bool SharedMemory::create( const char* name, size_t size )
+{
+	close();
+
+	if ( name == NULL || strchr( name, '/' ) != NULL || strchr( name, '\\' ) != NULL || size == 0 )
+		return false;
+
+#ifdef OS_UNIX
+	std::string osname = std::string( "/" ) + name;
+	shm_unlink( osname.c_str() );  // replace existing one
+
+	int fd = shm_open( osname.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644 );
+	if ( fd < 0 )
+		return false;
+
+	if ( ( static_cast< size_t >( static_cast< off_t >( size ) ) != size ) || ( ftruncate( fd, static_cast< off_t >( size ) ) != 0 ) )
+	{
+		::close( fd );
+		shm_unlink( osname.c_str() );
+		return false;
+	}
+
+	void* p = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+	::close( fd );  // mapping stays valid
+	if ( p == MAP_FAILED )
+	{
+		shm_unlink( osname.c_str() );
+		return false;
+	}
+
+	d_shm = new _sharedmemory_struct;
+	d_shm->name = osname;
+#endif
+#ifdef OS_WIN
+	unsigned long long size64 = size;
+	HANDLE m = CreateFileMappingA( INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+	                               static_cast< DWORD >( size64 >> 32 ), static_cast< DWORD >( size64 & 0xffffffff ), name );
+	if ( m == NULL )
+		return false;
+
+	if ( GetLastError() == ERROR_ALREADY_EXISTS )  // still in use by another process
+	{
+		CloseHandle( m );
+		return false;
+	}
+
+	void* p = MapViewOfFile( m, FILE_MAP_ALL_ACCESS, 0, 0, size );
+	if ( p == NULL )
+	{
+		CloseHandle( m );
+		return false;
+	}
+
+	d_shm = new _sharedmemory_struct;
+	d_shm->osmapping = m;
+#endif
+
+	d_data = static_cast< char* >( p );
+	d_size = size;
+	return true;
+}
+
+
+/*
+ * Open existing shared memory, with read access.
+ */
+bool SharedMemory::open( const char* name )
+{
+	close();
+
+	if ( name == NULL || strchr( name, '/' ) != NULL || strchr( name, '\\' ) != NULL )
+		return false;
+
+#ifdef OS_UNIX
+	std::string osname = std::string( "/" ) + name;
+	int fd = shm_open( osname.c_str(), O_RDONLY, 0 );
+	if ( fd < 0 )
+		return false;
+
+	struct stat st;
+	if ( ( fstat( fd, &st ) != 0 ) || ( st.st_size <= 0 ) ||
+	     ( static_cast< off_t >( static_cast< size_t >( st.st_size ) ) != st.st_size ) )  // too large for address space
+	{
+		::close( fd );
+		return false;
+	}
+
+	size_t size = static_cast< size_t >( st.st_size );
+	void* p = mmap( NULL, size, PROT_READ, MAP_SHARED, fd, 0 );
+	::close( fd );  // mapping stays valid
+	if ( p == MAP_FAILED )
+		return false;
+
+	d_shm = new _sharedmemory_struct;
+#endif
+#ifdef OS_WIN
+	HANDLE m = OpenFileMappingA( FILE_MAP_READ, FALSE, name );
+	if ( m == NULL )
+		return false;
+
+	void* p = MapViewOfFile( m, FILE_MAP_READ, 0, 0, 0 );
+	if ( p == NULL )
+	{
+		CloseHandle( m );
+		return false;
+	}
+
+	MEMORY_BASIC_INFORMATION info;
+	if ( VirtualQuery( p, &info, sizeof( info ) ) == 0 )
+	{
+		UnmapViewOfFile( p );
+		CloseHandle( m );
+		return false;
+	}
+
+	size_t size = info.RegionSize;
+	d_shm = new _sharedmemory_struct;
+	d_shm->osmapping = m;
+#endif
+
+	d_data = static_cast< char* >( p );
+	d_size = size;
+	return true;
+}
+
+
+/*
+ * Remove the mapping.
+ */
+void SharedMemory::close()
+{
+	if ( d_shm == NULL )
+		return;
+
+#ifdef OS_UNIX
+	munmap( d_data, d_size );
+	if ( ! d_shm->name.empty() )
+		shm_unlink( d_shm->name.c_str() );
+#endif
+#ifdef OS_WIN
+	UnmapViewOfFile( d_data );
+	CloseHandle( d_shm->osmapping );
+#endif
+
+	delete d_shm;
+	d_shm = NULL;
+	d_data = NULL;
+	d_size = 0;
+}
+
+
+/*
+ * Get content of the shared memory.
+ */
+char* SharedMemory::getData() const
+{
+	return d_data;
+}
+
+
+/*
+ * Get size of the shared memory.
+ */
+size_t SharedMemory::getSize() const
+{
+	return d_size;
+}
+
+
+}  // namespace DTrackSys
+